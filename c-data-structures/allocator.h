@@ -0,0 +1,92 @@
+#ifndef C_DATA_STRUCTURES_ALLOCATOR_H_
+#define C_DATA_STRUCTURES_ALLOCATOR_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include <stdlib.h>
+
+/**
+ * @file allocator.h
+ *
+ * @brief Pluggable allocator interface for the container macros.
+ *
+ * Containers generated with the `_WITH_ALLOC` macro variants (for example
+ * DEFINE_ARRAYLIKE_WITH_ALLOC) route every table and block allocation through
+ * an Allocator instead of calling malloc/realloc/free directly. The plain
+ * macros are unaffected and keep calling the C library directly.
+ *
+ * All callbacks receive the allocator's `ctx` and the size of the region
+ * involved, so size-aware allocators (arenas, pools) do not need to keep
+ * their own headers:
+ *  - `allocate` returns `size` bytes suitably aligned for any type, or NULL
+ *  - `reallocate` resizes a region previously returned by this allocator
+ *    from `old_size` to `new_size` bytes, preserving its contents, or
+ *    returns NULL on failure
+ *  - `deallocate` releases a region of `size` bytes; it may be a no-op for
+ *    allocators that release memory in bulk
+ *
+ * The Allocator must outlive every container that uses it.
+ */
+typedef struct {
+  void *(*allocate)(void *ctx, size_t size);
+  void *(*reallocate)(void *ctx, void *ptr, size_t old_size, size_t new_size);
+  void (*deallocate)(void *ctx, void *ptr, size_t size);
+  void *ctx;
+} Allocator;
+
+static inline void *allocator_default_allocate(void *ctx, size_t size) {
+  (void)ctx;
+  return malloc(size);
+}
+
+static inline void *allocator_default_reallocate(void *ctx, void *ptr,
+                                                 size_t old_size,
+                                                 size_t new_size) {
+  (void)ctx;
+  (void)old_size;
+  return realloc(ptr, new_size);
+}
+
+static inline void allocator_default_deallocate(void *ctx, void *ptr,
+                                                size_t size) {
+  (void)ctx;
+  (void)size;
+  free(ptr);
+}
+
+/**
+ * Returns an Allocator backed by malloc/realloc/free.
+ */
+static inline const Allocator *allocator_default(void) {
+  static const Allocator kDefault = {
+      allocator_default_allocate,
+      allocator_default_reallocate,
+      allocator_default_deallocate,
+      NULL,
+  };
+  return &kDefault;
+}
+
+static inline void *allocator_allocate(const Allocator *allocator,
+                                       size_t size) {
+  return allocator->allocate(allocator->ctx, size);
+}
+
+static inline void *allocator_reallocate(const Allocator *allocator, void *ptr,
+                                         size_t old_size, size_t new_size) {
+  return allocator->reallocate(allocator->ctx, ptr, old_size, new_size);
+}
+
+static inline void allocator_deallocate(const Allocator *allocator, void *ptr,
+                                        size_t size) {
+  allocator->deallocate(allocator->ctx, ptr, size);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* C_DATA_STRUCTURES_ALLOCATOR_H_ */
@@ -0,0 +1,200 @@
+#include "c-data-structures/arena.h"
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+struct ArenaChunk_ {
+  ArenaChunk *next;
+  size_t capacity;
+  size_t used;
+  unsigned char data[];
+};
+
+static inline uintptr_t align_up(uintptr_t value, size_t alignment) {
+  return (value + alignment - 1) & ~((uintptr_t)alignment - 1);
+}
+
+static ArenaChunk *chunk_create(size_t capacity) {
+  ArenaChunk *chunk = (ArenaChunk *)malloc(sizeof(ArenaChunk) + capacity);
+  if (chunk == NULL) {
+    return NULL;
+  }
+  chunk->next = NULL;
+  chunk->capacity = capacity;
+  chunk->used = 0;
+  return chunk;
+}
+
+/* Returns the offset in `chunk` at which an allocation of `size` bytes with
+ * `alignment` would start, or SIZE_MAX if it does not fit. */
+static inline size_t chunk_fit(const ArenaChunk *chunk, size_t size,
+                               size_t alignment) {
+  uintptr_t base = (uintptr_t)chunk->data;
+  size_t offset = (size_t)(align_up(base + chunk->used, alignment) - base);
+  if (offset > chunk->capacity || chunk->capacity - offset < size) {
+    return SIZE_MAX;
+  }
+  return offset;
+}
+
+static void *arena_allocate_fn(void *ctx, size_t size) {
+  return arena_alloc((Arena *)ctx, size);
+}
+
+/* True if `ptr` of `size` bytes is the most recent allocation in the
+ * current chunk. */
+static inline bool arena_is_last(const Arena *arena, const void *ptr,
+                                 size_t size) {
+  const ArenaChunk *chunk = arena->current;
+  return (const unsigned char *)ptr + size == chunk->data + chunk->used;
+}
+
+static void *arena_reallocate_fn(void *ctx, void *ptr, size_t old_size,
+                                 size_t new_size) {
+  Arena *arena = (Arena *)ctx;
+  if (ptr == NULL) {
+    return arena_alloc(arena, new_size);
+  }
+  if (arena_is_last(arena, ptr, old_size)) {
+    size_t start = (size_t)((unsigned char *)ptr - arena->current->data);
+    if (arena->current->capacity - start >= new_size) {
+      arena->current->used = start + new_size;
+      return ptr;
+    }
+  }
+  if (new_size <= old_size) {
+    return ptr;
+  }
+  void *moved = arena_alloc(arena, new_size);
+  if (moved != NULL) {
+    memcpy(moved, ptr, old_size);
+  }
+  return moved;
+}
+
+static void arena_deallocate_fn(void *ctx, void *ptr, size_t size) {
+  Arena *arena = (Arena *)ctx;
+  if (ptr != NULL && arena_is_last(arena, ptr, size)) {
+    arena->current->used -= size;
+  }
+}
+
+bool arena_init(Arena *arena, size_t chunk_size) {
+  assert(arena != NULL);
+  arena->chunk_size = chunk_size > 0 ? chunk_size : ARENA_DEFAULT_CHUNK_SIZE;
+  arena->first = arena->current = chunk_create(arena->chunk_size);
+  arena->allocator.allocate = arena_allocate_fn;
+  arena->allocator.reallocate = arena_reallocate_fn;
+  arena->allocator.deallocate = arena_deallocate_fn;
+  arena->allocator.ctx = arena;
+  return arena->first != NULL;
+}
+
+void arena_finalize(Arena *arena) {
+  assert(arena != NULL);
+  ArenaChunk *chunk = arena->first;
+  while (chunk != NULL) {
+    ArenaChunk *next = chunk->next;
+    free(chunk);
+    chunk = next;
+  }
+  arena->first = arena->current = NULL;
+}
+
+void *arena_alloc_aligned(Arena *arena, size_t size, size_t alignment) {
+  assert(arena != NULL && arena->current != NULL);
+  assert(alignment > 0 && (alignment & (alignment - 1)) == 0);
+  ArenaChunk *chunk = arena->current;
+  size_t offset = chunk_fit(chunk, size, alignment);
+  /* Move forward through retained chunks until one fits, passing over any
+   * that are too small for this request. */
+  ArenaChunk *target = chunk;
+  while (offset == SIZE_MAX && target->next != NULL) {
+    target = target->next;
+    target->used = 0;
+    offset = chunk_fit(target, size, alignment);
+  }
+  if (offset == SIZE_MAX) {
+    /* No retained chunk fits. Put a fresh chunk right after `chunk` so that
+     * chunk order (and with it every outstanding checkpoint) is preserved,
+     * replacing the unused chunk there, if any, so that ever larger
+     * requests after each reset do not lengthen the chain. */
+    size_t needed = size + alignment;
+    ArenaChunk *fresh =
+        chunk_create(needed > arena->chunk_size ? needed : arena->chunk_size);
+    if (fresh == NULL) {
+      return NULL;
+    }
+    ArenaChunk *replaced = chunk->next;
+    if (replaced != NULL) {
+      fresh->next = replaced->next;
+      free(replaced);
+    }
+    chunk->next = fresh;
+    target = fresh;
+    offset = chunk_fit(target, size, alignment);
+    assert(offset != SIZE_MAX);
+  }
+  arena->current = target;
+  target->used = offset + size;
+  return target->data + offset;
+}
+
+void *arena_alloc(Arena *arena, size_t size) {
+  return arena_alloc_aligned(arena, size, ARENA_DEFAULT_ALIGNMENT);
+}
+
+void *arena_calloc(Arena *arena, size_t count, size_t size) {
+  if (size != 0 && count > SIZE_MAX / size) {
+    return NULL;
+  }
+  void *ptr = arena_alloc(arena, count * size);
+  if (ptr != NULL) {
+    memset(ptr, 0x0, count * size);
+  }
+  return ptr;
+}
+
+ArenaCheckpoint arena_checkpoint(const Arena *arena) {
+  assert(arena != NULL);
+  ArenaCheckpoint checkpoint = {arena->current, arena->current->used};
+  return checkpoint;
+}
+
+void arena_rollback(Arena *arena, ArenaCheckpoint checkpoint) {
+  assert(arena != NULL && checkpoint.chunk != NULL);
+  arena->current = checkpoint.chunk;
+  arena->current->used = checkpoint.used;
+}
+
+void arena_reset(Arena *arena) {
+  assert(arena != NULL);
+  arena->current = arena->first;
+  arena->current->used = 0;
+}
+
+size_t arena_bytes_reserved(const Arena *arena) {
+  assert(arena != NULL);
+  size_t total = 0;
+  for (const ArenaChunk *chunk = arena->first; chunk != NULL;
+       chunk = chunk->next) {
+    total += chunk->capacity;
+  }
+  return total;
+}
+
+size_t arena_chunk_count(const Arena *arena) {
+  assert(arena != NULL);
+  size_t count = 0;
+  for (const ArenaChunk *chunk = arena->first; chunk != NULL;
+       chunk = chunk->next) {
+    count++;
+  }
+  return count;
+}
+
+const Allocator *arena_allocator(Arena *arena) {
+  assert(arena != NULL);
+  return &arena->allocator;
+}
@@ -0,0 +1,106 @@
+#ifndef C_DATA_STRUCTURES_ARENA_H_
+#define C_DATA_STRUCTURES_ARENA_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "c-data-structures/allocator.h"
+
+/**
+ * @file arena.h
+ *
+ * @brief Chunked bump allocator with checkpoints and O(1) reset.
+ *
+ * An Arena hands out memory by advancing a cursor through large chunks
+ * obtained from malloc. Individual allocations are never freed; instead the
+ * whole arena is released at once:
+ *  - arena_reset rewinds to the first chunk in O(1); chunks are retained and
+ *    reused by later allocations
+ *  - arena_checkpoint/arena_rollback rewind to an earlier point, releasing
+ *    everything allocated since in O(1)
+ *  - arena_finalize returns every chunk to the system
+ *
+ * Requests larger than the chunk size get a dedicated chunk, which is also
+ * retained across resets. A request that no retained chunk can hold replaces
+ * the next unused one, so the number of chunks only grows with what a
+ * single reset-to-reset cycle needs.
+ *
+ * `arena_allocator` exposes the arena through the Allocator interface, so it
+ * can back any container generated with a `_WITH_ALLOC` macro, as well as a
+ * KeyedList's keys and values through keyedlist_init_allocator:
+ *
+ *   Arena arena;
+ *   arena_init(&arena, 0);
+ *   IntArray arr;
+ *   IntArray_init_allocator(&arr, arena_allocator(&arena), 16);
+ *   ...
+ *   arena_reset(&arena);  // drops arr's table, no per-container free
+ *
+ * Containers backed by an arena must not be used after the arena is reset
+ * or rolled back past their allocations. Calling their finalize functions
+ * beforehand is allowed but unnecessary.
+ *
+ * An Arena is not thread-safe and must not be moved (copied by value) after
+ * arena_init, since its Allocator refers back to it.
+ */
+
+/** Chunk size used when arena_init is passed 0. */
+#define ARENA_DEFAULT_CHUNK_SIZE (64 * 1024)
+
+/** Alignment of arena_alloc results; suitable for any fundamental type. */
+#define ARENA_DEFAULT_ALIGNMENT 16
+
+typedef struct ArenaChunk_ ArenaChunk;
+
+typedef struct {
+  ArenaChunk *first;
+  ArenaChunk *current;
+  size_t chunk_size;
+  Allocator allocator;
+} Arena;
+
+/**
+ * A position in an arena that can later be rolled back to.
+ */
+typedef struct {
+  ArenaChunk *chunk;
+  size_t used;
+} ArenaCheckpoint;
+
+/* Initialization and lifetime management */
+bool arena_init(Arena *arena, size_t chunk_size);
+void arena_finalize(Arena *arena);
+
+/* Allocation */
+void *arena_alloc(Arena *arena, size_t size);
+void *arena_alloc_aligned(Arena *arena, size_t size, size_t alignment);
+void *arena_calloc(Arena *arena, size_t count, size_t size);
+
+/* Bulk release */
+ArenaCheckpoint arena_checkpoint(const Arena *arena);
+void arena_rollback(Arena *arena, ArenaCheckpoint checkpoint);
+void arena_reset(Arena *arena);
+
+/* Introspection */
+size_t arena_bytes_reserved(const Arena *arena);
+size_t arena_chunk_count(const Arena *arena);
+
+/**
+ * Returns an Allocator that allocates from `arena`.
+ *
+ * Reallocating the most recent allocation grows or shrinks it in place when
+ * the current chunk has room. Deallocating the most recent allocation
+ * returns its space to the arena; all other deallocations are no-ops.
+ */
+const Allocator *arena_allocator(Arena *arena);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* C_DATA_STRUCTURES_ARENA_H_ */
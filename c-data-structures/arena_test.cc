@@ -0,0 +1,217 @@
+#include "c-data-structures/arena.h"
+
+#include <gtest/gtest.h>
+#include <stdint.h>
+
+#include "c-data-structures/arraylike.h"
+#include "c-data-structures/stable_arraylike.h"
+
+extern "C" {
+#include "c-data-structures/keyed_list.h"
+}
+
+namespace {
+
+DEFINE_ARRAYLIKE_WITH_ALLOC(ArenaIntArray, int);
+IMPL_ARRAYLIKE_WITH_ALLOC(ArenaIntArray, int, allocator_default());
+
+DEFINE_STABLE_ARRAYLIKE_WITH_ALLOC(ArenaStableIntArray, int);
+IMPL_STABLE_ARRAYLIKE_WITH_ALLOC(ArenaStableIntArray, int,
+                                 allocator_default());
+
+/* Test fixture to ensure proper setup / teardown */
+class ArenaTest : public ::testing::Test {
+ protected:
+  Arena arena{};
+
+  void SetUp() override { ASSERT_TRUE(arena_init(&arena, 1024)); }
+
+  void TearDown() override { arena_finalize(&arena); }
+};
+
+/* -------------------------------------------------------------
+ * Allocation
+ * ------------------------------------------------------------- */
+
+TEST_F(ArenaTest, AllocationsAreDistinctAndAligned) {
+  char* a = (char*)arena_alloc(&arena, 3);
+  char* b = (char*)arena_alloc(&arena, 5);
+  ASSERT_NE(a, nullptr);
+  ASSERT_NE(b, nullptr);
+  EXPECT_GE(b, a + 3);
+  EXPECT_EQ((uintptr_t)a % ARENA_DEFAULT_ALIGNMENT, 0u);
+  EXPECT_EQ((uintptr_t)b % ARENA_DEFAULT_ALIGNMENT, 0u);
+}
+
+TEST_F(ArenaTest, AlignedAllocation) {
+  arena_alloc_aligned(&arena, 1, 1);
+  void* ptr = arena_alloc_aligned(&arena, 64, 256);
+  ASSERT_NE(ptr, nullptr);
+  EXPECT_EQ((uintptr_t)ptr % 256, 0u);
+}
+
+TEST_F(ArenaTest, CallocZeroes) {
+  int* values = (int*)arena_calloc(&arena, 16, sizeof(int));
+  ASSERT_NE(values, nullptr);
+  for (int i = 0; i < 16; ++i) {
+    EXPECT_EQ(values[i], 0);
+  }
+}
+
+TEST_F(ArenaTest, SpillsIntoNewChunks) {
+  for (int i = 0; i < 100; ++i) {
+    int* value = (int*)arena_alloc(&arena, 100);
+    ASSERT_NE(value, nullptr);
+    *value = i;
+  }
+  EXPECT_GE(arena_bytes_reserved(&arena), 100u * 100u);
+}
+
+TEST_F(ArenaTest, LargeAllocationGetsDedicatedChunk) {
+  char* big = (char*)arena_alloc(&arena, 10000);
+  ASSERT_NE(big, nullptr);
+  memset(big, 0xAB, 10000);
+  EXPECT_NE(arena_alloc(&arena, 8), nullptr);
+}
+
+/* -------------------------------------------------------------
+ * Checkpoints and reset
+ * ------------------------------------------------------------- */
+
+TEST_F(ArenaTest, RollbackReusesSpace) {
+  arena_alloc(&arena, 32);
+  ArenaCheckpoint checkpoint = arena_checkpoint(&arena);
+  void* first = arena_alloc(&arena, 64);
+  for (int i = 0; i < 50; ++i) {
+    arena_alloc(&arena, 100);
+  }
+  arena_rollback(&arena, checkpoint);
+  EXPECT_EQ(arena_alloc(&arena, 64), first);
+}
+
+TEST_F(ArenaTest, ResetRetainsChunks) {
+  void* first = arena_alloc(&arena, 16);
+  for (int i = 0; i < 50; ++i) {
+    arena_alloc(&arena, 100);
+  }
+  const size_t reserved = arena_bytes_reserved(&arena);
+
+  arena_reset(&arena);
+  EXPECT_EQ(arena_alloc(&arena, 16), first);
+  for (int i = 0; i < 50; ++i) {
+    arena_alloc(&arena, 100);
+  }
+  EXPECT_EQ(arena_bytes_reserved(&arena), reserved);
+}
+
+TEST_F(ArenaTest, ResetThenLargerAllocationReplacesRetainedChunk) {
+  arena_alloc(&arena, 16);
+  ASSERT_NE(arena_alloc(&arena, 2000), nullptr);
+  const size_t chunks = arena_chunk_count(&arena);
+
+  for (size_t size = 3000; size <= 30000; size += 1000) {
+    arena_reset(&arena);
+    arena_alloc(&arena, 16);
+    char* big = (char*)arena_alloc(&arena, size);
+    ASSERT_NE(big, nullptr);
+    memset(big, 0xAB, size);
+    EXPECT_EQ(arena_chunk_count(&arena), chunks);
+  }
+}
+
+TEST_F(ArenaTest, LargeAllocationSkipsToARetainedChunkThatFits) {
+  arena_alloc(&arena, 16);
+  arena_alloc(&arena, 1010);  // spills into a second 1024-byte chunk
+  char* big = (char*)arena_alloc(&arena, 5000);
+  ASSERT_NE(big, nullptr);
+  const size_t chunks = arena_chunk_count(&arena);
+
+  arena_reset(&arena);
+  arena_alloc(&arena, 16);
+  EXPECT_EQ(arena_alloc(&arena, 5000), big);
+  EXPECT_EQ(arena_chunk_count(&arena), chunks);
+}
+
+/* -------------------------------------------------------------
+ * Allocator interface
+ * ------------------------------------------------------------- */
+
+TEST_F(ArenaTest, ReallocateLastAllocationInPlace) {
+  const Allocator* allocator = arena_allocator(&arena);
+  char* ptr = (char*)allocator_allocate(allocator, 16);
+  strcpy(ptr, "arena");
+  char* grown = (char*)allocator_reallocate(allocator, ptr, 16, 64);
+  EXPECT_EQ(grown, ptr);
+
+  allocator_allocate(allocator, 8);
+  char* moved = (char*)allocator_reallocate(allocator, grown, 64, 128);
+  EXPECT_NE(moved, grown);
+  EXPECT_STREQ(moved, "arena");
+}
+
+TEST_F(ArenaTest, DeallocateLastAllocationReturnsSpace) {
+  const Allocator* allocator = arena_allocator(&arena);
+  void* ptr = allocator_allocate(allocator, 48);
+  allocator_deallocate(allocator, ptr, 48);
+  EXPECT_EQ(allocator_allocate(allocator, 48), ptr);
+}
+
+TEST_F(ArenaTest, BacksArrayLikeTable) {
+  ArenaIntArray arr{};
+  ASSERT_TRUE(ArenaIntArray_init_allocator(&arr, arena_allocator(&arena), 4));
+  for (int i = 0; i < 1000; ++i) {
+    ArenaIntArray_push_back(&arr, i);
+  }
+  for (int i = 0; i < 1000; ++i) {
+    ASSERT_EQ(ArenaIntArray_get_unchecked(&arr, i), i);
+  }
+  /* No finalize: the arena releases the table. */
+  arena_reset(&arena);
+}
+
+TEST_F(ArenaTest, BacksStableArrayLikeBlocks) {
+  ArenaStableIntArray arr{};
+  ASSERT_TRUE(
+      ArenaStableIntArray_init_allocator(&arr, arena_allocator(&arena)));
+  const int* first = nullptr;
+  ArenaStableIntArray_push_back(&arr, -1);
+  ASSERT_TRUE(ArenaStableIntArray_get_ref(&arr, 0, &first));
+  for (int i = 1; i < 5000; ++i) {
+    ArenaStableIntArray_push_back(&arr, i);
+  }
+  EXPECT_EQ(*first, -1);
+  EXPECT_EQ(ArenaStableIntArray_get_unchecked(&arr, 4999), 4999);
+  arena_reset(&arena);
+}
+
+TEST_F(ArenaTest, BacksKeyedListValuesAndKeys) {
+  /* Keys are compared by address. */
+  static int keys[2000];
+  KeyedList klist;
+  keyedlist_init_allocator(&klist, int64_t, 0, arena_allocator(&arena));
+  EXPECT_EQ(klist._keys.allocator, arena_allocator(&arena));
+  size_t reserved = arena_bytes_reserved(&arena);
+  for (int i = 0; i < 2000; ++i) {
+    void* entry;
+    keyedlist_insert(&klist, &keys[i], &entry);
+    *(int64_t*)entry = i;
+  }
+  EXPECT_GT(arena_bytes_reserved(&arena), reserved);
+
+  for (int i = 1; i < 2000; i += 2) {
+    keyedlist_remove(&klist, &keys[i]);
+  }
+  EXPECT_TRUE(keyedlist_compact(&klist));
+  for (int i = 0; i < 2000; ++i) {
+    void* value = keyedlist_lookup(&klist, &keys[i]);
+    if (i % 2 == 0) {
+      ASSERT_NE(value, nullptr);
+      EXPECT_EQ(*(int64_t*)value, i);
+    } else {
+      EXPECT_EQ(value, nullptr);
+    }
+  }
+  keyedlist_finalize(&klist);
+}
+
+}  // namespace
@@ -7,10 +7,14 @@ extern "C" {
 
 #include <assert.h>
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
 
+#include "c-data-structures/allocator.h"
+#include "c-data-structures/container_stats.h"
+
 /**
  * @file arraylike.h
  *
@@ -28,6 +32,7 @@ extern "C" {
  *
  * The generated container supports:
  *  - Push/pop at both ends
+ *  - Bulk insertion, erasure and filtering of ranges, each in a single pass
  *  - Random access get/set (with bounds-checked and unchecked variants)
  *  - Automatic capacity growth
  *  - Appending other arrays or ranges
@@ -35,8 +40,21 @@ extern "C" {
  *
  * Memory management:
  *  - The array owns a contiguous heap buffer (`table`)
- *  - Capacity grows in fixed-size chunks (DEFAULT_TABLE_SIZE)
- *  - Shrinking does not reduce capacity, only logical size
+ *  - The buffer comes from malloc/realloc/free, or from a user-supplied
+ *    Allocator for types generated with DEFINE_ARRAYLIKE_WITH_ALLOC
+ *  - Types generated with DEFINE_SMALL_ARRAYLIKE keep up to N elements in
+ *    the struct itself and only allocate a buffer beyond that
+ *  - Types generated with DEFINE_COW_ARRAYLIKE can share one buffer between
+ *    several arrays, copying it only when one of them is modified
+ *  - Capacity grows according to a growth policy chosen per instantiation
+ *    (geometric by default, giving amortized O(1) push_back)
+ *  - Shrinking does not reduce capacity, only logical size; call
+ *    `name##_shrink_to_fit` to release the unused tail
+ *
+ * Instrumentation:
+ *  - With CONTAINER_STATS defined, each array counts table resizes, bytes
+ *    memmoved by front and middle insertion/removal, and its peak size and
+ *    capacity, readable through `name##_stats` (see container_stats.h)
  *
  * Error handling:
  *  - Functions returning `bool` indicate failure for invalid indices or
@@ -70,6 +88,52 @@ extern "C" {
  */
 #define DEFAULT_TABLE_SIZE 8
 
+/**
+ * Growth policies.
+ *
+ * A growth policy is a function-like macro (or function) invoked as
+ * `policy(capacity, needed)` that returns the new capacity for a table that
+ * currently holds `capacity` slots and must accommodate at least `needed`
+ * elements. It is only consulted when `needed > capacity`.
+ *
+ *  - ARRAYLIKE_GROWTH_GEOMETRIC doubles the capacity until it fits, so a
+ *    sequence of n push_back calls performs O(log n) reallocations.
+ *  - ARRAYLIKE_GROWTH_LINEAR rounds up to the next multiple of
+ *    DEFAULT_TABLE_SIZE. This minimizes slack but costs O(n) reallocations
+ *    (and O(n^2) copying) for a sequence of n push_back calls.
+ *
+ * ARRAYLIKE_DEFAULT_GROWTH is used by IMPL_ARRAYLIKE and may be overridden
+ * before including this header. Individual instantiations may select a
+ * policy with IMPL_ARRAYLIKE_WITH_GROWTH.
+ */
+static inline size_t arraylike_grow_geometric(size_t capacity, size_t needed) {
+  size_t new_capacity =
+      capacity < DEFAULT_TABLE_SIZE ? DEFAULT_TABLE_SIZE : capacity;
+  while (new_capacity < needed) {
+    if (new_capacity > SIZE_MAX / 2) {
+      return needed;
+    }
+    new_capacity *= 2;
+  }
+  return new_capacity;
+}
+
+static inline size_t arraylike_grow_linear(size_t capacity, size_t needed) {
+  (void)capacity;
+  return ((needed + DEFAULT_TABLE_SIZE - 1) / DEFAULT_TABLE_SIZE) *
+         DEFAULT_TABLE_SIZE;
+}
+
+#define ARRAYLIKE_GROWTH_GEOMETRIC(capacity, needed) \
+  arraylike_grow_geometric((capacity), (needed))
+
+#define ARRAYLIKE_GROWTH_LINEAR(capacity, needed) \
+  arraylike_grow_linear((capacity), (needed))
+
+#ifndef ARRAYLIKE_DEFAULT_GROWTH
+#define ARRAYLIKE_DEFAULT_GROWTH ARRAYLIKE_GROWTH_GEOMETRIC
+#endif
+
 /**
  * @macro DEFINE_ARRAYLIKE
  *
@@ -83,7 +147,89 @@ extern "C" {
  * @param name  Base name for the generated type and functions
  * @param type  Element type stored in the array
  */
-#define DEFINE_ARRAYLIKE(name, type)                                          \
+#define DEFINE_ARRAYLIKE(name, type) _ARRAYLIKE_DECLARE(name, type, )
+
+/**
+ * @macro DEFINE_ARRAYLIKE_WITH_ALLOC
+ *
+ * @brief Same as DEFINE_ARRAYLIKE, but every table allocation goes through
+ * an Allocator stored in the array.
+ *
+ * In addition to the DEFINE_ARRAYLIKE API this declares
+ * `name##_init_allocator`, which initializes an array backed by a specific
+ * Allocator. The other initializers use the default allocator passed to
+ * IMPL_ARRAYLIKE_WITH_ALLOC. Copies share the source array's allocator.
+ *
+ * @param name  Base name for the generated type and functions
+ * @param type  Element type stored in the array
+ */
+#define DEFINE_ARRAYLIKE_WITH_ALLOC(name, type)                  \
+  _ARRAYLIKE_DECLARE(name, type, const Allocator *allocator;);   \
+  bool name##_init_allocator(name *, const Allocator *allocator, \
+                             size_t capacity)
+
+/**
+ * @macro DEFINE_SMALL_ARRAYLIKE
+ *
+ * @brief Same as DEFINE_ARRAYLIKE, but the first N elements are stored
+ * inline in the array struct.
+ *
+ * `table` points at the inline buffer until the array grows past N
+ * elements, at which point the elements move to a heap buffer; shrinking
+ * back to N or fewer with `name##_shrink_to_fit` moves them back inline.
+ * Arrays that never exceed N elements make no allocations of their own, and
+ * `name##_create` costs a single allocation.
+ *
+ * Because `table` may point into the struct, a small array must not be
+ * copied or moved by value; use `name##_copy` instead.
+ *
+ * @param name  Base name for the generated type and functions
+ * @param type  Element type stored in the array
+ * @param N     Number of elements stored inline
+ */
+#define DEFINE_SMALL_ARRAYLIKE(name, type, N) \
+  _ARRAYLIKE_DECLARE(name, type, type _inline[N];)
+
+/**
+ * @macro DEFINE_COW_ARRAYLIKE
+ *
+ * @brief Same as DEFINE_ARRAYLIKE, but tables are reference counted so that
+ * arrays can share them copy-on-write.
+ *
+ * In addition to the DEFINE_ARRAYLIKE API this declares:
+ *  - `name##_share`, which returns a new heap-allocated array sharing the
+ *    source array's table in O(1) (release it with `name##_delete`)
+ *  - `name##_is_shared`, which reports whether the table is shared
+ *
+ * An array whose table is shared copies it the first time it writes to it:
+ * set, push, insert, remove, erase, retain_if, append, mutable_ref and
+ * mutable_value all detach, as do reserve and shrink_to_fit, and the sort,
+ * parallel_sort and fill functions from arraylike_sort.h,
+ * arraylike_parallel_sort.h and arraylike_numeric.h. Reads, pop_back, rshrink
+ * and clear only change the array's own view and do not copy.
+ * `name##_make_unique`, declared for every arraylike and a no-op unless the
+ * table is shared, detaches explicitly; code that writes through `table`
+ * directly must call it first.
+ * Pointers obtained from an array before it detaches keep pointing into the
+ * shared table.
+ *
+ * The reference count is atomic, so arrays sharing a table may be used and
+ * finalized from different threads. Each array on its own is exactly as
+ * thread-safe as a plain arraylike; in particular, sharing an array races
+ * with modifying it.
+ *
+ * `name##_copy` still makes a deep copy.
+ *
+ * @param name  Base name for the generated type and functions
+ * @param type  Element type stored in the array
+ */
+#define DEFINE_COW_ARRAYLIKE(name, type) \
+  _ARRAYLIKE_DECLARE(name, type, );      \
+  name *name##_share(const name *const); \
+  bool name##_is_shared(const name *const)
+
+/* Declares the array type with `fields` appended to the struct. */
+#define _ARRAYLIKE_DECLARE(name, type, fields)                                \
                                                                               \
   /**                                                                         \
    * Dynamic array structure.                                                 \
@@ -97,6 +243,8 @@ extern "C" {
     size_t capacity;                                                          \
     size_t size;                                                              \
     type *table;                                                              \
+    CONTAINER_STATS_FIELD                                                     \
+    fields                                                                    \
   };                                                                          \
                                                                               \
   /**                                                                         \
@@ -122,6 +270,11 @@ extern "C" {
   void name##_delete(name *);                                                 \
   void name##_clear(name *const);                                             \
                                                                               \
+  /* Capacity management */                                                   \
+  void name##_reserve(name *const, size_t capacity);                          \
+  void name##_shrink_to_fit(name *const);                                     \
+  void name##_make_unique(name *const);                                       \
+                                                                              \
   /* Shrinking operations */                                                  \
   bool name##_lshrink(name *const array, size_t amount);                      \
   bool name##_rshrink(name *const array, size_t amount);                      \
@@ -159,9 +312,20 @@ extern "C" {
   bool name##_remove(name *const, int32_t, type *ptr);                        \
   type name##_remove_unchecked(name *const, int32_t);                         \
                                                                               \
+  /* Range operations */                                                      \
+  bool name##_insert_range(name *const, int32_t index, const type elts[],     \
+                           size_t count);                                     \
+  bool name##_erase_range(name *const, int32_t range_start,                   \
+                          int32_t range_end);                                 \
+  type *name##_push_back_n(name *const, size_t count);                        \
+  size_t name##_retain_if(name *const,                                        \
+                          bool (*predicate)(const type *elt, void *ctx),      \
+                          void *ctx);                                         \
+                                                                              \
   /* Size and state */                                                        \
   size_t name##_size(const name *const);                                      \
   bool name##_is_empty(const name *const);                                    \
+  ContainerStats name##_stats(const name *const);                             \
                                                                               \
   /* Copying and concatenation */                                             \
   name *name##_copy(const name *const);                                       \
@@ -188,21 +352,329 @@ extern "C" {
  * The implementation assumes:
  *  - All pointers passed to checked functions are non-NULL
  *  - `_unchecked` functions are called only with valid indices
+ *
+ * Capacity grows according to ARRAYLIKE_DEFAULT_GROWTH.
+ */
+#define IMPL_ARRAYLIKE(name, type) \
+  IMPL_ARRAYLIKE_WITH_GROWTH(name, type, ARRAYLIKE_DEFAULT_GROWTH)
+
+/**
+ * @macro IMPL_ARRAYLIKE_WITH_GROWTH
+ *
+ * @brief Same as IMPL_ARRAYLIKE, but with an explicit growth policy.
+ *
+ * @param name    Base name used in DEFINE_ARRAYLIKE
+ * @param type    Element type used in DEFINE_ARRAYLIKE
+ * @param growth  Growth policy, e.g. ARRAYLIKE_GROWTH_LINEAR
+ */
+#define IMPL_ARRAYLIKE_WITH_GROWTH(name, type, growth) \
+  _ARRAYLIKE_DEFAULT_MEMORY(name, type)                \
+  _ARRAYLIKE_IMPLEMENT(name, type, growth, DEFAULT_TABLE_SIZE)
+
+/**
+ * @macro IMPL_ARRAYLIKE_WITH_ALLOC
+ *
+ * @brief Generates the implementation for a type declared with
+ * DEFINE_ARRAYLIKE_WITH_ALLOC.
+ *
+ * @param name               Base name used in DEFINE_ARRAYLIKE_WITH_ALLOC
+ * @param type               Element type used in DEFINE_ARRAYLIKE_WITH_ALLOC
+ * @param default_allocator  `const Allocator *` expression used by the
+ *                           initializers other than `name##_init_allocator`
+ */
+#define IMPL_ARRAYLIKE_WITH_ALLOC(name, type, default_allocator)      \
+  IMPL_ARRAYLIKE_WITH_ALLOC_AND_GROWTH(name, type, default_allocator, \
+                                       ARRAYLIKE_DEFAULT_GROWTH)
+
+/**
+ * @macro IMPL_ARRAYLIKE_WITH_ALLOC_AND_GROWTH
+ *
+ * @brief IMPL_ARRAYLIKE_WITH_ALLOC with an explicit growth policy.
+ */
+#define IMPL_ARRAYLIKE_WITH_ALLOC_AND_GROWTH(name, type, default_allocator, \
+                                             growth)                        \
+  _ARRAYLIKE_ALLOCATOR_MEMORY(name, type, default_allocator)                \
+  _ARRAYLIKE_IMPLEMENT(name, type, growth, DEFAULT_TABLE_SIZE)              \
+                                                                            \
+  bool name##_init_allocator(name *array, const Allocator *allocator,       \
+                             size_t capacity) {                             \
+    assert(array != NULL && allocator != NULL);                             \
+    array->allocator = allocator;                                           \
+    return name##_init_table(array, capacity);                              \
+  }
+
+/**
+ * @macro IMPL_SMALL_ARRAYLIKE
+ *
+ * @brief Generates the implementation for a type declared with
+ * DEFINE_SMALL_ARRAYLIKE. `name##_init` starts with the inline capacity.
+ *
+ * @param name  Base name used in DEFINE_SMALL_ARRAYLIKE
+ * @param type  Element type used in DEFINE_SMALL_ARRAYLIKE
+ */
+#define IMPL_SMALL_ARRAYLIKE(name, type) \
+  IMPL_SMALL_ARRAYLIKE_WITH_GROWTH(name, type, ARRAYLIKE_DEFAULT_GROWTH)
+
+/**
+ * @macro IMPL_SMALL_ARRAYLIKE_WITH_GROWTH
+ *
+ * @brief IMPL_SMALL_ARRAYLIKE with an explicit growth policy.
+ */
+#define IMPL_SMALL_ARRAYLIKE_WITH_GROWTH(name, type, growth) \
+  _ARRAYLIKE_SMALL_MEMORY(name, type)                        \
+  _ARRAYLIKE_IMPLEMENT(name, type, growth, _ARRAYLIKE_INLINE_CAPACITY(name))
+
+/**
+ * @macro IMPL_COW_ARRAYLIKE
+ *
+ * @brief Generates the implementation for a type declared with
+ * DEFINE_COW_ARRAYLIKE.
+ *
+ * @param name  Base name used in DEFINE_COW_ARRAYLIKE
+ * @param type  Element type used in DEFINE_COW_ARRAYLIKE
+ */
+#define IMPL_COW_ARRAYLIKE(name, type) \
+  IMPL_COW_ARRAYLIKE_WITH_GROWTH(name, type, ARRAYLIKE_DEFAULT_GROWTH)
+
+/**
+ * @macro IMPL_COW_ARRAYLIKE_WITH_GROWTH
+ *
+ * @brief IMPL_COW_ARRAYLIKE with an explicit growth policy.
+ */
+#define IMPL_COW_ARRAYLIKE_WITH_GROWTH(name, type, growth)               \
+  _ARRAYLIKE_COW_MEMORY(name, type)                                      \
+  _ARRAYLIKE_IMPLEMENT(name, type, growth, DEFAULT_TABLE_SIZE)           \
+                                                                         \
+  name *name##_share(const name *const array) {                          \
+    assert(array != NULL);                                               \
+    name *share = (name *)malloc(sizeof(name));                          \
+    assert(share != NULL);                                               \
+    *share = *array;                                                     \
+    __atomic_add_fetch(&arraylike_shared_header(array->table)->refs, 1,  \
+                       __ATOMIC_RELAXED);                                \
+    CONTAINER_STATS_REGISTER(share, #name);                              \
+    CONTAINER_STATS_MAX(share, peak_size, share->size);                  \
+    CONTAINER_STATS_MAX(share, peak_capacity, share->capacity);          \
+    return share;                                                        \
+  }                                                                      \
+                                                                         \
+  bool name##_is_shared(const name *const array) {                       \
+    assert(array != NULL);                                               \
+    return __atomic_load_n(&arraylike_shared_header(array->table)->refs, \
+                           __ATOMIC_ACQUIRE) > 1;                        \
+  }
+
+/*
+ * Memory hooks used by _ARRAYLIKE_IMPLEMENT. Each returns or releases a
+ * table of `n` elements on behalf of `array`:
+ *  - name##_use_default_allocator(array) prepares a fresh array
+ *  - name##_table_calloc(array, n) returns a zeroed table
+ *  - name##_table_realloc(array, table, old_n, new_n) resizes a table
+ *  - name##_table_free(array, table, n) releases a table
+ *  - name##_table_unshare(array) makes `array->table` safe to write to; it
+ *    is called before every in-place write
  */
-#define IMPL_ARRAYLIKE(name, type)                                             \
+#define _ARRAYLIKE_DEFAULT_MEMORY(name, type)                              \
+  static inline void name##_use_default_allocator(name *const array) {     \
+    (void)array;                                                           \
+  }                                                                        \
+                                                                           \
+  static inline type *name##_table_calloc(name *const array, size_t n) {   \
+    (void)array;                                                           \
+    return (type *)calloc(n, sizeof(type));                                \
+  }                                                                        \
+                                                                           \
+  static inline type *name##_table_realloc(name *const array, type *table, \
+                                           size_t old_n, size_t new_n) {   \
+    (void)array;                                                           \
+    (void)old_n;                                                           \
+    return (type *)realloc(table, sizeof(type) * new_n);                   \
+  }                                                                        \
+                                                                           \
+  static inline void name##_table_free(name *const array, type *table,     \
+                                       size_t n) {                         \
+    (void)array;                                                           \
+    (void)n;                                                               \
+    free(table);                                                           \
+  }                                                                        \
+                                                                           \
+  static inline void name##_table_unshare(name *const array) {             \
+    (void)array;                                                           \
+  }
+
+#define _ARRAYLIKE_ALLOCATOR_MEMORY(name, type, default_allocator)         \
+  static inline void name##_use_default_allocator(name *const array) {     \
+    array->allocator = (default_allocator);                                \
+  }                                                                        \
+                                                                           \
+  static inline type *name##_table_calloc(name *const array, size_t n) {   \
+    type *table =                                                          \
+        (type *)allocator_allocate(array->allocator, sizeof(type) * n);    \
+    if (table != NULL) {                                                   \
+      memset(table, 0x0, sizeof(type) * n);                                \
+    }                                                                      \
+    return table;                                                          \
+  }                                                                        \
+                                                                           \
+  static inline type *name##_table_realloc(name *const array, type *table, \
+                                           size_t old_n, size_t new_n) {   \
+    return (type *)allocator_reallocate(array->allocator, table,           \
+                                        sizeof(type) * old_n,              \
+                                        sizeof(type) * new_n);             \
+  }                                                                        \
+                                                                           \
+  static inline void name##_table_free(name *const array, type *table,     \
+                                       size_t n) {                         \
+    allocator_deallocate(array->allocator, table, sizeof(type) * n);       \
+  }                                                                        \
+                                                                           \
+  static inline void name##_table_unshare(name *const array) {             \
+    (void)array;                                                           \
+  }
+
+#define _ARRAYLIKE_INLINE_CAPACITY(name) \
+  (sizeof(((name *)0)->_inline) / sizeof(((name *)0)->_inline[0]))
+
+/* Tables of up to the inline capacity live in `array->_inline`. */
+#define _ARRAYLIKE_SMALL_MEMORY(name, type)                                \
+  static inline void name##_use_default_allocator(name *const array) {     \
+    (void)array;                                                           \
+  }                                                                        \
+                                                                           \
+  static inline type *name##_table_calloc(name *const array, size_t n) {   \
+    if (n <= _ARRAYLIKE_INLINE_CAPACITY(name)) {                           \
+      memset(array->_inline, 0x0, sizeof(type) * n);                       \
+      return array->_inline;                                               \
+    }                                                                      \
+    return (type *)calloc(n, sizeof(type));                                \
+  }                                                                        \
+                                                                           \
+  static inline type *name##_table_realloc(name *const array, type *table, \
+                                           size_t old_n, size_t new_n) {   \
+    if (table == array->_inline) {                                         \
+      if (new_n <= _ARRAYLIKE_INLINE_CAPACITY(name)) {                     \
+        return table;                                                      \
+      }                                                                    \
+      type *spilled = (type *)malloc(sizeof(type) * new_n);                \
+      if (spilled != NULL) {                                               \
+        memcpy(spilled, table, sizeof(type) * old_n);                      \
+      }                                                                    \
+      return spilled;                                                      \
+    }                                                                      \
+    if (new_n <= _ARRAYLIKE_INLINE_CAPACITY(name)) {                       \
+      memcpy(array->_inline, table, sizeof(type) * new_n);                 \
+      free(table);                                                         \
+      return array->_inline;                                               \
+    }                                                                      \
+    return (type *)realloc(table, sizeof(type) * new_n);                   \
+  }                                                                        \
+                                                                           \
+  static inline void name##_table_free(name *const array, type *table,     \
+                                       size_t n) {                         \
+    (void)n;                                                               \
+    if (table != array->_inline) {                                         \
+      free(table);                                                         \
+    }                                                                      \
+  }                                                                        \
+                                                                           \
+  static inline void name##_table_unshare(name *const array) {             \
+    (void)array;                                                           \
+  }
+
+/*
+ * Copy-on-write tables are preceded by a header holding the number of
+ * arrays that share them.
+ */
+typedef union {
+  size_t refs;
+  max_align_t _align;
+} ArrayLikeSharedHeader;
+
+static inline ArrayLikeSharedHeader *arraylike_shared_header(void *table) {
+  return (ArrayLikeSharedHeader *)table - 1;
+}
+
+#define _ARRAYLIKE_COW_MEMORY(name, type)                                  \
+  static inline void name##_use_default_allocator(name *const array) {     \
+    (void)array;                                                           \
+  }                                                                        \
+                                                                           \
+  static inline type *name##_table_calloc(name *const array, size_t n) {   \
+    (void)array;                                                           \
+    ArrayLikeSharedHeader *header = (ArrayLikeSharedHeader *)calloc(       \
+        1, sizeof(ArrayLikeSharedHeader) + sizeof(type) * n);              \
+    if (header == NULL) {                                                  \
+      return NULL;                                                         \
+    }                                                                      \
+    header->refs = 1;                                                      \
+    return (type *)(header + 1);                                           \
+  }                                                                        \
+                                                                           \
+  /* Drops the array's reference; the last one frees the table. */         \
+  static inline void name##_table_free(name *const array, type *table,     \
+                                       size_t n) {                         \
+    (void)array;                                                           \
+    (void)n;                                                               \
+    ArrayLikeSharedHeader *header = arraylike_shared_header(table);        \
+    if (__atomic_sub_fetch(&header->refs, 1, __ATOMIC_ACQ_REL) == 0) {     \
+      free(header);                                                        \
+    }                                                                      \
+  }                                                                        \
+                                                                           \
+  /* A shared table is left to its other owners; the array moves its       \
+   * elements to a private table of the new size instead. */               \
+  static inline type *name##_table_realloc(name *const array, type *table, \
+                                           size_t old_n, size_t new_n) {   \
+    ArrayLikeSharedHeader *header = arraylike_shared_header(table);        \
+    if (__atomic_load_n(&header->refs, __ATOMIC_ACQUIRE) == 1) {           \
+      header = (ArrayLikeSharedHeader *)realloc(                           \
+          header, sizeof(ArrayLikeSharedHeader) + sizeof(type) * new_n);   \
+      return header == NULL ? NULL : (type *)(header + 1);                 \
+    }                                                                      \
+    type *copy = name##_table_calloc(array, new_n);                        \
+    if (copy != NULL) {                                                    \
+      memcpy(copy, table,                                                  \
+             sizeof(type) * (array->size < new_n ? array->size : new_n));  \
+      name##_table_free(array, table, old_n);                              \
+    }                                                                      \
+    return copy;                                                           \
+  }                                                                        \
+                                                                           \
+  static inline void name##_table_unshare(name *const array) {             \
+    ArrayLikeSharedHeader *header = arraylike_shared_header(array->table); \
+    if (__atomic_load_n(&header->refs, __ATOMIC_ACQUIRE) == 1) {           \
+      return;                                                              \
+    }                                                                      \
+    type *copy = name##_table_calloc(array, array->capacity);              \
+    assert(copy != NULL);                                                  \
+    memcpy(copy, array->table, sizeof(type) * array->size);                \
+    name##_table_free(array, array->table, array->capacity);               \
+    array->table = copy;                                                   \
+  }
+
+/* Generates the array implementation on top of the memory hooks. New arrays
+ * start with `initial_capacity` slots. */
+#define _ARRAYLIKE_IMPLEMENT(name, type, growth, initial_capacity)             \
                                                                                \
-  bool name##_init_capacity(name *array, size_t capacity) {                    \
+  static inline bool name##_init_table(name *array, size_t capacity) {         \
     if (capacity == 0) {                                                       \
       return false;                                                            \
     }                                                                          \
-    array->table = (type *)calloc((array->capacity = capacity), sizeof(type)); \
+    array->table = name##_table_calloc(array, (array->capacity = capacity));   \
     assert(array->table != NULL);                                              \
     array->size = 0;                                                           \
+    CONTAINER_STATS_REGISTER(array, #name);                                    \
+    CONTAINER_STATS_MAX(array, peak_capacity, capacity);                       \
     return true;                                                               \
   }                                                                            \
                                                                                \
+  bool name##_init_capacity(name *array, size_t capacity) {                    \
+    name##_use_default_allocator(array);                                       \
+    return name##_init_table(array, capacity);                                 \
+  }                                                                            \
+                                                                               \
   bool name##_init(name *array) {                                              \
-    return name##_init_capacity(array, DEFAULT_TABLE_SIZE);                    \
+    return name##_init_capacity(array, (initial_capacity));                    \
   }                                                                            \
                                                                                \
   name *name##_create() {                                                      \
@@ -222,17 +694,21 @@ extern "C" {
   name *name##_create_copy(const type input[], size_t capacity) {              \
     name *array = (name *)malloc(sizeof(name));                                \
     assert(array != NULL);                                                     \
-    name##_init_capacity(                                                      \
-        array, ((capacity + DEFAULT_TABLE_SIZE - 1) / DEFAULT_TABLE_SIZE) *    \
-                   DEFAULT_TABLE_SIZE);                                        \
+    /* An empty copy still gets a table, so `table` is always set. */          \
+    size_t rounded =                                                           \
+        ((capacity + DEFAULT_TABLE_SIZE - 1) / DEFAULT_TABLE_SIZE) *           \
+        DEFAULT_TABLE_SIZE;                                                    \
+    name##_init_capacity(array, rounded > 0 ? rounded : DEFAULT_TABLE_SIZE);   \
     memmove(array->table, input, capacity * sizeof(type));                     \
     array->size = capacity;                                                    \
+    CONTAINER_STATS_MAX(array, peak_size, capacity);                           \
     return array;                                                              \
   }                                                                            \
                                                                                \
   void name##_finalize(name *array) {                                          \
     assert(array != NULL);                                                     \
-    free(array->table);                                                        \
+    name##_table_free(array, array->table, array->capacity);                   \
+    CONTAINER_STATS_UNREGISTER(array);                                         \
   }                                                                            \
                                                                                \
   void name##_delete(name *array) {                                            \
@@ -241,27 +717,66 @@ extern "C" {
     free(array);                                                               \
   }                                                                            \
                                                                                \
-  inline void name##_ensure_capacity(name *const array,                        \
-                                     size_t need_to_accomodate) {              \
+  static inline void name##_resize_table(name *const array,                    \
+                                         size_t new_capacity) {                \
+    array->table = name##_table_realloc(array, array->table, array->capacity,  \
+                                        new_capacity);                         \
+    assert(array->table != NULL);                                              \
+    array->capacity = new_capacity;                                            \
+    CONTAINER_STATS_ADD(array, reallocs, 1);                                   \
+    CONTAINER_STATS_MAX(array, peak_capacity, new_capacity);                   \
+    if (array->capacity > array->size) {                                       \
+      memset(array->table + array->size, 0x0,                                  \
+             (array->capacity - array->size) * sizeof(type));                  \
+    }                                                                          \
+  }                                                                            \
+                                                                               \
+  static inline void name##_ensure_capacity(name *const array,                 \
+                                            size_t need_to_accomodate) {       \
     assert(array != NULL);                                                     \
-    size_t new_capacity =                                                      \
-        ((need_to_accomodate + DEFAULT_TABLE_SIZE - 1) / DEFAULT_TABLE_SIZE) * \
-        DEFAULT_TABLE_SIZE;                                                    \
-    if (new_capacity <= array->capacity) {                                     \
+    /* Every growing operation passes its resulting size. */                   \
+    CONTAINER_STATS_MAX(array, peak_size, need_to_accomodate);                 \
+    if (need_to_accomodate <= array->capacity) {                               \
+      name##_table_unshare(array);                                             \
       return;                                                                  \
     }                                                                          \
-    array->table = (type *)realloc(array->table, sizeof(type) * new_capacity); \
-    assert(array->table != NULL);                                              \
-    array->capacity = new_capacity;                                            \
-    memset(array->table + array->size, 0x0,                                    \
-           (array->capacity - array->size) * sizeof(type));                    \
+    size_t new_capacity = growth(array->capacity, need_to_accomodate);         \
+    if (new_capacity < need_to_accomodate) {                                   \
+      new_capacity = need_to_accomodate;                                       \
+    }                                                                          \
+    name##_resize_table(array, new_capacity);                                  \
+  }                                                                            \
+                                                                               \
+  void name##_reserve(name *const array, size_t capacity) {                    \
+    assert(array != NULL);                                                     \
+    if (capacity <= array->capacity) {                                         \
+      return;                                                                  \
+    }                                                                          \
+    name##_resize_table(array, capacity);                                      \
+  }                                                                            \
+                                                                               \
+  void name##_shrink_to_fit(name *const array) {                               \
+    assert(array != NULL);                                                     \
+    size_t new_capacity = array->size > 0 ? array->size : 1;                   \
+    if (new_capacity >= array->capacity) {                                     \
+      return;                                                                  \
+    }                                                                          \
+    name##_resize_table(array, new_capacity);                                  \
+  }                                                                            \
+                                                                               \
+  void name##_make_unique(name *const array) {                                 \
+    assert(array != NULL);                                                     \
+    name##_table_unshare(array);                                               \
   }                                                                            \
                                                                                \
   static inline void name##_shift_left(name *const array, int32_t start,       \
                                        int32_t amount) {                       \
     assert(amount > 0 && start >= amount);                                     \
+    name##_table_unshare(array);                                               \
     memmove(array->table + start - amount, array->table + start,               \
             (array->size - start) * sizeof(type));                             \
+    CONTAINER_STATS_ADD(array, bytes_moved,                                    \
+                        (array->size - start) * sizeof(type));                 \
   }                                                                            \
                                                                                \
   static inline void name##_shift_right(name *const array, int32_t start,      \
@@ -270,6 +785,8 @@ extern "C" {
     name##_ensure_capacity(array, array->size + amount);                       \
     memmove(array->table + start + amount, array->table + start,               \
             (array->size - start) * sizeof(type));                             \
+    CONTAINER_STATS_ADD(array, bytes_moved,                                    \
+                        (array->size - start) * sizeof(type));                 \
     memset(array->table + start, 0x0, amount * sizeof(type));                  \
   }                                                                            \
                                                                                \
@@ -280,19 +797,23 @@ extern "C" {
                                                                                \
   void name##_push_front(name *const array, type elt) {                        \
     assert(array != NULL);                                                     \
+    name##_table_unshare(array);                                               \
     if (array->size > 0) {                                                     \
       name##_shift_right(array, 0, 1);                                         \
     }                                                                          \
     array->table[0] = elt;                                                     \
     array->size++;                                                             \
+    CONTAINER_STATS_MAX(array, peak_size, array->size);                        \
   }                                                                            \
                                                                                \
   type *name##_push_front_ref(name *const array) {                             \
     assert(array != NULL);                                                     \
+    name##_table_unshare(array);                                               \
     if (array->size > 0) {                                                     \
       name##_shift_right(array, 0, 1);                                         \
     }                                                                          \
     array->size++;                                                             \
+    CONTAINER_STATS_MAX(array, peak_size, array->size);                        \
     return array->table;                                                       \
   }                                                                            \
                                                                                \
@@ -372,6 +893,7 @@ extern "C" {
     if (index < 0) {                                                           \
       return false;                                                            \
     }                                                                          \
+    name##_table_unshare(array);                                               \
     if ((size_t)index >= array->size) {                                        \
       name##_ensure_capacity(array, index + 1);                                \
       array->size = index + 1;                                                 \
@@ -385,6 +907,7 @@ extern "C" {
     if (index < 0) {                                                           \
       return false;                                                            \
     }                                                                          \
+    name##_table_unshare(array);                                               \
     if ((size_t)index >= array->size) {                                        \
       name##_ensure_capacity(array, index + 1);                                \
       array->size = index + 1;                                                 \
@@ -395,6 +918,7 @@ extern "C" {
                                                                                \
   type *name##_set_ref_unchecked(name *const array, int32_t index) {           \
     assert(array != NULL);                                                     \
+    name##_table_unshare(array);                                               \
     if ((size_t)index >= array->size) {                                        \
       name##_ensure_capacity(array, index + 1);                                \
       array->size = index + 1;                                                 \
@@ -429,16 +953,19 @@ extern "C" {
     if (index < 0 || (size_t)index >= array->size) {                           \
       return false;                                                            \
     }                                                                          \
+    name##_table_unshare(array);                                               \
     *ptr = &array->table[index];                                               \
     return true;                                                               \
   }                                                                            \
                                                                                \
   const type *name##_get_ref_unchecked(name *const array, int32_t index) {     \
-    return name##_mutable_ref_unchecked(array, index);                         \
+    assert(array != NULL);                                                     \
+    return &array->table[index];                                               \
   }                                                                            \
                                                                                \
   type *name##_mutable_ref_unchecked(name *const array, int32_t index) {       \
     assert(array != NULL);                                                     \
+    name##_table_unshare(array);                                               \
     return &array->table[index];                                               \
   }                                                                            \
                                                                                \
@@ -485,6 +1012,77 @@ extern "C" {
     return to_return;                                                          \
   }                                                                            \
                                                                                \
+  /* Inserts `count` elements before `index` (0 <= index <= size). `elts`      \
+   * must not point into the array. */                                         \
+  bool name##_insert_range(name *const array, int32_t index,                   \
+                           const type elts[], size_t count) {                  \
+    assert(array != NULL);                                                     \
+    if (index < 0 || (size_t)index > array->size) {                            \
+      return false;                                                            \
+    }                                                                          \
+    if (count == 0) {                                                          \
+      return true;                                                             \
+    }                                                                          \
+    assert(elts != NULL);                                                      \
+    name##_ensure_capacity(array, array->size + count);                        \
+    memmove(array->table + index + count, array->table + index,                \
+            (array->size - index) * sizeof(type));                             \
+    CONTAINER_STATS_ADD(array, bytes_moved,                                    \
+                        (array->size - index) * sizeof(type));                 \
+    memcpy(array->table + index, elts, count * sizeof(type));                  \
+    array->size += count;                                                      \
+    return true;                                                               \
+  }                                                                            \
+                                                                               \
+  /* Erases the elements in [range_start, range_end). */                       \
+  bool name##_erase_range(name *const array, int32_t range_start,              \
+                          int32_t range_end) {                                 \
+    assert(array != NULL);                                                     \
+    if (range_start < 0 || range_start > range_end ||                          \
+        (size_t)range_end > array->size) {                                     \
+      return false;                                                            \
+    }                                                                          \
+    name##_table_unshare(array);                                               \
+    memmove(array->table + range_start, array->table + range_end,              \
+            (array->size - range_end) * sizeof(type));                         \
+    CONTAINER_STATS_ADD(array, bytes_moved,                                    \
+                        (array->size - range_end) * sizeof(type));             \
+    array->size -= (range_end - range_start);                                  \
+    return true;                                                               \
+  }                                                                            \
+                                                                               \
+  /* Appends `count` slots and returns the first; their contents are           \
+   * unspecified. */                                                           \
+  type *name##_push_back_n(name *const array, size_t count) {                  \
+    assert(array != NULL);                                                     \
+    name##_ensure_capacity(array, array->size + count);                        \
+    type *first = array->table + array->size;                                  \
+    array->size += count;                                                      \
+    return first;                                                              \
+  }                                                                            \
+                                                                               \
+  /* Keeps the elements for which `predicate` returns true, preserving         \
+   * their order, and returns the number of elements removed. */               \
+  size_t name##_retain_if(name *const array,                                   \
+                          bool (*predicate)(const type *elt, void *ctx),       \
+                          void *ctx) {                                         \
+    assert(array != NULL && predicate != NULL);                                \
+    name##_table_unshare(array);                                               \
+    size_t kept = 0;                                                           \
+    for (size_t i = 0; i < array->size; ++i) {                                 \
+      if (!predicate(array->table + i, ctx)) {                                 \
+        continue;                                                              \
+      }                                                                        \
+      if (kept != i) {                                                         \
+        array->table[kept] = array->table[i];                                  \
+      }                                                                        \
+      kept++;                                                                  \
+    }                                                                          \
+    size_t removed = array->size - kept;                                       \
+    array->size = kept;                                                        \
+    return removed;                                                            \
+  }                                                                            \
+                                                                               \
   size_t name##_size(const name *const array) {                                \
     assert(array != NULL);                                                     \
     return array->size;                                                        \
@@ -495,14 +1093,22 @@ extern "C" {
     return array->size == 0;                                                   \
   }                                                                            \
                                                                                \
+  ContainerStats name##_stats(const name *const array) {                       \
+    assert(array != NULL);                                                     \
+    return CONTAINER_STATS_GET(array);                                         \
+  }                                                                            \
+                                                                               \
   name *name##_copy(const name *const array) {                                 \
     assert(array != NULL);                                                     \
     name *copy = (name *)malloc(sizeof(name));                                 \
     assert(copy != NULL);                                                      \
     *copy = *array;                                                            \
-    copy->table = (type *)malloc(sizeof(type) * array->capacity);              \
+    copy->table = name##_table_calloc(copy, array->capacity);                  \
     assert(copy->table != NULL);                                               \
     memcpy(copy->table, array->table, sizeof(type) * array->size);             \
+    CONTAINER_STATS_REGISTER(copy, #name);                                     \
+    CONTAINER_STATS_MAX(copy, peak_size, copy->size);                          \
+    CONTAINER_STATS_MAX(copy, peak_capacity, copy->capacity);                  \
     return copy;                                                               \
   }                                                                            \
                                                                                \
@@ -0,0 +1,454 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+#include "c-data-structures/arraylike.h"
+
+namespace {
+
+/* Element types used to sweep element size. */
+template <size_t N>
+struct Blob {
+  char bytes[N];
+};
+
+using Blob64 = Blob<64>;
+using Blob256 = Blob<256>;
+
+DEFINE_ARRAYLIKE(Int32Array, int32_t);
+IMPL_ARRAYLIKE(Int32Array, int32_t);
+DEFINE_ARRAYLIKE(Blob64Array, Blob64);
+IMPL_ARRAYLIKE(Blob64Array, Blob64);
+DEFINE_ARRAYLIKE(Blob256Array, Blob256);
+IMPL_ARRAYLIKE(Blob256Array, Blob256);
+DEFINE_SMALL_ARRAYLIKE(SmallInt32Array, int32_t, 8);
+IMPL_SMALL_ARRAYLIKE(SmallInt32Array, int32_t);
+DEFINE_COW_ARRAYLIKE(CowInt32Array, int32_t);
+IMPL_COW_ARRAYLIKE(CowInt32Array, int32_t);
+
+/* Maps an element type to its generated arraylike so the benchmarks below
+ * can be written once and instantiated per element size. */
+template <typename T>
+struct Ops;
+
+#define ARRAYLIKE_OPS(Array, T)                                             \
+  template <>                                                               \
+  struct Ops<T> {                                                           \
+    using A = Array;                                                        \
+    static void init(A* a) { Array##_init(a); }                             \
+    static void finalize(A* a) { Array##_finalize(a); }                     \
+    static void push_back(A* a, T v) { Array##_push_back(a, v); }           \
+    static void push_front(A* a, T v) { Array##_push_front(a, v); }         \
+    static bool pop_back(A* a, T* v) { return Array##_pop_back(a, v); }     \
+    static bool pop_front(A* a, T* v) { return Array##_pop_front(a, v); }   \
+    static bool remove(A* a, int32_t i, T* v) {                             \
+      return Array##_remove(a, i, v);                                       \
+    }                                                                       \
+    static void append(A* a, const A* b) { Array##_append(a, b); }          \
+    static size_t retain_if(A* a, bool (*keep)(const T*, void*)) {          \
+      return Array##_retain_if(a, keep, nullptr);                           \
+    }                                                                       \
+    static void iterator(Array##Iterator* it, A* a) {                       \
+      Array##_iterator(it, a);                                              \
+    }                                                                       \
+    using Iterator = Array##Iterator;                                       \
+    static bool has_next(const Iterator* it) {                              \
+      return Array##_has_next(it);                                          \
+    }                                                                       \
+    static void next(Iterator* it) { Array##_next(it); }                    \
+    static const T* value(const Iterator* it) { return Array##_value(it); } \
+  }
+
+ARRAYLIKE_OPS(Int32Array, int32_t);
+ARRAYLIKE_OPS(Blob64Array, Blob64);
+ARRAYLIKE_OPS(Blob256Array, Blob256);
+
+template <typename T>
+void Fill(typename Ops<T>::A* array, int64_t n) {
+  Ops<T>::init(array);
+  for (int64_t i = 0; i < n; ++i) {
+    Ops<T>::push_back(array, T{});
+  }
+}
+
+/* -------------------------------------------------------------
+ * arraylike
+ * ------------------------------------------------------------- */
+
+template <typename T>
+void BM_ArrayLike_PushBack(benchmark::State& state) {
+  const int64_t n = state.range(0);
+  for (auto _ : state) {
+    typename Ops<T>::A array;
+    Ops<T>::init(&array);
+    for (int64_t i = 0; i < n; ++i) {
+      Ops<T>::push_back(&array, T{});
+    }
+    benchmark::DoNotOptimize(array.table);
+    Ops<T>::finalize(&array);
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+template <typename T>
+void BM_ArrayLike_PushFront(benchmark::State& state) {
+  const int64_t n = state.range(0);
+  for (auto _ : state) {
+    typename Ops<T>::A array;
+    Ops<T>::init(&array);
+    for (int64_t i = 0; i < n; ++i) {
+      Ops<T>::push_front(&array, T{});
+    }
+    benchmark::DoNotOptimize(array.table);
+    Ops<T>::finalize(&array);
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+template <typename T>
+void BM_ArrayLike_PopBack(benchmark::State& state) {
+  const int64_t n = state.range(0);
+  for (auto _ : state) {
+    state.PauseTiming();
+    typename Ops<T>::A array;
+    Fill<T>(&array, n);
+    state.ResumeTiming();
+    T value{};
+    while (Ops<T>::pop_back(&array, &value)) {
+      benchmark::DoNotOptimize(value);
+    }
+    Ops<T>::finalize(&array);
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+template <typename T>
+void BM_ArrayLike_PopFront(benchmark::State& state) {
+  const int64_t n = state.range(0);
+  for (auto _ : state) {
+    state.PauseTiming();
+    typename Ops<T>::A array;
+    Fill<T>(&array, n);
+    state.ResumeTiming();
+    T value{};
+    while (Ops<T>::pop_front(&array, &value)) {
+      benchmark::DoNotOptimize(value);
+    }
+    Ops<T>::finalize(&array);
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+/* Removes every element from the middle of the array. */
+template <typename T>
+void BM_ArrayLike_RemoveMiddle(benchmark::State& state) {
+  const int64_t n = state.range(0);
+  for (auto _ : state) {
+    state.PauseTiming();
+    typename Ops<T>::A array;
+    Fill<T>(&array, n);
+    state.ResumeTiming();
+    T value{};
+    while (array.size > 0) {
+      Ops<T>::remove(&array, (int32_t)(array.size / 2), &value);
+    }
+    benchmark::DoNotOptimize(value);
+    Ops<T>::finalize(&array);
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+/* Keeps every other element; the predicate only looks at the address so it
+ * works for every element type. */
+template <typename T>
+bool KeepEveryOther(const T* value, void*) {
+  return (reinterpret_cast<uintptr_t>(value) / sizeof(T)) % 2 == 0;
+}
+
+/* Drops half the elements with a remove() per element. */
+template <typename T>
+void BM_ArrayLike_FilterByRemove(benchmark::State& state) {
+  const int64_t n = state.range(0);
+  for (auto _ : state) {
+    state.PauseTiming();
+    typename Ops<T>::A array;
+    Fill<T>(&array, n);
+    state.ResumeTiming();
+    T value{};
+    for (int32_t i = (int32_t)array.size - 1; i >= 0; i -= 2) {
+      Ops<T>::remove(&array, i, &value);
+    }
+    benchmark::DoNotOptimize(value);
+    Ops<T>::finalize(&array);
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+/* Drops half the elements with a single retain_if pass. */
+template <typename T>
+void BM_ArrayLike_FilterByRetainIf(benchmark::State& state) {
+  const int64_t n = state.range(0);
+  for (auto _ : state) {
+    state.PauseTiming();
+    typename Ops<T>::A array;
+    Fill<T>(&array, n);
+    state.ResumeTiming();
+    benchmark::DoNotOptimize(Ops<T>::retain_if(&array, KeepEveryOther<T>));
+    Ops<T>::finalize(&array);
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+template <typename T>
+void BM_ArrayLike_Append(benchmark::State& state) {
+  const int64_t n = state.range(0);
+  typename Ops<T>::A tail;
+  Fill<T>(&tail, n);
+  for (auto _ : state) {
+    typename Ops<T>::A head;
+    Ops<T>::init(&head);
+    Ops<T>::append(&head, &tail);
+    benchmark::DoNotOptimize(head.table);
+    Ops<T>::finalize(&head);
+  }
+  Ops<T>::finalize(&tail);
+  state.SetItemsProcessed(state.iterations() * n);
+  state.SetBytesProcessed(state.iterations() * n * sizeof(T));
+}
+
+template <typename T>
+void BM_ArrayLike_Iterate(benchmark::State& state) {
+  const int64_t n = state.range(0);
+  typename Ops<T>::A array;
+  Fill<T>(&array, n);
+  for (auto _ : state) {
+    typename Ops<T>::Iterator it;
+    for (Ops<T>::iterator(&it, &array); Ops<T>::has_next(&it);
+         Ops<T>::next(&it)) {
+      benchmark::DoNotOptimize(Ops<T>::value(&it));
+    }
+  }
+  Ops<T>::finalize(&array);
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+/* Creates, fills and deletes many short lists, as in per-node adjacency
+ * lists. Lists of up to 8 elements stay inline in a SmallInt32Array. */
+void BM_ArrayLike_ManySmall(benchmark::State& state) {
+  const int64_t len = state.range(0);
+  for (auto _ : state) {
+    for (int i = 0; i < 1024; ++i) {
+      Int32Array* array = Int32Array_create();
+      for (int64_t j = 0; j < len; ++j) {
+        Int32Array_push_back(array, (int32_t)j);
+      }
+      benchmark::DoNotOptimize(array->table);
+      Int32Array_delete(array);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * 1024);
+}
+
+void BM_SmallArrayLike_ManySmall(benchmark::State& state) {
+  const int64_t len = state.range(0);
+  for (auto _ : state) {
+    for (int i = 0; i < 1024; ++i) {
+      SmallInt32Array* array = SmallInt32Array_create();
+      for (int64_t j = 0; j < len; ++j) {
+        SmallInt32Array_push_back(array, (int32_t)j);
+      }
+      benchmark::DoNotOptimize(array->table);
+      SmallInt32Array_delete(array);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * 1024);
+}
+
+/* Snapshots a large array that is rarely modified afterwards: a deep copy
+ * versus a copy-on-write share. */
+void BM_ArrayLike_Snapshot(benchmark::State& state) {
+  const int64_t n = state.range(0);
+  Int32Array* array = Int32Array_create();
+  for (int64_t i = 0; i < n; ++i) {
+    Int32Array_push_back(array, (int32_t)i);
+  }
+  for (auto _ : state) {
+    Int32Array* snapshot = Int32Array_copy(array);
+    benchmark::DoNotOptimize(snapshot->table);
+    Int32Array_delete(snapshot);
+  }
+  Int32Array_delete(array);
+}
+
+void BM_CowArrayLike_Snapshot(benchmark::State& state) {
+  const int64_t n = state.range(0);
+  CowInt32Array* array = CowInt32Array_create();
+  for (int64_t i = 0; i < n; ++i) {
+    CowInt32Array_push_back(array, (int32_t)i);
+  }
+  for (auto _ : state) {
+    CowInt32Array* snapshot = CowInt32Array_share(array);
+    benchmark::DoNotOptimize(snapshot->table);
+    CowInt32Array_delete(snapshot);
+  }
+  CowInt32Array_delete(array);
+}
+
+/* -------------------------------------------------------------
+ * std::vector / std::deque baselines
+ * ------------------------------------------------------------- */
+
+template <typename T>
+void BM_Vector_PushBack(benchmark::State& state) {
+  const int64_t n = state.range(0);
+  for (auto _ : state) {
+    std::vector<T> v;
+    for (int64_t i = 0; i < n; ++i) {
+      v.push_back(T{});
+    }
+    benchmark::DoNotOptimize(v.data());
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+template <typename T>
+void BM_Vector_PushFront(benchmark::State& state) {
+  const int64_t n = state.range(0);
+  for (auto _ : state) {
+    std::vector<T> v;
+    for (int64_t i = 0; i < n; ++i) {
+      v.insert(v.begin(), T{});
+    }
+    benchmark::DoNotOptimize(v.data());
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+template <typename T>
+void BM_Deque_PushFront(benchmark::State& state) {
+  const int64_t n = state.range(0);
+  for (auto _ : state) {
+    std::deque<T> d;
+    for (int64_t i = 0; i < n; ++i) {
+      d.push_front(T{});
+    }
+    benchmark::DoNotOptimize(d.front());
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+template <typename T>
+void BM_Vector_PopBack(benchmark::State& state) {
+  const int64_t n = state.range(0);
+  for (auto _ : state) {
+    state.PauseTiming();
+    std::vector<T> v(n);
+    state.ResumeTiming();
+    while (!v.empty()) {
+      benchmark::DoNotOptimize(v.back());
+      v.pop_back();
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+template <typename T>
+void BM_Deque_PopFront(benchmark::State& state) {
+  const int64_t n = state.range(0);
+  for (auto _ : state) {
+    state.PauseTiming();
+    std::deque<T> d(n);
+    state.ResumeTiming();
+    while (!d.empty()) {
+      benchmark::DoNotOptimize(d.front());
+      d.pop_front();
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+template <typename T>
+void BM_Vector_RemoveMiddle(benchmark::State& state) {
+  const int64_t n = state.range(0);
+  for (auto _ : state) {
+    state.PauseTiming();
+    std::vector<T> v(n);
+    state.ResumeTiming();
+    while (!v.empty()) {
+      v.erase(v.begin() + v.size() / 2);
+    }
+    benchmark::DoNotOptimize(v.data());
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+template <typename T>
+void BM_Vector_Append(benchmark::State& state) {
+  const int64_t n = state.range(0);
+  std::vector<T> tail(n);
+  for (auto _ : state) {
+    std::vector<T> head;
+    head.insert(head.end(), tail.begin(), tail.end());
+    benchmark::DoNotOptimize(head.data());
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+  state.SetBytesProcessed(state.iterations() * n * sizeof(T));
+}
+
+template <typename T>
+void BM_Vector_Iterate(benchmark::State& state) {
+  const int64_t n = state.range(0);
+  std::vector<T> v(n);
+  for (auto _ : state) {
+    for (const T& value : v) {
+      benchmark::DoNotOptimize(&value);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+/* Linear-time operations sweep up to 256K elements; operations that are
+ * quadratic for a contiguous table (front insertion/removal, removal from
+ * the middle) stop at 16K so a full run stays short. */
+#define LINEAR_RANGE RangeMultiplier(8)->Range(64, 1 << 18)
+#define QUADRATIC_RANGE RangeMultiplier(4)->Range(64, 1 << 14)
+
+#define REGISTER_FOR_SIZES(bm, range)     \
+  BENCHMARK_TEMPLATE(bm, int32_t)->range; \
+  BENCHMARK_TEMPLATE(bm, Blob64)->range;  \
+  BENCHMARK_TEMPLATE(bm, Blob256)->range
+
+REGISTER_FOR_SIZES(BM_ArrayLike_PushBack, LINEAR_RANGE);
+REGISTER_FOR_SIZES(BM_Vector_PushBack, LINEAR_RANGE);
+
+REGISTER_FOR_SIZES(BM_ArrayLike_PushFront, QUADRATIC_RANGE);
+REGISTER_FOR_SIZES(BM_Vector_PushFront, QUADRATIC_RANGE);
+REGISTER_FOR_SIZES(BM_Deque_PushFront, QUADRATIC_RANGE);
+
+REGISTER_FOR_SIZES(BM_ArrayLike_PopBack, LINEAR_RANGE);
+REGISTER_FOR_SIZES(BM_Vector_PopBack, LINEAR_RANGE);
+
+REGISTER_FOR_SIZES(BM_ArrayLike_PopFront, QUADRATIC_RANGE);
+REGISTER_FOR_SIZES(BM_Deque_PopFront, QUADRATIC_RANGE);
+
+REGISTER_FOR_SIZES(BM_ArrayLike_RemoveMiddle, QUADRATIC_RANGE);
+REGISTER_FOR_SIZES(BM_Vector_RemoveMiddle, QUADRATIC_RANGE);
+
+REGISTER_FOR_SIZES(BM_ArrayLike_FilterByRemove, QUADRATIC_RANGE);
+REGISTER_FOR_SIZES(BM_ArrayLike_FilterByRetainIf, LINEAR_RANGE);
+
+REGISTER_FOR_SIZES(BM_ArrayLike_Append, LINEAR_RANGE);
+REGISTER_FOR_SIZES(BM_Vector_Append, LINEAR_RANGE);
+
+REGISTER_FOR_SIZES(BM_ArrayLike_Iterate, LINEAR_RANGE);
+REGISTER_FOR_SIZES(BM_Vector_Iterate, LINEAR_RANGE);
+
+BENCHMARK(BM_ArrayLike_ManySmall)->Arg(2)->Arg(8)->Arg(32);
+BENCHMARK(BM_SmallArrayLike_ManySmall)->Arg(2)->Arg(8)->Arg(32);
+
+BENCHMARK(BM_ArrayLike_Snapshot)->Arg(1 << 10)->Arg(1 << 20);
+BENCHMARK(BM_CowArrayLike_Snapshot)->Arg(1 << 10)->Arg(1 << 20);
+
+}  // namespace
@@ -0,0 +1,344 @@
+#ifndef C_DATA_STRUCTURES_ARRAYLIKE_NUMERIC_H_
+#define C_DATA_STRUCTURES_ARRAYLIKE_NUMERIC_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "c-data-structures/arraylike.h"
+
+/**
+ * @file arraylike_numeric.h
+ *
+ * @brief Vectorized reductions for arraylikes of arithmetic types.
+ *
+ * DEFINE_ARRAYLIKE_NUMERIC and IMPL_ARRAYLIKE_NUMERIC add find, count, sum,
+ * min/max and fill to an array type generated with DEFINE_ARRAYLIKE whose
+ * element type is a 4- or 8-byte arithmetic type (int32_t, int64_t, float,
+ * double and their unsigned counterparts).
+ *
+ * Each operation is generated three times from the same source:
+ *  - AVX2 (32-byte vectors), compiled with `target("avx2")`
+ *  - SSE2 (16-byte vectors), the x86-64 baseline
+ *  - a scalar loop
+ * The vector kernels use GCC/Clang vector extensions, so no intrinsics
+ * headers or special compile flags are required. On x86 the best kernel the
+ * CPU supports is chosen at runtime; elsewhere, or when
+ * ARRAYLIKE_NUMERIC_DISABLE_SIMD is defined, the scalar kernels are used.
+ *
+ * Semantics follow the scalar loop, with two caveats:
+ *  - floating-point sums are reassociated across lanes, so they may differ
+ *    from a left-to-right sum in the last bits
+ *  - min/max of arrays containing NaN are unspecified
+ * Signed integer sums must not overflow.
+ *
+ * Usage pattern:
+ *
+ *   DEFINE_ARRAYLIKE(FloatArray, float);
+ *   DEFINE_ARRAYLIKE_NUMERIC(FloatArray, float);
+ *
+ *   IMPL_ARRAYLIKE(FloatArray, float);
+ *   IMPL_ARRAYLIKE_NUMERIC(FloatArray, float);
+ *
+ *   float total = FloatArray_sum(&arr);
+ */
+
+#if !defined(ARRAYLIKE_NUMERIC_DISABLE_SIMD) && defined(__GNUC__) && \
+    (defined(__x86_64__) || defined(__i386__))
+#define ARRAYLIKE_NUMERIC_X86 1
+#else
+#define ARRAYLIKE_NUMERIC_X86 0
+#endif
+
+/** Kernel families, in order of preference. */
+typedef enum {
+  ARRAYLIKE_NUMERIC_SCALAR = 0,
+  ARRAYLIKE_NUMERIC_SSE2 = 1,
+  ARRAYLIKE_NUMERIC_AVX2 = 2,
+} ArraylikeNumericIsa;
+
+/**
+ * Returns the kernel family used by the generated functions on this CPU.
+ * Detected once, on first use.
+ */
+static inline ArraylikeNumericIsa arraylike_numeric_isa(void) {
+#if ARRAYLIKE_NUMERIC_X86
+  static int isa = -1;
+  int cached = __atomic_load_n(&isa, __ATOMIC_RELAXED);
+  if (cached < 0) {
+    __builtin_cpu_init();
+    /* SSE2 is baseline on x86-64 but not on 32-bit x86. */
+    cached = __builtin_cpu_supports("avx2")   ? ARRAYLIKE_NUMERIC_AVX2
+             : __builtin_cpu_supports("sse2") ? ARRAYLIKE_NUMERIC_SSE2
+                                              : ARRAYLIKE_NUMERIC_SCALAR;
+    __atomic_store_n(&isa, cached, __ATOMIC_RELAXED);
+  }
+  return (ArraylikeNumericIsa)cached;
+#else
+  return ARRAYLIKE_NUMERIC_SCALAR;
+#endif
+}
+
+/**
+ * @macro DEFINE_ARRAYLIKE_NUMERIC
+ *
+ * @brief Declares the numeric API for an arraylike type.
+ *
+ *  - `name##_find` returns the index of the first element equal to `value`,
+ *    or -1
+ *  - `name##_count` returns the number of elements equal to `value`
+ *  - `name##_sum` returns the sum of all elements (0 when empty)
+ *  - `name##_minmax` stores the smallest and largest elements, or returns
+ *    false when the array is empty
+ *  - `name##_fill` sets every element to `value`
+ *
+ * @param name  Base name used in DEFINE_ARRAYLIKE
+ * @param type  Element type used in DEFINE_ARRAYLIKE
+ */
+#define DEFINE_ARRAYLIKE_NUMERIC(name, type)                           \
+  int32_t name##_find(const name *const, type value);                  \
+  size_t name##_count(const name *const, type value);                  \
+  type name##_sum(const name *const);                                  \
+  bool name##_minmax(const name *const, type *min_ptr, type *max_ptr); \
+  void name##_fill(name *const, type value)
+
+/**
+ * @macro IMPL_ARRAYLIKE_NUMERIC
+ *
+ * @brief Generates the functions declared by DEFINE_ARRAYLIKE_NUMERIC.
+ *
+ * The kernels are also available directly, on a raw table of `n` elements,
+ * as `name##_<op>_scalar`, and on x86 as `name##_<op>_sse2` and
+ * `name##_<op>_avx2`. The AVX2 kernels must only be called on CPUs that
+ * support AVX2, and the SSE2 kernels on CPUs that support SSE2.
+ *
+ * @param name  Base name used in DEFINE_ARRAYLIKE
+ * @param type  Element type used in DEFINE_ARRAYLIKE
+ */
+#define IMPL_ARRAYLIKE_NUMERIC(name, type)                                     \
+  _ARRAYLIKE_NUMERIC_SCALAR_KERNELS(name, type)                                \
+  _ARRAYLIKE_NUMERIC_SIMD_KERNELS(name, type)                                  \
+                                                                               \
+  int32_t name##_find(const name *const array, type value) {                   \
+    assert(array != NULL);                                                     \
+    return _ARRAYLIKE_NUMERIC_DISPATCH(name, find)(array->table, array->size,  \
+                                                   value);                     \
+  }                                                                            \
+                                                                               \
+  size_t name##_count(const name *const array, type value) {                   \
+    assert(array != NULL);                                                     \
+    return _ARRAYLIKE_NUMERIC_DISPATCH(name, count)(array->table,              \
+                                                    array->size, value);       \
+  }                                                                            \
+                                                                               \
+  type name##_sum(const name *const array) {                                   \
+    assert(array != NULL);                                                     \
+    return _ARRAYLIKE_NUMERIC_DISPATCH(name, sum)(array->table, array->size);  \
+  }                                                                            \
+                                                                               \
+  bool name##_minmax(const name *const array, type *min_ptr, type *max_ptr) {  \
+    assert(array != NULL && min_ptr != NULL && max_ptr != NULL);               \
+    if (array->size == 0) {                                                    \
+      return false;                                                            \
+    }                                                                          \
+    _ARRAYLIKE_NUMERIC_DISPATCH(name, minmax)(array->table, array->size,       \
+                                              min_ptr, max_ptr);               \
+    return true;                                                               \
+  }                                                                            \
+                                                                               \
+  void name##_fill(name *const array, type value) {                            \
+    assert(array != NULL);                                                     \
+    name##_make_unique(array);                                                 \
+    _ARRAYLIKE_NUMERIC_DISPATCH(name, fill)(array->table, array->size, value); \
+  }
+
+/* Scalar kernels, also used for the tails of the vector kernels. */
+#define _ARRAYLIKE_NUMERIC_SCALAR_KERNELS(name, type)                          \
+  static int32_t name##_find_scalar(const type *table, size_t n,               \
+                                    type value) {                              \
+    for (size_t i = 0; i < n; ++i) {                                           \
+      if (table[i] == value) {                                                 \
+        return (int32_t)i;                                                     \
+      }                                                                        \
+    }                                                                          \
+    return -1;                                                                 \
+  }                                                                            \
+                                                                               \
+  static size_t name##_count_scalar(const type *table, size_t n, type value) { \
+    size_t count = 0;                                                          \
+    for (size_t i = 0; i < n; ++i) {                                           \
+      count += table[i] == value;                                              \
+    }                                                                          \
+    return count;                                                              \
+  }                                                                            \
+                                                                               \
+  static type name##_sum_scalar(const type *table, size_t n) {                 \
+    type sum = 0;                                                              \
+    for (size_t i = 0; i < n; ++i) {                                           \
+      sum += table[i];                                                         \
+    }                                                                          \
+    return sum;                                                                \
+  }                                                                            \
+                                                                               \
+  /* Folds table[0, n) into *min_ptr and *max_ptr, which must be set. */       \
+  static inline void name##_minmax_fold(const type *table, size_t n,           \
+                                        type *min_ptr, type *max_ptr) {        \
+    for (size_t i = 0; i < n; ++i) {                                           \
+      if (table[i] < *min_ptr) *min_ptr = table[i];                            \
+      if (table[i] > *max_ptr) *max_ptr = table[i];                            \
+    }                                                                          \
+  }                                                                            \
+                                                                               \
+  static void name##_minmax_scalar(const type *table, size_t n,                \
+                                   type *min_ptr, type *max_ptr) {             \
+    *min_ptr = *max_ptr = table[0];                                            \
+    name##_minmax_fold(table + 1, n - 1, min_ptr, max_ptr);                    \
+  }                                                                            \
+                                                                               \
+  static void name##_fill_scalar(type *table, size_t n, type value) {          \
+    for (size_t i = 0; i < n; ++i) {                                           \
+      table[i] = value;                                                        \
+    }                                                                          \
+  }
+
+/*
+ * Vector kernels for one instruction set. `vec` is `type` repeated over
+ * `bytes`; comparisons yield `mask`, a vector of same-width signed integers
+ * with all bits set in matching lanes, which is also used to blend `vec`s
+ * bitwise. Loads and stores go through memcpy since tables are only
+ * aligned to `type`.
+ */
+#define _ARRAYLIKE_NUMERIC_VECTOR_KERNELS(name, type, isa, bytes, isa_target) \
+  typedef type name##_##isa##_vec __attribute__((vector_size(bytes)));        \
+  typedef __typeof__((name##_##isa##_vec){0} < (name##_##isa##_vec){0})       \
+      name##_##isa##_mask;                                                    \
+  typedef uint64_t name##_##isa##_words __attribute__((vector_size(bytes)));  \
+                                                                              \
+  static __attribute__((target(isa_target))) int32_t name##_find_##isa(       \
+      const type *table, size_t n, type value) {                              \
+    const size_t lanes = bytes / sizeof(type);                                \
+    size_t i = 0;                                                             \
+    for (; i + lanes <= n; i += lanes) {                                      \
+      name##_##isa##_vec chunk;                                               \
+      memcpy(&chunk, table + i, bytes);                                       \
+      name##_##isa##_words hit = (name##_##isa##_words)(chunk == value);      \
+      uint64_t any = 0;                                                       \
+      for (size_t w = 0; w < bytes / 8; ++w) {                                \
+        any |= hit[w];                                                        \
+      }                                                                       \
+      if (any != 0) {                                                         \
+        return (int32_t)i + name##_find_scalar(table + i, lanes, value);      \
+      }                                                                       \
+    }                                                                         \
+    int32_t tail = name##_find_scalar(table + i, n - i, value);               \
+    return tail < 0 ? -1 : (int32_t)i + tail;                                 \
+  }                                                                           \
+                                                                              \
+  static __attribute__((target(isa_target))) size_t name##_count_##isa(       \
+      const type *table, size_t n, type value) {                              \
+    const size_t lanes = bytes / sizeof(type);                                \
+    name##_##isa##_vec zero = {0};                                            \
+    name##_##isa##_mask matches = zero != zero;                               \
+    size_t i = 0;                                                             \
+    for (; i + lanes <= n; i += lanes) {                                      \
+      name##_##isa##_vec chunk;                                               \
+      memcpy(&chunk, table + i, bytes);                                       \
+      matches -= (chunk == value);                                            \
+    }                                                                         \
+    size_t count = 0;                                                         \
+    for (size_t k = 0; k < lanes; ++k) {                                      \
+      count += (size_t)matches[k];                                            \
+    }                                                                         \
+    return count + name##_count_scalar(table + i, n - i, value);              \
+  }                                                                           \
+                                                                              \
+  static __attribute__((target(isa_target))) type name##_sum_##isa(           \
+      const type *table, size_t n) {                                          \
+    const size_t lanes = bytes / sizeof(type);                                \
+    name##_##isa##_vec acc0 = {0}, acc1 = {0};                                \
+    size_t i = 0;                                                             \
+    for (; i + 2 * lanes <= n; i += 2 * lanes) {                              \
+      name##_##isa##_vec chunk0, chunk1;                                      \
+      memcpy(&chunk0, table + i, bytes);                                      \
+      memcpy(&chunk1, table + i + lanes, bytes);                              \
+      acc0 += chunk0;                                                         \
+      acc1 += chunk1;                                                         \
+    }                                                                         \
+    acc0 += acc1;                                                             \
+    type sum = 0;                                                             \
+    for (size_t k = 0; k < lanes; ++k) {                                      \
+      sum += acc0[k];                                                         \
+    }                                                                         \
+    return sum + name##_sum_scalar(table + i, n - i);                         \
+  }                                                                           \
+                                                                              \
+  static __attribute__((target(isa_target))) void name##_minmax_##isa(        \
+      const type *table, size_t n, type *min_ptr, type *max_ptr) {            \
+    const size_t lanes = bytes / sizeof(type);                                \
+    if (n < lanes) {                                                          \
+      name##_minmax_scalar(table, n, min_ptr, max_ptr);                       \
+      return;                                                                 \
+    }                                                                         \
+    name##_##isa##_vec lo, hi;                                                \
+    memcpy(&lo, table, bytes);                                                \
+    hi = lo;                                                                  \
+    size_t i = lanes;                                                         \
+    for (; i + lanes <= n; i += lanes) {                                      \
+      name##_##isa##_vec chunk;                                               \
+      memcpy(&chunk, table + i, bytes);                                       \
+      name##_##isa##_mask below = chunk < lo, above = chunk > hi;             \
+      lo = (name##_##isa##_vec)(((name##_##isa##_mask)chunk & below) |        \
+                                ((name##_##isa##_mask)lo & ~below));          \
+      hi = (name##_##isa##_vec)(((name##_##isa##_mask)chunk & above) |        \
+                                ((name##_##isa##_mask)hi & ~above));          \
+    }                                                                         \
+    *min_ptr = lo[0];                                                         \
+    *max_ptr = hi[0];                                                         \
+    for (size_t k = 1; k < lanes; ++k) {                                      \
+      if (lo[k] < *min_ptr) *min_ptr = lo[k];                                 \
+      if (hi[k] > *max_ptr) *max_ptr = hi[k];                                 \
+    }                                                                         \
+    name##_minmax_fold(table + i, n - i, min_ptr, max_ptr);                   \
+  }                                                                           \
+                                                                              \
+  static __attribute__((target(isa_target))) void name##_fill_##isa(          \
+      type *table, size_t n, type value) {                                    \
+    const size_t lanes = bytes / sizeof(type);                                \
+    name##_##isa##_vec splat = {0};                                           \
+    splat += value;                                                           \
+    size_t i = 0;                                                             \
+    for (; i + lanes <= n; i += lanes) {                                      \
+      memcpy(table + i, &splat, bytes);                                       \
+    }                                                                         \
+    name##_fill_scalar(table + i, n - i, value);                              \
+  }
+
+#if ARRAYLIKE_NUMERIC_X86
+
+#define _ARRAYLIKE_NUMERIC_SIMD_KERNELS(name, type)               \
+  _ARRAYLIKE_NUMERIC_VECTOR_KERNELS(name, type, sse2, 16, "sse2") \
+  _ARRAYLIKE_NUMERIC_VECTOR_KERNELS(name, type, avx2, 32, "avx2")
+
+#define _ARRAYLIKE_NUMERIC_DISPATCH(name, op)                               \
+  (arraylike_numeric_isa() == ARRAYLIKE_NUMERIC_AVX2   ? name##_##op##_avx2 \
+   : arraylike_numeric_isa() == ARRAYLIKE_NUMERIC_SSE2 ? name##_##op##_sse2 \
+                                                       : name##_##op##_scalar)
+
+#else
+
+#define _ARRAYLIKE_NUMERIC_SIMD_KERNELS(name, type)
+#define _ARRAYLIKE_NUMERIC_DISPATCH(name, op) name##_##op##_scalar
+
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* C_DATA_STRUCTURES_ARRAYLIKE_NUMERIC_H_ */
@@ -0,0 +1,220 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include "c-data-structures/arraylike_numeric.h"
+
+namespace {
+
+DEFINE_ARRAYLIKE(Int32Array, int32_t);
+DEFINE_ARRAYLIKE_NUMERIC(Int32Array, int32_t);
+IMPL_ARRAYLIKE(Int32Array, int32_t);
+IMPL_ARRAYLIKE_NUMERIC(Int32Array, int32_t);
+
+DEFINE_ARRAYLIKE(DoubleArray, double);
+DEFINE_ARRAYLIKE_NUMERIC(DoubleArray, double);
+IMPL_ARRAYLIKE(DoubleArray, double);
+IMPL_ARRAYLIKE_NUMERIC(DoubleArray, double);
+
+/* Maps an element type to its generated arraylike, its dispatched API and
+ * its scalar kernels. */
+template <typename T>
+struct Ops;
+
+template <>
+struct Ops<int32_t> {
+  using A = Int32Array;
+  static void init(A* a) { Int32Array_init(a); }
+  static void finalize(A* a) { Int32Array_finalize(a); }
+  static void push_back(A* a, int32_t v) { Int32Array_push_back(a, v); }
+  static int32_t sum(A* a) { return Int32Array_sum(a); }
+  static int32_t sum_scalar(A* a) {
+    return Int32Array_sum_scalar(a->table, a->size);
+  }
+  static size_t count(A* a, int32_t v) { return Int32Array_count(a, v); }
+  static size_t count_scalar(A* a, int32_t v) {
+    return Int32Array_count_scalar(a->table, a->size, v);
+  }
+  static void minmax(A* a, int32_t* lo, int32_t* hi) {
+    Int32Array_minmax(a, lo, hi);
+  }
+  static void minmax_scalar(A* a, int32_t* lo, int32_t* hi) {
+    Int32Array_minmax_scalar(a->table, a->size, lo, hi);
+  }
+};
+
+template <>
+struct Ops<double> {
+  using A = DoubleArray;
+  static void init(A* a) { DoubleArray_init(a); }
+  static void finalize(A* a) { DoubleArray_finalize(a); }
+  static void push_back(A* a, double v) { DoubleArray_push_back(a, v); }
+  static double sum(A* a) { return DoubleArray_sum(a); }
+  static double sum_scalar(A* a) {
+    return DoubleArray_sum_scalar(a->table, a->size);
+  }
+  static size_t count(A* a, double v) { return DoubleArray_count(a, v); }
+  static size_t count_scalar(A* a, double v) {
+    return DoubleArray_count_scalar(a->table, a->size, v);
+  }
+  static void minmax(A* a, double* lo, double* hi) {
+    DoubleArray_minmax(a, lo, hi);
+  }
+  static void minmax_scalar(A* a, double* lo, double* hi) {
+    DoubleArray_minmax_scalar(a->table, a->size, lo, hi);
+  }
+};
+
+/* Fixed-seed array of small values, like a window of metric samples. */
+template <typename T>
+void FillRandom(typename Ops<T>::A* array, int64_t n) {
+  std::mt19937 rng(42);
+  Ops<T>::init(array);
+  for (int64_t i = 0; i < n; ++i) {
+    Ops<T>::push_back(array, (T)(rng() % 1000));
+  }
+}
+
+/* -------------------------------------------------------------
+ * Sum
+ * ------------------------------------------------------------- */
+
+template <typename T>
+void BM_ArrayLike_Sum(benchmark::State& state) {
+  typename Ops<T>::A array;
+  FillRandom<T>(&array, state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(Ops<T>::sum(&array));
+  }
+  Ops<T>::finalize(&array);
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename T>
+void BM_ArrayLike_SumScalar(benchmark::State& state) {
+  typename Ops<T>::A array;
+  FillRandom<T>(&array, state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(Ops<T>::sum_scalar(&array));
+  }
+  Ops<T>::finalize(&array);
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename T>
+void BM_StdAccumulate(benchmark::State& state) {
+  typename Ops<T>::A array;
+  FillRandom<T>(&array, state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        std::accumulate(array.table, array.table + array.size, T(0)));
+  }
+  Ops<T>::finalize(&array);
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+/* -------------------------------------------------------------
+ * Count
+ * ------------------------------------------------------------- */
+
+template <typename T>
+void BM_ArrayLike_Count(benchmark::State& state) {
+  typename Ops<T>::A array;
+  FillRandom<T>(&array, state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(Ops<T>::count(&array, T(7)));
+  }
+  Ops<T>::finalize(&array);
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename T>
+void BM_ArrayLike_CountScalar(benchmark::State& state) {
+  typename Ops<T>::A array;
+  FillRandom<T>(&array, state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(Ops<T>::count_scalar(&array, T(7)));
+  }
+  Ops<T>::finalize(&array);
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename T>
+void BM_StdCount(benchmark::State& state) {
+  typename Ops<T>::A array;
+  FillRandom<T>(&array, state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        std::count(array.table, array.table + array.size, T(7)));
+  }
+  Ops<T>::finalize(&array);
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+/* -------------------------------------------------------------
+ * Min / max
+ * ------------------------------------------------------------- */
+
+template <typename T>
+void BM_ArrayLike_MinMax(benchmark::State& state) {
+  typename Ops<T>::A array;
+  FillRandom<T>(&array, state.range(0));
+  T lo, hi;
+  for (auto _ : state) {
+    Ops<T>::minmax(&array, &lo, &hi);
+    benchmark::DoNotOptimize(lo);
+    benchmark::DoNotOptimize(hi);
+  }
+  Ops<T>::finalize(&array);
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename T>
+void BM_ArrayLike_MinMaxScalar(benchmark::State& state) {
+  typename Ops<T>::A array;
+  FillRandom<T>(&array, state.range(0));
+  T lo, hi;
+  for (auto _ : state) {
+    Ops<T>::minmax_scalar(&array, &lo, &hi);
+    benchmark::DoNotOptimize(lo);
+    benchmark::DoNotOptimize(hi);
+  }
+  Ops<T>::finalize(&array);
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename T>
+void BM_StdMinMaxElement(benchmark::State& state) {
+  typename Ops<T>::A array;
+  FillRandom<T>(&array, state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        std::minmax_element(array.table, array.table + array.size));
+  }
+  Ops<T>::finalize(&array);
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+#define RANGE RangeMultiplier(16)->Range(64, 1 << 20)
+
+#define REGISTER_FOR_TYPES(bm)            \
+  BENCHMARK_TEMPLATE(bm, int32_t)->RANGE; \
+  BENCHMARK_TEMPLATE(bm, double)->RANGE
+
+REGISTER_FOR_TYPES(BM_ArrayLike_Sum);
+REGISTER_FOR_TYPES(BM_ArrayLike_SumScalar);
+REGISTER_FOR_TYPES(BM_StdAccumulate);
+
+REGISTER_FOR_TYPES(BM_ArrayLike_Count);
+REGISTER_FOR_TYPES(BM_ArrayLike_CountScalar);
+REGISTER_FOR_TYPES(BM_StdCount);
+
+REGISTER_FOR_TYPES(BM_ArrayLike_MinMax);
+REGISTER_FOR_TYPES(BM_ArrayLike_MinMaxScalar);
+REGISTER_FOR_TYPES(BM_StdMinMaxElement);
+
+}  // namespace
@@ -0,0 +1,223 @@
+#include "c-data-structures/arraylike_numeric.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <vector>
+
+namespace {
+
+DEFINE_ARRAYLIKE(Int32Array, int32_t);
+DEFINE_ARRAYLIKE_NUMERIC(Int32Array, int32_t);
+IMPL_ARRAYLIKE(Int32Array, int32_t);
+IMPL_ARRAYLIKE_NUMERIC(Int32Array, int32_t);
+
+DEFINE_ARRAYLIKE(Int64Array, int64_t);
+DEFINE_ARRAYLIKE_NUMERIC(Int64Array, int64_t);
+IMPL_ARRAYLIKE(Int64Array, int64_t);
+IMPL_ARRAYLIKE_NUMERIC(Int64Array, int64_t);
+
+DEFINE_ARRAYLIKE(FloatArray, float);
+DEFINE_ARRAYLIKE_NUMERIC(FloatArray, float);
+IMPL_ARRAYLIKE(FloatArray, float);
+IMPL_ARRAYLIKE_NUMERIC(FloatArray, float);
+
+DEFINE_ARRAYLIKE(DoubleArray, double);
+DEFINE_ARRAYLIKE_NUMERIC(DoubleArray, double);
+IMPL_ARRAYLIKE(DoubleArray, double);
+IMPL_ARRAYLIKE_NUMERIC(DoubleArray, double);
+
+DEFINE_COW_ARRAYLIKE(CowInt32Array, int32_t);
+DEFINE_ARRAYLIKE_NUMERIC(CowInt32Array, int32_t);
+IMPL_COW_ARRAYLIKE(CowInt32Array, int32_t);
+IMPL_ARRAYLIKE_NUMERIC(CowInt32Array, int32_t);
+
+/* One set of kernels (scalar, SSE2 or AVX2) for an element type. */
+template <typename T>
+struct Kernels {
+  int32_t (*find)(const T*, size_t, T);
+  size_t (*count)(const T*, size_t, T);
+  T (*sum)(const T*, size_t);
+  void (*minmax)(const T*, size_t, T*, T*);
+  void (*fill)(T*, size_t, T);
+};
+
+#if ARRAYLIKE_NUMERIC_X86
+#define KERNELS_FOR(name, type)                                                \
+  std::vector<Kernels<type>> name##Kernels() {                                 \
+    std::vector<Kernels<type>> kernels = {                                     \
+        {name##_find_scalar, name##_count_scalar, name##_sum_scalar,           \
+         name##_minmax_scalar, name##_fill_scalar},                            \
+        {name##_find_sse2, name##_count_sse2, name##_sum_sse2,                 \
+         name##_minmax_sse2, name##_fill_sse2}};                               \
+    if (arraylike_numeric_isa() == ARRAYLIKE_NUMERIC_AVX2) {                   \
+      kernels.push_back({name##_find_avx2, name##_count_avx2, name##_sum_avx2, \
+                         name##_minmax_avx2, name##_fill_avx2});               \
+    }                                                                          \
+    return kernels;                                                            \
+  }
+#else
+#define KERNELS_FOR(name, type)                                          \
+  std::vector<Kernels<type>> name##Kernels() {                           \
+    return {{name##_find_scalar, name##_count_scalar, name##_sum_scalar, \
+             name##_minmax_scalar, name##_fill_scalar}};                 \
+  }
+#endif
+
+KERNELS_FOR(Int32Array, int32_t)
+KERNELS_FOR(Int64Array, int64_t)
+KERNELS_FOR(FloatArray, float)
+KERNELS_FOR(DoubleArray, double)
+
+/* Small values so that sums are exact for every type and duplicates are
+ * common enough to exercise count. */
+template <typename T>
+std::vector<T> SmallValues(size_t n, uint32_t seed) {
+  std::mt19937 rng(seed);
+  std::vector<T> values(n);
+  for (T& value : values) {
+    value = (T)((int)(rng() % 201) - 100);
+  }
+  return values;
+}
+
+/* Checks every kernel against std algorithms for lengths that cover empty
+ * input, partial vectors and several full vectors plus a tail. */
+template <typename T>
+void ExpectKernelsMatchStd(const std::vector<Kernels<T>>& kernels) {
+  for (size_t n = 0; n <= 70; ++n) {
+    const std::vector<T> values = SmallValues<T>(n, (uint32_t)n);
+    for (const Kernels<T>& k : kernels) {
+      EXPECT_EQ(k.sum(values.data(), n),
+                std::accumulate(values.begin(), values.end(), T(0)))
+          << n;
+      for (T key : {T(-100), T(0), T(7), T(1000)}) {
+        auto it = std::find(values.begin(), values.end(), key);
+        EXPECT_EQ(k.find(values.data(), n, key),
+                  it == values.end() ? -1 : (int32_t)(it - values.begin()))
+            << n;
+        EXPECT_EQ(k.count(values.data(), n, key),
+                  (size_t)std::count(values.begin(), values.end(), key))
+            << n;
+      }
+      if (n > 0) {
+        T lo, hi;
+        k.minmax(values.data(), n, &lo, &hi);
+        EXPECT_EQ(lo, *std::min_element(values.begin(), values.end())) << n;
+        EXPECT_EQ(hi, *std::max_element(values.begin(), values.end())) << n;
+      }
+      std::vector<T> filled(n + 1, T(-1));
+      k.fill(filled.data(), n, T(3));
+      EXPECT_EQ(std::count(filled.begin(), filled.end(), T(3)), (long)n) << n;
+      EXPECT_EQ(filled[n], T(-1)) << n;
+    }
+  }
+}
+
+/* -------------------------------------------------------------
+ * Kernels
+ * ------------------------------------------------------------- */
+
+TEST(ArraylikeNumericTest, Int32KernelsMatchStd) {
+  ExpectKernelsMatchStd(Int32ArrayKernels());
+}
+
+TEST(ArraylikeNumericTest, Int64KernelsMatchStd) {
+  ExpectKernelsMatchStd(Int64ArrayKernels());
+}
+
+TEST(ArraylikeNumericTest, FloatKernelsMatchStd) {
+  ExpectKernelsMatchStd(FloatArrayKernels());
+}
+
+TEST(ArraylikeNumericTest, DoubleKernelsMatchStd) {
+  ExpectKernelsMatchStd(DoubleArrayKernels());
+}
+
+TEST(ArraylikeNumericTest, FindReturnsFirstMatch) {
+  std::vector<int32_t> values(100, 0);
+  values[37] = values[38] = values[90] = 5;
+  for (const Kernels<int32_t>& k : Int32ArrayKernels()) {
+    EXPECT_EQ(k.find(values.data(), values.size(), 5), 37);
+    EXPECT_EQ(k.count(values.data(), values.size(), 5), 3u);
+  }
+}
+
+TEST(ArraylikeNumericTest, MinMaxOfExtremeValues) {
+  std::vector<int64_t> values(50, 0);
+  values[3] = INT64_MIN;
+  values[49] = INT64_MAX;
+  for (const Kernels<int64_t>& k : Int64ArrayKernels()) {
+    int64_t lo, hi;
+    k.minmax(values.data(), values.size(), &lo, &hi);
+    EXPECT_EQ(lo, INT64_MIN);
+    EXPECT_EQ(hi, INT64_MAX);
+  }
+}
+
+/* -------------------------------------------------------------
+ * Array API
+ * ------------------------------------------------------------- */
+
+class FloatArrayNumericTest : public ::testing::Test {
+ protected:
+  FloatArray array{};
+
+  void SetUp() override { ASSERT_TRUE(FloatArray_init(&array)); }
+
+  void TearDown() override { FloatArray_finalize(&array); }
+};
+
+TEST_F(FloatArrayNumericTest, EmptyArray) {
+  float lo = 1, hi = 2;
+  EXPECT_EQ(FloatArray_find(&array, 0.0f), -1);
+  EXPECT_EQ(FloatArray_count(&array, 0.0f), 0u);
+  EXPECT_EQ(FloatArray_sum(&array), 0.0f);
+  EXPECT_FALSE(FloatArray_minmax(&array, &lo, &hi));
+  EXPECT_EQ(lo, 1);
+  EXPECT_EQ(hi, 2);
+  FloatArray_fill(&array, 1.0f);
+  EXPECT_TRUE(FloatArray_is_empty(&array));
+}
+
+TEST_F(FloatArrayNumericTest, Reductions) {
+  for (int i = 0; i < 1000; ++i) {
+    FloatArray_push_back(&array, (float)(i % 10));
+  }
+  float lo, hi;
+  EXPECT_EQ(FloatArray_sum(&array), 4500.0f);
+  EXPECT_EQ(FloatArray_find(&array, 9.0f), 9);
+  EXPECT_EQ(FloatArray_count(&array, 3.0f), 100u);
+  ASSERT_TRUE(FloatArray_minmax(&array, &lo, &hi));
+  EXPECT_EQ(lo, 0.0f);
+  EXPECT_EQ(hi, 9.0f);
+}
+
+TEST_F(FloatArrayNumericTest, Fill) {
+  for (int i = 0; i < 37; ++i) {
+    FloatArray_push_back(&array, (float)i);
+  }
+  FloatArray_fill(&array, -0.5f);
+  EXPECT_EQ(FloatArray_size(&array), 37u);
+  EXPECT_EQ(FloatArray_count(&array, -0.5f), 37u);
+  EXPECT_EQ(FloatArray_sum(&array), -18.5f);
+}
+
+TEST(CowInt32ArrayNumericTest, FillDetachesSharedTable) {
+  CowInt32Array* array = CowInt32Array_create();
+  for (int32_t i = 0; i < 37; ++i) {
+    CowInt32Array_push_back(array, i);
+  }
+  CowInt32Array* snapshot = CowInt32Array_share(array);
+  CowInt32Array_fill(array, 7);
+  EXPECT_FALSE(CowInt32Array_is_shared(snapshot));
+  EXPECT_EQ(CowInt32Array_count(array, 7), 37u);
+  EXPECT_EQ(CowInt32Array_sum(snapshot), 666);
+  CowInt32Array_delete(snapshot);
+  CowInt32Array_delete(array);
+}
+
+}  // namespace
\ No newline at end of file
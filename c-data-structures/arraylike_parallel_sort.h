@@ -0,0 +1,308 @@
+#ifndef C_DATA_STRUCTURES_ARRAYLIKE_PARALLEL_SORT_H_
+#define C_DATA_STRUCTURES_ARRAYLIKE_PARALLEL_SORT_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <assert.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "c-data-structures/arraylike_sort.h"
+
+/**
+ * @file arraylike_parallel_sort.h
+ *
+ * @brief Multithreaded sort for arraylike types, built on pthreads.
+ *
+ * DEFINE_ARRAYLIKE_PARALLEL_SORT and IMPL_ARRAYLIKE_PARALLEL_SORT add
+ * `name##_parallel_sort(array, nthreads)` to an array type that already has
+ * IMPL_ARRAYLIKE_SORT, and order elements by the same `less`.
+ *
+ * The table is cut into one chunk per thread and each chunk is sorted in
+ * parallel with the serial introsort. Sorted runs are then merged pairwise
+ * until one remains. Every merge round is itself parallel: each pair's
+ * output is split into segments of roughly n / nthreads elements, and the
+ * matching input positions are found by binary search, so all threads stay
+ * busy through the last merge. Merging ping-pongs between the table and a
+ * temporary buffer of the same size.
+ *
+ * Arrays with fewer than 2 * ARRAYLIKE_PARALLEL_SORT_MIN_CHUNK elements are
+ * sorted serially, as are all arrays if the temporary buffer cannot be
+ * allocated. Threads are started per call and joined before it returns.
+ *
+ * Usage pattern:
+ *
+ *   DEFINE_ARRAYLIKE(IntArray, int);
+ *   DEFINE_ARRAYLIKE_SORT(IntArray, int);
+ *   DEFINE_ARRAYLIKE_PARALLEL_SORT(IntArray, int);
+ *
+ *   IMPL_ARRAYLIKE(IntArray, int);
+ *   IMPL_ARRAYLIKE_SORT(IntArray, int, INT_LESS);
+ *   IMPL_ARRAYLIKE_PARALLEL_SORT(IntArray, int);
+ *
+ *   IntArray_parallel_sort(&arr, 8);
+ */
+
+/** Minimum number of elements each thread sorts. */
+#ifndef ARRAYLIKE_PARALLEL_SORT_MIN_CHUNK
+#define ARRAYLIKE_PARALLEL_SORT_MIN_CHUNK 16384
+#endif
+
+/*
+ * A batch of equally sized tasks, spread over threads by striding: the
+ * worker starting at `first` runs tasks first, first + stride, ...
+ */
+typedef struct {
+  void (*run)(void *task);
+  char *tasks;
+  size_t task_size;
+  size_t count;
+  size_t first;
+  size_t stride;
+} ArraylikeTaskBatch;
+
+static inline void *arraylike_run_task_batch(void *arg) {
+  const ArraylikeTaskBatch *batch = (const ArraylikeTaskBatch *)arg;
+  for (size_t i = batch->first; i < batch->count; i += batch->stride) {
+    batch->run(batch->tasks + i * batch->task_size);
+  }
+  return NULL;
+}
+
+/*
+ * Runs `count` tasks of `task_size` bytes on up to `nthreads` threads,
+ * including the calling thread. Tasks whose thread fails to start run on
+ * the calling thread instead, as do all of them if the per-thread
+ * bookkeeping cannot be allocated.
+ */
+static inline void arraylike_parallel_for(void (*run)(void *task), void *tasks,
+                                          size_t task_size, size_t count,
+                                          size_t nthreads) {
+  size_t stride = nthreads < count ? nthreads : count;
+  pthread_t *threads = NULL;
+  bool *started = NULL;
+  ArraylikeTaskBatch *batches = NULL;
+  if (stride > 1) {
+    threads = (pthread_t *)malloc(stride * sizeof(pthread_t));
+    started = (bool *)calloc(stride, sizeof(bool));
+    batches = (ArraylikeTaskBatch *)malloc(stride * sizeof(ArraylikeTaskBatch));
+  }
+  if (threads == NULL || started == NULL || batches == NULL) {
+    free(batches);
+    free(started);
+    free(threads);
+    ArraylikeTaskBatch batch = {run, (char *)tasks, task_size, count, 0, 1};
+    arraylike_run_task_batch(&batch);
+    return;
+  }
+  for (size_t t = 0; t < stride; ++t) {
+    ArraylikeTaskBatch batch = {run,   (char *)tasks, task_size,
+                                count, t,             stride};
+    batches[t] = batch;
+  }
+  for (size_t t = 1; t < stride; ++t) {
+    started[t] = pthread_create(&threads[t], NULL, arraylike_run_task_batch,
+                                &batches[t]) == 0;
+  }
+  arraylike_run_task_batch(&batches[0]);
+  for (size_t t = 1; t < stride; ++t) {
+    if (started[t]) {
+      pthread_join(threads[t], NULL);
+    } else {
+      arraylike_run_task_batch(&batches[t]);
+    }
+  }
+  free(batches);
+  free(started);
+  free(threads);
+}
+
+/** Number of online processors, used when nthreads is 0. */
+static inline size_t arraylike_hardware_threads(void) {
+  long count = sysconf(_SC_NPROCESSORS_ONLN);
+  return count > 0 ? (size_t)count : 1;
+}
+
+/**
+ * @macro DEFINE_ARRAYLIKE_PARALLEL_SORT
+ *
+ * @brief Declares `name##_parallel_sort`.
+ *
+ * Sorts the array using up to `nthreads` threads, including the caller;
+ * 0 uses one thread per online processor. Like `name##_sort`, the sort is
+ * not stable.
+ *
+ * @param name  Base name used in DEFINE_ARRAYLIKE
+ * @param type  Element type used in DEFINE_ARRAYLIKE
+ */
+#define DEFINE_ARRAYLIKE_PARALLEL_SORT(name, type) \
+  void name##_parallel_sort(name *const, size_t nthreads)
+
+/**
+ * @macro IMPL_ARRAYLIKE_PARALLEL_SORT
+ *
+ * @brief Generates `name##_parallel_sort`. Must follow IMPL_ARRAYLIKE_SORT
+ * for the same type.
+ *
+ * @param name  Base name used in DEFINE_ARRAYLIKE
+ * @param type  Element type used in DEFINE_ARRAYLIKE
+ */
+#define IMPL_ARRAYLIKE_PARALLEL_SORT(name, type)                              \
+                                                                              \
+  typedef struct {                                                            \
+    type *table;                                                              \
+    size_t n;                                                                 \
+  } name##SortTask;                                                           \
+                                                                              \
+  /* Writes out[k_begin, k_end) of the merge of a and b. */                   \
+  typedef struct {                                                            \
+    const type *a;                                                            \
+    size_t na;                                                                \
+    const type *b;                                                            \
+    size_t nb;                                                                \
+    type *out;                                                                \
+    size_t k_begin;                                                           \
+    size_t k_end;                                                             \
+  } name##MergeTask;                                                          \
+                                                                              \
+  static void name##_run_sort_task(void *arg) {                               \
+    name##SortTask *task = (name##SortTask *)arg;                             \
+    name##_sort_table(task->table, task->n);                                  \
+  }                                                                           \
+                                                                              \
+  /* Number of elements taken from `a` by the first k outputs of the          \
+   * merge. Ties are taken from `a` first. */                                 \
+  static inline size_t name##_merge_split(const type *a, size_t na,           \
+                                          const type *b, size_t nb,           \
+                                          size_t k) {                         \
+    size_t lo = k > nb ? k - nb : 0;                                          \
+    size_t hi = k < na ? k : na;                                              \
+    while (lo < hi) {                                                         \
+      size_t i = lo + (hi - lo) / 2;                                          \
+      if (!name##_less(&b[k - i - 1], &a[i])) {                               \
+        lo = i + 1;                                                           \
+      } else {                                                                \
+        hi = i;                                                               \
+      }                                                                       \
+    }                                                                         \
+    return lo;                                                                \
+  }                                                                           \
+                                                                              \
+  static void name##_run_merge_task(void *arg) {                              \
+    name##MergeTask *task = (name##MergeTask *)arg;                           \
+    const type *a = task->a, *b = task->b;                                    \
+    size_t i = name##_merge_split(a, task->na, b, task->nb, task->k_begin);   \
+    size_t j = task->k_begin - i;                                             \
+    size_t i_end = name##_merge_split(a, task->na, b, task->nb, task->k_end); \
+    size_t j_end = task->k_end - i_end;                                       \
+    type *out = task->out + task->k_begin;                                    \
+    while (i < i_end && j < j_end) {                                          \
+      if (name##_less(&b[j], &a[i])) {                                        \
+        *out++ = b[j++];                                                      \
+      } else {                                                                \
+        *out++ = a[i++];                                                      \
+      }                                                                       \
+    }                                                                         \
+    memcpy(out, a + i, (i_end - i) * sizeof(type));                           \
+    memcpy(out + (i_end - i), b + j, (j_end - j) * sizeof(type));             \
+  }                                                                           \
+                                                                              \
+  void name##_parallel_sort(name *const array, size_t nthreads) {             \
+    assert(array != NULL);                                                    \
+    name##_make_unique(array);                                                \
+    const size_t n = array->size;                                             \
+    if (nthreads == 0) {                                                      \
+      nthreads = arraylike_hardware_threads();                                \
+    }                                                                         \
+    size_t runs = n / ARRAYLIKE_PARALLEL_SORT_MIN_CHUNK;                      \
+    if (runs > nthreads) {                                                    \
+      runs = nthreads;                                                        \
+    }                                                                         \
+    if (runs < 2) {                                                           \
+      name##_sort_table(array->table, n);                                     \
+      return;                                                                 \
+    }                                                                         \
+    /* A round splits each pair of runs spanning m elements into              \
+     * m * nthreads / n + 1 segments, so at most nthreads + runs in all. */   \
+    size_t max_tasks = runs + nthreads;                                       \
+    type *buffer = (type *)malloc(n * sizeof(type));                          \
+    size_t *bounds = (size_t *)malloc((runs + 1) * sizeof(size_t));           \
+    name##SortTask *sorts =                                                   \
+        (name##SortTask *)malloc(runs * sizeof(name##SortTask));              \
+    name##MergeTask *merges =                                                 \
+        (name##MergeTask *)malloc(max_tasks * sizeof(name##MergeTask));       \
+    if (buffer == NULL || bounds == NULL || sorts == NULL ||                  \
+        merges == NULL) {                                                     \
+      free(merges);                                                           \
+      free(sorts);                                                            \
+      free(bounds);                                                           \
+      free(buffer);                                                           \
+      name##_sort_table(array->table, n);                                     \
+      return;                                                                 \
+    }                                                                         \
+                                                                              \
+    /* Sort one chunk per thread. */                                          \
+    for (size_t r = 0; r <= runs; ++r) {                                      \
+      bounds[r] = n * r / runs;                                               \
+    }                                                                         \
+    for (size_t r = 0; r < runs; ++r) {                                       \
+      sorts[r].table = array->table + bounds[r];                              \
+      sorts[r].n = bounds[r + 1] - bounds[r];                                 \
+    }                                                                         \
+    arraylike_parallel_for(name##_run_sort_task, sorts,                       \
+                           sizeof(name##SortTask), runs, nthreads);           \
+                                                                              \
+    /* Merge runs pairwise, splitting each merge into segments of about       \
+     * n / nthreads outputs. */                                               \
+    type *src = array->table, *dst = buffer;                                  \
+    while (runs > 1) {                                                        \
+      size_t count = 0;                                                       \
+      for (size_t r = 0; r < runs; r += 2) {                                  \
+        size_t lo = bounds[r];                                                \
+        size_t mid = bounds[r + 1];                                           \
+        size_t hi = r + 2 <= runs ? bounds[r + 2] : mid;                      \
+        size_t segments = (hi - lo) * nthreads / n + 1;                       \
+        for (size_t s = 0; s < segments; ++s) {                               \
+          name##MergeTask task = {src + lo,                                   \
+                                  mid - lo,                                   \
+                                  src + mid,                                  \
+                                  hi - mid,                                   \
+                                  dst + lo,                                   \
+                                  (hi - lo) * s / segments,                   \
+                                  (hi - lo) * (s + 1) / segments};            \
+          assert(count < max_tasks);                                          \
+          merges[count++] = task;                                             \
+        }                                                                     \
+      }                                                                       \
+      arraylike_parallel_for(name##_run_merge_task, merges,                   \
+                             sizeof(name##MergeTask), count, nthreads);       \
+      for (size_t r = 0; 2 * r <= runs; ++r) {                                \
+        bounds[r] = bounds[2 * r < runs ? 2 * r : runs];                      \
+      }                                                                       \
+      runs = (runs + 1) / 2;                                                  \
+      bounds[runs] = n;                                                       \
+      type *swap = src;                                                       \
+      src = dst;                                                              \
+      dst = swap;                                                             \
+    }                                                                         \
+    if (src != array->table) {                                                \
+      memcpy(array->table, src, n * sizeof(type));                            \
+    }                                                                         \
+    free(merges);                                                             \
+    free(sorts);                                                              \
+    free(bounds);                                                             \
+    free(buffer);                                                             \
+  }
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* C_DATA_STRUCTURES_ARRAYLIKE_PARALLEL_SORT_H_ */
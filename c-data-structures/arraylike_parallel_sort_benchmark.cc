@@ -0,0 +1,64 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "c-data-structures/arraylike_parallel_sort.h"
+
+namespace {
+
+#define INT32_LESS(a, b) (*(a) < *(b))
+
+DEFINE_ARRAYLIKE(Int32Array, int32_t);
+DEFINE_ARRAYLIKE_SORT(Int32Array, int32_t);
+DEFINE_ARRAYLIKE_PARALLEL_SORT(Int32Array, int32_t);
+IMPL_ARRAYLIKE(Int32Array, int32_t);
+IMPL_ARRAYLIKE_SORT(Int32Array, int32_t, INT32_LESS);
+IMPL_ARRAYLIKE_PARALLEL_SORT(Int32Array, int32_t);
+
+/* Sorts state.range(0) random elements with state.range(1) threads. */
+void BM_ArrayLike_ParallelSort(benchmark::State& state) {
+  const int64_t n = state.range(0);
+  const size_t nthreads = (size_t)state.range(1);
+  std::mt19937 rng(42);
+  std::vector<int32_t> input(n);
+  for (auto& value : input) {
+    value = (int32_t)rng();
+  }
+  Int32Array array;
+  Int32Array_init(&array);
+  Int32Array_reserve(&array, n);
+  for (auto _ : state) {
+    state.PauseTiming();
+    array.size = 0;
+    Int32Array_insert_range(&array, 0, input.data(), input.size());
+    state.ResumeTiming();
+    Int32Array_parallel_sort(&array, nthreads);
+    benchmark::DoNotOptimize(array.table);
+  }
+  Int32Array_finalize(&array);
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+/* Thread counts from 1 up to the number of hardware threads, doubling. */
+void ThreadCounts(benchmark::internal::Benchmark* bm) {
+  const int64_t max_threads =
+      std::max<int64_t>(1, std::thread::hardware_concurrency());
+  for (int64_t n : {1 << 20, 1 << 24}) {
+    for (int64_t threads = 1; threads < max_threads; threads *= 2) {
+      bm->Args({n, threads});
+    }
+    bm->Args({n, max_threads});
+  }
+}
+
+BENCHMARK(BM_ArrayLike_ParallelSort)
+    ->Apply(ThreadCounts)
+    ->ArgNames({"n", "threads"})
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+}  // namespace
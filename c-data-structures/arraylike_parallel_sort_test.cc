@@ -0,0 +1,112 @@
+/* Small chunks so that modest arrays exercise many threads and merge
+ * rounds. */
+#define ARRAYLIKE_PARALLEL_SORT_MIN_CHUNK 64
+
+#include "c-data-structures/arraylike_parallel_sort.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+namespace {
+
+#define INT_LESS(a, b) (*(a) < *(b))
+
+DEFINE_ARRAYLIKE(IntArray, int);
+DEFINE_ARRAYLIKE_SORT(IntArray, int);
+DEFINE_ARRAYLIKE_PARALLEL_SORT(IntArray, int);
+IMPL_ARRAYLIKE(IntArray, int);
+IMPL_ARRAYLIKE_SORT(IntArray, int, INT_LESS);
+IMPL_ARRAYLIKE_PARALLEL_SORT(IntArray, int);
+
+DEFINE_COW_ARRAYLIKE(CowIntArray, int);
+DEFINE_ARRAYLIKE_SORT(CowIntArray, int);
+DEFINE_ARRAYLIKE_PARALLEL_SORT(CowIntArray, int);
+IMPL_COW_ARRAYLIKE(CowIntArray, int);
+IMPL_ARRAYLIKE_SORT(CowIntArray, int, INT_LESS);
+IMPL_ARRAYLIKE_PARALLEL_SORT(CowIntArray, int);
+
+/* Test fixture to ensure proper setup / teardown */
+class IntArrayParallelSortTest : public ::testing::Test {
+ protected:
+  IntArray array{};
+
+  void SetUp() override { ASSERT_TRUE(IntArray_init(&array)); }
+
+  void TearDown() override { IntArray_finalize(&array); }
+
+  /* Sorts `values` with IntArray_parallel_sort and std::sort and
+   * compares. */
+  void ExpectSortsLikeStd(std::vector<int> values, size_t nthreads) {
+    IntArray_clear(&array);
+    for (int value : values) {
+      IntArray_push_back(&array, value);
+    }
+    IntArray_parallel_sort(&array, nthreads);
+    std::sort(values.begin(), values.end());
+    EXPECT_EQ(std::vector<int>(array.table, array.table + array.size),
+              values)
+        << values.size() << " elements, " << nthreads << " threads";
+  }
+};
+
+std::vector<int> RandomValues(size_t n, int modulus) {
+  std::mt19937 rng(42);
+  std::vector<int> values(n);
+  for (int& value : values) {
+    value = (int)(rng() % modulus);
+  }
+  return values;
+}
+
+/* -------------------------------------------------------------
+ * Parallel sort
+ * ------------------------------------------------------------- */
+
+TEST_F(IntArrayParallelSortTest, SmallArraysSortSerially) {
+  ExpectSortsLikeStd({}, 4);
+  ExpectSortsLikeStd({3, 1, 2}, 4);
+  ExpectSortsLikeStd(RandomValues(127, 1000), 8);
+}
+
+TEST_F(IntArrayParallelSortTest, SortsWithAnyThreadCount) {
+  for (size_t nthreads : {1u, 2u, 3u, 4u, 5u, 7u, 8u, 16u}) {
+    ExpectSortsLikeStd(RandomValues(10007, 1 << 30), nthreads);
+  }
+}
+
+TEST_F(IntArrayParallelSortTest, SortsDuplicatesAndPresortedInput) {
+  std::vector<int> ascending(5000), descending(5000);
+  for (int i = 0; i < 5000; ++i) {
+    ascending[i] = i;
+    descending[i] = 5000 - i;
+  }
+  ExpectSortsLikeStd(ascending, 6);
+  ExpectSortsLikeStd(descending, 6);
+  ExpectSortsLikeStd(RandomValues(5000, 4), 6);
+  ExpectSortsLikeStd(std::vector<int>(5000, 1), 6);
+}
+
+TEST_F(IntArrayParallelSortTest, ZeroThreadsUsesHardwareThreads) {
+  ExpectSortsLikeStd(RandomValues(4096, 1 << 30), 0);
+}
+
+TEST(CowIntArrayParallelSortTest, SortDetachesSharedTable) {
+  const std::vector<int> values = RandomValues(5000, 1 << 30);
+  CowIntArray* array = CowIntArray_create();
+  for (int value : values) {
+    CowIntArray_push_back(array, value);
+  }
+  CowIntArray* snapshot = CowIntArray_share(array);
+  CowIntArray_parallel_sort(array, 4);
+  EXPECT_FALSE(CowIntArray_is_shared(snapshot));
+  EXPECT_TRUE(std::is_sorted(array->table, array->table + array->size));
+  EXPECT_EQ(std::vector<int>(snapshot->table, snapshot->table + snapshot->size),
+            values);
+  CowIntArray_delete(snapshot);
+  CowIntArray_delete(array);
+}
+
+}  // namespace
\ No newline at end of file
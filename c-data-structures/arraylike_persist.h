@@ -0,0 +1,256 @@
+#ifndef C_DATA_STRUCTURES_ARRAYLIKE_PERSIST_H_
+#define C_DATA_STRUCTURES_ARRAYLIKE_PERSIST_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <assert.h>
+#include <fcntl.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "c-data-structures/arraylike.h"
+
+/**
+ * @file arraylike_persist.h
+ *
+ * @brief Saving arraylike types to disk and mapping them back without a copy.
+ *
+ * DEFINE_ARRAYLIKE_PERSIST and IMPL_ARRAYLIKE_PERSIST add `name##_save`,
+ * which writes the elements of an array generated with DEFINE_ARRAYLIKE to
+ * a file, and `name##_map`, which maps such a file into memory and exposes
+ * it as a read-only array whose `table` points straight into the mapping.
+ * Without checksum verification, mapping costs the same regardless of the
+ * file size: pages are read lazily as elements are accessed. Verifying the
+ * checksum reads the whole file once.
+ *
+ * Only trivially-copyable element types are supported: elements are written
+ * as raw bytes, so any pointers they contain are meaningless once mapped.
+ * Files are not portable between machines with different byte orders.
+ *
+ * File format (version ARRAYLIKE_PERSIST_VERSION):
+ *  - An ArrayLikeFileHeader, padded to ARRAYLIKE_PERSIST_HEADER_SIZE bytes
+ *    so the elements that follow are 64-byte aligned in the mapping
+ *  - `count` elements of `element_size` bytes each
+ * The header records the element size, the element count and a 64-bit
+ * checksum of the element bytes.
+ *
+ * Saving writes to `<path>.tmp`, syncs it to disk and renames it over
+ * `path`, so readers never observe a partially written file, even after a
+ * crash.
+ *
+ * Error handling: I/O and format errors are reported by returning false.
+ *
+ * Usage pattern:
+ *
+ *   DEFINE_ARRAYLIKE(IntArray, int);
+ *   DEFINE_ARRAYLIKE_PERSIST(IntArray, int);
+ *
+ *   IMPL_ARRAYLIKE(IntArray, int);
+ *   IMPL_ARRAYLIKE_PERSIST(IntArray, int);
+ *
+ *   IntArray_save(&arr, "ints.bin");
+ *
+ *   IntArrayMapping mapping;
+ *   if (IntArray_map(&mapping, "ints.bin", false)) {
+ *     int first = IntArray_get_unchecked(&mapping.array, 0);
+ *     IntArray_unmap(&mapping);
+ *   }
+ */
+
+#define ARRAYLIKE_PERSIST_MAGIC "CDSARRAY"
+#define ARRAYLIKE_PERSIST_VERSION 1
+#define ARRAYLIKE_PERSIST_HEADER_SIZE 64
+
+typedef struct {
+  char magic[8];          /* ARRAYLIKE_PERSIST_MAGIC, without the NUL */
+  uint32_t version;       /* ARRAYLIKE_PERSIST_VERSION */
+  uint32_t element_size;  /* sizeof(type) */
+  uint64_t count;         /* number of elements */
+  uint64_t checksum;      /* arraylike_persist_checksum of the elements */
+} ArrayLikeFileHeader;
+
+/**
+ * 64-bit checksum of `size` bytes, processed a word at a time.
+ */
+static inline uint64_t arraylike_persist_checksum(const void *data,
+                                                  size_t size) {
+  const unsigned char *bytes = (const unsigned char *)data;
+  uint64_t h = 0xcbf29ce484222325ULL ^ size;
+  size_t i = 0;
+  for (; i + 8 <= size; i += 8) {
+    uint64_t word;
+    memcpy(&word, bytes + i, sizeof(word));
+    h = (h ^ word) * 0x100000001b3ULL;
+    h ^= h >> 29;
+  }
+  for (; i < size; ++i) {
+    h = (h ^ bytes[i]) * 0x100000001b3ULL;
+  }
+  return h;
+}
+
+/**
+ * Writes `count` elements of `element_size` bytes from `data` to `path`.
+ */
+static inline bool arraylike_persist_save(const char *path,
+                                          uint32_t element_size,
+                                          const void *data, size_t count) {
+  unsigned char header[ARRAYLIKE_PERSIST_HEADER_SIZE] = {0};
+  ArrayLikeFileHeader fields;
+  memcpy(fields.magic, ARRAYLIKE_PERSIST_MAGIC, sizeof(fields.magic));
+  fields.version = ARRAYLIKE_PERSIST_VERSION;
+  fields.element_size = element_size;
+  fields.count = count;
+  fields.checksum = arraylike_persist_checksum(data, count * element_size);
+  memcpy(header, &fields, sizeof(fields));
+
+  size_t path_len = strlen(path);
+  char *tmp_path = (char *)malloc(path_len + sizeof(".tmp"));
+  assert(tmp_path != NULL);
+  memcpy(tmp_path, path, path_len);
+  memcpy(tmp_path + path_len, ".tmp", sizeof(".tmp"));
+
+  bool ok = false;
+  FILE *file = fopen(tmp_path, "wb");
+  if (file != NULL) {
+    ok = fwrite(header, sizeof(header), 1, file) == 1 &&
+         (count == 0 || fwrite(data, element_size, count, file) == count);
+    /* The data must be on disk before the rename makes it visible. */
+    ok = ok && fflush(file) == 0 && fsync(fileno(file)) == 0;
+    ok = (fclose(file) == 0) && ok;
+    ok = ok && rename(tmp_path, path) == 0;
+    if (!ok) {
+      remove(tmp_path);
+    }
+  }
+  free(tmp_path);
+  return ok;
+}
+
+/**
+ * Maps the file at `path` read-only and validates its header against
+ * `element_size`. On success sets `*base` and `*length` to the mapping and
+ * `*data` and `*count` to the elements.
+ */
+static inline bool arraylike_persist_map(const char *path,
+                                         uint32_t element_size,
+                                         bool verify_checksum, void **base,
+                                         size_t *length, const void **data,
+                                         size_t *count) {
+  int fd = open(path, O_RDONLY);
+  if (fd < 0) {
+    return false;
+  }
+  struct stat st;
+  if (fstat(fd, &st) != 0 || st.st_size < ARRAYLIKE_PERSIST_HEADER_SIZE) {
+    close(fd);
+    return false;
+  }
+  size_t file_size = (size_t)st.st_size;
+  void *mapped = mmap(NULL, file_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (mapped == MAP_FAILED) {
+    return false;
+  }
+
+  ArrayLikeFileHeader header;
+  memcpy(&header, mapped, sizeof(header));
+  const unsigned char *elements =
+      (const unsigned char *)mapped + ARRAYLIKE_PERSIST_HEADER_SIZE;
+  size_t capacity =
+      (file_size - ARRAYLIKE_PERSIST_HEADER_SIZE) / element_size;
+  bool ok = memcmp(header.magic, ARRAYLIKE_PERSIST_MAGIC,
+                   sizeof(header.magic)) == 0 &&
+            header.version == ARRAYLIKE_PERSIST_VERSION &&
+            header.element_size == element_size && header.count <= capacity &&
+            header.count <= INT32_MAX;
+  if (ok && verify_checksum) {
+    ok = arraylike_persist_checksum(elements, header.count * element_size) ==
+         header.checksum;
+  }
+  if (!ok) {
+    munmap(mapped, file_size);
+    return false;
+  }
+  *base = mapped;
+  *length = file_size;
+  *data = elements;
+  *count = (size_t)header.count;
+  return true;
+}
+
+/**
+ * @macro DEFINE_ARRAYLIKE_PERSIST
+ *
+ * @brief Declares the save / map API for an arraylike type.
+ *
+ * `name##Mapping` owns a read-only mapping of a saved array. Its `array`
+ * member can be passed to any non-mutating function of the array type, and
+ * must not be modified or finalized; release it with `name##_unmap`.
+ *
+ * @param name  Base name used in DEFINE_ARRAYLIKE
+ * @param type  Element type used in DEFINE_ARRAYLIKE
+ */
+#define DEFINE_ARRAYLIKE_PERSIST(name, type)                                \
+  typedef struct {                                                          \
+    name array;                                                             \
+    void *_base;                                                            \
+    size_t _length;                                                         \
+  } name##Mapping;                                                          \
+                                                                            \
+  bool name##_save(const name *const, const char *path);                    \
+  bool name##_map(name##Mapping *, const char *path, bool verify_checksum); \
+  void name##_unmap(name##Mapping *)
+
+/**
+ * @macro IMPL_ARRAYLIKE_PERSIST
+ *
+ * @brief Generates the functions declared by DEFINE_ARRAYLIKE_PERSIST.
+ *
+ * @param name  Base name used in DEFINE_ARRAYLIKE
+ * @param type  Element type used in DEFINE_ARRAYLIKE
+ */
+#define IMPL_ARRAYLIKE_PERSIST(name, type)                                    \
+  bool name##_save(const name *const array, const char *path) {               \
+    assert(array != NULL && path != NULL);                                    \
+    return arraylike_persist_save(path, (uint32_t)sizeof(type), array->table, \
+                                  array->size);                               \
+  }                                                                           \
+                                                                              \
+  bool name##_map(name##Mapping *mapping, const char *path,                   \
+                  bool verify_checksum) {                                     \
+    assert(mapping != NULL && path != NULL);                                  \
+    const void *data;                                                         \
+    size_t count;                                                             \
+    if (!arraylike_persist_map(path, (uint32_t)sizeof(type), verify_checksum, \
+                               &mapping->_base, &mapping->_length, &data,     \
+                               &count)) {                                     \
+      return false;                                                           \
+    }                                                                         \
+    memset(&mapping->array, 0x0, sizeof(mapping->array));                     \
+    mapping->array.capacity = count;                                          \
+    mapping->array.size = count;                                              \
+    mapping->array.table = (type *)data;                                      \
+    return true;                                                              \
+  }                                                                           \
+                                                                              \
+  void name##_unmap(name##Mapping *mapping) {                                 \
+    assert(mapping != NULL);                                                  \
+    munmap(mapping->_base, mapping->_length);                                 \
+    memset(mapping, 0x0, sizeof(*mapping));                                   \
+  }
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* C_DATA_STRUCTURES_ARRAYLIKE_PERSIST_H_ */
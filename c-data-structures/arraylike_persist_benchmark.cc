@@ -0,0 +1,100 @@
+#include <benchmark/benchmark.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <string>
+
+#include "c-data-structures/arraylike_persist.h"
+
+namespace {
+
+DEFINE_ARRAYLIKE(Int64Array, int64_t);
+DEFINE_ARRAYLIKE_PERSIST(Int64Array, int64_t);
+IMPL_ARRAYLIKE(Int64Array, int64_t);
+IMPL_ARRAYLIKE_PERSIST(Int64Array, int64_t);
+
+std::string FilePath(int64_t n) {
+  return "/tmp/arraylike_persist_benchmark_" + std::to_string(n);
+}
+
+/* Saves an array of n elements to FilePath(n). */
+void SaveFile(int64_t n) {
+  Int64Array array;
+  Int64Array_init_capacity(&array, n);
+  for (int64_t i = 0; i < n; ++i) {
+    Int64Array_push_back(&array, i);
+  }
+  Int64Array_save(&array, FilePath(n).c_str());
+  Int64Array_finalize(&array);
+}
+
+/* -------------------------------------------------------------
+ * Startup: rebuilding from scratch vs. mapping a saved array
+ * ------------------------------------------------------------- */
+
+void BM_ArrayLike_Rebuild(benchmark::State& state) {
+  const int64_t n = state.range(0);
+  for (auto _ : state) {
+    Int64Array array;
+    Int64Array_init(&array);
+    for (int64_t i = 0; i < n; ++i) {
+      Int64Array_push_back(&array, i);
+    }
+    benchmark::DoNotOptimize(array.table);
+    Int64Array_finalize(&array);
+  }
+}
+
+void BM_ArrayLike_Map(benchmark::State& state) {
+  const int64_t n = state.range(0);
+  SaveFile(n);
+  for (auto _ : state) {
+    Int64ArrayMapping mapping;
+    Int64Array_map(&mapping, FilePath(n).c_str(), false);
+    benchmark::DoNotOptimize(mapping.array.table);
+    Int64Array_unmap(&mapping);
+  }
+  unlink(FilePath(n).c_str());
+}
+
+void BM_ArrayLike_MapVerified(benchmark::State& state) {
+  const int64_t n = state.range(0);
+  SaveFile(n);
+  for (auto _ : state) {
+    Int64ArrayMapping mapping;
+    Int64Array_map(&mapping, FilePath(n).c_str(), true);
+    benchmark::DoNotOptimize(mapping.array.table);
+    Int64Array_unmap(&mapping);
+  }
+  unlink(FilePath(n).c_str());
+  state.SetBytesProcessed(state.iterations() * n * sizeof(int64_t));
+}
+
+/* -------------------------------------------------------------
+ * Saving
+ * ------------------------------------------------------------- */
+
+void BM_ArrayLike_Save(benchmark::State& state) {
+  const int64_t n = state.range(0);
+  Int64Array array;
+  Int64Array_init_capacity(&array, n);
+  for (int64_t i = 0; i < n; ++i) {
+    Int64Array_push_back(&array, i);
+  }
+  for (auto _ : state) {
+    Int64Array_save(&array, FilePath(n).c_str());
+  }
+  Int64Array_finalize(&array);
+  unlink(FilePath(n).c_str());
+  state.SetBytesProcessed(state.iterations() * n * sizeof(int64_t));
+}
+
+#define RANGE RangeMultiplier(16)->Range(1 << 10, 1 << 22)
+
+BENCHMARK(BM_ArrayLike_Rebuild)->RANGE;
+BENCHMARK(BM_ArrayLike_Map)->RANGE;
+BENCHMARK(BM_ArrayLike_MapVerified)->RANGE;
+
+BENCHMARK(BM_ArrayLike_Save)->RANGE;
+
+}  // namespace
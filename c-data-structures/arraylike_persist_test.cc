@@ -0,0 +1,192 @@
+#include "c-data-structures/arraylike_persist.h"
+
+#include <gtest/gtest.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <unistd.h>
+
+#include <string>
+
+namespace {
+
+DEFINE_ARRAYLIKE(IntArray, int);
+DEFINE_ARRAYLIKE_PERSIST(IntArray, int);
+IMPL_ARRAYLIKE(IntArray, int);
+IMPL_ARRAYLIKE_PERSIST(IntArray, int);
+
+struct Point {
+  double x;
+  double y;
+  int32_t id;
+};
+
+DEFINE_ARRAYLIKE(PointArray, Point);
+DEFINE_ARRAYLIKE_PERSIST(PointArray, Point);
+IMPL_ARRAYLIKE(PointArray, Point);
+IMPL_ARRAYLIKE_PERSIST(PointArray, Point);
+
+/* Test fixture to ensure proper setup / teardown */
+class IntArrayPersistTest : public ::testing::Test {
+ protected:
+  IntArray array{};
+  std::string path;
+
+  void SetUp() override {
+    ASSERT_TRUE(IntArray_init(&array));
+    path = ::testing::TempDir() + "arraylike_persist_test_" +
+           ::testing::UnitTest::GetInstance()->current_test_info()->name();
+  }
+
+  void TearDown() override {
+    IntArray_finalize(&array);
+    unlink(path.c_str());
+  }
+
+  void Fill(int n) {
+    for (int i = 0; i < n; ++i) {
+      IntArray_push_back(&array, i * 7);
+    }
+  }
+
+  /* Overwrites `size` bytes of the saved file at `offset` */
+  void Corrupt(long offset, const void *bytes, size_t size) {
+    FILE *file = fopen(path.c_str(), "r+b");
+    ASSERT_NE(file, nullptr);
+    fseek(file, offset, SEEK_SET);
+    fwrite(bytes, size, 1, file);
+    fclose(file);
+  }
+};
+
+/* -------------------------------------------------------------
+ * Round trips
+ * ------------------------------------------------------------- */
+
+TEST_F(IntArrayPersistTest, SaveAndMap) {
+  Fill(10000);
+  ASSERT_TRUE(IntArray_save(&array, path.c_str()));
+
+  IntArrayMapping mapping;
+  ASSERT_TRUE(IntArray_map(&mapping, path.c_str(), true));
+  ASSERT_EQ(IntArray_size(&mapping.array), 10000u);
+  for (int i = 0; i < 10000; ++i) {
+    EXPECT_EQ(IntArray_get_unchecked(&mapping.array, i), i * 7);
+  }
+  IntArray_unmap(&mapping);
+}
+
+TEST_F(IntArrayPersistTest, MappedTableIsZeroCopy) {
+  Fill(100);
+  ASSERT_TRUE(IntArray_save(&array, path.c_str()));
+
+  IntArrayMapping mapping;
+  ASSERT_TRUE(IntArray_map(&mapping, path.c_str(), false));
+  EXPECT_EQ((const char *)mapping.array.table,
+            (const char *)mapping._base + ARRAYLIKE_PERSIST_HEADER_SIZE);
+  EXPECT_EQ((uintptr_t)mapping.array.table % 64, 0u);
+  IntArray_unmap(&mapping);
+}
+
+TEST_F(IntArrayPersistTest, EmptyArray) {
+  ASSERT_TRUE(IntArray_save(&array, path.c_str()));
+
+  IntArrayMapping mapping;
+  ASSERT_TRUE(IntArray_map(&mapping, path.c_str(), true));
+  EXPECT_TRUE(IntArray_is_empty(&mapping.array));
+  IntArray_unmap(&mapping);
+}
+
+TEST_F(IntArrayPersistTest, SaveReplacesExistingFile) {
+  Fill(100);
+  ASSERT_TRUE(IntArray_save(&array, path.c_str()));
+  IntArray_clear(&array);
+  Fill(3);
+  ASSERT_TRUE(IntArray_save(&array, path.c_str()));
+  EXPECT_NE(access((path + ".tmp").c_str(), F_OK), 0);
+
+  IntArrayMapping mapping;
+  ASSERT_TRUE(IntArray_map(&mapping, path.c_str(), true));
+  EXPECT_EQ(IntArray_size(&mapping.array), 3u);
+  IntArray_unmap(&mapping);
+}
+
+TEST(ArrayLikePersistTest, StructElements) {
+  std::string path = ::testing::TempDir() + "arraylike_persist_test_points";
+  PointArray points;
+  PointArray_init(&points);
+  for (int i = 0; i < 500; ++i) {
+    PointArray_push_back(&points, Point{i * 0.5, -i * 1.5, i});
+  }
+  ASSERT_TRUE(PointArray_save(&points, path.c_str()));
+  PointArray_finalize(&points);
+
+  PointArrayMapping mapping;
+  ASSERT_TRUE(PointArray_map(&mapping, path.c_str(), true));
+  ASSERT_EQ(PointArray_size(&mapping.array), 500u);
+  for (int i = 0; i < 500; ++i) {
+    const Point *point = PointArray_get_ref_unchecked(&mapping.array, i);
+    EXPECT_EQ(point->x, i * 0.5);
+    EXPECT_EQ(point->y, -i * 1.5);
+    EXPECT_EQ(point->id, i);
+  }
+  PointArray_unmap(&mapping);
+  unlink(path.c_str());
+}
+
+/* -------------------------------------------------------------
+ * Validation
+ * ------------------------------------------------------------- */
+
+TEST_F(IntArrayPersistTest, MissingFile) {
+  IntArrayMapping mapping;
+  EXPECT_FALSE(IntArray_map(&mapping, path.c_str(), false));
+}
+
+TEST_F(IntArrayPersistTest, RejectsOtherElementType) {
+  Fill(100);
+  ASSERT_TRUE(IntArray_save(&array, path.c_str()));
+  PointArrayMapping mapping;
+  EXPECT_FALSE(PointArray_map(&mapping, path.c_str(), false));
+}
+
+TEST_F(IntArrayPersistTest, RejectsBadMagic) {
+  Fill(10);
+  ASSERT_TRUE(IntArray_save(&array, path.c_str()));
+  Corrupt(0, "XXXX", 4);
+  IntArrayMapping mapping;
+  EXPECT_FALSE(IntArray_map(&mapping, path.c_str(), false));
+}
+
+TEST_F(IntArrayPersistTest, RejectsOtherVersion) {
+  Fill(10);
+  ASSERT_TRUE(IntArray_save(&array, path.c_str()));
+  uint32_t version = ARRAYLIKE_PERSIST_VERSION + 1;
+  Corrupt(offsetof(ArrayLikeFileHeader, version), &version, sizeof(version));
+  IntArrayMapping mapping;
+  EXPECT_FALSE(IntArray_map(&mapping, path.c_str(), false));
+}
+
+TEST_F(IntArrayPersistTest, RejectsTruncatedFile) {
+  Fill(100);
+  ASSERT_TRUE(IntArray_save(&array, path.c_str()));
+  ASSERT_EQ(truncate(path.c_str(), ARRAYLIKE_PERSIST_HEADER_SIZE + 40), 0);
+  IntArrayMapping mapping;
+  EXPECT_FALSE(IntArray_map(&mapping, path.c_str(), false));
+}
+
+TEST_F(IntArrayPersistTest, ChecksumDetectsCorruptElements) {
+  Fill(100);
+  ASSERT_TRUE(IntArray_save(&array, path.c_str()));
+  int bad = -1;
+  Corrupt(ARRAYLIKE_PERSIST_HEADER_SIZE + 50 * sizeof(int), &bad,
+          sizeof(bad));
+
+  IntArrayMapping mapping;
+  EXPECT_FALSE(IntArray_map(&mapping, path.c_str(), true));
+  /* Without verification the file maps as-is */
+  ASSERT_TRUE(IntArray_map(&mapping, path.c_str(), false));
+  EXPECT_EQ(IntArray_get_unchecked(&mapping.array, 50), -1);
+  IntArray_unmap(&mapping);
+}
+
+}  // namespace
\ No newline at end of file
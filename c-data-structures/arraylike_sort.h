@@ -0,0 +1,245 @@
+#ifndef C_DATA_STRUCTURES_ARRAYLIKE_SORT_H_
+#define C_DATA_STRUCTURES_ARRAYLIKE_SORT_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "c-data-structures/arraylike.h"
+
+/**
+ * @file arraylike_sort.h
+ *
+ * @brief Sorting and binary search for arraylike types.
+ *
+ * DEFINE_ARRAYLIKE_SORT and IMPL_ARRAYLIKE_SORT add sorting and searching
+ * functions to an array type generated with DEFINE_ARRAYLIKE. The ordering
+ * is a `less` function-like macro (or function) supplied to
+ * IMPL_ARRAYLIKE_SORT and invoked as `less(a, b)` with two `const type *`.
+ * Since it is expanded into the generated code, every comparison is inlined
+ * instead of going through a comparator pointer as with qsort.
+ *
+ * Sorting uses introsort: quicksort with median-of-three pivots, insertion
+ * sort for short ranges and a heapsort fallback once the recursion gets too
+ * deep, for O(n log n) worst-case time. The sort is not stable. Sorting
+ * a copy-on-write array detaches it from the arrays it shares a table with.
+ *
+ * Usage pattern:
+ *
+ *   DEFINE_ARRAYLIKE(IntArray, int);
+ *   DEFINE_ARRAYLIKE_SORT(IntArray, int);
+ *
+ *   #define INT_LESS(a, b) (*(a) < *(b))
+ *   IMPL_ARRAYLIKE(IntArray, int);
+ *   IMPL_ARRAYLIKE_SORT(IntArray, int, INT_LESS);
+ *
+ *   IntArray_sort(&arr);
+ *   int32_t at = IntArray_lower_bound(&arr, &key);
+ */
+
+/** Ranges at most this long are sorted with insertion sort. */
+#ifndef ARRAYLIKE_SORT_INSERTION_THRESHOLD
+#define ARRAYLIKE_SORT_INSERTION_THRESHOLD 16
+#endif
+
+/**
+ * @macro DEFINE_ARRAYLIKE_SORT
+ *
+ * @brief Declares the sorting and searching API for an arraylike type.
+ *
+ * The search functions require the array to be sorted by the same `less`
+ * passed to IMPL_ARRAYLIKE_SORT.
+ *
+ * @param name  Base name used in DEFINE_ARRAYLIKE
+ * @param type  Element type used in DEFINE_ARRAYLIKE
+ */
+#define DEFINE_ARRAYLIKE_SORT(name, type)                                      \
+  /* Sorting */                                                                \
+  void name##_sort(name *const);                                               \
+  bool name##_sort_range(name *const, int32_t range_start, int32_t range_end); \
+                                                                               \
+  /* Binary search */                                                          \
+  bool name##_bsearch(const name *const, const type *key, int32_t *index);     \
+  int32_t name##_lower_bound(const name *const, const type *key);              \
+  int32_t name##_upper_bound(const name *const, const type *key)
+
+/**
+ * @macro IMPL_ARRAYLIKE_SORT
+ *
+ * @brief Generates the functions declared by DEFINE_ARRAYLIKE_SORT.
+ *
+ * @param name  Base name used in DEFINE_ARRAYLIKE
+ * @param type  Element type used in DEFINE_ARRAYLIKE
+ * @param less  Strict weak ordering invoked as `less(a, b)` with two
+ *              `const type *`
+ */
+#define IMPL_ARRAYLIKE_SORT(name, type, less)                               \
+                                                                            \
+  static inline bool name##_less(const type *a, const type *b) {            \
+    return (less(a, b));                                                    \
+  }                                                                         \
+                                                                            \
+  static inline void name##_swap(type *a, type *b) {                        \
+    type tmp = *a;                                                          \
+    *a = *b;                                                                \
+    *b = tmp;                                                               \
+  }                                                                         \
+                                                                            \
+  static inline void name##_insertion_sort(type *table, size_t n) {         \
+    for (size_t i = 1; i < n; ++i) {                                        \
+      type value = table[i];                                                \
+      size_t j = i;                                                         \
+      while (j > 0 && name##_less(&value, &table[j - 1])) {                 \
+        table[j] = table[j - 1];                                            \
+        j--;                                                                \
+      }                                                                     \
+      table[j] = value;                                                     \
+    }                                                                       \
+  }                                                                         \
+                                                                            \
+  static inline void name##_sift_down(type *table, size_t root, size_t n) { \
+    type value = table[root];                                               \
+    size_t child;                                                           \
+    while ((child = 2 * root + 1) < n) {                                    \
+      if (child + 1 < n && name##_less(&table[child], &table[child + 1])) { \
+        child++;                                                            \
+      }                                                                     \
+      if (!name##_less(&value, &table[child])) {                            \
+        break;                                                              \
+      }                                                                     \
+      table[root] = table[child];                                           \
+      root = child;                                                         \
+    }                                                                       \
+    table[root] = value;                                                    \
+  }                                                                         \
+                                                                            \
+  static inline void name##_heap_sort(type *table, size_t n) {              \
+    for (size_t i = n / 2; i > 0; --i) {                                    \
+      name##_sift_down(table, i - 1, n);                                    \
+    }                                                                       \
+    for (size_t end = n; end > 1; --end) {                                  \
+      name##_swap(&table[0], &table[end - 1]);                              \
+      name##_sift_down(table, 0, end - 1);                                  \
+    }                                                                       \
+  }                                                                         \
+                                                                            \
+  /* Orders the first, middle and last elements and partitions around the   \
+   * middle one. Returns the size of the lower part; both parts are         \
+   * non-empty. */                                                          \
+  static inline size_t name##_partition(type *table, size_t n) {            \
+    type *lo = table, *mid = table + n / 2, *hi = table + n - 1;            \
+    if (name##_less(mid, lo)) name##_swap(mid, lo);                         \
+    if (name##_less(hi, mid)) {                                             \
+      name##_swap(hi, mid);                                                 \
+      if (name##_less(mid, lo)) name##_swap(mid, lo);                       \
+    }                                                                       \
+    type pivot = *mid;                                                      \
+    size_t i = 0, j = n - 1;                                                \
+    for (;;) {                                                              \
+      while (name##_less(&table[i], &pivot)) i++;                           \
+      while (name##_less(&pivot, &table[j])) j--;                           \
+      if (i >= j) return j + 1;                                             \
+      name##_swap(&table[i], &table[j]);                                    \
+      i++;                                                                  \
+      j--;                                                                  \
+    }                                                                       \
+  }                                                                         \
+                                                                            \
+  static void name##_introsort(type *table, size_t n, int depth) {          \
+    while (n > ARRAYLIKE_SORT_INSERTION_THRESHOLD) {                        \
+      if (depth-- == 0) {                                                   \
+        name##_heap_sort(table, n);                                         \
+        return;                                                             \
+      }                                                                     \
+      size_t split = name##_partition(table, n);                            \
+      /* Recurse into the smaller part to bound the stack depth. */         \
+      if (split < n - split) {                                              \
+        name##_introsort(table, split, depth);                              \
+        table += split;                                                     \
+        n -= split;                                                         \
+      } else {                                                              \
+        name##_introsort(table + split, n - split, depth);                  \
+        n = split;                                                          \
+      }                                                                     \
+    }                                                                       \
+    name##_insertion_sort(table, n);                                        \
+  }                                                                         \
+                                                                            \
+  static inline void name##_sort_table(type *table, size_t n) {             \
+    int depth = 0;                                                          \
+    for (size_t m = n; m > 1; m >>= 1) {                                    \
+      depth += 2;                                                           \
+    }                                                                       \
+    name##_introsort(table, n, depth);                                      \
+  }                                                                         \
+                                                                            \
+  void name##_sort(name *const array) {                                     \
+    assert(array != NULL);                                                  \
+    name##_make_unique(array);                                              \
+    name##_sort_table(array->table, array->size);                           \
+  }                                                                         \
+                                                                            \
+  bool name##_sort_range(name *const array, int32_t range_start,            \
+                         int32_t range_end) {                               \
+    assert(array != NULL);                                                  \
+    if (range_start < 0 || range_start > range_end ||                       \
+        (size_t)range_end > array->size) {                                  \
+      return false;                                                         \
+    }                                                                       \
+    name##_make_unique(array);                                              \
+    name##_sort_table(array->table + range_start, range_end - range_start); \
+    return true;                                                            \
+  }                                                                         \
+                                                                            \
+  int32_t name##_lower_bound(const name *const array, const type *key) {    \
+    assert(array != NULL && key != NULL);                                   \
+    size_t lo = 0, n = array->size;                                         \
+    while (n > 0) {                                                         \
+      size_t half = n / 2;                                                  \
+      if (name##_less(&array->table[lo + half], key)) {                     \
+        lo += half + 1;                                                     \
+        n -= half + 1;                                                      \
+      } else {                                                              \
+        n = half;                                                           \
+      }                                                                     \
+    }                                                                       \
+    return (int32_t)lo;                                                     \
+  }                                                                         \
+                                                                            \
+  int32_t name##_upper_bound(const name *const array, const type *key) {    \
+    assert(array != NULL && key != NULL);                                   \
+    size_t lo = 0, n = array->size;                                         \
+    while (n > 0) {                                                         \
+      size_t half = n / 2;                                                  \
+      if (!name##_less(key, &array->table[lo + half])) {                    \
+        lo += half + 1;                                                     \
+        n -= half + 1;                                                      \
+      } else {                                                              \
+        n = half;                                                           \
+      }                                                                     \
+    }                                                                       \
+    return (int32_t)lo;                                                     \
+  }                                                                         \
+                                                                            \
+  bool name##_bsearch(const name *const array, const type *key,             \
+                      int32_t *index) {                                     \
+    int32_t at = name##_lower_bound(array, key);                            \
+    if ((size_t)at == array->size || name##_less(key, &array->table[at])) { \
+      return false;                                                         \
+    }                                                                       \
+    if (index != NULL) {                                                    \
+      *index = at;                                                          \
+    }                                                                       \
+    return true;                                                            \
+  }
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* C_DATA_STRUCTURES_ARRAYLIKE_SORT_H_ */
@@ -0,0 +1,190 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "c-data-structures/arraylike_sort.h"
+
+namespace {
+
+/* A record sorted by its first field, as in typical batch processing. */
+struct Record {
+  uint64_t key;
+  uint64_t payload[3];
+};
+
+#define INT32_LESS(a, b) (*(a) < *(b))
+#define RECORD_LESS(a, b) ((a)->key < (b)->key)
+
+DEFINE_ARRAYLIKE(Int32Array, int32_t);
+DEFINE_ARRAYLIKE_SORT(Int32Array, int32_t);
+IMPL_ARRAYLIKE(Int32Array, int32_t);
+IMPL_ARRAYLIKE_SORT(Int32Array, int32_t, INT32_LESS);
+
+DEFINE_ARRAYLIKE(RecordArray, Record);
+DEFINE_ARRAYLIKE_SORT(RecordArray, Record);
+IMPL_ARRAYLIKE(RecordArray, Record);
+IMPL_ARRAYLIKE_SORT(RecordArray, Record, RECORD_LESS);
+
+/* Maps an element type to its generated arraylike and to the equivalent
+ * qsort comparator and std::sort predicate. */
+template <typename T>
+struct Ops;
+
+template <>
+struct Ops<int32_t> {
+  using A = Int32Array;
+  static void init(A* a) { Int32Array_init(a); }
+  static void finalize(A* a) { Int32Array_finalize(a); }
+  static void push_back(A* a, int32_t v) { Int32Array_push_back(a, v); }
+  static void sort(A* a) { Int32Array_sort(a); }
+  static int32_t lower_bound(A* a, const int32_t* key) {
+    return Int32Array_lower_bound(a, key);
+  }
+  static int32_t make(uint64_t bits) { return (int32_t)bits; }
+  static int compare(const void* a, const void* b) {
+    int32_t x = *(const int32_t*)a, y = *(const int32_t*)b;
+    return (x > y) - (x < y);
+  }
+  static bool less(const int32_t& a, const int32_t& b) { return a < b; }
+};
+
+template <>
+struct Ops<Record> {
+  using A = RecordArray;
+  static void init(A* a) { RecordArray_init(a); }
+  static void finalize(A* a) { RecordArray_finalize(a); }
+  static void push_back(A* a, Record v) { RecordArray_push_back(a, v); }
+  static void sort(A* a) { RecordArray_sort(a); }
+  static int32_t lower_bound(A* a, const Record* key) {
+    return RecordArray_lower_bound(a, key);
+  }
+  static Record make(uint64_t bits) { return Record{bits, {bits, 0, 0}}; }
+  static int compare(const void* a, const void* b) {
+    uint64_t x = ((const Record*)a)->key, y = ((const Record*)b)->key;
+    return (x > y) - (x < y);
+  }
+  static bool less(const Record& a, const Record& b) { return a.key < b.key; }
+};
+
+/* Fixed-seed random input so every run sorts the same data. */
+template <typename T>
+std::vector<T> RandomValues(int64_t n) {
+  std::mt19937_64 rng(42);
+  std::vector<T> values;
+  values.reserve(n);
+  for (int64_t i = 0; i < n; ++i) {
+    values.push_back(Ops<T>::make(rng()));
+  }
+  return values;
+}
+
+/* -------------------------------------------------------------
+ * Sorting
+ * ------------------------------------------------------------- */
+
+template <typename T>
+void BM_ArrayLike_Sort(benchmark::State& state) {
+  const int64_t n = state.range(0);
+  const std::vector<T> input = RandomValues<T>(n);
+  typename Ops<T>::A array;
+  Ops<T>::init(&array);
+  for (auto _ : state) {
+    state.PauseTiming();
+    array.size = 0;
+    for (const T& value : input) {
+      Ops<T>::push_back(&array, value);
+    }
+    state.ResumeTiming();
+    Ops<T>::sort(&array);
+    benchmark::DoNotOptimize(array.table);
+  }
+  Ops<T>::finalize(&array);
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+template <typename T>
+void BM_Qsort(benchmark::State& state) {
+  const int64_t n = state.range(0);
+  const std::vector<T> input = RandomValues<T>(n);
+  std::vector<T> values;
+  for (auto _ : state) {
+    state.PauseTiming();
+    values = input;
+    state.ResumeTiming();
+    qsort(values.data(), values.size(), sizeof(T), Ops<T>::compare);
+    benchmark::DoNotOptimize(values.data());
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+template <typename T>
+void BM_StdSort(benchmark::State& state) {
+  const int64_t n = state.range(0);
+  const std::vector<T> input = RandomValues<T>(n);
+  std::vector<T> values;
+  for (auto _ : state) {
+    state.PauseTiming();
+    values = input;
+    state.ResumeTiming();
+    std::sort(values.begin(), values.end(), Ops<T>::less);
+    benchmark::DoNotOptimize(values.data());
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+/* -------------------------------------------------------------
+ * Binary search
+ * ------------------------------------------------------------- */
+
+template <typename T>
+void BM_ArrayLike_LowerBound(benchmark::State& state) {
+  const int64_t n = state.range(0);
+  const std::vector<T> input = RandomValues<T>(n);
+  typename Ops<T>::A array;
+  Ops<T>::init(&array);
+  for (const T& value : input) {
+    Ops<T>::push_back(&array, value);
+  }
+  Ops<T>::sort(&array);
+  for (auto _ : state) {
+    for (const T& key : input) {
+      benchmark::DoNotOptimize(Ops<T>::lower_bound(&array, &key));
+    }
+  }
+  Ops<T>::finalize(&array);
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+template <typename T>
+void BM_Bsearch(benchmark::State& state) {
+  const int64_t n = state.range(0);
+  std::vector<T> values = RandomValues<T>(n);
+  const std::vector<T> keys = values;
+  qsort(values.data(), values.size(), sizeof(T), Ops<T>::compare);
+  for (auto _ : state) {
+    for (const T& key : keys) {
+      benchmark::DoNotOptimize(bsearch(&key, values.data(), values.size(),
+                                       sizeof(T), Ops<T>::compare));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+#define RANGE RangeMultiplier(8)->Range(64, 1 << 20)
+
+#define REGISTER_FOR_TYPES(bm)            \
+  BENCHMARK_TEMPLATE(bm, int32_t)->RANGE; \
+  BENCHMARK_TEMPLATE(bm, Record)->RANGE
+
+REGISTER_FOR_TYPES(BM_ArrayLike_Sort);
+REGISTER_FOR_TYPES(BM_Qsort);
+REGISTER_FOR_TYPES(BM_StdSort);
+
+REGISTER_FOR_TYPES(BM_ArrayLike_LowerBound);
+REGISTER_FOR_TYPES(BM_Bsearch);
+
+}  // namespace
@@ -0,0 +1,208 @@
+#include "c-data-structures/arraylike_sort.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+namespace {
+
+#define INT_LESS(a, b) (*(a) < *(b))
+
+DEFINE_ARRAYLIKE(IntArray, int);
+DEFINE_ARRAYLIKE_SORT(IntArray, int);
+IMPL_ARRAYLIKE(IntArray, int);
+IMPL_ARRAYLIKE_SORT(IntArray, int, INT_LESS);
+
+/* Records ordered by key only, to check ordering by a struct field */
+struct Record {
+  int key;
+  int payload;
+};
+
+#define RECORD_LESS(a, b) ((a)->key < (b)->key)
+
+DEFINE_ARRAYLIKE(RecordArray, Record);
+DEFINE_ARRAYLIKE_SORT(RecordArray, Record);
+IMPL_ARRAYLIKE(RecordArray, Record);
+IMPL_ARRAYLIKE_SORT(RecordArray, Record, RECORD_LESS);
+
+DEFINE_COW_ARRAYLIKE(CowIntArray, int);
+DEFINE_ARRAYLIKE_SORT(CowIntArray, int);
+IMPL_COW_ARRAYLIKE(CowIntArray, int);
+IMPL_ARRAYLIKE_SORT(CowIntArray, int, INT_LESS);
+
+/* Test fixture to ensure proper setup / teardown */
+class IntArraySortTest : public ::testing::Test {
+ protected:
+  IntArray array{};
+
+  void SetUp() override { ASSERT_TRUE(IntArray_init(&array)); }
+
+  void TearDown() override { IntArray_finalize(&array); }
+
+  void Fill(const std::vector<int>& values) {
+    for (int value : values) {
+      IntArray_push_back(&array, value);
+    }
+  }
+
+  std::vector<int> Contents() {
+    return std::vector<int>(array.table, array.table + array.size);
+  }
+
+  /* Sorts `values` with both IntArray_sort and std::sort and compares. */
+  void ExpectSortsLikeStd(std::vector<int> values) {
+    IntArray_clear(&array);
+    Fill(values);
+    IntArray_sort(&array);
+    std::sort(values.begin(), values.end());
+    EXPECT_EQ(Contents(), values);
+  }
+};
+
+/* -------------------------------------------------------------
+ * Sorting
+ * ------------------------------------------------------------- */
+
+TEST_F(IntArraySortTest, SortsEmptyAndSingleton) {
+  IntArray_sort(&array);
+  EXPECT_TRUE(IntArray_is_empty(&array));
+
+  IntArray_push_back(&array, 3);
+  IntArray_sort(&array);
+  EXPECT_EQ(IntArray_get_unchecked(&array, 0), 3);
+}
+
+TEST_F(IntArraySortTest, SortsRandomInput) {
+  std::mt19937 rng(42);
+  for (size_t n : {5u, 16u, 17u, 100u, 1000u, 100000u}) {
+    std::vector<int> values(n);
+    for (int& value : values) {
+      value = (int)rng();
+    }
+    ExpectSortsLikeStd(values);
+  }
+}
+
+TEST_F(IntArraySortTest, SortsAdversarialInput) {
+  const int kCount = 10000;
+  std::vector<int> ascending(kCount), descending(kCount), few(kCount),
+      organ_pipe(kCount);
+  for (int i = 0; i < kCount; ++i) {
+    ascending[i] = i;
+    descending[i] = kCount - i;
+    few[i] = i % 3;
+    organ_pipe[i] = i < kCount / 2 ? i : kCount - i;
+  }
+  ExpectSortsLikeStd(ascending);
+  ExpectSortsLikeStd(descending);
+  ExpectSortsLikeStd(few);
+  ExpectSortsLikeStd(organ_pipe);
+  ExpectSortsLikeStd(std::vector<int>(kCount, 7));
+}
+
+TEST_F(IntArraySortTest, HeapSortFallback) {
+  std::mt19937 rng(7);
+  std::vector<int> values(1000);
+  for (int& value : values) {
+    value = (int)(rng() % 100);
+  }
+  Fill(values);
+  /* Depth 0 sends the whole range straight to heapsort. */
+  IntArray_introsort(array.table, array.size, 0);
+  std::sort(values.begin(), values.end());
+  EXPECT_EQ(Contents(), values);
+}
+
+TEST_F(IntArraySortTest, SortRange) {
+  Fill({9, 8, 7, 6, 5, 4, 3, 2, 1, 0});
+  EXPECT_TRUE(IntArray_sort_range(&array, 2, 6));
+  EXPECT_EQ(Contents(), (std::vector<int>{9, 8, 4, 5, 6, 7, 3, 2, 1, 0}));
+
+  EXPECT_FALSE(IntArray_sort_range(&array, -1, 2));
+  EXPECT_FALSE(IntArray_sort_range(&array, 3, 2));
+  EXPECT_FALSE(IntArray_sort_range(&array, 0, 11));
+}
+
+TEST(RecordArraySortTest, SortsByStructField) {
+  RecordArray records{};
+  ASSERT_TRUE(RecordArray_init(&records));
+  for (int i = 0; i < 100; ++i) {
+    RecordArray_push_back(&records, Record{(i * 37) % 100, i});
+  }
+  RecordArray_sort(&records);
+  for (int i = 0; i < 100; ++i) {
+    const Record* record = RecordArray_get_ref_unchecked(&records, i);
+    EXPECT_EQ(record->key, i);
+    EXPECT_EQ((record->payload * 37) % 100, i);
+  }
+  RecordArray_finalize(&records);
+}
+
+TEST(CowIntArraySortTest, SortDetachesSharedTable) {
+  CowIntArray* array = CowIntArray_create();
+  for (int value : {5, 4, 3, 2, 1}) {
+    CowIntArray_push_back(array, value);
+  }
+  CowIntArray* snapshot = CowIntArray_share(array);
+  CowIntArray_sort(array);
+  EXPECT_FALSE(CowIntArray_is_shared(snapshot));
+  EXPECT_EQ(std::vector<int>(array->table, array->table + 5),
+            (std::vector<int>{1, 2, 3, 4, 5}));
+  EXPECT_EQ(std::vector<int>(snapshot->table, snapshot->table + 5),
+            (std::vector<int>{5, 4, 3, 2, 1}));
+
+  CowIntArray* range_snapshot = CowIntArray_share(snapshot);
+  EXPECT_TRUE(CowIntArray_sort_range(snapshot, 1, 4));
+  EXPECT_EQ(std::vector<int>(snapshot->table, snapshot->table + 5),
+            (std::vector<int>{5, 2, 3, 4, 1}));
+  EXPECT_EQ(std::vector<int>(range_snapshot->table, range_snapshot->table + 5),
+            (std::vector<int>{5, 4, 3, 2, 1}));
+
+  CowIntArray_delete(range_snapshot);
+  CowIntArray_delete(snapshot);
+  CowIntArray_delete(array);
+}
+
+/* -------------------------------------------------------------
+ * Binary search
+ * ------------------------------------------------------------- */
+
+TEST_F(IntArraySortTest, BoundsOnEmptyArray) {
+  const int key = 1;
+  EXPECT_EQ(IntArray_lower_bound(&array, &key), 0);
+  EXPECT_EQ(IntArray_upper_bound(&array, &key), 0);
+  EXPECT_FALSE(IntArray_bsearch(&array, &key, nullptr));
+}
+
+TEST_F(IntArraySortTest, LowerAndUpperBound) {
+  Fill({1, 3, 3, 3, 5, 7});
+  const int keys[] = {0, 1, 2, 3, 4, 7, 8};
+  const int lower[] = {0, 0, 1, 1, 4, 5, 6};
+  const int upper[] = {0, 1, 1, 4, 4, 6, 6};
+  for (int i = 0; i < 7; ++i) {
+    EXPECT_EQ(IntArray_lower_bound(&array, &keys[i]), lower[i]) << keys[i];
+    EXPECT_EQ(IntArray_upper_bound(&array, &keys[i]), upper[i]) << keys[i];
+  }
+}
+
+TEST_F(IntArraySortTest, BsearchFindsPresentKeys) {
+  for (int i = 0; i < 100; ++i) {
+    IntArray_push_back(&array, 2 * i);
+  }
+  for (int key = -1; key < 201; ++key) {
+    int32_t index = -1;
+    bool found = IntArray_bsearch(&array, &key, &index);
+    if (key >= 0 && key < 200 && key % 2 == 0) {
+      EXPECT_TRUE(found) << key;
+      EXPECT_EQ(index, key / 2);
+    } else {
+      EXPECT_FALSE(found) << key;
+      EXPECT_EQ(index, -1);
+    }
+  }
+}
+
+}  // namespace
\ No newline at end of file
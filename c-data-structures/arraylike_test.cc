@@ -7,6 +7,49 @@ namespace {
 DEFINE_ARRAYLIKE(IntArray, int);
 IMPL_ARRAYLIKE(IntArray, int);
 
+/* Same element type, but with the fixed-chunk growth policy */
+DEFINE_ARRAYLIKE(LinearIntArray, int);
+IMPL_ARRAYLIKE_WITH_GROWTH(LinearIntArray, int, ARRAYLIKE_GROWTH_LINEAR);
+
+/* Allocator that forwards to malloc and tracks outstanding bytes */
+struct CountingAllocator {
+  size_t allocations = 0;
+  size_t frees = 0;
+  size_t live_bytes = 0;
+};
+
+void* CountingAllocate(void* ctx, size_t size) {
+  auto* counts = static_cast<CountingAllocator*>(ctx);
+  counts->allocations++;
+  counts->live_bytes += size;
+  return malloc(size);
+}
+
+void* CountingReallocate(void* ctx, void* ptr, size_t old_size,
+                         size_t new_size) {
+  auto* counts = static_cast<CountingAllocator*>(ctx);
+  counts->live_bytes += new_size - old_size;
+  return realloc(ptr, new_size);
+}
+
+void CountingDeallocate(void* ctx, void* ptr, size_t size) {
+  auto* counts = static_cast<CountingAllocator*>(ctx);
+  counts->frees++;
+  counts->live_bytes -= size;
+  free(ptr);
+}
+
+DEFINE_ARRAYLIKE_WITH_ALLOC(AllocIntArray, int);
+IMPL_ARRAYLIKE_WITH_ALLOC(AllocIntArray, int, allocator_default());
+
+/* Keeps up to four elements inside the struct */
+DEFINE_SMALL_ARRAYLIKE(SmallIntArray, int, 4);
+IMPL_SMALL_ARRAYLIKE(SmallIntArray, int);
+
+/* Shares tables copy-on-write */
+DEFINE_COW_ARRAYLIKE(CowIntArray, int);
+IMPL_COW_ARRAYLIKE(CowIntArray, int);
+
 /* Test fixture to ensure proper setup / teardown */
 class IntArrayTest : public ::testing::Test {
  protected:
@@ -39,6 +82,348 @@ TEST(IntArrayStandaloneTest, InitWithZeroCapacityFails) {
   EXPECT_FALSE(IntArray_init_capacity(&arr, 0));
 }
 
+TEST(IntArrayStandaloneTest, CreateCopyOfEmptyInputHasATable) {
+  const int input[1] = {0};
+  IntArray* arr = IntArray_create_copy(input, 0);
+  EXPECT_TRUE(IntArray_is_empty(arr));
+  EXPECT_EQ(arr->capacity, (size_t)DEFAULT_TABLE_SIZE);
+  IntArray_push_back(arr, 1);
+  EXPECT_EQ(IntArray_last_unchecked(arr), 1);
+  IntArray_delete(arr);
+}
+
+/* -------------------------------------------------------------
+ * Capacity management
+ * ------------------------------------------------------------- */
+
+TEST_F(IntArrayTest, GeometricGrowthReallocatesLogarithmically) {
+  const int kCount = 1 << 16;
+  size_t last_capacity = array.capacity;
+  int reallocs = 0;
+  for (int i = 0; i < kCount; ++i) {
+    IntArray_push_back(&array, i);
+    if (array.capacity != last_capacity) {
+      ++reallocs;
+      last_capacity = array.capacity;
+    }
+  }
+  /* DEFAULT_TABLE_SIZE (2^3) doubled up to 2^16. */
+  EXPECT_LE(reallocs, 13);
+  EXPECT_GE(array.capacity, static_cast<size_t>(kCount));
+  EXPECT_LT(array.capacity, 2u * kCount);
+  for (int i = 0; i < kCount; ++i) {
+    EXPECT_EQ(IntArray_get_unchecked(&array, i), i);
+  }
+}
+
+TEST(LinearIntArrayTest, LinearGrowthUsesFixedChunks) {
+  LinearIntArray arr{};
+  ASSERT_TRUE(LinearIntArray_init(&arr));
+  int reallocs = 0;
+  size_t last_capacity = arr.capacity;
+  for (int i = 0; i < 64; ++i) {
+    LinearIntArray_push_back(&arr, i);
+    if (arr.capacity != last_capacity) {
+      ++reallocs;
+      last_capacity = arr.capacity;
+    }
+  }
+  EXPECT_EQ(reallocs, 7);
+  EXPECT_EQ(arr.capacity, 64u);
+  LinearIntArray_finalize(&arr);
+}
+
+TEST_F(IntArrayTest, ReserveAllocatesExactly) {
+  IntArray_reserve(&array, 1000);
+  EXPECT_EQ(array.capacity, 1000u);
+
+  int* table = array.table;
+  for (int i = 0; i < 1000; ++i) {
+    IntArray_push_back(&array, i);
+  }
+  EXPECT_EQ(array.table, table);
+  EXPECT_EQ(array.capacity, 1000u);
+}
+
+TEST_F(IntArrayTest, ReserveNeverShrinks) {
+  IntArray_reserve(&array, 100);
+  IntArray_reserve(&array, 10);
+  EXPECT_EQ(array.capacity, 100u);
+}
+
+TEST_F(IntArrayTest, ShrinkToFit) {
+  for (int i = 0; i < 100; ++i) {
+    IntArray_push_back(&array, i);
+  }
+  EXPECT_TRUE(IntArray_rshrink(&array, 60));
+  IntArray_shrink_to_fit(&array);
+  EXPECT_EQ(array.capacity, 40u);
+  EXPECT_EQ(IntArray_size(&array), 40u);
+  EXPECT_EQ(IntArray_last_unchecked(&array), 39);
+
+  IntArray_push_back(&array, 40);
+  EXPECT_EQ(IntArray_last_unchecked(&array), 40);
+}
+
+TEST_F(IntArrayTest, ShrinkToFitEmptyKeepsUsableTable) {
+  IntArray_reserve(&array, 100);
+  IntArray_shrink_to_fit(&array);
+  EXPECT_EQ(array.capacity, 1u);
+  IntArray_push_back(&array, 7);
+  IntArray_push_back(&array, 8);
+  EXPECT_EQ(IntArray_get_unchecked(&array, 1), 8);
+}
+
+/* -------------------------------------------------------------
+ * Allocator hooks
+ * ------------------------------------------------------------- */
+
+TEST(AllocIntArrayTest, RoutesTableThroughAllocator) {
+  CountingAllocator counts;
+  const Allocator allocator = {CountingAllocate, CountingReallocate,
+                               CountingDeallocate, &counts};
+
+  AllocIntArray arr{};
+  ASSERT_TRUE(AllocIntArray_init_allocator(&arr, &allocator, 4));
+  EXPECT_EQ(counts.allocations, 1u);
+  for (int i = 0; i < 100; ++i) {
+    AllocIntArray_push_back(&arr, i);
+  }
+  EXPECT_EQ(counts.live_bytes, arr.capacity * sizeof(int));
+
+  AllocIntArray* copy = AllocIntArray_copy(&arr);
+  EXPECT_EQ(copy->allocator, &allocator);
+  EXPECT_EQ(counts.allocations, 2u);
+  EXPECT_EQ(AllocIntArray_get_unchecked(copy, 99), 99);
+  AllocIntArray_delete(copy);
+
+  AllocIntArray_finalize(&arr);
+  EXPECT_EQ(counts.frees, 2u);
+  EXPECT_EQ(counts.live_bytes, 0u);
+}
+
+TEST(AllocIntArrayTest, InitUsesDefaultAllocator) {
+  AllocIntArray arr{};
+  ASSERT_TRUE(AllocIntArray_init(&arr));
+  EXPECT_EQ(arr.allocator, allocator_default());
+  AllocIntArray_push_back(&arr, 1);
+  EXPECT_EQ(AllocIntArray_last_unchecked(&arr), 1);
+  AllocIntArray_finalize(&arr);
+}
+
+/* -------------------------------------------------------------
+ * Small arrays with inline storage
+ * ------------------------------------------------------------- */
+
+TEST(SmallIntArrayTest, StaysInlineUpToInlineCapacity) {
+  SmallIntArray arr;
+  ASSERT_TRUE(SmallIntArray_init(&arr));
+  EXPECT_EQ(arr.capacity, 4u);
+  for (int i = 0; i < 4; ++i) {
+    SmallIntArray_push_back(&arr, i);
+  }
+  EXPECT_EQ(arr.table, arr._inline);
+  EXPECT_EQ(SmallIntArray_get_unchecked(&arr, 3), 3);
+  SmallIntArray_finalize(&arr);
+}
+
+TEST(SmallIntArrayTest, SpillsToHeapAndShrinksBack) {
+  SmallIntArray arr;
+  SmallIntArray_init(&arr);
+  for (int i = 0; i < 100; ++i) {
+    SmallIntArray_push_back(&arr, i);
+  }
+  EXPECT_NE(arr.table, arr._inline);
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_EQ(SmallIntArray_get_unchecked(&arr, i), i);
+  }
+
+  SmallIntArray_rshrink(&arr, 97);
+  SmallIntArray_shrink_to_fit(&arr);
+  EXPECT_EQ(arr.table, arr._inline);
+  EXPECT_EQ(arr.capacity, 3u);
+  EXPECT_EQ(SmallIntArray_get_unchecked(&arr, 2), 2);
+
+  /* Growing again from a shrunken inline table */
+  SmallIntArray_push_back(&arr, 3);
+  SmallIntArray_push_back(&arr, 4);
+  EXPECT_NE(arr.table, arr._inline);
+  EXPECT_EQ(SmallIntArray_last_unchecked(&arr), 4);
+  SmallIntArray_finalize(&arr);
+}
+
+TEST(SmallIntArrayTest, InitCapacityBeyondInlineAllocates) {
+  SmallIntArray arr;
+  ASSERT_TRUE(SmallIntArray_init_capacity(&arr, 16));
+  EXPECT_NE(arr.table, arr._inline);
+  SmallIntArray_push_back(&arr, 7);
+  EXPECT_EQ(SmallIntArray_get_unchecked(&arr, 0), 7);
+  SmallIntArray_finalize(&arr);
+}
+
+TEST(SmallIntArrayTest, CreateAndCopyUseTheirOwnInlineStorage) {
+  SmallIntArray* arr = SmallIntArray_create();
+  SmallIntArray_push_back(arr, 1);
+  SmallIntArray_push_back(arr, 2);
+  EXPECT_EQ(arr->table, arr->_inline);
+
+  SmallIntArray* copy = SmallIntArray_copy(arr);
+  EXPECT_EQ(copy->table, copy->_inline);
+  SmallIntArray_set(copy, 0, 10);
+  EXPECT_EQ(SmallIntArray_get_unchecked(arr, 0), 1);
+  EXPECT_EQ(SmallIntArray_get_unchecked(copy, 1), 2);
+
+  SmallIntArray_delete(copy);
+  SmallIntArray_delete(arr);
+}
+
+TEST(SmallIntArrayTest, RangeOperationsAcrossTheInlineBoundary) {
+  SmallIntArray arr;
+  SmallIntArray_init(&arr);
+  const int elts[] = {1, 2, 3, 4, 5, 6};
+  SmallIntArray_push_back(&arr, 0);
+  SmallIntArray_push_back(&arr, 7);
+  ASSERT_TRUE(SmallIntArray_insert_range(&arr, 1, elts, 6));
+  ASSERT_EQ(SmallIntArray_size(&arr), 8u);
+  for (int i = 0; i < 8; ++i) {
+    EXPECT_EQ(SmallIntArray_get_unchecked(&arr, i), i);
+  }
+  ASSERT_TRUE(SmallIntArray_erase_range(&arr, 2, 8));
+  EXPECT_EQ(SmallIntArray_size(&arr), 2u);
+  SmallIntArray_push_front(&arr, -1);
+  EXPECT_EQ(SmallIntArray_get_unchecked(&arr, 0), -1);
+  SmallIntArray_finalize(&arr);
+}
+
+/* -------------------------------------------------------------
+ * Copy-on-write sharing
+ * ------------------------------------------------------------- */
+
+CowIntArray* CreateCowRange(int n) {
+  CowIntArray* arr = CowIntArray_create();
+  for (int i = 0; i < n; ++i) {
+    CowIntArray_push_back(arr, i);
+  }
+  return arr;
+}
+
+TEST(CowIntArrayTest, ShareReusesTheTable) {
+  CowIntArray* arr = CreateCowRange(10);
+  EXPECT_FALSE(CowIntArray_is_shared(arr));
+  CowIntArray* share = CowIntArray_share(arr);
+  EXPECT_EQ(share->table, arr->table);
+  EXPECT_EQ(CowIntArray_size(share), 10u);
+  EXPECT_TRUE(CowIntArray_is_shared(arr));
+  EXPECT_TRUE(CowIntArray_is_shared(share));
+
+  /* Reads and pop_back do not detach. */
+  const int* ref;
+  ASSERT_TRUE(CowIntArray_get_ref(share, 9, &ref));
+  EXPECT_EQ(*ref, 9);
+  EXPECT_EQ(CowIntArray_pop_back_unchecked(share), 9);
+  EXPECT_EQ(share->table, arr->table);
+  EXPECT_EQ(CowIntArray_size(arr), 10u);
+
+  CowIntArray_delete(arr);
+  EXPECT_FALSE(CowIntArray_is_shared(share));
+  EXPECT_EQ(CowIntArray_last_unchecked(share), 8);
+  CowIntArray_delete(share);
+}
+
+TEST(CowIntArrayTest, WritesDetach) {
+  CowIntArray* arr = CreateCowRange(10);
+  CowIntArray* set = CowIntArray_share(arr);
+  CowIntArray* pushed = CowIntArray_share(arr);
+  CowIntArray* removed = CowIntArray_share(arr);
+  CowIntArray* mutated = CowIntArray_share(arr);
+
+  CowIntArray_set(set, 0, 100);
+  CowIntArray_push_back(pushed, 10);
+  int value;
+  CowIntArray_remove(removed, 0, &value);
+  int* ptr;
+  ASSERT_TRUE(CowIntArray_mutable_ref(mutated, 5, &ptr));
+  *ptr = 500;
+
+  for (CowIntArray* detached : {set, pushed, removed, mutated}) {
+    EXPECT_NE(detached->table, arr->table);
+    EXPECT_FALSE(CowIntArray_is_shared(detached));
+  }
+  EXPECT_FALSE(CowIntArray_is_shared(arr));
+  for (int i = 0; i < 10; ++i) {
+    EXPECT_EQ(CowIntArray_get_unchecked(arr, i), i);
+  }
+  EXPECT_EQ(CowIntArray_size(arr), 10u);
+  EXPECT_EQ(CowIntArray_get_unchecked(set, 0), 100);
+  EXPECT_EQ(CowIntArray_get_unchecked(set, 1), 1);
+  EXPECT_EQ(CowIntArray_size(pushed), 11u);
+  EXPECT_EQ(CowIntArray_last_unchecked(pushed), 10);
+  EXPECT_EQ(CowIntArray_get_unchecked(removed, 0), 1);
+  EXPECT_EQ(CowIntArray_get_unchecked(mutated, 5), 500);
+
+  for (CowIntArray* detached : {set, pushed, removed, mutated, arr}) {
+    CowIntArray_delete(detached);
+  }
+}
+
+TEST(CowIntArrayTest, MakeUniqueDetaches) {
+  CowIntArray* arr = CreateCowRange(10);
+  const int* table = arr->table;
+  CowIntArray_make_unique(arr);
+  EXPECT_EQ(arr->table, table);
+
+  CowIntArray* share = CowIntArray_share(arr);
+  CowIntArray_make_unique(share);
+  EXPECT_NE(share->table, arr->table);
+  EXPECT_FALSE(CowIntArray_is_shared(arr));
+  EXPECT_FALSE(CowIntArray_is_shared(share));
+  for (int i = 0; i < 10; ++i) {
+    EXPECT_EQ(CowIntArray_get_unchecked(share, i), i);
+  }
+
+  CowIntArray_delete(share);
+  CowIntArray_delete(arr);
+}
+
+TEST(CowIntArrayTest, GrowingASharedTableLeavesItIntact) {
+  CowIntArray* arr = CreateCowRange(8);
+  ASSERT_EQ(arr->capacity, 8u);
+  CowIntArray* share = CowIntArray_share(arr);
+  for (int i = 8; i < 100; ++i) {
+    CowIntArray_push_back(share, i);
+  }
+  EXPECT_FALSE(CowIntArray_is_shared(arr));
+  EXPECT_EQ(CowIntArray_size(arr), 8u);
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_EQ(CowIntArray_get_unchecked(share, i), i);
+  }
+
+  CowIntArray* again = CowIntArray_share(share);
+  CowIntArray_shrink_to_fit(again);
+  EXPECT_EQ(again->capacity, 100u);
+  EXPECT_NE(again->table, share->table);
+  EXPECT_EQ(CowIntArray_last_unchecked(again), 99);
+
+  CowIntArray_delete(again);
+  CowIntArray_delete(share);
+  CowIntArray_delete(arr);
+}
+
+TEST(CowIntArrayTest, DetachedTableStartsAfterTheSharedSize) {
+  CowIntArray* arr = CreateCowRange(6);
+  CowIntArray* share = CowIntArray_share(arr);
+  CowIntArray_rshrink(share, 3);
+  CowIntArray_push_front(share, -1);
+  CowIntArray_erase_range(arr, 0, 1);
+  EXPECT_EQ(CowIntArray_size(share), 4u);
+  EXPECT_EQ(CowIntArray_get_unchecked(share, 0), -1);
+  EXPECT_EQ(CowIntArray_last_unchecked(share), 2);
+  EXPECT_EQ(CowIntArray_get_unchecked(arr, 0), 1);
+  EXPECT_EQ(CowIntArray_last_unchecked(arr), 5);
+  CowIntArray_delete(share);
+  CowIntArray_delete(arr);
+}
+
 /* -------------------------------------------------------------
  * Push / Pop Back
  * ------------------------------------------------------------- */
@@ -186,6 +571,111 @@ TEST_F(IntArrayTest, RemoveInvalidIndexFails) {
   EXPECT_FALSE(IntArray_remove(&array, 0, &removed));
 }
 
+/* -------------------------------------------------------------
+ * Range operations
+ * ------------------------------------------------------------- */
+
+TEST_F(IntArrayTest, InsertRangeInMiddle) {
+  for (int i = 0; i < 4; ++i) {
+    IntArray_push_back(&array, i);
+  }
+  const int values[] = {10, 11, 12};
+  EXPECT_TRUE(IntArray_insert_range(&array, 2, values, 3));
+
+  const int expected[] = {0, 1, 10, 11, 12, 2, 3};
+  ASSERT_EQ(IntArray_size(&array), 7u);
+  for (int i = 0; i < 7; ++i) {
+    EXPECT_EQ(IntArray_get_unchecked(&array, i), expected[i]);
+  }
+}
+
+TEST_F(IntArrayTest, InsertRangeAtEndsAndGrows) {
+  int values[100];
+  for (int i = 0; i < 100; ++i) {
+    values[i] = i;
+  }
+  EXPECT_TRUE(IntArray_insert_range(&array, 0, values + 50, 50));
+  EXPECT_TRUE(IntArray_insert_range(&array, 0, values, 50));
+  EXPECT_TRUE(IntArray_insert_range(&array, 100, values, 0));
+  ASSERT_EQ(IntArray_size(&array), 100u);
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_EQ(IntArray_get_unchecked(&array, i), i);
+  }
+}
+
+TEST_F(IntArrayTest, InsertRangeInvalidIndexFails) {
+  const int value = 1;
+  EXPECT_FALSE(IntArray_insert_range(&array, -1, &value, 1));
+  EXPECT_FALSE(IntArray_insert_range(&array, 1, &value, 1));
+  EXPECT_TRUE(IntArray_is_empty(&array));
+}
+
+TEST_F(IntArrayTest, EraseRange) {
+  for (int i = 0; i < 6; ++i) {
+    IntArray_push_back(&array, i);
+  }
+  EXPECT_TRUE(IntArray_erase_range(&array, 1, 4));
+  ASSERT_EQ(IntArray_size(&array), 3u);
+  EXPECT_EQ(IntArray_get_unchecked(&array, 0), 0);
+  EXPECT_EQ(IntArray_get_unchecked(&array, 1), 4);
+  EXPECT_EQ(IntArray_get_unchecked(&array, 2), 5);
+
+  EXPECT_TRUE(IntArray_erase_range(&array, 1, 1));
+  EXPECT_TRUE(IntArray_erase_range(&array, 0, 3));
+  EXPECT_TRUE(IntArray_is_empty(&array));
+}
+
+TEST_F(IntArrayTest, EraseRangeInvalidFails) {
+  IntArray_push_back(&array, 1);
+  EXPECT_FALSE(IntArray_erase_range(&array, -1, 1));
+  EXPECT_FALSE(IntArray_erase_range(&array, 1, 0));
+  EXPECT_FALSE(IntArray_erase_range(&array, 0, 2));
+  EXPECT_EQ(IntArray_size(&array), 1u);
+}
+
+TEST_F(IntArrayTest, PushBackN) {
+  IntArray_push_back(&array, 7);
+  int* slots = IntArray_push_back_n(&array, 20);
+  ASSERT_NE(slots, nullptr);
+  for (int i = 0; i < 20; ++i) {
+    slots[i] = i;
+  }
+  ASSERT_EQ(IntArray_size(&array), 21u);
+  EXPECT_EQ(IntArray_get_unchecked(&array, 0), 7);
+  EXPECT_EQ(IntArray_last_unchecked(&array), 19);
+}
+
+bool IsEven(const int* value, void*) { return *value % 2 == 0; }
+
+bool LessThan(const int* value, void* ctx) {
+  return *value < *static_cast<int*>(ctx);
+}
+
+TEST_F(IntArrayTest, RetainIfKeepsOrder) {
+  for (int i = 0; i < 10; ++i) {
+    IntArray_push_back(&array, i);
+  }
+  EXPECT_EQ(IntArray_retain_if(&array, IsEven, nullptr), 5u);
+  ASSERT_EQ(IntArray_size(&array), 5u);
+  for (int i = 0; i < 5; ++i) {
+    EXPECT_EQ(IntArray_get_unchecked(&array, i), 2 * i);
+  }
+}
+
+TEST_F(IntArrayTest, RetainIfPassesContext) {
+  for (int i = 0; i < 10; ++i) {
+    IntArray_push_back(&array, i);
+  }
+  int limit = 3;
+  EXPECT_EQ(IntArray_retain_if(&array, LessThan, &limit), 7u);
+  EXPECT_EQ(IntArray_size(&array), 3u);
+  EXPECT_EQ(IntArray_last_unchecked(&array), 2);
+
+  limit = 0;
+  EXPECT_EQ(IntArray_retain_if(&array, LessThan, &limit), 3u);
+  EXPECT_TRUE(IntArray_is_empty(&array));
+}
+
 /* -------------------------------------------------------------
  * Shrinking
  * ------------------------------------------------------------- */
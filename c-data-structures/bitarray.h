@@ -0,0 +1,620 @@
+#ifndef C_DATA_STRUCTURES_BITARRAY_H_
+#define C_DATA_STRUCTURES_BITARRAY_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "c-data-structures/container_stats.h"
+
+/**
+ * @file bitarray.h
+ *
+ * @brief Packed array of booleans, one bit per element.
+ *
+ * DEFINE_ARRAYLIKE(BoolArray, bool) spends a byte per element and counts set
+ * elements one at a time. DEFINE_BITARRAY and IMPL_BITARRAY generate a
+ * container with the arraylike push_back / pop_back / get / set / iterate
+ * API that packs elements into 64-bit words, plus whole-word operations:
+ *  - `name##_count` counts set bits with the CPU's popcount instruction when
+ *    it has one (chosen at runtime on x86)
+ *  - `name##_and`, `name##_or` and `name##_xor` combine two arrays a word at
+ *    a time
+ *  - `name##_next_set` skips to the next set bit, a word at a time
+ *  - `name##_rank` and `name##_select` convert between positions and set-bit
+ *    counts
+ *
+ * Rank and select scan the words up to the answer, which is O(n). Calling
+ * `name##_build_rank` adds a directory with the number of set bits before
+ * every BITARRAY_RANK_BLOCK_WORDS-word block, which makes rank O(1) and
+ * select O(log n). The directory costs 64 bits per block (1/8 of the array
+ * at the default block size). Any modification of the bits discards it; call
+ * `name##_build_rank` again after a batch of updates.
+ *
+ * Memory management and error handling follow arraylike.h: `words` grows
+ * geometrically, shrinking only reduces the size until
+ * `name##_shrink_to_fit`, `bool` results report invalid indices, and
+ * allocation failures are guarded with `assert`. Bits past `size` are always
+ * zero.
+ *
+ * Usage pattern:
+ *
+ *   // In a header or source file:
+ *   DEFINE_BITARRAY(Mask);
+ *
+ *   // In exactly one source file:
+ *   IMPL_BITARRAY(Mask);
+ *
+ *   // Use as:
+ *   Mask mask;
+ *   Mask_init(&mask);
+ *   Mask_resize(&mask, 1000);
+ *   Mask_set(&mask, 42, true);
+ *   size_t hits = Mask_count(&mask);
+ */
+
+/** Words per rank directory entry. Must be a power of two. */
+#ifndef BITARRAY_RANK_BLOCK_WORDS
+#define BITARRAY_RANK_BLOCK_WORDS 8
+#endif
+
+/** Initial capacity, in words, of arrays created with `name##_init`. */
+#define BITARRAY_DEFAULT_WORDS 1
+
+static inline size_t bitarray_words_for(size_t bits) {
+  return (bits + 63) / 64;
+}
+
+/* Mask of the bits of the last word that are in use for `bits` bits. */
+static inline uint64_t bitarray_tail_mask(size_t bits) {
+  return (bits & 63) == 0 ? ~(uint64_t)0 : ((uint64_t)1 << (bits & 63)) - 1;
+}
+
+/** Position of the `k`-th (0-based) set bit of `word`, which must have more
+ * than `k` set bits. */
+static inline uint32_t bitarray_select_word(uint64_t word, size_t k) {
+  for (; k > 0; --k) {
+    word &= word - 1;
+  }
+  return (uint32_t)__builtin_ctzll(word);
+}
+
+/**
+ * Population count of `n` words.
+ *
+ * Without compiler flags for a popcount instruction, __builtin_popcountll
+ * compiles to a bit-twiddling sequence. On x86 the loop is therefore also
+ * compiled with `target("popcnt")` and chosen at runtime when the CPU
+ * supports it.
+ */
+static inline size_t bitarray_popcount_generic(const uint64_t *words,
+                                               size_t n) {
+  size_t count = 0;
+  for (size_t i = 0; i < n; ++i) {
+    count += (size_t)__builtin_popcountll(words[i]);
+  }
+  return count;
+}
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+__attribute__((target("popcnt"))) static inline size_t bitarray_popcount_hw(
+    const uint64_t *words, size_t n) {
+  size_t count = 0;
+  for (size_t i = 0; i < n; ++i) {
+    count += (size_t)__builtin_popcountll(words[i]);
+  }
+  return count;
+}
+
+static inline bool bitarray_has_popcnt(void) {
+  static int has = -1;
+  int cached = __atomic_load_n(&has, __ATOMIC_RELAXED);
+  if (cached < 0) {
+    __builtin_cpu_init();
+    cached = __builtin_cpu_supports("popcnt") ? 1 : 0;
+    __atomic_store_n(&has, cached, __ATOMIC_RELAXED);
+  }
+  return cached != 0;
+}
+
+static inline size_t bitarray_popcount(const uint64_t *words, size_t n) {
+  return bitarray_has_popcnt() ? bitarray_popcount_hw(words, n)
+                               : bitarray_popcount_generic(words, n);
+}
+#else
+static inline size_t bitarray_popcount(const uint64_t *words, size_t n) {
+  return bitarray_popcount_generic(words, n);
+}
+#endif
+
+/**
+ * @macro DEFINE_BITARRAY
+ *
+ * @brief Declares a bit array type and its public API.
+ *
+ * @param name  Base name for the generated type and functions
+ */
+#define DEFINE_BITARRAY(name)                                          \
+                                                                       \
+  /**                                                                  \
+   * Bit array structure.                                              \
+   *                                                                   \
+   * - `size` is the number of bits                                    \
+   * - `capacity` is the allocated length of `words`, in words         \
+   * - bit i is bit (i % 64) of `words[i / 64]`                        \
+   * - `rank` holds the set bits before each block when `rank_valid`   \
+   */                                                                  \
+  typedef struct {                                                     \
+    size_t size;                                                       \
+    size_t capacity;                                                   \
+    uint64_t *words;                                                   \
+    uint64_t *rank;                                                    \
+    size_t rank_capacity;                                              \
+    bool rank_valid;                                                   \
+    CONTAINER_STATS_FIELD                                              \
+  } name;                                                              \
+                                                                       \
+  /**                                                                  \
+   * Forward iterator over the bits, valid until the array is resized. \
+   */                                                                  \
+  typedef struct {                                                     \
+    int32_t index;                                                     \
+    name *array;                                                       \
+  } name##Iterator;                                                    \
+                                                                       \
+  /* Initialization and lifetime management */                         \
+  bool name##_init_capacity(name *, size_t bits);                      \
+  bool name##_init(name *);                                            \
+                                                                       \
+  name *name##_create();                                               \
+  name *name##_create_capacity(size_t bits);                           \
+                                                                       \
+  void name##_finalize(name *);                                        \
+  void name##_delete(name *);                                          \
+  void name##_clear(name *const);                                      \
+                                                                       \
+  /* Capacity management */                                            \
+  void name##_reserve(name *const, size_t bits);                       \
+  void name##_shrink_to_fit(name *const);                              \
+  /* Sets the size to `bits`; new bits are 0. */                       \
+  void name##_resize(name *const, size_t bits);                        \
+                                                                       \
+  /* Back operations */                                                \
+  void name##_push_back(name *const, bool);                            \
+  bool name##_pop_back(name *const, bool *ptr);                        \
+  bool name##_pop_back_unchecked(name *const);                         \
+                                                                       \
+  /* Random access */                                                  \
+  bool name##_set(name *const, int32_t index, bool);                   \
+  bool name##_get(const name *const, int32_t index, bool *ptr);        \
+  bool name##_get_unchecked(const name *const, int32_t index);         \
+                                                                       \
+  /* Size and state */                                                 \
+  size_t name##_size(const name *const);                               \
+  bool name##_is_empty(const name *const);                             \
+  ContainerStats name##_stats(const name *const);                      \
+                                                                       \
+  /* Whole-array operations */                                         \
+  size_t name##_count(const name *const);                              \
+  int32_t name##_next_set(const name *const, int32_t from);            \
+  void name##_and(name *const dst, const name *const src);             \
+  void name##_or(name *const dst, const name *const src);              \
+  void name##_xor(name *const dst, const name *const src);             \
+                                                                       \
+  /* Rank and select */                                                \
+  void name##_build_rank(name *const);                                 \
+  size_t name##_rank(const name *const, size_t index);                 \
+  int32_t name##_select(const name *const, size_t k);                  \
+                                                                       \
+  /* Iteration */                                                      \
+  void name##_iterator(name##Iterator *, name *const);                 \
+  bool name##_has_next(const name##Iterator *const);                   \
+  void name##_next(name##Iterator *);                                  \
+  bool name##_value(const name##Iterator *const)
+
+/**
+ * @macro IMPL_BITARRAY
+ *
+ * @brief Generates the implementation for a previously declared bit array.
+ *
+ * `name##_and`, `name##_or` and `name##_xor` store the result in `dst` and
+ * keep its size. Bits of `dst` past the end of `src` are combined with 0.
+ *
+ * `name##_rank(array, i)` returns the number of set bits before bit `i`
+ * (0 <= i <= size). `name##_select(array, k)` returns the index of the
+ * `k`-th (0-based) set bit, or -1 if there are at most `k` set bits.
+ *
+ * @param name  Base name used in DEFINE_BITARRAY
+ */
+#define IMPL_BITARRAY(name)                                                    \
+                                                                               \
+  static inline void name##_resize_words(name *const array,                    \
+                                         size_t new_capacity) {                \
+    array->words =                                                             \
+        (uint64_t *)realloc(array->words, new_capacity * sizeof(uint64_t));    \
+    assert(array->words != NULL);                                              \
+    if (new_capacity > array->capacity) {                                      \
+      memset(array->words + array->capacity, 0x0,                              \
+             (new_capacity - array->capacity) * sizeof(uint64_t));             \
+    }                                                                          \
+    array->capacity = new_capacity;                                            \
+    CONTAINER_STATS_ADD(array, reallocs, 1);                                   \
+    CONTAINER_STATS_MAX(array, peak_capacity, new_capacity * 64);              \
+  }                                                                            \
+                                                                               \
+  static inline void name##_ensure_bits(name *const array, size_t bits) {      \
+    CONTAINER_STATS_MAX(array, peak_size, bits);                               \
+    size_t needed = bitarray_words_for(bits);                                  \
+    if (needed <= array->capacity) {                                           \
+      return;                                                                  \
+    }                                                                          \
+    size_t new_capacity = array->capacity;                                     \
+    while (new_capacity < needed) {                                            \
+      new_capacity *= 2;                                                       \
+    }                                                                          \
+    name##_resize_words(array, new_capacity);                                  \
+  }                                                                            \
+                                                                               \
+  /* Zeroes bits [from, size) so that bits past a new, smaller size stay 0. */ \
+  static inline void name##_zero_from(name *const array, size_t from) {        \
+    size_t word = from / 64;                                                   \
+    size_t end = bitarray_words_for(array->size);                              \
+    if (word >= end) {                                                         \
+      return;                                                                  \
+    }                                                                          \
+    array->words[word] &= ((uint64_t)1 << (from % 64)) - 1;                    \
+    memset(array->words + word + 1, 0x0, (end - word - 1) * sizeof(uint64_t)); \
+  }                                                                            \
+                                                                               \
+  bool name##_init_capacity(name *array, size_t bits) {                        \
+    array->size = 0;                                                           \
+    array->capacity = bitarray_words_for(bits);                                \
+    if (array->capacity == 0) {                                                \
+      array->capacity = 1;                                                     \
+    }                                                                          \
+    array->words = (uint64_t *)calloc(array->capacity, sizeof(uint64_t));      \
+    assert(array->words != NULL);                                              \
+    array->rank = NULL;                                                        \
+    array->rank_capacity = 0;                                                  \
+    array->rank_valid = false;                                                 \
+    CONTAINER_STATS_REGISTER(array, #name);                                    \
+    CONTAINER_STATS_MAX(array, peak_capacity, array->capacity * 64);           \
+    return true;                                                               \
+  }                                                                            \
+                                                                               \
+  bool name##_init(name *array) {                                              \
+    return name##_init_capacity(array, BITARRAY_DEFAULT_WORDS * 64);           \
+  }                                                                            \
+                                                                               \
+  name *name##_create() {                                                      \
+    name *array = (name *)malloc(sizeof(name));                                \
+    assert(array != NULL);                                                     \
+    name##_init(array);                                                        \
+    return array;                                                              \
+  }                                                                            \
+                                                                               \
+  name *name##_create_capacity(size_t bits) {                                  \
+    name *array = (name *)malloc(sizeof(name));                                \
+    assert(array != NULL);                                                     \
+    name##_init_capacity(array, bits);                                         \
+    return array;                                                              \
+  }                                                                            \
+                                                                               \
+  void name##_finalize(name *array) {                                          \
+    assert(array != NULL);                                                     \
+    free(array->words);                                                        \
+    free(array->rank);                                                         \
+    CONTAINER_STATS_UNREGISTER(array);                                         \
+  }                                                                            \
+                                                                               \
+  void name##_delete(name *array) {                                            \
+    assert(array != NULL);                                                     \
+    name##_finalize(array);                                                    \
+    free(array);                                                               \
+  }                                                                            \
+                                                                               \
+  void name##_clear(name *const array) {                                       \
+    assert(array != NULL);                                                     \
+    memset(array->words, 0x0,                                                  \
+           bitarray_words_for(array->size) * sizeof(uint64_t));                \
+    array->size = 0;                                                           \
+    array->rank_valid = false;                                                 \
+  }                                                                            \
+                                                                               \
+  void name##_reserve(name *const array, size_t bits) {                        \
+    assert(array != NULL);                                                     \
+    size_t needed = bitarray_words_for(bits);                                  \
+    if (needed > array->capacity) {                                            \
+      name##_resize_words(array, needed);                                      \
+    }                                                                          \
+  }                                                                            \
+                                                                               \
+  void name##_shrink_to_fit(name *const array) {                               \
+    assert(array != NULL);                                                     \
+    size_t needed = bitarray_words_for(array->size);                           \
+    if (needed == 0) {                                                         \
+      needed = 1;                                                              \
+    }                                                                          \
+    if (needed < array->capacity) {                                            \
+      name##_resize_words(array, needed);                                      \
+    }                                                                          \
+  }                                                                            \
+                                                                               \
+  void name##_resize(name *const array, size_t bits) {                         \
+    assert(array != NULL);                                                     \
+    if (bits < array->size) {                                                  \
+      name##_zero_from(array, bits);                                           \
+    } else {                                                                   \
+      name##_ensure_bits(array, bits);                                         \
+    }                                                                          \
+    array->size = bits;                                                        \
+    array->rank_valid = false;                                                 \
+  }                                                                            \
+                                                                               \
+  void name##_push_back(name *const array, bool value) {                       \
+    assert(array != NULL);                                                     \
+    name##_ensure_bits(array, array->size + 1);                                \
+    array->words[array->size / 64] |= (uint64_t)value << (array->size % 64);   \
+    array->size++;                                                             \
+    array->rank_valid = false;                                                 \
+  }                                                                            \
+                                                                               \
+  bool name##_pop_back_unchecked(name *const array) {                          \
+    assert(array != NULL && array->size > 0);                                  \
+    array->size--;                                                             \
+    uint64_t *word = &array->words[array->size / 64];                          \
+    uint64_t bit = (uint64_t)1 << (array->size % 64);                          \
+    bool value = (*word & bit) != 0;                                           \
+    *word &= ~bit;                                                             \
+    array->rank_valid = false;                                                 \
+    return value;                                                              \
+  }                                                                            \
+                                                                               \
+  bool name##_pop_back(name *const array, bool *ptr) {                         \
+    assert(array != NULL);                                                     \
+    if (array->size == 0) {                                                    \
+      return false;                                                            \
+    }                                                                          \
+    bool value = name##_pop_back_unchecked(array);                             \
+    if (ptr != NULL) {                                                         \
+      *ptr = value;                                                            \
+    }                                                                          \
+    return true;                                                               \
+  }                                                                            \
+                                                                               \
+  /* Like arraylike's set, setting past the end grows the array. */            \
+  bool name##_set(name *const array, int32_t index, bool value) {              \
+    assert(array != NULL);                                                     \
+    if (index < 0) {                                                           \
+      return false;                                                            \
+    }                                                                          \
+    if ((size_t)index >= array->size) {                                        \
+      name##_ensure_bits(array, (size_t)index + 1);                            \
+      array->size = (size_t)index + 1;                                         \
+    }                                                                          \
+    uint64_t bit = (uint64_t)1 << (index % 64);                                \
+    if (value) {                                                               \
+      array->words[index / 64] |= bit;                                         \
+    } else {                                                                   \
+      array->words[index / 64] &= ~bit;                                        \
+    }                                                                          \
+    array->rank_valid = false;                                                 \
+    return true;                                                               \
+  }                                                                            \
+                                                                               \
+  bool name##_get_unchecked(const name *const array, int32_t index) {          \
+    assert(array != NULL);                                                     \
+    return (array->words[index / 64] >> (index % 64)) & 1;                     \
+  }                                                                            \
+                                                                               \
+  bool name##_get(const name *const array, int32_t index, bool *ptr) {         \
+    assert(array != NULL);                                                     \
+    if (index < 0 || (size_t)index >= array->size) {                           \
+      return false;                                                            \
+    }                                                                          \
+    *ptr = name##_get_unchecked(array, index);                                 \
+    return true;                                                               \
+  }                                                                            \
+                                                                               \
+  size_t name##_size(const name *const array) {                                \
+    assert(array != NULL);                                                     \
+    return array->size;                                                        \
+  }                                                                            \
+                                                                               \
+  bool name##_is_empty(const name *const array) {                              \
+    assert(array != NULL);                                                     \
+    return array->size == 0;                                                   \
+  }                                                                            \
+                                                                               \
+  ContainerStats name##_stats(const name *const array) {                       \
+    assert(array != NULL);                                                     \
+    return CONTAINER_STATS_GET(array);                                         \
+  }                                                                            \
+                                                                               \
+  size_t name##_count(const name *const array) {                               \
+    assert(array != NULL);                                                     \
+    return bitarray_popcount(array->words, bitarray_words_for(array->size));   \
+  }                                                                            \
+                                                                               \
+  /* Returns the index of the first set bit at or after `from`, or -1. */      \
+  int32_t name##_next_set(const name *const array, int32_t from) {             \
+    assert(array != NULL);                                                     \
+    if (from < 0) {                                                            \
+      from = 0;                                                                \
+    }                                                                          \
+    if ((size_t)from >= array->size) {                                         \
+      return -1;                                                               \
+    }                                                                          \
+    size_t end = bitarray_words_for(array->size);                              \
+    size_t word = (size_t)from / 64;                                           \
+    uint64_t bits = array->words[word] & (~(uint64_t)0 << (from % 64));        \
+    while (bits == 0) {                                                        \
+      if (++word == end) {                                                     \
+        return -1;                                                             \
+      }                                                                        \
+      bits = array->words[word];                                               \
+    }                                                                          \
+    return (int32_t)(word * 64 + __builtin_ctzll(bits));                       \
+  }                                                                            \
+                                                                               \
+  /* Words of `src` that overlap `dst`; later words of `dst` are combined      \
+   * with 0. */                                                                \
+  static inline size_t name##_common_words(const name *const dst,              \
+                                           const name *const src) {            \
+    size_t dst_words = bitarray_words_for(dst->size);                          \
+    size_t src_words = bitarray_words_for(src->size);                          \
+    return dst_words < src_words ? dst_words : src_words;                      \
+  }                                                                            \
+                                                                               \
+  /* Clears the bits of the last word of `dst` past its size. */               \
+  static inline void name##_mask_tail(name *const array) {                     \
+    if (array->size > 0) {                                                     \
+      array->words[(array->size - 1) / 64] &= bitarray_tail_mask(array->size); \
+    }                                                                          \
+    array->rank_valid = false;                                                 \
+  }                                                                            \
+                                                                               \
+  void name##_and(name *const dst, const name *const src) {                    \
+    assert(dst != NULL && src != NULL);                                        \
+    size_t common = name##_common_words(dst, src);                             \
+    for (size_t i = 0; i < common; ++i) {                                      \
+      dst->words[i] &= src->words[i];                                          \
+    }                                                                          \
+    size_t dst_words = bitarray_words_for(dst->size);                          \
+    memset(dst->words + common, 0x0, (dst_words - common) * sizeof(uint64_t)); \
+    name##_mask_tail(dst);                                                     \
+  }                                                                            \
+                                                                               \
+  void name##_or(name *const dst, const name *const src) {                     \
+    assert(dst != NULL && src != NULL);                                        \
+    size_t common = name##_common_words(dst, src);                             \
+    for (size_t i = 0; i < common; ++i) {                                      \
+      dst->words[i] |= src->words[i];                                          \
+    }                                                                          \
+    name##_mask_tail(dst);                                                     \
+  }                                                                            \
+                                                                               \
+  void name##_xor(name *const dst, const name *const src) {                    \
+    assert(dst != NULL && src != NULL);                                        \
+    size_t common = name##_common_words(dst, src);                             \
+    for (size_t i = 0; i < common; ++i) {                                      \
+      dst->words[i] ^= src->words[i];                                          \
+    }                                                                          \
+    name##_mask_tail(dst);                                                     \
+  }                                                                            \
+                                                                               \
+  /* --- Rank and select --- */                                                \
+                                                                               \
+  /* rank[b] is the number of set bits in words [0, b * BLOCK_WORDS); the      \
+   * last entry holds the total. */                                            \
+  void name##_build_rank(name *const array) {                                  \
+    assert(array != NULL);                                                     \
+    size_t words = bitarray_words_for(array->size);                            \
+    size_t blocks = (words + BITARRAY_RANK_BLOCK_WORDS - 1) /                  \
+                    BITARRAY_RANK_BLOCK_WORDS;                                 \
+    if (blocks + 1 > array->rank_capacity) {                                   \
+      free(array->rank);                                                       \
+      array->rank_capacity = blocks + 1;                                       \
+      array->rank =                                                            \
+          (uint64_t *)malloc(array->rank_capacity * sizeof(uint64_t));         \
+      assert(array->rank != NULL);                                             \
+    }                                                                          \
+    uint64_t total = 0;                                                        \
+    for (size_t b = 0; b < blocks; ++b) {                                      \
+      array->rank[b] = total;                                                  \
+      size_t start = b * BITARRAY_RANK_BLOCK_WORDS;                            \
+      size_t n = words - start < BITARRAY_RANK_BLOCK_WORDS                     \
+                     ? words - start                                           \
+                     : BITARRAY_RANK_BLOCK_WORDS;                              \
+      total += bitarray_popcount(array->words + start, n);                     \
+    }                                                                          \
+    array->rank[blocks] = total;                                               \
+    array->rank_valid = true;                                                  \
+  }                                                                            \
+                                                                               \
+  size_t name##_rank(const name *const array, size_t index) {                  \
+    assert(array != NULL && index <= array->size);                             \
+    size_t word = index / 64;                                                  \
+    size_t count = 0;                                                          \
+    size_t start = 0;                                                          \
+    if (array->rank_valid) {                                                   \
+      size_t block = word / BITARRAY_RANK_BLOCK_WORDS;                         \
+      count = array->rank[block];                                              \
+      start = block * BITARRAY_RANK_BLOCK_WORDS;                               \
+    }                                                                          \
+    count += bitarray_popcount(array->words + start, word - start);            \
+    if (index % 64 != 0) {                                                     \
+      count += (size_t)__builtin_popcountll(array->words[word] &               \
+                                            bitarray_tail_mask(index));        \
+    }                                                                          \
+    return count;                                                              \
+  }                                                                            \
+                                                                               \
+  int32_t name##_select(const name *const array, size_t k) {                   \
+    assert(array != NULL);                                                     \
+    size_t words = bitarray_words_for(array->size);                            \
+    size_t word = 0;                                                           \
+    if (array->rank_valid) {                                                   \
+      size_t blocks = (words + BITARRAY_RANK_BLOCK_WORDS - 1) /                \
+                      BITARRAY_RANK_BLOCK_WORDS;                               \
+      if (k >= array->rank[blocks]) {                                          \
+        return -1;                                                             \
+      }                                                                        \
+      /* Last block with fewer than k + 1 set bits before it. */               \
+      size_t lo = 0, hi = blocks - 1;                                          \
+      while (lo < hi) {                                                        \
+        size_t mid = lo + (hi - lo + 1) / 2;                                   \
+        if (array->rank[mid] <= k) {                                           \
+          lo = mid;                                                            \
+        } else {                                                               \
+          hi = mid - 1;                                                        \
+        }                                                                      \
+      }                                                                        \
+      k -= array->rank[lo];                                                    \
+      word = lo * BITARRAY_RANK_BLOCK_WORDS;                                   \
+    }                                                                          \
+    for (; word < words; ++word) {                                             \
+      size_t ones = (size_t)__builtin_popcountll(array->words[word]);          \
+      if (k < ones) {                                                          \
+        return (int32_t)(word * 64 +                                           \
+                         bitarray_select_word(array->words[word], k));         \
+      }                                                                        \
+      k -= ones;                                                               \
+    }                                                                          \
+    return -1;                                                                 \
+  }                                                                            \
+                                                                               \
+  /* --- Iteration --- */                                                      \
+  void name##_iterator(name##Iterator *iter, name *const array) {              \
+    assert(iter != NULL && array != NULL);                                     \
+    iter->index = 0;                                                           \
+    iter->array = array;                                                       \
+  }                                                                            \
+                                                                               \
+  bool name##_has_next(const name##Iterator *const iter) {                     \
+    assert(iter != NULL);                                                      \
+    return (size_t)iter->index < iter->array->size;                            \
+  }                                                                            \
+                                                                               \
+  void name##_next(name##Iterator *iter) {                                     \
+    assert(iter != NULL && (size_t)iter->index < iter->array->size);           \
+    iter->index++;                                                             \
+  }                                                                            \
+                                                                               \
+  bool name##_value(const name##Iterator *const iter) {                        \
+    assert(iter != NULL);                                                      \
+    return name##_get_unchecked(iter->array, iter->index);                     \
+  }
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* C_DATA_STRUCTURES_BITARRAY_H_ */
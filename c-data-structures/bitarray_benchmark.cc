@@ -0,0 +1,105 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+
+#include "c-data-structures/arraylike.h"
+#include "c-data-structures/bitarray.h"
+
+namespace {
+
+DEFINE_ARRAYLIKE(BoolArray, bool);
+IMPL_ARRAYLIKE(BoolArray, bool);
+
+DEFINE_BITARRAY(Bits);
+IMPL_BITARRAY(Bits);
+
+/* Roughly one element in three set, in no particular pattern. */
+bool Pattern(int64_t i) { return ((uint64_t)i * 2654435761u >> 7) % 3 == 0; }
+
+void FillBools(BoolArray *array, int64_t n) {
+  BoolArray_init(array);
+  for (int64_t i = 0; i < n; ++i) {
+    BoolArray_push_back(array, Pattern(i));
+  }
+}
+
+void FillBits(Bits *bits, int64_t n) {
+  Bits_init(bits);
+  for (int64_t i = 0; i < n; ++i) {
+    Bits_push_back(bits, Pattern(i));
+  }
+}
+
+/* -------------------------------------------------------------
+ * Count
+ * ------------------------------------------------------------- */
+
+void BM_BoolArray_Count(benchmark::State& state) {
+  BoolArray array;
+  FillBools(&array, state.range(0));
+  for (auto _ : state) {
+    size_t count = 0;
+    for (size_t i = 0; i < array.size; ++i) {
+      count += array.table[i];
+    }
+    benchmark::DoNotOptimize(count);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  BoolArray_finalize(&array);
+}
+BENCHMARK(BM_BoolArray_Count)->Arg(1 << 12)->Arg(1 << 20);
+
+void BM_BitArray_Count(benchmark::State& state) {
+  Bits bits;
+  FillBits(&bits, state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(Bits_count(&bits));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  Bits_finalize(&bits);
+}
+BENCHMARK(BM_BitArray_Count)->Arg(1 << 12)->Arg(1 << 20);
+
+/* -------------------------------------------------------------
+ * Rank and select
+ * ------------------------------------------------------------- */
+
+void BM_BitArray_Rank(benchmark::State& state) {
+  const int64_t n = state.range(0);
+  Bits bits;
+  FillBits(&bits, n);
+  if (state.range(1)) {
+    Bits_build_rank(&bits);
+  }
+  uint64_t i = 0;
+  for (auto _ : state) {
+    i = (i + 7919) % (uint64_t)n;
+    benchmark::DoNotOptimize(Bits_rank(&bits, i));
+  }
+  Bits_finalize(&bits);
+}
+BENCHMARK(BM_BitArray_Rank)
+    ->ArgNames({"n", "indexed"})
+    ->Args({1 << 20, 0})
+    ->Args({1 << 20, 1});
+
+void BM_BitArray_Select(benchmark::State& state) {
+  Bits bits;
+  FillBits(&bits, state.range(0));
+  if (state.range(1)) {
+    Bits_build_rank(&bits);
+  }
+  const size_t ones = Bits_count(&bits);
+  size_t k = 0;
+  for (auto _ : state) {
+    k = (k + 7919) % ones;
+    benchmark::DoNotOptimize(Bits_select(&bits, k));
+  }
+  Bits_finalize(&bits);
+}
+BENCHMARK(BM_BitArray_Select)
+    ->ArgNames({"n", "indexed"})
+    ->Args({1 << 20, 0})
+    ->Args({1 << 20, 1});
+
+}  // namespace
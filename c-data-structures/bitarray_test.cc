@@ -0,0 +1,246 @@
+#include "c-data-structures/bitarray.h"
+
+#include <gtest/gtest.h>
+#include <stdint.h>
+
+#include <vector>
+
+namespace {
+
+DEFINE_BITARRAY(Bits);
+IMPL_BITARRAY(Bits);
+
+/* Test fixture to ensure proper setup / teardown */
+class BitArrayTest : public ::testing::Test {
+ protected:
+  Bits bits{};
+
+  void SetUp() override { ASSERT_TRUE(Bits_init(&bits)); }
+  void TearDown() override { Bits_finalize(&bits); }
+
+  /* Fills `bits` and returns the same pattern as a vector. */
+  std::vector<bool> Fill(int32_t n, uint32_t seed) {
+    std::vector<bool> expected;
+    for (int32_t i = 0; i < n; ++i) {
+      seed = seed * 1103515245u + 12345u;
+      bool value = ((seed >> 16) % 3) == 0;
+      Bits_push_back(&bits, value);
+      expected.push_back(value);
+    }
+    return expected;
+  }
+};
+
+/* -------------------------------------------------------------
+ * Element access
+ * ------------------------------------------------------------- */
+
+TEST_F(BitArrayTest, InitEmpty) {
+  EXPECT_TRUE(Bits_is_empty(&bits));
+  EXPECT_EQ(Bits_size(&bits), 0u);
+  EXPECT_EQ(Bits_count(&bits), 0u);
+}
+
+TEST_F(BitArrayTest, PushBackAndGet) {
+  std::vector<bool> expected = Fill(300, 1);
+  ASSERT_EQ(Bits_size(&bits), 300u);
+  for (int32_t i = 0; i < 300; ++i) {
+    bool value;
+    ASSERT_TRUE(Bits_get(&bits, i, &value));
+    EXPECT_EQ(value, expected[i]) << i;
+  }
+  bool value;
+  EXPECT_FALSE(Bits_get(&bits, 300, &value));
+  EXPECT_FALSE(Bits_get(&bits, -1, &value));
+}
+
+TEST_F(BitArrayTest, SetGrowsLikeArrayLike) {
+  EXPECT_TRUE(Bits_set(&bits, 130, true));
+  EXPECT_EQ(Bits_size(&bits), 131u);
+  EXPECT_EQ(Bits_count(&bits), 1u);
+  EXPECT_TRUE(Bits_get_unchecked(&bits, 130));
+  EXPECT_FALSE(Bits_get_unchecked(&bits, 129));
+
+  EXPECT_TRUE(Bits_set(&bits, 130, false));
+  EXPECT_EQ(Bits_count(&bits), 0u);
+  EXPECT_FALSE(Bits_set(&bits, -1, true));
+}
+
+TEST_F(BitArrayTest, PopBack) {
+  Bits_push_back(&bits, true);
+  Bits_push_back(&bits, false);
+  bool value = true;
+  EXPECT_TRUE(Bits_pop_back(&bits, &value));
+  EXPECT_FALSE(value);
+  EXPECT_TRUE(Bits_pop_back_unchecked(&bits));
+  EXPECT_FALSE(Bits_pop_back(&bits, &value));
+}
+
+TEST_F(BitArrayTest, ShrinkingClearsDroppedBits) {
+  for (int i = 0; i < 200; ++i) {
+    Bits_push_back(&bits, true);
+  }
+  Bits_resize(&bits, 70);
+  EXPECT_EQ(Bits_count(&bits), 70u);
+  /* Growing again exposes zeros, not the old bits. */
+  Bits_resize(&bits, 200);
+  EXPECT_EQ(Bits_count(&bits), 70u);
+  EXPECT_FALSE(Bits_get_unchecked(&bits, 70));
+
+  Bits_resize(&bits, 128);
+  Bits_resize(&bits, 64);
+  Bits_resize(&bits, 128);
+  EXPECT_EQ(Bits_count(&bits), 64u);
+
+  Bits_pop_back(&bits, NULL);
+  Bits_push_back(&bits, false);
+  EXPECT_EQ(Bits_count(&bits), 64u);
+
+  Bits_clear(&bits);
+  Bits_resize(&bits, 100);
+  EXPECT_EQ(Bits_count(&bits), 0u);
+}
+
+TEST_F(BitArrayTest, ReserveAndShrinkToFit) {
+  Bits_reserve(&bits, 1000);
+  EXPECT_GE(bits.capacity * 64, 1000u);
+  Fill(100, 2);
+  Bits_shrink_to_fit(&bits);
+  EXPECT_EQ(bits.capacity, 2u);
+  EXPECT_EQ(Bits_size(&bits), 100u);
+}
+
+TEST_F(BitArrayTest, Iterate) {
+  std::vector<bool> expected = Fill(150, 3);
+  std::vector<bool> actual;
+  BitsIterator iter;
+  for (Bits_iterator(&iter, &bits); Bits_has_next(&iter); Bits_next(&iter)) {
+    actual.push_back(Bits_value(&iter));
+  }
+  EXPECT_EQ(actual, expected);
+}
+
+/* -------------------------------------------------------------
+ * Whole-array operations
+ * ------------------------------------------------------------- */
+
+TEST_F(BitArrayTest, Count) {
+  std::vector<bool> expected = Fill(1000, 4);
+  size_t ones = 0;
+  for (bool b : expected) {
+    ones += b;
+  }
+  EXPECT_EQ(Bits_count(&bits), ones);
+  EXPECT_EQ(bitarray_popcount_generic(bits.words, bits.capacity), ones);
+}
+
+TEST_F(BitArrayTest, NextSet) {
+  Bits_resize(&bits, 300);
+  Bits_set(&bits, 3, true);
+  Bits_set(&bits, 64, true);
+  Bits_set(&bits, 299, true);
+  EXPECT_EQ(Bits_next_set(&bits, 0), 3);
+  EXPECT_EQ(Bits_next_set(&bits, 3), 3);
+  EXPECT_EQ(Bits_next_set(&bits, 4), 64);
+  EXPECT_EQ(Bits_next_set(&bits, 65), 299);
+  EXPECT_EQ(Bits_next_set(&bits, 300), -1);
+  Bits_set(&bits, 299, false);
+  EXPECT_EQ(Bits_next_set(&bits, 65), -1);
+}
+
+TEST_F(BitArrayTest, AndOrXor) {
+  Bits other;
+  Bits_init(&other);
+  /* bits: 1100 + 100 zeros, other: 1010 */
+  Bits_resize(&bits, 104);
+  Bits_set(&bits, 0, true);
+  Bits_set(&bits, 1, true);
+  Bits_set(&bits, 100, true);
+  Bits_push_back(&other, true);
+  Bits_push_back(&other, false);
+  Bits_push_back(&other, true);
+  Bits_push_back(&other, false);
+
+  Bits_or(&bits, &other);
+  EXPECT_EQ(Bits_size(&bits), 104u);
+  EXPECT_EQ(Bits_count(&bits), 4u);
+
+  Bits_xor(&bits, &other);
+  EXPECT_EQ(Bits_count(&bits), 2u);
+  EXPECT_TRUE(Bits_get_unchecked(&bits, 1));
+
+  /* Bits past the end of `other` are ANDed with 0. */
+  Bits_set(&bits, 0, true);
+  Bits_and(&bits, &other);
+  EXPECT_EQ(Bits_count(&bits), 1u);
+  EXPECT_TRUE(Bits_get_unchecked(&bits, 0));
+
+  /* A longer source does not leak bits past the destination's size. */
+  Bits_resize(&other, 200);
+  Bits_set(&other, 150, true);
+  Bits_resize(&bits, 3);
+  Bits_or(&bits, &other);
+  EXPECT_EQ(Bits_count(&bits), 2u);
+  Bits_finalize(&other);
+}
+
+/* -------------------------------------------------------------
+ * Rank and select
+ * ------------------------------------------------------------- */
+
+TEST_F(BitArrayTest, RankAndSelectMatchScan) {
+  std::vector<bool> expected = Fill(5000, 5);
+  std::vector<int32_t> positions;
+  for (int32_t i = 0; i < (int32_t)expected.size(); ++i) {
+    if (expected[i]) {
+      positions.push_back(i);
+    }
+  }
+
+  for (int pass = 0; pass < 2; ++pass) {
+    if (pass == 1) {
+      Bits_build_rank(&bits);
+      ASSERT_TRUE(bits.rank_valid);
+    }
+    size_t ones = 0;
+    for (size_t i = 0; i <= expected.size(); ++i) {
+      ASSERT_EQ(Bits_rank(&bits, i), ones) << "pass " << pass << " at " << i;
+      if (i < expected.size()) {
+        ones += expected[i];
+      }
+    }
+    for (size_t k = 0; k < positions.size(); ++k) {
+      ASSERT_EQ(Bits_select(&bits, k), positions[k]) << "pass " << pass;
+    }
+    EXPECT_EQ(Bits_select(&bits, positions.size()), -1);
+  }
+}
+
+TEST_F(BitArrayTest, ModificationInvalidatesRank) {
+  Bits_resize(&bits, 1000);
+  Bits_set(&bits, 900, true);
+  Bits_build_rank(&bits);
+  EXPECT_EQ(Bits_rank(&bits, 1000), 1u);
+
+  Bits_set(&bits, 10, true);
+  EXPECT_FALSE(bits.rank_valid);
+  EXPECT_EQ(Bits_rank(&bits, 1000), 2u);
+  EXPECT_EQ(Bits_select(&bits, 0), 10);
+  EXPECT_EQ(Bits_select(&bits, 1), 900);
+}
+
+TEST_F(BitArrayTest, RankOfEmptyArray) {
+  EXPECT_EQ(Bits_rank(&bits, 0), 0u);
+  EXPECT_EQ(Bits_select(&bits, 0), -1);
+  Bits_build_rank(&bits);
+  EXPECT_EQ(Bits_rank(&bits, 0), 0u);
+  EXPECT_EQ(Bits_select(&bits, 0), -1);
+}
+
+TEST(BitArraySelectWordTest, FindsKthSetBit) {
+  EXPECT_EQ(bitarray_select_word(0x1u, 0), 0u);
+  EXPECT_EQ(bitarray_select_word(0xF0u, 2), 6u);
+  EXPECT_EQ(bitarray_select_word(0x8000000000000001ull, 1), 63u);
+}
+
+}  // namespace
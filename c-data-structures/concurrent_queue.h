@@ -0,0 +1,483 @@
+#ifndef C_DATA_STRUCTURES_CONCURRENT_QUEUE_H_
+#define C_DATA_STRUCTURES_CONCURRENT_QUEUE_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @file concurrent_queue.h
+ *
+ * @brief Bounded lock-free queues for passing elements between threads.
+ *
+ * Two macro families generate fixed-capacity FIFO queues over a power-of-two
+ * ring, in the same type-safe style as DEFINE_ARRAYLIKE:
+ *
+ *  - DEFINE_SPSC_QUEUE / IMPL_SPSC_QUEUE: one producer thread and one
+ *    consumer thread. Each side owns one index and keeps a cached copy of
+ *    the other side's, so the shared cache line is only read when the ring
+ *    looks full (or empty).
+ *  - DEFINE_MPMC_QUEUE / IMPL_MPMC_QUEUE: any number of producers and
+ *    consumers. Each slot carries a sequence number that tells producers
+ *    and consumers whose turn it is (Dmitry Vyukov's bounded MPMC queue), so
+ *    a push or pop is a single compare-and-swap on the shared index.
+ *
+ * The producer and consumer indices sit on separate cache lines so the two
+ * sides do not invalidate each other on every operation. Indices only grow;
+ * a slot is found by masking with `capacity - 1`.
+ *
+ * Both queues have batch operations, `name##_push_n` and `name##_pop_n`,
+ * that claim a run of slots with one index update. They transfer as many
+ * elements as fit (or are available) and return that number. The SPSC ring
+ * copies a batch with at most two memcpy calls.
+ *
+ * Error handling:
+ *  - Operations never block: `name##_push` returns false when the queue is
+ *    full and `name##_pop` returns false when it is empty
+ *  - The capacity is rounded up to a power of two; `name##_init` returns
+ *    false for a capacity of 0
+ *  - Allocation failures are guarded with `assert`
+ *
+ * Usage pattern:
+ *
+ *   DEFINE_MPMC_QUEUE(TaskQueue, Task);
+ *   IMPL_MPMC_QUEUE(TaskQueue, Task);
+ *
+ *   TaskQueue queue;
+ *   TaskQueue_init(&queue, 1024);
+ *   TaskQueue_push(&queue, task);    // on any thread
+ *   TaskQueue_pop(&queue, &task);    // on any thread
+ *   TaskQueue_finalize(&queue);
+ *
+ * Memory ordering uses the GCC/Clang `__atomic` builtins, which implement
+ * the C11 memory model and, unlike <stdatomic.h>, can be used from C++
+ * translation units including this header.
+ */
+
+/**
+ * Size of the padding that keeps producer and consumer state apart.
+ * Matches the cache line size of current x86 and most ARM cores.
+ */
+#ifndef CONCURRENT_QUEUE_CACHE_LINE
+#define CONCURRENT_QUEUE_CACHE_LINE 64
+#endif
+
+/**
+ * Returns the smallest power of two that is >= `needed` and >= 2.
+ */
+static inline size_t concurrent_queue_round_capacity(size_t needed) {
+  size_t capacity = 2;
+  while (capacity < needed) {
+    capacity *= 2;
+  }
+  return capacity;
+}
+
+/**
+ * @macro DEFINE_SPSC_QUEUE
+ *
+ * @brief Declares a single-producer, single-consumer queue type and its API.
+ *
+ * `name##_push` and `name##_push_n` may only be called from one thread at a
+ * time, and likewise `name##_pop` and `name##_pop_n`. `name##_size` is a
+ * snapshot that may be stale by the time it returns.
+ *
+ * @param name  Base name for the generated type and functions
+ * @param type  Element type stored in the queue
+ */
+#define DEFINE_SPSC_QUEUE(name, type)                                   \
+                                                                        \
+  /**                                                                   \
+   * Single-producer, single-consumer ring.                             \
+   *                                                                    \
+   * - `head` is the next slot to pop, written only by the consumer     \
+   * - `tail` is the next slot to push, written only by the producer    \
+   * - `cached_tail` and `cached_head` are each side's last view of the \
+   *   other side's index                                               \
+   */                                                                   \
+  typedef struct name##_ name;                                          \
+  struct name##_ {                                                      \
+    type *table;                                                        \
+    size_t mask;                                                        \
+    char pad0[CONCURRENT_QUEUE_CACHE_LINE];                             \
+    size_t head;                                                        \
+    size_t cached_tail;                                                 \
+    char pad1[CONCURRENT_QUEUE_CACHE_LINE];                             \
+    size_t tail;                                                        \
+    size_t cached_head;                                                 \
+    char pad2[CONCURRENT_QUEUE_CACHE_LINE];                             \
+  };                                                                    \
+                                                                        \
+  /* Initialization and lifetime management */                          \
+  bool name##_init(name *, size_t capacity);                            \
+  void name##_finalize(name *);                                         \
+                                                                        \
+  /* Producer operations */                                             \
+  bool name##_push(name *const, type);                                  \
+  size_t name##_push_n(name *const, const type elts[], size_t count);   \
+                                                                        \
+  /* Consumer operations */                                             \
+  bool name##_pop(name *const, type *ptr);                              \
+  size_t name##_pop_n(name *const, type out[], size_t max_count);       \
+                                                                        \
+  /* Size and state */                                                  \
+  size_t name##_size(const name *const);                                \
+  size_t name##_capacity(const name *const)
+
+/**
+ * @macro IMPL_SPSC_QUEUE
+ *
+ * @brief Generates the functions declared by DEFINE_SPSC_QUEUE.
+ *
+ * @param name  Base name used in DEFINE_SPSC_QUEUE
+ * @param type  Element type used in DEFINE_SPSC_QUEUE
+ */
+#define IMPL_SPSC_QUEUE(name, type)                                           \
+                                                                              \
+  bool name##_init(name *queue, size_t capacity) {                            \
+    assert(queue != NULL);                                                    \
+    if (capacity == 0) {                                                      \
+      return false;                                                           \
+    }                                                                         \
+    memset(queue, 0, sizeof(name));                                           \
+    capacity = concurrent_queue_round_capacity(capacity);                     \
+    queue->table = (type *)malloc(capacity * sizeof(type));                   \
+    assert(queue->table != NULL);                                             \
+    queue->mask = capacity - 1;                                               \
+    return true;                                                              \
+  }                                                                           \
+                                                                              \
+  void name##_finalize(name *queue) {                                         \
+    assert(queue != NULL);                                                    \
+    free(queue->table);                                                       \
+    queue->table = NULL;                                                      \
+  }                                                                           \
+                                                                              \
+  /* Copies `count` elements between `elts` and the ring starting at index    \
+   * `at`, in at most two pieces. */                                          \
+  static inline void name##_copy_in(name *queue, size_t at, const type *elts, \
+                                    size_t count) {                           \
+    size_t slot = at & queue->mask;                                           \
+    size_t first = queue->mask + 1 - slot;                                    \
+    if (first > count) {                                                      \
+      first = count;                                                          \
+    }                                                                         \
+    memcpy(queue->table + slot, elts, first * sizeof(type));                  \
+    memcpy(queue->table, elts + first, (count - first) * sizeof(type));       \
+  }                                                                           \
+                                                                              \
+  static inline void name##_copy_out(const name *queue, size_t at, type *out, \
+                                     size_t count) {                          \
+    size_t slot = at & queue->mask;                                           \
+    size_t first = queue->mask + 1 - slot;                                    \
+    if (first > count) {                                                      \
+      first = count;                                                          \
+    }                                                                         \
+    memcpy(out, queue->table + slot, first * sizeof(type));                   \
+    memcpy(out + first, queue->table, (count - first) * sizeof(type));        \
+  }                                                                           \
+                                                                              \
+  /* Free slots as seen by the producer, refreshing its view of `head` only   \
+   * if fewer than `wanted` appear free. */                                   \
+  static inline size_t name##_free_slots(name *queue, size_t tail,            \
+                                         size_t wanted) {                     \
+    size_t capacity = queue->mask + 1;                                        \
+    size_t free_slots = capacity - (tail - queue->cached_head);               \
+    if (free_slots < wanted) {                                                \
+      queue->cached_head = __atomic_load_n(&queue->head, __ATOMIC_ACQUIRE);   \
+      free_slots = capacity - (tail - queue->cached_head);                    \
+    }                                                                         \
+    return free_slots;                                                        \
+  }                                                                           \
+                                                                              \
+  /* Filled slots as seen by the consumer, refreshing its view of `tail`      \
+   * only if fewer than `wanted` appear filled. */                            \
+  static inline size_t name##_filled_slots(name *queue, size_t head,          \
+                                           size_t wanted) {                   \
+    size_t filled = queue->cached_tail - head;                                \
+    if (filled < wanted) {                                                    \
+      queue->cached_tail = __atomic_load_n(&queue->tail, __ATOMIC_ACQUIRE);   \
+      filled = queue->cached_tail - head;                                     \
+    }                                                                         \
+    return filled;                                                            \
+  }                                                                           \
+                                                                              \
+  bool name##_push(name *const queue, type elt) {                             \
+    assert(queue != NULL);                                                    \
+    size_t tail = queue->tail;                                                \
+    if (name##_free_slots(queue, tail, 1) == 0) {                             \
+      return false;                                                           \
+    }                                                                         \
+    queue->table[tail & queue->mask] = elt;                                   \
+    __atomic_store_n(&queue->tail, tail + 1, __ATOMIC_RELEASE);               \
+    return true;                                                              \
+  }                                                                           \
+                                                                              \
+  size_t name##_push_n(name *const queue, const type elts[], size_t count) {  \
+    assert(queue != NULL && (elts != NULL || count == 0));                    \
+    size_t tail = queue->tail;                                                \
+    size_t free_slots = name##_free_slots(queue, tail, count);                \
+    if (count > free_slots) {                                                 \
+      count = free_slots;                                                     \
+    }                                                                         \
+    name##_copy_in(queue, tail, elts, count);                                 \
+    __atomic_store_n(&queue->tail, tail + count, __ATOMIC_RELEASE);           \
+    return count;                                                             \
+  }                                                                           \
+                                                                              \
+  bool name##_pop(name *const queue, type *ptr) {                             \
+    assert(queue != NULL && ptr != NULL);                                     \
+    size_t head = queue->head;                                                \
+    if (name##_filled_slots(queue, head, 1) == 0) {                           \
+      return false;                                                           \
+    }                                                                         \
+    *ptr = queue->table[head & queue->mask];                                  \
+    __atomic_store_n(&queue->head, head + 1, __ATOMIC_RELEASE);               \
+    return true;                                                              \
+  }                                                                           \
+                                                                              \
+  size_t name##_pop_n(name *const queue, type out[], size_t max_count) {      \
+    assert(queue != NULL && (out != NULL || max_count == 0));                 \
+    size_t head = queue->head;                                                \
+    size_t filled = name##_filled_slots(queue, head, max_count);              \
+    if (max_count > filled) {                                                 \
+      max_count = filled;                                                     \
+    }                                                                         \
+    name##_copy_out(queue, head, out, max_count);                             \
+    __atomic_store_n(&queue->head, head + max_count, __ATOMIC_RELEASE);       \
+    return max_count;                                                         \
+  }                                                                           \
+                                                                              \
+  size_t name##_size(const name *const queue) {                               \
+    assert(queue != NULL);                                                    \
+    size_t head = __atomic_load_n(&queue->head, __ATOMIC_ACQUIRE);            \
+    size_t tail = __atomic_load_n(&queue->tail, __ATOMIC_ACQUIRE);            \
+    return tail - head;                                                       \
+  }                                                                           \
+                                                                              \
+  size_t name##_capacity(const name *const queue) {                           \
+    assert(queue != NULL);                                                    \
+    return queue->mask + 1;                                                   \
+  }
+
+/**
+ * @macro DEFINE_MPMC_QUEUE
+ *
+ * @brief Declares a multi-producer, multi-consumer queue type and its API.
+ *
+ * Every operation may be called from any thread and is lock-free. The
+ * batch operations first scan for a run of slots that are ready (free for
+ * `name##_push_n`, filled for `name##_pop_n`) starting at the shared index,
+ * then claim the whole run with one compare-and-swap. A run stops early at
+ * a slot another thread is still writing or reading.
+ *
+ * @param name  Base name for the generated type and functions
+ * @param type  Element type stored in the queue
+ */
+#define DEFINE_MPMC_QUEUE(name, type)                                  \
+                                                                       \
+  /**                                                                  \
+   * A slot is free for the push at index i when `sequence == i`, and  \
+   * holds a value for the pop at index i when `sequence == i + 1`.    \
+   */                                                                  \
+  typedef struct {                                                     \
+    size_t sequence;                                                   \
+    type value;                                                        \
+  } name##Cell;                                                        \
+                                                                       \
+  /**                                                                  \
+   * Multi-producer, multi-consumer ring.                              \
+   *                                                                   \
+   * - `head` is the next index to pop, claimed by consumers with CAS  \
+   * - `tail` is the next index to push, claimed by producers with CAS \
+   */                                                                  \
+  typedef struct name##_ name;                                         \
+  struct name##_ {                                                     \
+    name##Cell *cells;                                                 \
+    size_t mask;                                                       \
+    char pad0[CONCURRENT_QUEUE_CACHE_LINE];                            \
+    size_t head;                                                       \
+    char pad1[CONCURRENT_QUEUE_CACHE_LINE];                            \
+    size_t tail;                                                       \
+    char pad2[CONCURRENT_QUEUE_CACHE_LINE];                            \
+  };                                                                   \
+                                                                       \
+  /* Initialization and lifetime management */                         \
+  bool name##_init(name *, size_t capacity);                           \
+  void name##_finalize(name *);                                        \
+                                                                       \
+  /* Producer operations */                                            \
+  bool name##_push(name *const, type);                                 \
+  size_t name##_push_n(name *const, const type elts[], size_t count);  \
+                                                                       \
+  /* Consumer operations */                                            \
+  bool name##_pop(name *const, type *ptr);                             \
+  size_t name##_pop_n(name *const, type out[], size_t max_count);      \
+                                                                       \
+  /* Size and state */                                                 \
+  size_t name##_size(const name *const);                               \
+  size_t name##_capacity(const name *const)
+
+/**
+ * @macro IMPL_MPMC_QUEUE
+ *
+ * @brief Generates the functions declared by DEFINE_MPMC_QUEUE.
+ *
+ * @param name  Base name used in DEFINE_MPMC_QUEUE
+ * @param type  Element type used in DEFINE_MPMC_QUEUE
+ */
+#define IMPL_MPMC_QUEUE(name, type)                                            \
+                                                                               \
+  bool name##_init(name *queue, size_t capacity) {                             \
+    assert(queue != NULL);                                                     \
+    if (capacity == 0) {                                                       \
+      return false;                                                            \
+    }                                                                          \
+    memset(queue, 0, sizeof(name));                                            \
+    capacity = concurrent_queue_round_capacity(capacity);                      \
+    queue->cells = (name##Cell *)malloc(capacity * sizeof(name##Cell));        \
+    assert(queue->cells != NULL);                                              \
+    for (size_t i = 0; i < capacity; ++i) {                                    \
+      queue->cells[i].sequence = i;                                            \
+    }                                                                          \
+    queue->mask = capacity - 1;                                                \
+    return true;                                                               \
+  }                                                                            \
+                                                                               \
+  void name##_finalize(name *queue) {                                          \
+    assert(queue != NULL);                                                     \
+    free(queue->cells);                                                        \
+    queue->cells = NULL;                                                       \
+  }                                                                            \
+                                                                               \
+  bool name##_push(name *const queue, type elt) {                              \
+    assert(queue != NULL);                                                     \
+    size_t tail = __atomic_load_n(&queue->tail, __ATOMIC_RELAXED);             \
+    name##Cell *cell;                                                          \
+    for (;;) {                                                                 \
+      cell = &queue->cells[tail & queue->mask];                                \
+      size_t sequence = __atomic_load_n(&cell->sequence, __ATOMIC_ACQUIRE);    \
+      intptr_t diff = (intptr_t)sequence - (intptr_t)tail;                     \
+      if (diff == 0) {                                                         \
+        if (__atomic_compare_exchange_n(&queue->tail, &tail, tail + 1, true,   \
+                                        __ATOMIC_RELAXED, __ATOMIC_RELAXED)) { \
+          break;                                                               \
+        }                                                                      \
+      } else if (diff < 0) {                                                   \
+        return false; /* The slot still holds the value from a lap ago. */     \
+      } else {                                                                 \
+        tail = __atomic_load_n(&queue->tail, __ATOMIC_RELAXED);                \
+      }                                                                        \
+    }                                                                          \
+    cell->value = elt;                                                         \
+    __atomic_store_n(&cell->sequence, tail + 1, __ATOMIC_RELEASE);             \
+    return true;                                                               \
+  }                                                                            \
+                                                                               \
+  bool name##_pop(name *const queue, type *ptr) {                              \
+    assert(queue != NULL && ptr != NULL);                                      \
+    size_t head = __atomic_load_n(&queue->head, __ATOMIC_RELAXED);             \
+    name##Cell *cell;                                                          \
+    for (;;) {                                                                 \
+      cell = &queue->cells[head & queue->mask];                                \
+      size_t sequence = __atomic_load_n(&cell->sequence, __ATOMIC_ACQUIRE);    \
+      intptr_t diff = (intptr_t)sequence - (intptr_t)(head + 1);               \
+      if (diff == 0) {                                                         \
+        if (__atomic_compare_exchange_n(&queue->head, &head, head + 1, true,   \
+                                        __ATOMIC_RELAXED, __ATOMIC_RELAXED)) { \
+          break;                                                               \
+        }                                                                      \
+      } else if (diff < 0) {                                                   \
+        return false; /* The slot has not been filled yet. */                  \
+      } else {                                                                 \
+        head = __atomic_load_n(&queue->head, __ATOMIC_RELAXED);                \
+      }                                                                        \
+    }                                                                          \
+    *ptr = cell->value;                                                        \
+    __atomic_store_n(&cell->sequence, head + queue->mask + 1,                  \
+                     __ATOMIC_RELEASE);                                        \
+    return true;                                                               \
+  }                                                                            \
+                                                                               \
+  /* Counts the slots from `index` on, up to `count`, whose sequence is        \
+   * their index plus `offset`: free slots for pushes (offset 0), filled       \
+   * slots for pops (offset 1). */                                             \
+  static inline size_t name##_ready_run(const name *queue, size_t index,       \
+                                        size_t offset, size_t count) {         \
+    size_t ready = 0;                                                          \
+    while (ready < count) {                                                    \
+      const name##Cell *cell = &queue->cells[(index + ready) & queue->mask];   \
+      if (__atomic_load_n(&cell->sequence, __ATOMIC_ACQUIRE) !=                \
+          index + ready + offset) {                                            \
+        break;                                                                 \
+      }                                                                        \
+      ready++;                                                                 \
+    }                                                                          \
+    return ready;                                                              \
+  }                                                                            \
+                                                                               \
+  size_t name##_push_n(name *const queue, const type elts[], size_t count) {   \
+    assert(queue != NULL && (elts != NULL || count == 0));                     \
+    size_t tail = __atomic_load_n(&queue->tail, __ATOMIC_RELAXED);             \
+    size_t claimed;                                                            \
+    do {                                                                       \
+      claimed = name##_ready_run(queue, tail, 0, count);                       \
+      if (claimed == 0) {                                                      \
+        return 0;                                                              \
+      }                                                                        \
+    } while (!__atomic_compare_exchange_n(&queue->tail, &tail, tail + claimed, \
+                                          true, __ATOMIC_RELAXED,              \
+                                          __ATOMIC_RELAXED));                  \
+    for (size_t i = 0; i < claimed; ++i) {                                     \
+      name##Cell *cell = &queue->cells[(tail + i) & queue->mask];              \
+      cell->value = elts[i];                                                   \
+      __atomic_store_n(&cell->sequence, tail + i + 1, __ATOMIC_RELEASE);       \
+    }                                                                          \
+    return claimed;                                                            \
+  }                                                                            \
+                                                                               \
+  size_t name##_pop_n(name *const queue, type out[], size_t max_count) {       \
+    assert(queue != NULL && (out != NULL || max_count == 0));                  \
+    size_t head = __atomic_load_n(&queue->head, __ATOMIC_RELAXED);             \
+    size_t claimed;                                                            \
+    do {                                                                       \
+      claimed = name##_ready_run(queue, head, 1, max_count);                   \
+      if (claimed == 0) {                                                      \
+        return 0;                                                              \
+      }                                                                        \
+    } while (!__atomic_compare_exchange_n(&queue->head, &head, head + claimed, \
+                                          true, __ATOMIC_RELAXED,              \
+                                          __ATOMIC_RELAXED));                  \
+    for (size_t i = 0; i < claimed; ++i) {                                     \
+      name##Cell *cell = &queue->cells[(head + i) & queue->mask];              \
+      out[i] = cell->value;                                                    \
+      __atomic_store_n(&cell->sequence, head + i + queue->mask + 1,            \
+                       __ATOMIC_RELEASE);                                      \
+    }                                                                          \
+    return claimed;                                                            \
+  }                                                                            \
+                                                                               \
+  size_t name##_size(const name *const queue) {                                \
+    assert(queue != NULL);                                                     \
+    size_t head = __atomic_load_n(&queue->head, __ATOMIC_ACQUIRE);             \
+    size_t tail = __atomic_load_n(&queue->tail, __ATOMIC_ACQUIRE);             \
+    return (intptr_t)(tail - head) > 0 ? tail - head : 0;                      \
+  }                                                                            \
+                                                                               \
+  size_t name##_capacity(const name *const queue) {                            \
+    assert(queue != NULL);                                                     \
+    return queue->mask + 1;                                                    \
+  }
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* C_DATA_STRUCTURES_CONCURRENT_QUEUE_H_ */
@@ -0,0 +1,157 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "c-data-structures/arraylike.h"
+#include "c-data-structures/concurrent_queue.h"
+#include "c-data-structures/dequelike.h"
+
+namespace {
+
+DEFINE_SPSC_QUEUE(Int64SpscQueue, int64_t);
+IMPL_SPSC_QUEUE(Int64SpscQueue, int64_t);
+
+DEFINE_MPMC_QUEUE(Int64MpmcQueue, int64_t);
+IMPL_MPMC_QUEUE(Int64MpmcQueue, int64_t);
+
+DEFINE_ARRAYLIKE(Int64Array, int64_t);
+IMPL_ARRAYLIKE(Int64Array, int64_t);
+
+DEFINE_DEQUELIKE(Int64Deque, int64_t);
+IMPL_DEQUELIKE(Int64Deque, int64_t);
+
+/* Items moved through the queue per benchmark iteration. */
+const int64_t kItems = 1 << 16;
+const size_t kCapacity = 1024;
+
+/* Adapters giving every queue the same bounded push_n/pop_n interface. */
+struct SpscOps {
+  using Q = Int64SpscQueue;
+  static void init(Q* q) { Int64SpscQueue_init(q, kCapacity); }
+  static void finalize(Q* q) { Int64SpscQueue_finalize(q); }
+  static size_t push_n(Q* q, const int64_t* v, size_t n) {
+    return n == 1 ? Int64SpscQueue_push(q, *v) : Int64SpscQueue_push_n(q, v, n);
+  }
+  static size_t pop_n(Q* q, int64_t* v, size_t n) {
+    return n == 1 ? Int64SpscQueue_pop(q, v) : Int64SpscQueue_pop_n(q, v, n);
+  }
+};
+
+struct MpmcOps {
+  using Q = Int64MpmcQueue;
+  static void init(Q* q) { Int64MpmcQueue_init(q, kCapacity); }
+  static void finalize(Q* q) { Int64MpmcQueue_finalize(q); }
+  static size_t push_n(Q* q, const int64_t* v, size_t n) {
+    return n == 1 ? Int64MpmcQueue_push(q, *v) : Int64MpmcQueue_push_n(q, v, n);
+  }
+  static size_t pop_n(Q* q, int64_t* v, size_t n) {
+    return n == 1 ? Int64MpmcQueue_pop(q, v) : Int64MpmcQueue_pop_n(q, v, n);
+  }
+};
+
+/* The pattern the lock-free queues replace: a container behind a mutex. */
+template <typename C, void (*Init)(C*), void (*Finalize)(C*),
+          void (*PushBack)(C*, int64_t), bool (*PopFront)(C*, int64_t*)>
+struct LockedOps {
+  struct Q {
+    std::mutex mutex;
+    C container;
+  };
+  static void init(Q* q) { Init(&q->container); }
+  static void finalize(Q* q) { Finalize(&q->container); }
+  static size_t push_n(Q* q, const int64_t* v, size_t n) {
+    std::lock_guard<std::mutex> lock(q->mutex);
+    n = std::min(n, kCapacity - q->container.size);
+    for (size_t i = 0; i < n; ++i) {
+      PushBack(&q->container, v[i]);
+    }
+    return n;
+  }
+  static size_t pop_n(Q* q, int64_t* v, size_t n) {
+    std::lock_guard<std::mutex> lock(q->mutex);
+    size_t popped = 0;
+    while (popped < n && PopFront(&q->container, &v[popped])) {
+      popped++;
+    }
+    return popped;
+  }
+};
+
+void InitArray(Int64Array* a) { Int64Array_init(a); }
+void InitDeque(Int64Deque* d) { Int64Deque_init(d); }
+
+using LockedArrayOps =
+    LockedOps<Int64Array, InitArray, Int64Array_finalize,
+              Int64Array_push_back, Int64Array_pop_front>;
+using LockedDequeOps =
+    LockedOps<Int64Deque, InitDeque, Int64Deque_finalize,
+              Int64Deque_push_back, Int64Deque_pop_front>;
+
+/* Moves kItems from range(0) producers to range(1) consumers, in batches of
+ * range(2) elements. */
+template <typename Ops>
+void BM_Transfer(benchmark::State& state) {
+  const int64_t producers = state.range(0);
+  const int64_t consumers = state.range(1);
+  const size_t batch = (size_t)state.range(2);
+  const int64_t per_producer = kItems / producers;
+  const int64_t total = per_producer * producers;
+  typename Ops::Q queue;
+  Ops::init(&queue);
+  for (auto _ : state) {
+    int64_t consumed = 0;
+    std::vector<std::thread> threads;
+    for (int64_t p = 0; p < producers; ++p) {
+      threads.emplace_back([&queue, per_producer, batch] {
+        std::vector<int64_t> buffer(batch);
+        for (int64_t sent = 0; sent < per_producer;) {
+          size_t n = std::min<int64_t>(batch, per_producer - sent);
+          for (size_t i = 0; i < n; ++i) {
+            buffer[i] = sent + i;
+          }
+          size_t pushed = Ops::push_n(&queue, buffer.data(), n);
+          if (pushed == 0) {
+            std::this_thread::yield();
+          }
+          sent += pushed;
+        }
+      });
+    }
+    for (int64_t c = 0; c < consumers; ++c) {
+      threads.emplace_back([&queue, &consumed, total, batch] {
+        std::vector<int64_t> buffer(batch);
+        while (__atomic_load_n(&consumed, __ATOMIC_RELAXED) < total) {
+          size_t n = Ops::pop_n(&queue, buffer.data(), batch);
+          if (n == 0) {
+            std::this_thread::yield();
+          }
+          benchmark::DoNotOptimize(buffer.data());
+          __atomic_fetch_add(&consumed, (int64_t)n, __ATOMIC_RELAXED);
+        }
+      });
+    }
+    for (std::thread& thread : threads) {
+      thread.join();
+    }
+  }
+  Ops::finalize(&queue);
+  state.SetItemsProcessed(state.iterations() * total);
+}
+
+#define SPSC_ARGS ArgNames({"producers", "consumers", "batch"}) \
+  ->Args({1, 1, 1})                                            \
+  ->Args({1, 1, 64})                                           \
+  ->UseRealTime()
+
+#define MPMC_ARGS SPSC_ARGS->Args({4, 4, 1})->Args({4, 4, 64})
+
+BENCHMARK_TEMPLATE(BM_Transfer, SpscOps)->SPSC_ARGS;
+BENCHMARK_TEMPLATE(BM_Transfer, MpmcOps)->MPMC_ARGS;
+BENCHMARK_TEMPLATE(BM_Transfer, LockedArrayOps)->MPMC_ARGS;
+BENCHMARK_TEMPLATE(BM_Transfer, LockedDequeOps)->MPMC_ARGS;
+
+}  // namespace
@@ -0,0 +1,270 @@
+#include "c-data-structures/concurrent_queue.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace {
+
+DEFINE_SPSC_QUEUE(IntSpscQueue, int);
+IMPL_SPSC_QUEUE(IntSpscQueue, int);
+
+DEFINE_MPMC_QUEUE(IntMpmcQueue, int);
+IMPL_MPMC_QUEUE(IntMpmcQueue, int);
+
+/* Stress-test element: producer id and per-producer sequence number. */
+struct Message {
+  uint32_t producer;
+  uint32_t seq;
+};
+
+DEFINE_SPSC_QUEUE(MessageSpscQueue, Message);
+IMPL_SPSC_QUEUE(MessageSpscQueue, Message);
+
+DEFINE_MPMC_QUEUE(MessageMpmcQueue, Message);
+IMPL_MPMC_QUEUE(MessageMpmcQueue, Message);
+
+/* Maps a queue type to its generated functions so single-threaded tests
+ * can run against both flavors. */
+struct SpscOps {
+  using Q = IntSpscQueue;
+  static bool init(Q* q, size_t c) { return IntSpscQueue_init(q, c); }
+  static void finalize(Q* q) { IntSpscQueue_finalize(q); }
+  static bool push(Q* q, int v) { return IntSpscQueue_push(q, v); }
+  static bool pop(Q* q, int* v) { return IntSpscQueue_pop(q, v); }
+  static size_t push_n(Q* q, const int* v, size_t n) {
+    return IntSpscQueue_push_n(q, v, n);
+  }
+  static size_t pop_n(Q* q, int* v, size_t n) {
+    return IntSpscQueue_pop_n(q, v, n);
+  }
+  static size_t size(Q* q) { return IntSpscQueue_size(q); }
+  static size_t capacity(Q* q) { return IntSpscQueue_capacity(q); }
+};
+
+struct MpmcOps {
+  using Q = IntMpmcQueue;
+  static bool init(Q* q, size_t c) { return IntMpmcQueue_init(q, c); }
+  static void finalize(Q* q) { IntMpmcQueue_finalize(q); }
+  static bool push(Q* q, int v) { return IntMpmcQueue_push(q, v); }
+  static bool pop(Q* q, int* v) { return IntMpmcQueue_pop(q, v); }
+  static size_t push_n(Q* q, const int* v, size_t n) {
+    return IntMpmcQueue_push_n(q, v, n);
+  }
+  static size_t pop_n(Q* q, int* v, size_t n) {
+    return IntMpmcQueue_pop_n(q, v, n);
+  }
+  static size_t size(Q* q) { return IntMpmcQueue_size(q); }
+  static size_t capacity(Q* q) { return IntMpmcQueue_capacity(q); }
+};
+
+/* Test fixture to ensure proper setup / teardown */
+template <typename Ops>
+class QueueTest : public ::testing::Test {
+ protected:
+  typename Ops::Q queue{};
+
+  void SetUp() override { ASSERT_TRUE(Ops::init(&queue, 8)); }
+
+  void TearDown() override { Ops::finalize(&queue); }
+};
+
+using QueueTypes = ::testing::Types<SpscOps, MpmcOps>;
+TYPED_TEST_SUITE(QueueTest, QueueTypes);
+
+/* -------------------------------------------------------------
+ * Single-threaded semantics
+ * ------------------------------------------------------------- */
+
+TYPED_TEST(QueueTest, InitRoundsCapacity) {
+  typename TypeParam::Q queue;
+  EXPECT_FALSE(TypeParam::init(&queue, 0));
+  ASSERT_TRUE(TypeParam::init(&queue, 5));
+  EXPECT_EQ(TypeParam::capacity(&queue), 8u);
+  TypeParam::finalize(&queue);
+  ASSERT_TRUE(TypeParam::init(&queue, 1));
+  EXPECT_EQ(TypeParam::capacity(&queue), 2u);
+  TypeParam::finalize(&queue);
+}
+
+TYPED_TEST(QueueTest, FifoUntilFull) {
+  int value = -1;
+  EXPECT_FALSE(TypeParam::pop(&this->queue, &value));
+  for (int i = 0; i < 8; ++i) {
+    EXPECT_TRUE(TypeParam::push(&this->queue, i));
+  }
+  EXPECT_FALSE(TypeParam::push(&this->queue, 8));
+  EXPECT_EQ(TypeParam::size(&this->queue), 8u);
+  for (int i = 0; i < 8; ++i) {
+    ASSERT_TRUE(TypeParam::pop(&this->queue, &value));
+    EXPECT_EQ(value, i);
+  }
+  EXPECT_FALSE(TypeParam::pop(&this->queue, &value));
+  EXPECT_EQ(TypeParam::size(&this->queue), 0u);
+}
+
+TYPED_TEST(QueueTest, WrapsAround) {
+  int value;
+  for (int i = 0; i < 100; ++i) {
+    ASSERT_TRUE(TypeParam::push(&this->queue, i));
+    ASSERT_TRUE(TypeParam::push(&this->queue, -i));
+    ASSERT_TRUE(TypeParam::pop(&this->queue, &value));
+    EXPECT_EQ(value, i);
+    ASSERT_TRUE(TypeParam::pop(&this->queue, &value));
+    EXPECT_EQ(value, -i);
+  }
+}
+
+TYPED_TEST(QueueTest, BatchTransfersWhatFits) {
+  const int in[12] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11};
+  int out[12] = {0};
+  int value;
+
+  /* Offset the ring so the batches wrap. */
+  for (int i = 0; i < 5; ++i) {
+    ASSERT_TRUE(TypeParam::push(&this->queue, -1));
+    ASSERT_TRUE(TypeParam::pop(&this->queue, &value));
+  }
+  EXPECT_EQ(TypeParam::push_n(&this->queue, in, 3), 3u);
+  EXPECT_EQ(TypeParam::push_n(&this->queue, in + 3, 9), 5u);
+  EXPECT_EQ(TypeParam::push_n(&this->queue, in + 8, 4), 0u);
+
+  EXPECT_EQ(TypeParam::pop_n(&this->queue, out, 2), 2u);
+  EXPECT_EQ(TypeParam::pop_n(&this->queue, out + 2, 12), 6u);
+  EXPECT_EQ(TypeParam::pop_n(&this->queue, out + 8, 4), 0u);
+  for (int i = 0; i < 8; ++i) {
+    EXPECT_EQ(out[i], i);
+  }
+  EXPECT_EQ(TypeParam::push_n(&this->queue, in, 0), 0u);
+  EXPECT_EQ(TypeParam::pop_n(&this->queue, out, 0), 0u);
+}
+
+/* -------------------------------------------------------------
+ * Stress
+ * ------------------------------------------------------------- */
+
+const uint32_t kMessagesPerProducer = 100000;
+
+/* Checks that each consumer saw each producer's messages in order and that
+ * every message was delivered exactly once. */
+void ExpectAllDeliveredInOrder(
+    const std::vector<std::vector<Message>>& received, uint32_t producers) {
+  std::vector<uint64_t> count(producers, 0);
+  for (const std::vector<Message>& messages : received) {
+    std::vector<int64_t> last(producers, -1);
+    for (const Message& message : messages) {
+      ASSERT_LT(message.producer, producers);
+      ASSERT_GT((int64_t)message.seq, last[message.producer]);
+      last[message.producer] = message.seq;
+      count[message.producer]++;
+    }
+  }
+  for (uint32_t p = 0; p < producers; ++p) {
+    EXPECT_EQ(count[p], kMessagesPerProducer);
+  }
+}
+
+TEST(SpscQueueStressTest, SingleAndBatchTransfers) {
+  MessageSpscQueue queue;
+  ASSERT_TRUE(MessageSpscQueue_init(&queue, 64));
+  std::thread producer([&queue] {
+    Message batch[7];
+    for (uint32_t seq = 0; seq < kMessagesPerProducer;) {
+      if (seq % 2 == 0) {
+        if (MessageSpscQueue_push(&queue, Message{0, seq})) {
+          seq++;
+        } else {
+          std::this_thread::yield();
+        }
+        continue;
+      }
+      size_t n = 0;
+      for (; n < 7 && seq + n < kMessagesPerProducer; ++n) {
+        batch[n] = Message{0, (uint32_t)(seq + n)};
+      }
+      size_t pushed = MessageSpscQueue_push_n(&queue, batch, n);
+      if (pushed == 0) {
+        std::this_thread::yield();
+      }
+      seq += pushed;
+    }
+  });
+  std::vector<std::vector<Message>> received(1);
+  Message batch[5];
+  while (received[0].size() < kMessagesPerProducer) {
+    size_t n = MessageSpscQueue_pop_n(&queue, batch, 5);
+    if (n == 0) {
+      std::this_thread::yield();
+    }
+    received[0].insert(received[0].end(), batch, batch + n);
+  }
+  producer.join();
+  for (uint32_t i = 0; i < kMessagesPerProducer; ++i) {
+    ASSERT_EQ(received[0][i].seq, i);
+  }
+  MessageSpscQueue_finalize(&queue);
+}
+
+TEST(MpmcQueueStressTest, ManyProducersAndConsumers) {
+  const uint32_t kProducers = 4, kConsumers = 4;
+  const uint64_t kTotal = (uint64_t)kProducers * kMessagesPerProducer;
+  MessageMpmcQueue queue;
+  ASSERT_TRUE(MessageMpmcQueue_init(&queue, 256));
+  uint64_t consumed = 0;
+  std::vector<std::thread> threads;
+  for (uint32_t p = 0; p < kProducers; ++p) {
+    /* Odd producers push in batches. */
+    threads.emplace_back([&queue, p] {
+      Message batch[16];
+      for (uint32_t seq = 0; seq < kMessagesPerProducer;) {
+        if (p % 2 == 0) {
+          if (MessageMpmcQueue_push(&queue, Message{p, seq})) {
+            seq++;
+          } else {
+            std::this_thread::yield();
+          }
+          continue;
+        }
+        size_t n = 0;
+        for (; n < 16 && seq + n < kMessagesPerProducer; ++n) {
+          batch[n] = Message{p, (uint32_t)(seq + n)};
+        }
+        size_t pushed = MessageMpmcQueue_push_n(&queue, batch, n);
+        if (pushed == 0) {
+          std::this_thread::yield();
+        }
+        seq += pushed;
+      }
+    });
+  }
+  std::vector<std::vector<Message>> received(kConsumers);
+  for (uint32_t c = 0; c < kConsumers; ++c) {
+    /* Odd consumers pop in batches. */
+    threads.emplace_back([&queue, &received, &consumed, c, kTotal] {
+      Message batch[16];
+      while (__atomic_load_n(&consumed, __ATOMIC_RELAXED) < kTotal) {
+        size_t n = 0;
+        if (c % 2 == 0) {
+          n = MessageMpmcQueue_pop(&queue, batch) ? 1 : 0;
+        } else {
+          n = MessageMpmcQueue_pop_n(&queue, batch, 16);
+        }
+        if (n == 0) {
+          std::this_thread::yield();
+        }
+        received[c].insert(received[c].end(), batch, batch + n);
+        __atomic_fetch_add(&consumed, n, __ATOMIC_RELAXED);
+      }
+    });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+  ExpectAllDeliveredInOrder(received, kProducers);
+  EXPECT_EQ(MessageMpmcQueue_size(&queue), 0u);
+  MessageMpmcQueue_finalize(&queue);
+}
+
+}  // namespace
\ No newline at end of file
@@ -0,0 +1,312 @@
+#ifndef C_DATA_STRUCTURES_CONCURRENT_STABLE_ARRAYLIKE_H_
+#define C_DATA_STRUCTURES_CONCURRENT_STABLE_ARRAYLIKE_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "c-data-structures/stable_arraylike.h"
+
+/*
+ * Append-only variant of stable_arraylike that many threads can push to
+ * and read from at once.
+ *
+ * Writers reserve indices with an atomic fetch-add on `reserved`, copy
+ * their elements in and set a ready flag per element. `size` is the length
+ * of the ready prefix: after writing, each writer advances it over every
+ * ready element, including those of writers that finished earlier but were
+ * waiting on a gap. No writer ever waits for another, and an element is
+ * visible once it and everything before it have been written. Readers load
+ * `size` and may read any index below it without locks; published elements
+ * are never moved or modified.
+ *
+ * Element pointers must stay valid while readers hold them, so the block
+ * directory is never reallocated. Instead it is a fixed array of
+ * CONCURRENT_STABLE_ARRAY_MAX_BLOCKS pointers and block k holds
+ * `name##_BLOCK_SIZE << k` elements (plus one flag byte per element), as in
+ * a geometric arraylike. The first writer to reach a block allocates it and
+ * installs it with a compare-and-swap. Blocks are only freed by
+ * name##_finalize.
+ *
+ * Usage pattern:
+ *
+ *   DEFINE_CONCURRENT_STABLE_ARRAYLIKE(EventLog, Event);
+ *   IMPL_CONCURRENT_STABLE_ARRAYLIKE(EventLog, Event);
+ *
+ *   int32_t at = EventLog_push_back(&log, event);   // any thread
+ *   EventLogIterator it;                            // any thread
+ *   for (EventLog_iterator(&it, &log); EventLog_has_next(&it);
+ *        EventLog_next(&it)) {
+ *     const Event *event = EventLog_value(&it);
+ *   }
+ */
+
+/* Directory length. Enough for INT32_MAX elements at any block size. */
+#define CONCURRENT_STABLE_ARRAY_MAX_BLOCKS 32
+
+/* Padding that keeps the reservation counter and `size` apart. */
+#ifndef CONCURRENT_STABLE_ARRAY_CACHE_LINE
+#define CONCURRENT_STABLE_ARRAY_CACHE_LINE 64
+#endif
+
+#define DEFINE_CONCURRENT_STABLE_ARRAYLIKE(name, type) \
+  _STABLE_ARRAY_CHECK_BLOCK_SIZE();                    \
+  DEFINE_CONCURRENT_STABLE_ARRAYLIKE_N(                \
+      name, type, _STABLE_ARRAY_LOG2(STABLE_ARRAY_BLOCK_SIZE))
+
+/*
+ * Same as DEFINE_CONCURRENT_STABLE_ARRAYLIKE, but the first block holds
+ * `1 << log2_block` elements.
+ */
+#define DEFINE_CONCURRENT_STABLE_ARRAYLIKE_N(name, type, log2_block)        \
+                                                                            \
+  enum {                                                                    \
+    name##_BLOCK_SHIFT = (log2_block),                                      \
+    name##_BLOCK_SIZE = 1 << (log2_block),                                  \
+  };                                                                        \
+                                                                            \
+  typedef struct {                                                          \
+    type *blocks[CONCURRENT_STABLE_ARRAY_MAX_BLOCKS];                       \
+    char pad0[CONCURRENT_STABLE_ARRAY_CACHE_LINE];                          \
+    size_t reserved;                                                        \
+    char pad1[CONCURRENT_STABLE_ARRAY_CACHE_LINE];                          \
+    size_t size;                                                            \
+    char pad2[CONCURRENT_STABLE_ARRAY_CACHE_LINE];                          \
+  } name;                                                                   \
+                                                                            \
+  /* Iterates over the elements published when the iterator was created. */ \
+  typedef struct {                                                          \
+    const name *array;                                                      \
+    size_t index;                                                           \
+    size_t end;                                                             \
+  } name##Iterator;                                                         \
+                                                                            \
+  /* Initialization and lifetime management (not thread-safe) */            \
+  bool name##_init(name *);                                                 \
+  name *name##_create();                                                    \
+  void name##_finalize(name *);                                             \
+  void name##_delete(name *);                                               \
+                                                                            \
+  /* Back operations; return the index of the (first) new element */        \
+  int32_t name##_push_back(name *const, type);                              \
+  int32_t name##_push_back_n(name *const, const type elts[], size_t count); \
+                                                                            \
+  /* Random access lookup */                                                \
+  bool name##_get(const name *const, int32_t, type *ptr);                   \
+  type name##_get_unchecked(const name *const, int32_t);                    \
+  bool name##_get_ref(const name *const, int32_t, const type **ptr);        \
+  const type *name##_get_ref_unchecked(const name *const, int32_t);         \
+                                                                            \
+  /* Size and state */                                                      \
+  size_t name##_size(const name *const);                                    \
+  bool name##_is_empty(const name *const);                                  \
+                                                                            \
+  /* Iteration */                                                           \
+  void name##_iterator(name##Iterator *, const name *const);                \
+  bool name##_has_next(const name##Iterator *const);                        \
+  void name##_next(name##Iterator *);                                       \
+  const type *name##_value(const name##Iterator *const)
+
+#define IMPL_CONCURRENT_STABLE_ARRAYLIKE(name, type)                          \
+                                                                              \
+  /* --- Internal Helpers: Block geometry --- */                              \
+  /* Block k starts at index `(2^k - 1) * name##_BLOCK_SIZE`. */              \
+  static inline size_t name##_block_of(size_t index) {                        \
+    return 63 - __builtin_clzll(                                              \
+                    (unsigned long long)(index >> name##_BLOCK_SHIFT) + 1);   \
+  }                                                                           \
+                                                                              \
+  static inline size_t name##_block_start(size_t block_idx) {                 \
+    return (((size_t)1 << block_idx) - 1) << name##_BLOCK_SHIFT;              \
+  }                                                                           \
+                                                                              \
+  static inline size_t name##_block_length(size_t block_idx) {                \
+    return (size_t)name##_BLOCK_SIZE << block_idx;                            \
+  }                                                                           \
+                                                                              \
+  static inline type *name##_slot(const name *const array, size_t index) {    \
+    size_t block_idx = name##_block_of(index);                                \
+    type *block =                                                             \
+        __atomic_load_n(&array->blocks[block_idx], __ATOMIC_ACQUIRE);         \
+    return &block[index - name##_block_start(block_idx)];                     \
+  }                                                                           \
+                                                                              \
+  /* Each block of n elements is followed by n ready flags, set once the      \
+   * element has been written. */                                             \
+  static inline unsigned char *name##_ready_flags(type *block,                \
+                                                  size_t block_idx) {         \
+    return (unsigned char *)(block + name##_block_length(block_idx));         \
+  }                                                                           \
+                                                                              \
+  /* Returns block `block_idx`, allocating and installing it if no other      \
+   * writer has yet. */                                                       \
+  static type *name##_ensure_block(name *const array, size_t block_idx) {     \
+    type *block =                                                             \
+        __atomic_load_n(&array->blocks[block_idx], __ATOMIC_ACQUIRE);         \
+    if (block) return block;                                                  \
+    size_t length = name##_block_length(block_idx);                           \
+    type *fresh = (type *)calloc(length, sizeof(type) + 1);                   \
+    assert(fresh != NULL);                                                    \
+    if (__atomic_compare_exchange_n(&array->blocks[block_idx], &block, fresh, \
+                                    false, __ATOMIC_ACQ_REL,                  \
+                                    __ATOMIC_ACQUIRE)) {                      \
+      return fresh;                                                           \
+    }                                                                         \
+    free(fresh);                                                              \
+    return block;                                                             \
+  }                                                                           \
+                                                                              \
+  static inline bool name##_is_ready(const name *const array, size_t index) { \
+    size_t block_idx = name##_block_of(index);                                \
+    type *block =                                                             \
+        __atomic_load_n(&array->blocks[block_idx], __ATOMIC_ACQUIRE);         \
+    if (!block) return false;                                                 \
+    return __atomic_load_n(                                                   \
+        &name##_ready_flags(block, block_idx)[index -                         \
+                                              name##_block_start(block_idx)], \
+        __ATOMIC_ACQUIRE);                                                    \
+  }                                                                           \
+                                                                              \
+  /* Advances `size` over every ready element following it. Called by each    \
+   * writer after setting its ready flags, so whichever writer finishes last  \
+   * publishes the elements of writers that finished before it, and no        \
+   * writer ever waits for another. */                                        \
+  static void name##_advance_size(name *const array) {                        \
+    /* A read-modify-write rather than a load: RMWs on `size` are totally     \
+     * ordered, so of two writers finishing at once the later one sees the    \
+     * other's ready flags. */                                                \
+    size_t size = __atomic_fetch_add(&array->size, 0, __ATOMIC_ACQ_REL);      \
+    for (;;) {                                                                \
+      size_t end = size;                                                      \
+      while (name##_is_ready(array, end)) end++;                              \
+      if (end == size) return;                                                \
+      if (__atomic_compare_exchange_n(&array->size, &size, end, false,        \
+                                      __ATOMIC_RELEASE, __ATOMIC_ACQUIRE)) {  \
+        return;                                                               \
+      }                                                                       \
+    }                                                                         \
+  }                                                                           \
+                                                                              \
+  /* Reserves `count` consecutive indices and returns the first. */           \
+  static inline size_t name##_reserve(name *const array, size_t count) {      \
+    size_t start =                                                            \
+        __atomic_fetch_add(&array->reserved, count, __ATOMIC_RELAXED);        \
+    assert(start + count <= INT32_MAX);                                       \
+    return start;                                                             \
+  }                                                                           \
+                                                                              \
+  /* --- Initialization and lifetime management --- */                        \
+  bool name##_init(name *array) {                                             \
+    memset(array, 0x0, sizeof(name));                                         \
+    return true;                                                              \
+  }                                                                           \
+                                                                              \
+  name *name##_create() {                                                     \
+    name *array = (name *)malloc(sizeof(name));                               \
+    if (array) name##_init(array);                                            \
+    return array;                                                             \
+  }                                                                           \
+                                                                              \
+  void name##_finalize(name *array) {                                         \
+    if (!array) return;                                                       \
+    for (size_t i = 0; i < CONCURRENT_STABLE_ARRAY_MAX_BLOCKS; ++i) {         \
+      free(array->blocks[i]);                                                 \
+      array->blocks[i] = NULL;                                                \
+    }                                                                         \
+    array->reserved = 0;                                                      \
+    array->size = 0;                                                          \
+  }                                                                           \
+                                                                              \
+  void name##_delete(name *array) {                                           \
+    if (!array) return;                                                       \
+    name##_finalize(array);                                                   \
+    free(array);                                                              \
+  }                                                                           \
+                                                                              \
+  /* --- Back operations --- */                                               \
+  int32_t name##_push_back(name *const array, type value) {                   \
+    return name##_push_back_n(array, &value, 1);                              \
+  }                                                                           \
+                                                                              \
+  int32_t name##_push_back_n(name *const array, const type elts[],            \
+                             size_t count) {                                  \
+    size_t start = name##_reserve(array, count);                              \
+    size_t index = start, copied = 0;                                         \
+    while (copied < count) {                                                  \
+      size_t block_idx = name##_block_of(index);                              \
+      size_t offset = index - name##_block_start(block_idx);                  \
+      size_t n = name##_block_length(block_idx) - offset;                     \
+      if (n > count - copied) n = count - copied;                             \
+      type *block = name##_ensure_block(array, block_idx);                    \
+      unsigned char *ready = name##_ready_flags(block, block_idx);            \
+      memcpy(block + offset, elts + copied, n * sizeof(type));                \
+      for (size_t i = offset; i < offset + n; ++i) {                          \
+        __atomic_store_n(&ready[i], 1, __ATOMIC_RELEASE);                     \
+      }                                                                       \
+      index += n;                                                             \
+      copied += n;                                                            \
+    }                                                                         \
+    name##_advance_size(array);                                               \
+    return (int32_t)start;                                                    \
+  }                                                                           \
+                                                                              \
+  /* --- Random access lookup --- */                                          \
+  bool name##_get(const name *const array, int32_t index, type *ptr) {        \
+    if (index < 0 || (size_t)index >= name##_size(array)) return false;       \
+    if (ptr) *ptr = *name##_slot(array, (size_t)index);                       \
+    return true;                                                              \
+  }                                                                           \
+                                                                              \
+  type name##_get_unchecked(const name *const array, int32_t index) {         \
+    return *name##_slot(array, (size_t)index);                                \
+  }                                                                           \
+                                                                              \
+  bool name##_get_ref(const name *const array, int32_t index,                 \
+                      const type **ptr) {                                     \
+    if (index < 0 || (size_t)index >= name##_size(array)) return false;       \
+    if (ptr) *ptr = name##_slot(array, (size_t)index);                        \
+    return true;                                                              \
+  }                                                                           \
+                                                                              \
+  const type *name##_get_ref_unchecked(const name *const array,               \
+                                       int32_t index) {                       \
+    return name##_slot(array, (size_t)index);                                 \
+  }                                                                           \
+                                                                              \
+  /* --- Size and state --- */                                                \
+  size_t name##_size(const name *const array) {                               \
+    return __atomic_load_n(&array->size, __ATOMIC_ACQUIRE);                   \
+  }                                                                           \
+                                                                              \
+  bool name##_is_empty(const name *const array) {                             \
+    return name##_size(array) == 0;                                           \
+  }                                                                           \
+                                                                              \
+  /* --- Iteration --- */                                                     \
+  void name##_iterator(name##Iterator *it, const name *const array) {         \
+    it->array = array;                                                        \
+    it->index = 0;                                                            \
+    it->end = name##_size(array);                                             \
+  }                                                                           \
+                                                                              \
+  bool name##_has_next(const name##Iterator *const it) {                      \
+    return it->index < it->end;                                               \
+  }                                                                           \
+                                                                              \
+  void name##_next(name##Iterator *it) { it->index++; }                       \
+                                                                              \
+  const type *name##_value(const name##Iterator *const it) {                  \
+    return name##_slot(it->array, it->index);                                 \
+  }
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* C_DATA_STRUCTURES_CONCURRENT_STABLE_ARRAYLIKE_H_ */
@@ -0,0 +1,148 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "c-data-structures/concurrent_stable_arraylike.h"
+#include "c-data-structures/stable_arraylike.h"
+
+namespace {
+
+struct Event {
+  uint64_t timestamp;
+  uint64_t payload[3];
+};
+
+DEFINE_CONCURRENT_STABLE_ARRAYLIKE(EventLog, Event);
+IMPL_CONCURRENT_STABLE_ARRAYLIKE(EventLog, Event);
+
+DEFINE_STABLE_ARRAYLIKE(StableEventArray, Event);
+IMPL_STABLE_ARRAYLIKE(StableEventArray, Event);
+
+/* Events appended per benchmark iteration, split across the writers. */
+const int64_t kEvents = 1 << 18;
+
+/* Runs `append(writer, count)` on range(0) threads, kEvents in total. */
+template <typename Append>
+void RunWriters(benchmark::State& state, Append append) {
+  const int64_t writers = state.range(0);
+  std::vector<std::thread> threads;
+  for (int64_t w = 0; w < writers; ++w) {
+    threads.emplace_back(append, w, kEvents / writers);
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+}
+
+/* -------------------------------------------------------------
+ * Appends
+ * ------------------------------------------------------------- */
+
+void BM_ConcurrentStableArrayLike_PushBack(benchmark::State& state) {
+  for (auto _ : state) {
+    EventLog log;
+    EventLog_init(&log);
+    RunWriters(state, [&log](int64_t writer, int64_t count) {
+      for (int64_t i = 0; i < count; ++i) {
+        EventLog_push_back(&log, Event{(uint64_t)i, {(uint64_t)writer}});
+      }
+    });
+    benchmark::DoNotOptimize(log.size);
+    EventLog_finalize(&log);
+  }
+  state.SetItemsProcessed(state.iterations() * kEvents);
+}
+
+void BM_ConcurrentStableArrayLike_PushBackN(benchmark::State& state) {
+  for (auto _ : state) {
+    EventLog log;
+    EventLog_init(&log);
+    RunWriters(state, [&log](int64_t writer, int64_t count) {
+      Event batch[64];
+      for (int64_t i = 0; i < count; i += 64) {
+        for (int64_t j = 0; j < 64; ++j) {
+          batch[j] = Event{(uint64_t)(i + j), {(uint64_t)writer}};
+        }
+        EventLog_push_back_n(&log, batch, 64);
+      }
+    });
+    benchmark::DoNotOptimize(log.size);
+    EventLog_finalize(&log);
+  }
+  state.SetItemsProcessed(state.iterations() * kEvents);
+}
+
+/* The pattern this replaces: a stable_arraylike behind a mutex. */
+void BM_LockedStableArrayLike_PushBack(benchmark::State& state) {
+  for (auto _ : state) {
+    StableEventArray array;
+    std::mutex mutex;
+    StableEventArray_init(&array);
+    RunWriters(state, [&array, &mutex](int64_t writer, int64_t count) {
+      for (int64_t i = 0; i < count; ++i) {
+        std::lock_guard<std::mutex> lock(mutex);
+        StableEventArray_push_back(&array,
+                                   Event{(uint64_t)i, {(uint64_t)writer}});
+      }
+    });
+    benchmark::DoNotOptimize(array.size);
+    StableEventArray_finalize(&array);
+  }
+  state.SetItemsProcessed(state.iterations() * kEvents);
+}
+
+/* -------------------------------------------------------------
+ * Reads
+ * ------------------------------------------------------------- */
+
+void BM_ConcurrentStableArrayLike_Iterate(benchmark::State& state) {
+  EventLog log;
+  EventLog_init(&log);
+  for (int64_t i = 0; i < kEvents; ++i) {
+    EventLog_push_back(&log, Event{(uint64_t)i, {0}});
+  }
+  for (auto _ : state) {
+    uint64_t sum = 0;
+    EventLogIterator it;
+    for (EventLog_iterator(&it, &log); EventLog_has_next(&it);
+         EventLog_next(&it)) {
+      sum += EventLog_value(&it)->timestamp;
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  EventLog_finalize(&log);
+  state.SetItemsProcessed(state.iterations() * kEvents);
+}
+
+void BM_StableArrayLike_Iterate(benchmark::State& state) {
+  StableEventArray array;
+  StableEventArray_init(&array);
+  for (int64_t i = 0; i < kEvents; ++i) {
+    StableEventArray_push_back(&array, Event{(uint64_t)i, {0}});
+  }
+  for (auto _ : state) {
+    uint64_t sum = 0;
+    StableEventArrayIterator it;
+    for (StableEventArray_iterator(&it, &array); StableEventArray_has_next(&it);
+         StableEventArray_next(&it)) {
+      sum += StableEventArray_value(&it)->timestamp;
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  StableEventArray_finalize(&array);
+  state.SetItemsProcessed(state.iterations() * kEvents);
+}
+
+#define WRITERS ArgName("writers")->Arg(1)->Arg(2)->Arg(4)->UseRealTime()
+
+BENCHMARK(BM_ConcurrentStableArrayLike_PushBack)->WRITERS;
+BENCHMARK(BM_ConcurrentStableArrayLike_PushBackN)->WRITERS;
+BENCHMARK(BM_LockedStableArrayLike_PushBack)->WRITERS;
+
+BENCHMARK(BM_ConcurrentStableArrayLike_Iterate);
+BENCHMARK(BM_StableArrayLike_Iterate);
+
+}  // namespace
@@ -0,0 +1,173 @@
+#include "c-data-structures/concurrent_stable_arraylike.h"
+
+#include <gtest/gtest.h>
+#include <stdint.h>
+
+#include <thread>
+#include <vector>
+
+namespace {
+
+DEFINE_CONCURRENT_STABLE_ARRAYLIKE(ConcurrentIntArray, int);
+IMPL_CONCURRENT_STABLE_ARRAYLIKE(ConcurrentIntArray, int);
+
+/* Log entry whose checksum lets readers detect torn or unwritten slots */
+struct Event {
+  uint32_t writer;
+  uint32_t seq;
+  uint64_t checksum;
+};
+
+uint64_t Checksum(uint32_t writer, uint32_t seq) {
+  return ((uint64_t)writer << 32 | seq) * 0x9E3779B97F4A7C15ull;
+}
+
+/* Small first block so the stress test crosses many blocks */
+DEFINE_CONCURRENT_STABLE_ARRAYLIKE_N(EventLog, Event, 2);
+IMPL_CONCURRENT_STABLE_ARRAYLIKE(EventLog, Event);
+
+/* Test fixture to ensure proper setup / teardown */
+class ConcurrentIntArrayTest : public ::testing::Test {
+ protected:
+  ConcurrentIntArray array{};
+
+  void SetUp() override { ASSERT_TRUE(ConcurrentIntArray_init(&array)); }
+
+  void TearDown() override { ConcurrentIntArray_finalize(&array); }
+};
+
+/* -------------------------------------------------------------
+ * Single-threaded semantics
+ * ------------------------------------------------------------- */
+
+TEST_F(ConcurrentIntArrayTest, InitiallyEmpty) {
+  int value;
+  EXPECT_TRUE(ConcurrentIntArray_is_empty(&array));
+  EXPECT_EQ(ConcurrentIntArray_size(&array), 0u);
+  EXPECT_FALSE(ConcurrentIntArray_get(&array, 0, &value));
+}
+
+TEST_F(ConcurrentIntArrayTest, PushBackAcrossBlocks) {
+  const int kCount = ConcurrentIntArray_BLOCK_SIZE * 20;
+  for (int i = 0; i < kCount; ++i) {
+    EXPECT_EQ(ConcurrentIntArray_push_back(&array, i * 3), i);
+  }
+  ASSERT_EQ(ConcurrentIntArray_size(&array), (size_t)kCount);
+  for (int i = 0; i < kCount; ++i) {
+    int value = -1;
+    ASSERT_TRUE(ConcurrentIntArray_get(&array, i, &value));
+    EXPECT_EQ(value, i * 3);
+    EXPECT_EQ(ConcurrentIntArray_get_unchecked(&array, i), i * 3);
+  }
+  EXPECT_FALSE(ConcurrentIntArray_get(&array, -1, nullptr));
+  EXPECT_FALSE(ConcurrentIntArray_get(&array, kCount, nullptr));
+}
+
+TEST_F(ConcurrentIntArrayTest, PushBackNSpansBlocks) {
+  std::vector<int> values(1000);
+  for (int i = 0; i < 1000; ++i) {
+    values[i] = i;
+  }
+  EXPECT_EQ(ConcurrentIntArray_push_back(&array, -1), 0);
+  EXPECT_EQ(ConcurrentIntArray_push_back_n(&array, values.data(), 1000), 1);
+  EXPECT_EQ(ConcurrentIntArray_push_back_n(&array, values.data(), 0), 1001);
+  ASSERT_EQ(ConcurrentIntArray_size(&array), 1001u);
+  for (int i = 0; i < 1000; ++i) {
+    EXPECT_EQ(ConcurrentIntArray_get_unchecked(&array, i + 1), i);
+  }
+}
+
+TEST_F(ConcurrentIntArrayTest, ReferencesAreStable) {
+  ConcurrentIntArray_push_back(&array, 42);
+  const int* first = nullptr;
+  ASSERT_TRUE(ConcurrentIntArray_get_ref(&array, 0, &first));
+  for (int i = 0; i < 10000; ++i) {
+    ConcurrentIntArray_push_back(&array, i);
+  }
+  EXPECT_EQ(first, ConcurrentIntArray_get_ref_unchecked(&array, 0));
+  EXPECT_EQ(*first, 42);
+}
+
+TEST_F(ConcurrentIntArrayTest, IteratorStopsAtSnapshot) {
+  for (int i = 0; i < 5; ++i) {
+    ConcurrentIntArray_push_back(&array, i);
+  }
+  ConcurrentIntArrayIterator it;
+  ConcurrentIntArray_iterator(&it, &array);
+  ConcurrentIntArray_push_back(&array, 5);
+  int expected = 0;
+  for (; ConcurrentIntArray_has_next(&it); ConcurrentIntArray_next(&it)) {
+    EXPECT_EQ(*ConcurrentIntArray_value(&it), expected++);
+  }
+  EXPECT_EQ(expected, 5);
+}
+
+/* -------------------------------------------------------------
+ * Stress
+ * ------------------------------------------------------------- */
+
+TEST(EventLogStressTest, WritersAndReaders) {
+  const uint32_t kWriters = 4, kReaders = 2, kPerWriter = 50000;
+  EventLog log;
+  ASSERT_TRUE(EventLog_init(&log));
+
+  std::vector<std::thread> threads;
+  for (uint32_t w = 0; w < kWriters; ++w) {
+    /* Odd writers append in batches. */
+    threads.emplace_back([&log, w] {
+      Event batch[13];
+      for (uint32_t seq = 0; seq < kPerWriter;) {
+        if (w % 2 == 0) {
+          EventLog_push_back(&log, Event{w, seq, Checksum(w, seq)});
+          seq++;
+          continue;
+        }
+        size_t n = 0;
+        for (; n < 13 && seq < kPerWriter; ++n, ++seq) {
+          batch[n] = Event{w, seq, Checksum(w, seq)};
+        }
+        EventLog_push_back_n(&log, batch, n);
+      }
+    });
+  }
+  /* Readers check each newly published range as it appears. */
+  std::vector<size_t> reader_errors(kReaders, 0);
+  for (uint32_t r = 0; r < kReaders; ++r) {
+    threads.emplace_back([&log, &reader_errors, r] {
+      size_t seen = 0;
+      while (seen < kWriters * kPerWriter) {
+        EventLogIterator it;
+        EventLog_iterator(&it, &log);
+        if (it.end < seen) {
+          reader_errors[r]++;
+        }
+        for (it.index = seen; EventLog_has_next(&it); EventLog_next(&it)) {
+          const Event* event = EventLog_value(&it);
+          if (event->checksum != Checksum(event->writer, event->seq)) {
+            reader_errors[r]++;
+          }
+        }
+        seen = it.end;
+        std::this_thread::yield();
+      }
+    });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+  for (size_t errors : reader_errors) {
+    EXPECT_EQ(errors, 0u);
+  }
+
+  /* Every event is present once, and each writer's events are in order. */
+  ASSERT_EQ(EventLog_size(&log), (size_t)kWriters * kPerWriter);
+  std::vector<uint32_t> next(kWriters, 0);
+  for (int32_t i = 0; i < (int32_t)EventLog_size(&log); ++i) {
+    const Event* event = EventLog_get_ref_unchecked(&log, i);
+    ASSERT_LT(event->writer, kWriters);
+    ASSERT_EQ(event->seq, next[event->writer]++);
+  }
+  EventLog_finalize(&log);
+}
+
+}  // namespace
\ No newline at end of file
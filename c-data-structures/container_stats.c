@@ -0,0 +1,95 @@
+#include "c-data-structures/container_stats.h"
+
+#include <pthread.h>
+#include <stdlib.h>
+
+/* `stats` comes first so a ContainerStats * handed out by
+ * container_stats_register converts back to its record. */
+typedef struct StatsRecord_ StatsRecord;
+struct StatsRecord_ {
+  ContainerStats stats;
+  const char *type_name;
+  const void *container;
+  StatsRecord *prev;
+  StatsRecord *next;
+};
+
+static pthread_mutex_t registry_lock = PTHREAD_MUTEX_INITIALIZER;
+static StatsRecord *registry_head = NULL;
+static size_t registry_count = 0;
+
+ContainerStats *container_stats_register(const char type_name[],
+                                         const void *container) {
+  StatsRecord *record = (StatsRecord *)malloc(sizeof(StatsRecord));
+  if (record == NULL) {
+    return NULL;
+  }
+  record->stats = container_stats_zero();
+  record->type_name = type_name;
+  record->container = container;
+  record->prev = NULL;
+
+  pthread_mutex_lock(&registry_lock);
+  record->next = registry_head;
+  if (registry_head != NULL) {
+    registry_head->prev = record;
+  }
+  registry_head = record;
+  registry_count++;
+  pthread_mutex_unlock(&registry_lock);
+  return &record->stats;
+}
+
+void container_stats_unregister(ContainerStats *stats) {
+  if (stats == NULL) {
+    return;
+  }
+  StatsRecord *record = (StatsRecord *)stats;
+
+  pthread_mutex_lock(&registry_lock);
+  if (record->prev != NULL) {
+    record->prev->next = record->next;
+  } else {
+    registry_head = record->next;
+  }
+  if (record->next != NULL) {
+    record->next->prev = record->prev;
+  }
+  registry_count--;
+  pthread_mutex_unlock(&registry_lock);
+  free(record);
+}
+
+void container_stats_foreach(void (*fn)(const char type_name[],
+                                        const void *container,
+                                        const ContainerStats *stats,
+                                        void *ctx),
+                             void *ctx) {
+  pthread_mutex_lock(&registry_lock);
+  for (const StatsRecord *record = registry_head; record != NULL;
+       record = record->next) {
+    fn(record->type_name, record->container, &record->stats, ctx);
+  }
+  pthread_mutex_unlock(&registry_lock);
+}
+
+static void dump_record(const char type_name[], const void *container,
+                        const ContainerStats *stats, void *ctx) {
+  fprintf((FILE *)ctx,
+          "%s@%p reallocs=%zu bytes_moved=%zu peak_size=%zu "
+          "peak_capacity=%zu block_allocs=%zu lookups=%zu probes=%zu\n",
+          type_name, container, stats->reallocs, stats->bytes_moved,
+          stats->peak_size, stats->peak_capacity, stats->block_allocs,
+          stats->lookups, stats->probes);
+}
+
+void container_stats_dump(FILE *out) {
+  container_stats_foreach(dump_record, out);
+}
+
+size_t container_stats_live_count(void) {
+  pthread_mutex_lock(&registry_lock);
+  size_t count = registry_count;
+  pthread_mutex_unlock(&registry_lock);
+  return count;
+}
@@ -0,0 +1,124 @@
+#ifndef C_DATA_STRUCTURES_CONTAINER_STATS_H_
+#define C_DATA_STRUCTURES_CONTAINER_STATS_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include <stdio.h>
+
+/**
+ * @file container_stats.h
+ *
+ * @brief Opt-in instrumentation counters for the container macros.
+ *
+ * When CONTAINER_STATS is defined (e.g. `--copt=-DCONTAINER_STATS`), every
+ * arraylike, dequelike, soa_arraylike, stable_arraylike, hashmap and
+ * KeyedList keeps a ContainerStats record from init to finalize, and all
+ * live records are linked into a global registry that container_stats_dump
+ * prints.
+ *
+ * Without CONTAINER_STATS the hooks below expand to nothing: containers have
+ * no extra field and do no extra work. `name##_stats` still exists and
+ * returns zeroed counters.
+ *
+ * CONTAINER_STATS changes the layout of every container struct, so it must
+ * be defined the same way in every translation unit of a program.
+ *
+ * Counters are plain integers updated by the container that owns them, so
+ * they are exactly as thread-safe as the container. Registering and
+ * unregistering records is thread-safe.
+ */
+
+/**
+ * Counters kept per container instance. Counters that do not apply to a
+ * container stay 0.
+ */
+typedef struct {
+  size_t reallocs;       /* table resizes (arraylike) or rehashes (hashmap) */
+  size_t bytes_moved;    /* bytes memmoved to open or close gaps */
+  size_t peak_size;      /* largest number of elements held */
+  size_t peak_capacity;  /* largest number of slots allocated */
+  size_t block_allocs;   /* blocks obtained (stable_arraylike) */
+  size_t lookups;        /* key lookups, including inserts (hashmap) */
+  size_t probes;         /* slots inspected by those lookups (hashmap) */
+} ContainerStats;
+
+/* Registry. These are always available; without CONTAINER_STATS nothing
+ * registers, so the registry stays empty. */
+
+/* Adds a zeroed record for `container` of type `type_name` to the registry
+ * and returns it, or returns NULL if it cannot be allocated. */
+ContainerStats *container_stats_register(const char type_name[],
+                                         const void *container);
+/* Removes a record returned by container_stats_register. NULL is ignored. */
+void container_stats_unregister(ContainerStats *stats);
+
+/* Calls `fn` on every registered record, most recently registered first. */
+void container_stats_foreach(void (*fn)(const char type_name[],
+                                        const void *container,
+                                        const ContainerStats *stats,
+                                        void *ctx),
+                             void *ctx);
+/* Writes one line per registered record to `out`. */
+void container_stats_dump(FILE *out);
+size_t container_stats_live_count(void);
+
+static inline ContainerStats container_stats_zero(void) {
+  ContainerStats stats = {0, 0, 0, 0, 0, 0, 0};
+  return stats;
+}
+
+/*
+ * Hooks used by the container macros. `c` is a pointer to a container whose
+ * struct includes CONTAINER_STATS_FIELD. Records may be NULL (a failed
+ * registration, or a container that was never initialized, like a
+ * read-only persisted mapping), in which case updates are dropped.
+ */
+#ifdef CONTAINER_STATS
+
+#define CONTAINER_STATS_FIELD ContainerStats *_stats;
+
+#define CONTAINER_STATS_REGISTER(c, type_name) \
+  ((c)->_stats = container_stats_register((type_name), (c)))
+
+#define CONTAINER_STATS_UNREGISTER(c)        \
+  do {                                       \
+    container_stats_unregister((c)->_stats); \
+    (c)->_stats = NULL;                      \
+  } while (0)
+
+#define CONTAINER_STATS_ADD(c, counter, n) \
+  do {                                     \
+    if ((c)->_stats != NULL) {             \
+      (c)->_stats->counter += (n);         \
+    }                                      \
+  } while (0)
+
+#define CONTAINER_STATS_MAX(c, counter, n)                           \
+  do {                                                               \
+    if ((c)->_stats != NULL && (c)->_stats->counter < (size_t)(n)) { \
+      (c)->_stats->counter = (n);                                    \
+    }                                                                \
+  } while (0)
+
+#define CONTAINER_STATS_GET(c) \
+  ((c)->_stats != NULL ? *(c)->_stats : container_stats_zero())
+
+#else
+
+#define CONTAINER_STATS_FIELD
+#define CONTAINER_STATS_REGISTER(c, type_name) ((void)0)
+#define CONTAINER_STATS_UNREGISTER(c) ((void)0)
+#define CONTAINER_STATS_ADD(c, counter, n) ((void)0)
+#define CONTAINER_STATS_MAX(c, counter, n) ((void)0)
+#define CONTAINER_STATS_GET(c) ((void)(c), container_stats_zero())
+
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* C_DATA_STRUCTURES_CONTAINER_STATS_H_ */
@@ -0,0 +1,237 @@
+#include "c-data-structures/container_stats.h"
+
+#include <gtest/gtest.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include <string>
+
+#include "c-data-structures/arraylike.h"
+#include "c-data-structures/dequelike.h"
+#include "c-data-structures/hashmap.h"
+#include "c-data-structures/soa_arraylike.h"
+#include "c-data-structures/stable_arraylike.h"
+
+#ifndef CONTAINER_STATS
+#error "container_stats_test must be built with CONTAINER_STATS defined"
+#endif
+
+namespace {
+
+DEFINE_ARRAYLIKE(IntArray, int);
+IMPL_ARRAYLIKE(IntArray, int);
+
+DEFINE_STABLE_ARRAYLIKE_N(StableIntArray, int, 2);
+IMPL_STABLE_ARRAYLIKE(StableIntArray, int);
+
+DEFINE_HASHMAP(IntMap, int, int);
+IMPL_HASHMAP(IntMap, int, int, HASHMAP_HASH_INT, HASHMAP_EQ);
+
+DEFINE_DEQUELIKE(IntDeque, int);
+IMPL_DEQUELIKE(IntDeque, int);
+
+#define PAIR_FIELDS(X) \
+  X(int32_t, id)       \
+  X(double, weight)
+
+DEFINE_SOA_ARRAYLIKE(PairArray, PAIR_FIELDS);
+IMPL_SOA_ARRAYLIKE(PairArray, PAIR_FIELDS);
+
+/* Finds the registry record of `container`. */
+struct Found {
+  const void *container;
+  std::string type_name;
+  bool found = false;
+};
+
+void FindRecord(const char type_name[], const void *container,
+                const ContainerStats *, void *ctx) {
+  auto *found = static_cast<Found *>(ctx);
+  if (container == found->container) {
+    found->type_name = type_name;
+    found->found = true;
+  }
+}
+
+/* -------------------------------------------------------------
+ * Registry
+ * ------------------------------------------------------------- */
+
+TEST(ContainerStatsTest, ContainersRegisterUntilFinalized) {
+  size_t live = container_stats_live_count();
+  IntArray arr;
+  IntArray_init(&arr);
+  IntMap map;
+  IntMap_init(&map);
+  EXPECT_EQ(container_stats_live_count(), live + 2);
+
+  Found found;
+  found.container = &arr;
+  container_stats_foreach(FindRecord, &found);
+  EXPECT_TRUE(found.found);
+  EXPECT_EQ(found.type_name, "IntArray");
+
+  IntArray_finalize(&arr);
+  IntMap_finalize(&map);
+  EXPECT_EQ(container_stats_live_count(), live);
+}
+
+TEST(ContainerStatsTest, CopiesHaveTheirOwnRecord) {
+  size_t live = container_stats_live_count();
+  IntArray *arr = IntArray_create();
+  IntArray_push_back(arr, 1);
+  IntArray *copy = IntArray_copy(arr);
+  EXPECT_EQ(container_stats_live_count(), live + 2);
+  EXPECT_EQ(IntArray_stats(copy).peak_size, 1u);
+  IntArray_delete(arr);
+  IntArray_delete(copy);
+  EXPECT_EQ(container_stats_live_count(), live);
+}
+
+TEST(ContainerStatsTest, DumpWritesOneLinePerContainer) {
+  IntArray arr;
+  IntArray_init(&arr);
+  char buffer[4096] = {0};
+  FILE *out = fmemopen(buffer, sizeof(buffer), "w");
+  ASSERT_NE(out, nullptr);
+  container_stats_dump(out);
+  fclose(out);
+  EXPECT_NE(std::string(buffer).find("IntArray@"), std::string::npos);
+  IntArray_finalize(&arr);
+}
+
+/* -------------------------------------------------------------
+ * Counters
+ * ------------------------------------------------------------- */
+
+TEST(ContainerStatsTest, ArrayCountsReallocsAndPeaks) {
+  IntArray arr;
+  IntArray_init_capacity(&arr, 8);
+  for (int i = 0; i < 100; ++i) {
+    IntArray_push_back(&arr, i);
+  }
+  IntArray_rshrink(&arr, 90);
+  ContainerStats stats = IntArray_stats(&arr);
+  EXPECT_EQ(stats.reallocs, 4u); /* 8 -> 16 -> 32 -> 64 -> 128 */
+  EXPECT_EQ(stats.peak_size, 100u);
+  EXPECT_EQ(stats.peak_capacity, 128u);
+  EXPECT_EQ(stats.bytes_moved, 0u);
+  IntArray_finalize(&arr);
+}
+
+TEST(ContainerStatsTest, ArrayCountsBytesMoved) {
+  IntArray arr;
+  IntArray_init(&arr);
+  IntArray_push_front(&arr, 1);
+  EXPECT_EQ(IntArray_stats(&arr).peak_size, 1u);
+  for (int i = 0; i < 3; ++i) {
+    IntArray_push_front(&arr, i);
+  }
+  /* Shifts of 1, 2 and 3 elements */
+  EXPECT_EQ(IntArray_stats(&arr).bytes_moved, 6 * sizeof(int));
+
+  int value;
+  IntArray_remove(&arr, 0, &value);
+  EXPECT_EQ(IntArray_stats(&arr).bytes_moved, 9 * sizeof(int));
+
+  const int elts[] = {7, 8};
+  IntArray_insert_range(&arr, 1, elts, 2);
+  IntArray_erase_range(&arr, 0, 1);
+  EXPECT_EQ(IntArray_stats(&arr).bytes_moved, 15 * sizeof(int));
+  IntArray_finalize(&arr);
+}
+
+TEST(ContainerStatsTest, StableArrayCountsBlockAllocations) {
+  StableIntArray arr;
+  StableIntArray_init(&arr);
+  for (int i = 0; i < 10; ++i) {
+    StableIntArray_push_back(&arr, i);
+  }
+  ContainerStats stats = StableIntArray_stats(&arr);
+  EXPECT_EQ(stats.block_allocs, 3u);
+  EXPECT_EQ(stats.peak_size, 10u);
+  EXPECT_EQ(stats.peak_capacity, 12u);
+
+  /* Reusing the retained spare block is not a new allocation. */
+  for (int i = 0; i < 2; ++i) {
+    StableIntArray_pop_back(&arr, NULL);
+  }
+  StableIntArray_push_back(&arr, 8);
+  StableIntArray_push_back(&arr, 9);
+  EXPECT_EQ(StableIntArray_stats(&arr).block_allocs, 3u);
+  StableIntArray_finalize(&arr);
+}
+
+TEST(ContainerStatsTest, HashmapCountsLookupsAndProbes) {
+  IntMap map;
+  IntMap_init(&map);
+  for (int i = 0; i < 100; ++i) {
+    IntMap_insert(&map, i, i);
+  }
+  ContainerStats stats = IntMap_stats(&map);
+  EXPECT_EQ(stats.lookups, 100u);
+  EXPECT_GE(stats.probes, 100u);
+  EXPECT_EQ(stats.peak_size, 100u);
+  EXPECT_GT(stats.reallocs, 0u);
+
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_NE(IntMap_lookup(&map, i), nullptr);
+  }
+  ContainerStats after = IntMap_stats(&map);
+  EXPECT_EQ(after.lookups, 200u);
+  EXPECT_GE(after.probes, stats.probes + 100);
+  IntMap_finalize(&map);
+}
+
+TEST(ContainerStatsTest, DequeCountsGrowthAndBytesMoved) {
+  size_t live = container_stats_live_count();
+  IntDeque deque;
+  IntDeque_init(&deque);
+  EXPECT_EQ(container_stats_live_count(), live + 1);
+  for (int i = 0; i < 20; ++i) {
+    IntDeque_push_back(&deque, i);
+  }
+  ContainerStats stats = IntDeque_stats(&deque);
+  EXPECT_EQ(stats.reallocs, 2u); /* 8 -> 16 -> 32 */
+  EXPECT_EQ(stats.peak_size, 20u);
+  EXPECT_EQ(stats.peak_capacity, 32u);
+  EXPECT_EQ(stats.bytes_moved, 0u);
+
+  /* Removal shifts the shorter side: 2 elements, then 1. */
+  int value;
+  IntDeque_remove(&deque, 2, &value);
+  IntDeque_remove(&deque, 17, &value);
+  EXPECT_EQ(IntDeque_stats(&deque).bytes_moved, 3 * sizeof(int));
+
+  IntDeque *copy = IntDeque_copy(&deque);
+  EXPECT_EQ(container_stats_live_count(), live + 2);
+  EXPECT_EQ(IntDeque_stats(copy).peak_size, 18u);
+  EXPECT_EQ(IntDeque_stats(copy).bytes_moved, 0u);
+  IntDeque_delete(copy);
+  IntDeque_finalize(&deque);
+  EXPECT_EQ(container_stats_live_count(), live);
+}
+
+TEST(ContainerStatsTest, SoaArrayCountsGrowthAndBytesMoved) {
+  size_t live = container_stats_live_count();
+  PairArray arr;
+  PairArray_init_capacity(&arr, 8);
+  EXPECT_EQ(container_stats_live_count(), live + 1);
+  for (int i = 0; i < 20; ++i) {
+    PairArray_push_back(&arr, PairArrayRecord{i, (double)i});
+  }
+  ContainerStats stats = PairArray_stats(&arr);
+  EXPECT_EQ(stats.reallocs, 2u); /* all columns 8 -> 16 -> 32, once each */
+  EXPECT_EQ(stats.peak_size, 20u);
+  EXPECT_EQ(stats.peak_capacity, 32u);
+
+  /* Removing row 5 of 20 shifts 14 rows of every column. */
+  PairArrayRecord record;
+  PairArray_remove(&arr, 5, &record);
+  EXPECT_EQ(PairArray_stats(&arr).bytes_moved,
+            14 * (sizeof(int32_t) + sizeof(double)));
+  PairArray_finalize(&arr);
+  EXPECT_EQ(container_stats_live_count(), live);
+}
+
+}  // namespace
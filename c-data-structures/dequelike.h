@@ -0,0 +1,598 @@
+#ifndef C_DATA_STRUCTURES_DEQUELIKE_H_
+#define C_DATA_STRUCTURES_DEQUELIKE_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "c-data-structures/container_stats.h"
+
+/**
+ * @file dequelike.h
+ *
+ * @brief Macro-based, type-safe double-ended queue for C.
+ *
+ * DEFINE_DEQUELIKE and IMPL_DEQUELIKE generate a container with the same API
+ * surface as DEFINE_ARRAYLIKE/IMPL_ARRAYLIKE, backed by a circular buffer
+ * instead of a left-aligned table. Code written against an arraylike can
+ * switch to a dequelike by changing the macros.
+ *
+ * Complexity:
+ *  - push/pop at either end: amortized O(1) (no memmove of the table)
+ *  - random access get/set: O(1)
+ *  - remove at index i: O(min(i, size - i))
+ *
+ * Memory management:
+ *  - The deque owns a heap buffer (`table`) whose capacity is always a power
+ *    of two, so logical indices map to slots with a mask
+ *  - Logical element 0 lives at `table[head]`; elements wrap around the end
+ *    of the table
+ *  - Capacity doubles when full; shrinking only reduces logical size unless
+ *    `name##_shrink_to_fit` is called
+ *
+ * Instrumentation:
+ *  - With CONTAINER_STATS defined, each deque counts table resizes, bytes
+ *    moved by removal from the middle, and its peak size and capacity,
+ *    readable through `name##_stats` (see container_stats.h)
+ *
+ * Error handling follows arraylike.h: `bool` results report invalid indices
+ * or insufficient size, `_unchecked` functions assume valid preconditions and
+ * allocation failures are guarded with `assert`.
+ *
+ * Usage pattern:
+ *
+ *   // In a header or source file:
+ *   DEFINE_DEQUELIKE(IntQueue, int);
+ *
+ *   // In exactly one source file:
+ *   IMPL_DEQUELIKE(IntQueue, int);
+ *
+ *   // Use as:
+ *   IntQueue queue;
+ *   IntQueue_init(&queue);
+ *   IntQueue_push_back(&queue, 42);
+ *   IntQueue_pop_front(&queue, &value);
+ */
+
+/**
+ * Default (and minimum) capacity. Must be a power of two.
+ */
+#define DEFAULT_DEQUE_SIZE 8
+
+/**
+ * Returns the smallest power of two that is >= `needed` and >=
+ * DEFAULT_DEQUE_SIZE, or 0 if no size_t power of two is that large.
+ */
+static inline size_t dequelike_round_capacity(size_t needed) {
+  size_t capacity = DEFAULT_DEQUE_SIZE;
+  while (capacity < needed) {
+    if (capacity > SIZE_MAX / 2) {
+      return 0;
+    }
+    capacity *= 2;
+  }
+  return capacity;
+}
+
+/**
+ * @macro DEFINE_DEQUELIKE
+ *
+ * @brief Declares a circular-buffer deque type and its public API.
+ *
+ * @param name  Base name for the generated type and functions
+ * @param type  Element type stored in the deque
+ */
+#define DEFINE_DEQUELIKE(name, type)                                          \
+                                                                              \
+  /**                                                                         \
+   * Circular-buffer deque structure.                                         \
+   *                                                                          \
+   * - `capacity` is the allocated length of `table` (a power of two)         \
+   * - `head` is the slot holding logical element 0                           \
+   * - `size` is the number of logically present elements                     \
+   */                                                                         \
+  typedef struct name##_ name;                                                \
+  struct name##_ {                                                            \
+    size_t capacity;                                                          \
+    size_t head;                                                              \
+    size_t size;                                                              \
+    type *table;                                                              \
+    CONTAINER_STATS_FIELD                                                     \
+  };                                                                          \
+                                                                              \
+  /**                                                                         \
+   * Forward iterator over the deque, in logical order.                       \
+   *                                                                          \
+   * The iterator remains valid as long as the underlying deque is not        \
+   * structurally modified (push/pop/resize).                                 \
+   */                                                                         \
+  typedef struct {                                                            \
+    int32_t index;                                                            \
+    name *array;                                                              \
+  } name##Iterator;                                                           \
+                                                                              \
+  /* Initialization and lifetime management */                                \
+  bool name##_init_capacity(name *, size_t capacity);                         \
+  bool name##_init(name *);                                                   \
+                                                                              \
+  name *name##_create();                                                      \
+  name *name##_create_capacity(size_t capacity);                              \
+  name *name##_create_copy(const type input[], size_t capacity);              \
+                                                                              \
+  void name##_finalize(name *);                                               \
+  void name##_delete(name *);                                                 \
+  void name##_clear(name *const);                                             \
+                                                                              \
+  /* Capacity management */                                                   \
+  void name##_reserve(name *const, size_t capacity);                          \
+  void name##_shrink_to_fit(name *const);                                     \
+                                                                              \
+  /* Shrinking operations */                                                  \
+  bool name##_lshrink(name *const array, size_t amount);                      \
+  bool name##_rshrink(name *const array, size_t amount);                      \
+                                                                              \
+  /* Front operations */                                                      \
+  void name##_push_front(name *const, type);                                  \
+  type *name##_push_front_ref(name *const);                                   \
+  bool name##_pop_front(name *const array, type *ptr);                        \
+  type name##_pop_front_unchecked(name *const);                               \
+                                                                              \
+  /* Back operations */                                                       \
+  void name##_push_back(name *const, type);                                   \
+  type *name##_push_back_ref(name *const);                                    \
+  bool name##_pop_back(name *const, type *ptr);                               \
+  type name##_pop_back_unchecked(name *const);                                \
+                                                                              \
+  /* Random access mutation */                                                \
+  bool name##_set(name *const, int32_t index, type);                          \
+  bool name##_set_ref(name *const array, int32_t index, type **ptr);          \
+  type *name##_set_ref_unchecked(name *const array, int32_t index);           \
+                                                                              \
+  /* Random access lookup */                                                  \
+  bool name##_get(name *const, int32_t, type *ptr);                           \
+  type name##_get_unchecked(name *const, int32_t);                            \
+  bool name##_get_ref(name *const, int32_t, const type **ptr);                \
+  bool name##_mutable_ref(name *const, int32_t, type **ptr);                  \
+  const type *name##_get_ref_unchecked(name *const, int32_t);                 \
+  type *name##_mutable_ref_unchecked(name *const, int32_t);                   \
+  bool name##_last(name *const, type *ptr);                                   \
+  type name##_last_unchecked(name *const);                                    \
+  bool name##_last_ref(name *const, const type **ptr);                        \
+  const type *name##_last_ref_unchecked(name *const);                         \
+                                                                              \
+  /* Removal */                                                               \
+  bool name##_remove(name *const, int32_t, type *ptr);                        \
+  type name##_remove_unchecked(name *const, int32_t);                         \
+                                                                              \
+  /* Size and state */                                                        \
+  size_t name##_size(const name *const);                                      \
+  bool name##_is_empty(const name *const);                                    \
+  ContainerStats name##_stats(const name *const);                             \
+                                                                              \
+  /* Copying and concatenation */                                             \
+  name *name##_copy(const name *const);                                       \
+  void name##_append(name *const head, const name *const tail);               \
+  bool name##_append_range(name *const head, const name *const tail,          \
+                           int32_t tail_range_start, int32_t tail_range_end); \
+                                                                              \
+  /* Iteration */                                                             \
+  void name##_iterator(name##Iterator *, name *const);                        \
+  bool name##_has_next(const name##Iterator *const);                          \
+  void name##_next(name##Iterator *);                                         \
+  const type *name##_value(const name##Iterator *const);                      \
+  type *name##_mutable_value(const name##Iterator *const)
+
+/**
+ * @macro IMPL_DEQUELIKE
+ *
+ * @brief Generates the implementation for a previously declared deque type.
+ *
+ * This macro must be invoked exactly once per deque type, typically in a
+ * `.c` file. It provides all function definitions declared by
+ * DEFINE_DEQUELIKE.
+ */
+#define IMPL_DEQUELIKE(name, type)                                             \
+                                                                               \
+  /* Maps a logical index to a slot in `table`. */                             \
+  static inline size_t name##_slot(const name *const array, size_t index) {    \
+    return (array->head + index) & (array->capacity - 1);                      \
+  }                                                                            \
+                                                                               \
+  /* Zeroes logical slots [start, end), which may wrap around. */              \
+  static inline void name##_zero_range(name *const array, size_t start,        \
+                                       size_t end) {                           \
+    for (size_t i = start; i < end; ++i) {                                     \
+      memset(array->table + name##_slot(array, i), 0x0, sizeof(type));         \
+    }                                                                          \
+  }                                                                            \
+                                                                               \
+  /* Moves the table to `new_capacity` slots and unwraps it so head == 0. */   \
+  static inline void name##_resize_table(name *const array,                    \
+                                         size_t new_capacity) {                \
+    assert(new_capacity >= array->size);                                       \
+    type *table = (type *)calloc(new_capacity, sizeof(type));                  \
+    assert(table != NULL);                                                     \
+    size_t first = array->capacity - array->head;                              \
+    if (first > array->size) {                                                 \
+      first = array->size;                                                     \
+    }                                                                          \
+    memcpy(table, array->table + array->head, first * sizeof(type));           \
+    memcpy(table + first, array->table, (array->size - first) * sizeof(type)); \
+    free(array->table);                                                        \
+    array->table = table;                                                      \
+    array->capacity = new_capacity;                                            \
+    array->head = 0;                                                           \
+    CONTAINER_STATS_ADD(array, reallocs, 1);                                   \
+    CONTAINER_STATS_MAX(array, peak_capacity, new_capacity);                   \
+  }                                                                            \
+                                                                               \
+  /* Returns false, leaving the deque unchanged, if no capacity fits. */       \
+  static inline bool name##_ensure_capacity(name *const array,                 \
+                                            size_t need_to_accomodate) {       \
+    if (need_to_accomodate > array->capacity) {                                \
+      size_t new_capacity = dequelike_round_capacity(need_to_accomodate);      \
+      if (new_capacity == 0) {                                                 \
+        return false;                                                          \
+      }                                                                        \
+      name##_resize_table(array, new_capacity);                                \
+    }                                                                          \
+    CONTAINER_STATS_MAX(array, peak_size, need_to_accomodate);                 \
+    return true;                                                               \
+  }                                                                            \
+                                                                               \
+  bool name##_init_capacity(name *array, size_t capacity) {                    \
+    size_t rounded = dequelike_round_capacity(capacity);                       \
+    if (capacity == 0 || rounded == 0) {                                       \
+      return false;                                                            \
+    }                                                                          \
+    array->capacity = rounded;                                                 \
+    array->table = (type *)calloc(array->capacity, sizeof(type));              \
+    assert(array->table != NULL);                                              \
+    array->head = 0;                                                           \
+    array->size = 0;                                                           \
+    CONTAINER_STATS_REGISTER(array, #name);                                    \
+    CONTAINER_STATS_MAX(array, peak_capacity, array->capacity);                \
+    return true;                                                               \
+  }                                                                            \
+                                                                               \
+  bool name##_init(name *array) {                                              \
+    return name##_init_capacity(array, DEFAULT_DEQUE_SIZE);                    \
+  }                                                                            \
+                                                                               \
+  name *name##_create() {                                                      \
+    name *array = (name *)malloc(sizeof(name));                                \
+    assert(array != NULL);                                                     \
+    name##_init(array);                                                        \
+    return array;                                                              \
+  }                                                                            \
+                                                                               \
+  name *name##_create_capacity(size_t capacity) {                              \
+    name *array = (name *)malloc(sizeof(name));                                \
+    assert(array != NULL);                                                     \
+    name##_init_capacity(array, capacity);                                     \
+    return array;                                                              \
+  }                                                                            \
+                                                                               \
+  name *name##_create_copy(const type input[], size_t capacity) {              \
+    name *array = (name *)malloc(sizeof(name));                                \
+    assert(array != NULL);                                                     \
+    name##_init_capacity(array, capacity > 0 ? capacity : 1);                  \
+    memcpy(array->table, input, capacity * sizeof(type));                      \
+    array->size = capacity;                                                    \
+    CONTAINER_STATS_MAX(array, peak_size, capacity);                           \
+    return array;                                                              \
+  }                                                                            \
+                                                                               \
+  void name##_finalize(name *array) {                                          \
+    assert(array != NULL);                                                     \
+    free(array->table);                                                        \
+    CONTAINER_STATS_UNREGISTER(array);                                         \
+  }                                                                            \
+                                                                               \
+  void name##_delete(name *array) {                                            \
+    assert(array != NULL);                                                     \
+    name##_finalize(array);                                                    \
+    free(array);                                                               \
+  }                                                                            \
+                                                                               \
+  void name##_clear(name *const array) {                                       \
+    assert(array != NULL);                                                     \
+    array->head = 0;                                                           \
+    array->size = 0;                                                           \
+  }                                                                            \
+                                                                               \
+  void name##_reserve(name *const array, size_t capacity) {                    \
+    assert(array != NULL);                                                     \
+    name##_ensure_capacity(array, capacity);                                   \
+  }                                                                            \
+                                                                               \
+  void name##_shrink_to_fit(name *const array) {                               \
+    assert(array != NULL);                                                     \
+    size_t new_capacity = dequelike_round_capacity(array->size);               \
+    if (new_capacity >= array->capacity) {                                     \
+      return;                                                                  \
+    }                                                                          \
+    name##_resize_table(array, new_capacity);                                  \
+  }                                                                            \
+                                                                               \
+  bool name##_lshrink(name *const array, size_t amount) {                      \
+    assert(array != NULL);                                                     \
+    if (array->size < amount) {                                                \
+      return false;                                                            \
+    }                                                                          \
+    array->head = name##_slot(array, amount);                                  \
+    array->size -= amount;                                                     \
+    return true;                                                               \
+  }                                                                            \
+                                                                               \
+  bool name##_rshrink(name *const array, size_t amount) {                      \
+    assert(array != NULL);                                                     \
+    if (array->size < amount) {                                                \
+      return false;                                                            \
+    }                                                                          \
+    array->size -= amount;                                                     \
+    return true;                                                               \
+  }                                                                            \
+                                                                               \
+  type *name##_push_front_ref(name *const array) {                             \
+    assert(array != NULL);                                                     \
+    name##_ensure_capacity(array, array->size + 1);                            \
+    array->head = (array->head - 1) & (array->capacity - 1);                   \
+    array->size++;                                                             \
+    return array->table + array->head;                                         \
+  }                                                                            \
+                                                                               \
+  void name##_push_front(name *const array, type elt) {                        \
+    *name##_push_front_ref(array) = elt;                                       \
+  }                                                                            \
+                                                                               \
+  type name##_pop_front_unchecked(name *const array) {                         \
+    assert(array != NULL);                                                     \
+    type to_return = array->table[array->head];                                \
+    array->head = name##_slot(array, 1);                                       \
+    array->size--;                                                             \
+    return to_return;                                                          \
+  }                                                                            \
+                                                                               \
+  bool name##_pop_front(name *const array, type *ptr) {                        \
+    assert(array != NULL);                                                     \
+    if (array->size == 0) {                                                    \
+      return false;                                                            \
+    }                                                                          \
+    *ptr = name##_pop_front_unchecked(array);                                  \
+    return true;                                                               \
+  }                                                                            \
+                                                                               \
+  type *name##_push_back_ref(name *const array) {                              \
+    assert(array != NULL);                                                     \
+    name##_ensure_capacity(array, array->size + 1);                            \
+    return array->table + name##_slot(array, array->size++);                   \
+  }                                                                            \
+                                                                               \
+  void name##_push_back(name *const array, type elt) {                         \
+    *name##_push_back_ref(array) = elt;                                        \
+  }                                                                            \
+                                                                               \
+  type name##_pop_back_unchecked(name *const array) {                          \
+    assert(array != NULL);                                                     \
+    return array->table[name##_slot(array, --array->size)];                    \
+  }                                                                            \
+                                                                               \
+  bool name##_pop_back(name *const array, type *ptr) {                         \
+    assert(array != NULL);                                                     \
+    if (array->size == 0) {                                                    \
+      return false;                                                            \
+    }                                                                          \
+    *ptr = name##_pop_back_unchecked(array);                                   \
+    return true;                                                               \
+  }                                                                            \
+                                                                               \
+  type *name##_set_ref_unchecked(name *const array, int32_t index) {           \
+    assert(array != NULL);                                                     \
+    if ((size_t)index >= array->size) {                                        \
+      name##_ensure_capacity(array, index + 1);                                \
+      name##_zero_range(array, array->size, index + 1);                        \
+      array->size = index + 1;                                                 \
+    }                                                                          \
+    return array->table + name##_slot(array, index);                           \
+  }                                                                            \
+                                                                               \
+  bool name##_set(name *const array, int32_t index, type elt) {                \
+    assert(array != NULL);                                                     \
+    if (index < 0) {                                                           \
+      return false;                                                            \
+    }                                                                          \
+    *name##_set_ref_unchecked(array, index) = elt;                             \
+    return true;                                                               \
+  }                                                                            \
+                                                                               \
+  bool name##_set_ref(name *const array, int32_t index, type **ptr) {          \
+    assert(array != NULL);                                                     \
+    if (index < 0) {                                                           \
+      return false;                                                            \
+    }                                                                          \
+    *ptr = name##_set_ref_unchecked(array, index);                             \
+    return true;                                                               \
+  }                                                                            \
+                                                                               \
+  bool name##_get(name *const array, int32_t index, type *ptr) {               \
+    assert(array != NULL);                                                     \
+    if (index < 0 || (size_t)index >= array->size) {                           \
+      return false;                                                            \
+    }                                                                          \
+    *ptr = array->table[name##_slot(array, index)];                            \
+    return true;                                                               \
+  }                                                                            \
+                                                                               \
+  type name##_get_unchecked(name *const array, int32_t index) {                \
+    assert(array != NULL);                                                     \
+    return array->table[name##_slot(array, index)];                            \
+  }                                                                            \
+                                                                               \
+  bool name##_get_ref(name *const array, int32_t index, const type **ptr) {    \
+    if (index < 0 || (size_t)index >= array->size) {                           \
+      return false;                                                            \
+    }                                                                          \
+    *ptr = array->table + name##_slot(array, index);                           \
+    return true;                                                               \
+  }                                                                            \
+                                                                               \
+  bool name##_mutable_ref(name *const array, int32_t index, type **ptr) {      \
+    assert(array != NULL);                                                     \
+    if (index < 0 || (size_t)index >= array->size) {                           \
+      return false;                                                            \
+    }                                                                          \
+    *ptr = array->table + name##_slot(array, index);                           \
+    return true;                                                               \
+  }                                                                            \
+                                                                               \
+  const type *name##_get_ref_unchecked(name *const array, int32_t index) {     \
+    return name##_mutable_ref_unchecked(array, index);                         \
+  }                                                                            \
+                                                                               \
+  type *name##_mutable_ref_unchecked(name *const array, int32_t index) {       \
+    assert(array != NULL);                                                     \
+    return array->table + name##_slot(array, index);                           \
+  }                                                                            \
+                                                                               \
+  bool name##_last(name *const array, type *ptr) {                             \
+    assert(array != NULL);                                                     \
+    return name##_get(array, name##_size(array) - 1, ptr);                     \
+  }                                                                            \
+                                                                               \
+  type name##_last_unchecked(name *const array) {                              \
+    assert(array != NULL);                                                     \
+    return name##_get_unchecked(array, name##_size(array) - 1);                \
+  }                                                                            \
+                                                                               \
+  bool name##_last_ref(name *const array, const type **ptr) {                  \
+    assert(array != NULL);                                                     \
+    return name##_get_ref(array, name##_size(array) - 1, ptr);                 \
+  }                                                                            \
+                                                                               \
+  const type *name##_last_ref_unchecked(name *const array) {                   \
+    assert(array != NULL);                                                     \
+    return name##_get_ref_unchecked(array, name##_size(array) - 1);            \
+  }                                                                            \
+                                                                               \
+  type name##_remove_unchecked(name *const array, int32_t index) {             \
+    assert(array != NULL);                                                     \
+    size_t i = (size_t)index;                                                  \
+    type to_return = array->table[name##_slot(array, i)];                      \
+    if (i < array->size / 2) {                                                 \
+      /* Closer to the front: shift the prefix right by one. */                \
+      CONTAINER_STATS_ADD(array, bytes_moved, i * sizeof(type));               \
+      for (; i > 0; --i) {                                                     \
+        array->table[name##_slot(array, i)] =                                  \
+            array->table[name##_slot(array, i - 1)];                           \
+      }                                                                        \
+      array->head = name##_slot(array, 1);                                     \
+    } else {                                                                   \
+      /* Closer to the back: shift the suffix left by one. */                  \
+      CONTAINER_STATS_ADD(array, bytes_moved,                                  \
+                          (array->size - i - 1) * sizeof(type));               \
+      for (; i + 1 < array->size; ++i) {                                       \
+        array->table[name##_slot(array, i)] =                                  \
+            array->table[name##_slot(array, i + 1)];                           \
+      }                                                                        \
+    }                                                                          \
+    array->size--;                                                             \
+    return to_return;                                                          \
+  }                                                                            \
+                                                                               \
+  bool name##_remove(name *const array, int32_t index, type *ptr) {            \
+    assert(array != NULL);                                                     \
+    if (index < 0 || (size_t)index >= array->size) {                           \
+      return false;                                                            \
+    }                                                                          \
+    *ptr = name##_remove_unchecked(array, index);                              \
+    return true;                                                               \
+  }                                                                            \
+                                                                               \
+  size_t name##_size(const name *const array) {                                \
+    assert(array != NULL);                                                     \
+    return array->size;                                                        \
+  }                                                                            \
+                                                                               \
+  bool name##_is_empty(const name *const array) {                              \
+    assert(array != NULL);                                                     \
+    return array->size == 0;                                                   \
+  }                                                                            \
+                                                                               \
+  ContainerStats name##_stats(const name *const array) {                       \
+    assert(array != NULL);                                                     \
+    return CONTAINER_STATS_GET(array);                                         \
+  }                                                                            \
+                                                                               \
+  name *name##_copy(const name *const array) {                                 \
+    assert(array != NULL);                                                     \
+    name *copy = (name *)malloc(sizeof(name));                                 \
+    assert(copy != NULL);                                                      \
+    *copy = *array;                                                            \
+    copy->table = (type *)malloc(sizeof(type) * array->capacity);              \
+    assert(copy->table != NULL);                                               \
+    memcpy(copy->table, array->table, sizeof(type) * array->capacity);         \
+    CONTAINER_STATS_REGISTER(copy, #name);                                     \
+    CONTAINER_STATS_MAX(copy, peak_size, copy->size);                          \
+    CONTAINER_STATS_MAX(copy, peak_capacity, copy->capacity);                  \
+    return copy;                                                               \
+  }                                                                            \
+                                                                               \
+  bool name##_append_range(name *const head, const name *const tail,           \
+                           int32_t tail_range_start, int32_t tail_range_end) { \
+    assert(head != NULL && tail != NULL);                                      \
+    if (tail_range_start < 0 || tail_range_start > tail_range_end ||           \
+        (size_t)tail_range_end > tail->size) {                                 \
+      return false;                                                            \
+    }                                                                          \
+    name##_ensure_capacity(head,                                               \
+                           head->size + tail_range_end - tail_range_start);    \
+    for (int32_t i = tail_range_start; i < tail_range_end; ++i) {              \
+      head->table[name##_slot(head, head->size++)] =                           \
+          tail->table[name##_slot(tail, i)];                                   \
+    }                                                                          \
+    return true;                                                               \
+  }                                                                            \
+                                                                               \
+  void name##_append(name *const head, const name *const tail) {               \
+    assert(head != NULL && tail != NULL);                                      \
+    name##_append_range(head, tail, 0, (int32_t)tail->size);                   \
+  }                                                                            \
+                                                                               \
+  void name##_iterator(name##Iterator *iter, name *const array) {              \
+    assert(iter != NULL && array != NULL);                                     \
+    iter->index = 0;                                                           \
+    iter->array = array;                                                       \
+  }                                                                            \
+                                                                               \
+  bool name##_has_next(const name##Iterator *const iter) {                     \
+    assert(iter != NULL);                                                      \
+    return (size_t)iter->index < iter->array->size;                            \
+  }                                                                            \
+                                                                               \
+  void name##_next(name##Iterator *iter) {                                     \
+    assert(iter != NULL && (size_t)iter->index < iter->array->size);           \
+    iter->index++;                                                             \
+  }                                                                            \
+                                                                               \
+  const type *name##_value(const name##Iterator *const iter) {                 \
+    assert(iter != NULL);                                                      \
+    return name##_get_ref_unchecked(iter->array, iter->index);                 \
+  }                                                                            \
+                                                                               \
+  type *name##_mutable_value(const name##Iterator *const iter) {               \
+    assert(iter != NULL);                                                      \
+    return name##_mutable_ref_unchecked(iter->array, iter->index);             \
+  }
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* C_DATA_STRUCTURES_DEQUELIKE_H_ */
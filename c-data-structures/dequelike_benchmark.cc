@@ -0,0 +1,117 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <deque>
+
+#include "c-data-structures/dequelike.h"
+
+namespace {
+
+/* Element types used to sweep element size. */
+template <size_t N>
+struct Blob {
+  char bytes[N];
+};
+
+using Blob64 = Blob<64>;
+using Blob256 = Blob<256>;
+
+DEFINE_DEQUELIKE(Int32Deque, int32_t);
+IMPL_DEQUELIKE(Int32Deque, int32_t);
+DEFINE_DEQUELIKE(Blob64Deque, Blob64);
+IMPL_DEQUELIKE(Blob64Deque, Blob64);
+DEFINE_DEQUELIKE(Blob256Deque, Blob256);
+IMPL_DEQUELIKE(Blob256Deque, Blob256);
+
+/* Maps an element type to its generated dequelike so the benchmarks below
+ * can be written once and instantiated per element size. */
+template <typename T>
+struct Ops;
+
+#define DEQUELIKE_OPS(Deque, T)                                           \
+  template <>                                                             \
+  struct Ops<T> {                                                         \
+    using D = Deque;                                                      \
+    static void init(D* d) { Deque##_init(d); }                           \
+    static void finalize(D* d) { Deque##_finalize(d); }                   \
+    static void push_back(D* d, T v) { Deque##_push_back(d, v); }         \
+    static void push_front(D* d, T v) { Deque##_push_front(d, v); }       \
+    static bool pop_front(D* d, T* v) { return Deque##_pop_front(d, v); } \
+  }
+
+DEQUELIKE_OPS(Int32Deque, int32_t);
+DEQUELIKE_OPS(Blob64Deque, Blob64);
+DEQUELIKE_OPS(Blob256Deque, Blob256);
+
+template <typename T>
+void BM_DequeLike_PushFront(benchmark::State& state) {
+  const int64_t n = state.range(0);
+  for (auto _ : state) {
+    typename Ops<T>::D deque;
+    Ops<T>::init(&deque);
+    for (int64_t i = 0; i < n; ++i) {
+      Ops<T>::push_front(&deque, T{});
+    }
+    benchmark::DoNotOptimize(deque.table);
+    Ops<T>::finalize(&deque);
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+/* Steady-state FIFO: n elements in flight, one push_back per pop_front. */
+template <typename T>
+void BM_DequeLike_Fifo(benchmark::State& state) {
+  const int64_t n = state.range(0);
+  typename Ops<T>::D deque;
+  Ops<T>::init(&deque);
+  for (int64_t i = 0; i < n; ++i) {
+    Ops<T>::push_back(&deque, T{});
+  }
+  T value{};
+  for (auto _ : state) {
+    Ops<T>::pop_front(&deque, &value);
+    Ops<T>::push_back(&deque, value);
+  }
+  Ops<T>::finalize(&deque);
+  state.SetItemsProcessed(state.iterations());
+}
+
+template <typename T>
+void BM_StdDeque_PushFront(benchmark::State& state) {
+  const int64_t n = state.range(0);
+  for (auto _ : state) {
+    std::deque<T> d;
+    for (int64_t i = 0; i < n; ++i) {
+      d.push_front(T{});
+    }
+    benchmark::DoNotOptimize(d.front());
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+template <typename T>
+void BM_StdDeque_Fifo(benchmark::State& state) {
+  const int64_t n = state.range(0);
+  std::deque<T> d(n);
+  for (auto _ : state) {
+    T value = d.front();
+    d.pop_front();
+    d.push_back(value);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+#define RANGE RangeMultiplier(8)->Range(64, 1 << 18)
+
+#define REGISTER_FOR_SIZES(bm)            \
+  BENCHMARK_TEMPLATE(bm, int32_t)->RANGE; \
+  BENCHMARK_TEMPLATE(bm, Blob64)->RANGE;  \
+  BENCHMARK_TEMPLATE(bm, Blob256)->RANGE
+
+REGISTER_FOR_SIZES(BM_DequeLike_PushFront);
+REGISTER_FOR_SIZES(BM_StdDeque_PushFront);
+
+REGISTER_FOR_SIZES(BM_DequeLike_Fifo);
+REGISTER_FOR_SIZES(BM_StdDeque_Fifo);
+
+}  // namespace
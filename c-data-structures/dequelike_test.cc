@@ -0,0 +1,278 @@
+#include "c-data-structures/dequelike.h"
+
+#include <gtest/gtest.h>
+
+namespace {
+/* Instantiate a deque type for testing */
+DEFINE_DEQUELIKE(IntDeque, int);
+IMPL_DEQUELIKE(IntDeque, int);
+
+/* Test fixture to ensure proper setup / teardown */
+class IntDequeTest : public ::testing::Test {
+ protected:
+  IntDeque deque{};
+
+  void SetUp() override { ASSERT_TRUE(IntDeque_init(&deque)); }
+
+  void TearDown() override { IntDeque_finalize(&deque); }
+
+  /* Leaves `deque` holding [0, n) with its head in the middle of the table,
+   * so that the elements wrap around the end. */
+  void FillWrapped(int n) {
+    for (int i = 0; i < 5; ++i) {
+      IntDeque_push_back(&deque, -1);
+    }
+    ASSERT_TRUE(IntDeque_lshrink(&deque, 5));
+    for (int i = 0; i < n; ++i) {
+      IntDeque_push_back(&deque, i);
+    }
+  }
+};
+
+/* -------------------------------------------------------------
+ * Initialization and basic state
+ * ------------------------------------------------------------- */
+
+TEST_F(IntDequeTest, StartsEmpty) {
+  EXPECT_TRUE(IntDeque_is_empty(&deque));
+  EXPECT_EQ(IntDeque_size(&deque), 0u);
+}
+
+TEST(IntDequeStandaloneTest, InitCapacityRoundsToPowerOfTwo) {
+  IntDeque deque{};
+  EXPECT_TRUE(IntDeque_init_capacity(&deque, 20));
+  EXPECT_EQ(deque.capacity, 32u);
+  IntDeque_finalize(&deque);
+}
+
+TEST(IntDequeStandaloneTest, InitWithZeroCapacityFails) {
+  IntDeque deque{};
+  EXPECT_FALSE(IntDeque_init_capacity(&deque, 0));
+}
+
+TEST(IntDequeStandaloneTest, InitBeyondLargestPowerOfTwoFails) {
+  IntDeque deque{};
+  EXPECT_FALSE(IntDeque_init_capacity(&deque, SIZE_MAX / 2 + 2));
+  EXPECT_FALSE(IntDeque_init_capacity(&deque, SIZE_MAX));
+}
+
+TEST(IntDequeStandaloneTest, ReserveBeyondLargestPowerOfTwoIsIgnored) {
+  IntDeque deque{};
+  ASSERT_TRUE(IntDeque_init(&deque));
+  IntDeque_push_back(&deque, 1);
+  IntDeque_reserve(&deque, SIZE_MAX);
+  EXPECT_EQ(deque.capacity, (size_t)DEFAULT_DEQUE_SIZE);
+  EXPECT_EQ(IntDeque_get_unchecked(&deque, 0), 1);
+  IntDeque_finalize(&deque);
+}
+
+/* -------------------------------------------------------------
+ * Push / Pop at both ends
+ * ------------------------------------------------------------- */
+
+TEST_F(IntDequeTest, PushBackAndPopBack) {
+  IntDeque_push_back(&deque, 10);
+  IntDeque_push_back(&deque, 20);
+
+  int value = 0;
+  EXPECT_TRUE(IntDeque_pop_back(&deque, &value));
+  EXPECT_EQ(value, 20);
+  EXPECT_TRUE(IntDeque_pop_back(&deque, &value));
+  EXPECT_EQ(value, 10);
+  EXPECT_FALSE(IntDeque_pop_back(&deque, &value));
+}
+
+TEST_F(IntDequeTest, PushFrontAndPopFront) {
+  IntDeque_push_front(&deque, 1);
+  IntDeque_push_front(&deque, 2);
+  IntDeque_push_front(&deque, 3);
+
+  EXPECT_EQ(IntDeque_size(&deque), 3u);
+  EXPECT_EQ(IntDeque_get_unchecked(&deque, 0), 3);
+
+  int value = 0;
+  EXPECT_TRUE(IntDeque_pop_front(&deque, &value));
+  EXPECT_EQ(value, 3);
+  EXPECT_TRUE(IntDeque_pop_front(&deque, &value));
+  EXPECT_EQ(value, 2);
+  EXPECT_TRUE(IntDeque_pop_front(&deque, &value));
+  EXPECT_EQ(value, 1);
+  EXPECT_FALSE(IntDeque_pop_front(&deque, &value));
+}
+
+TEST_F(IntDequeTest, FifoAcrossManyWraparounds) {
+  int next_in = 0;
+  int next_out = 0;
+  for (int round = 0; round < 1000; ++round) {
+    IntDeque_push_back(&deque, next_in++);
+    IntDeque_push_back(&deque, next_in++);
+    EXPECT_EQ(IntDeque_pop_front_unchecked(&deque), next_out++);
+  }
+  EXPECT_EQ(IntDeque_size(&deque), 1000u);
+  int value = 0;
+  while (IntDeque_pop_front(&deque, &value)) {
+    EXPECT_EQ(value, next_out++);
+  }
+  EXPECT_EQ(next_out, next_in);
+}
+
+TEST_F(IntDequeTest, SteadyStateQueueDoesNotGrow) {
+  for (int i = 0; i < 4; ++i) {
+    IntDeque_push_back(&deque, i);
+  }
+  for (int i = 4; i < 10000; ++i) {
+    IntDeque_push_back(&deque, i);
+    EXPECT_EQ(IntDeque_pop_front_unchecked(&deque), i - 4);
+  }
+  EXPECT_EQ(deque.capacity, static_cast<size_t>(DEFAULT_DEQUE_SIZE));
+}
+
+TEST_F(IntDequeTest, GrowWhileWrappedPreservesOrder) {
+  FillWrapped(100);
+  ASSERT_EQ(IntDeque_size(&deque), 100u);
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_EQ(IntDeque_get_unchecked(&deque, i), i);
+  }
+}
+
+TEST_F(IntDequeTest, PushFrontRef) {
+  int* slot = IntDeque_push_front_ref(&deque);
+  ASSERT_NE(slot, nullptr);
+  *slot = 99;
+
+  EXPECT_EQ(IntDeque_size(&deque), 1u);
+  EXPECT_EQ(IntDeque_get_unchecked(&deque, 0), 99);
+}
+
+/* -------------------------------------------------------------
+ * Random access get / set
+ * ------------------------------------------------------------- */
+
+TEST_F(IntDequeTest, SetExpandsDequeWithZeroes) {
+  FillWrapped(2);
+  EXPECT_TRUE(IntDeque_set(&deque, 5, 55));
+  EXPECT_EQ(IntDeque_size(&deque), 6u);
+  EXPECT_EQ(IntDeque_get_unchecked(&deque, 2), 0);
+  EXPECT_EQ(IntDeque_get_unchecked(&deque, 4), 0);
+  EXPECT_EQ(IntDeque_get_unchecked(&deque, 5), 55);
+}
+
+TEST_F(IntDequeTest, SetNegativeIndexFails) {
+  EXPECT_FALSE(IntDeque_set(&deque, -1, 123));
+}
+
+TEST_F(IntDequeTest, GetOutOfRangeFails) {
+  int value = 0;
+  EXPECT_FALSE(IntDeque_get(&deque, 0, &value));
+}
+
+TEST_F(IntDequeTest, LastElementAccess) {
+  FillWrapped(6);
+  int value = 0;
+  EXPECT_TRUE(IntDeque_last(&deque, &value));
+  EXPECT_EQ(value, 5);
+  EXPECT_EQ(IntDeque_last_unchecked(&deque), 5);
+}
+
+/* -------------------------------------------------------------
+ * Removal and shrinking
+ * ------------------------------------------------------------- */
+
+TEST_F(IntDequeTest, RemoveNearFrontAndBack) {
+  FillWrapped(7);
+
+  int removed = 0;
+  EXPECT_TRUE(IntDeque_remove(&deque, 1, &removed));
+  EXPECT_EQ(removed, 1);
+  EXPECT_TRUE(IntDeque_remove(&deque, 4, &removed));
+  EXPECT_EQ(removed, 5);
+
+  const int expected[] = {0, 2, 3, 4, 6};
+  ASSERT_EQ(IntDeque_size(&deque), 5u);
+  for (int i = 0; i < 5; ++i) {
+    EXPECT_EQ(IntDeque_get_unchecked(&deque, i), expected[i]);
+  }
+}
+
+TEST_F(IntDequeTest, RemoveInvalidIndexFails) {
+  int removed = 0;
+  EXPECT_FALSE(IntDeque_remove(&deque, 0, &removed));
+}
+
+TEST_F(IntDequeTest, LeftAndRightShrink) {
+  FillWrapped(6);
+  EXPECT_TRUE(IntDeque_lshrink(&deque, 2));
+  EXPECT_TRUE(IntDeque_rshrink(&deque, 1));
+  EXPECT_FALSE(IntDeque_rshrink(&deque, 4));
+  EXPECT_EQ(IntDeque_size(&deque), 3u);
+  EXPECT_EQ(IntDeque_get_unchecked(&deque, 0), 2);
+  EXPECT_EQ(IntDeque_last_unchecked(&deque), 4);
+}
+
+TEST_F(IntDequeTest, ShrinkToFitUnwraps) {
+  FillWrapped(100);
+  EXPECT_TRUE(IntDeque_lshrink(&deque, 90));
+  IntDeque_shrink_to_fit(&deque);
+  EXPECT_EQ(deque.capacity, 16u);
+  for (int i = 0; i < 10; ++i) {
+    EXPECT_EQ(IntDeque_get_unchecked(&deque, i), 90 + i);
+  }
+}
+
+/* -------------------------------------------------------------
+ * Copying and append
+ * ------------------------------------------------------------- */
+
+TEST_F(IntDequeTest, CopyCreatesIndependentDeque) {
+  FillWrapped(5);
+
+  IntDeque* copy = IntDeque_copy(&deque);
+  ASSERT_NE(copy, nullptr);
+  IntDeque_push_front(&deque, -7);
+
+  ASSERT_EQ(IntDeque_size(copy), 5u);
+  for (int i = 0; i < 5; ++i) {
+    EXPECT_EQ(IntDeque_get_unchecked(copy, i), i);
+  }
+  IntDeque_delete(copy);
+}
+
+TEST_F(IntDequeTest, AppendRange) {
+  IntDeque other{};
+  ASSERT_TRUE(IntDeque_init(&other));
+  for (int i = 0; i < 5; ++i) {
+    IntDeque_push_front(&other, 4 - i);
+  }
+
+  IntDeque_push_back(&deque, -1);
+  EXPECT_TRUE(IntDeque_append_range(&deque, &other, 1, 4));
+  EXPECT_FALSE(IntDeque_append_range(&deque, &other, 1, 6));
+  IntDeque_append(&deque, &other);
+
+  const int expected[] = {-1, 1, 2, 3, 0, 1, 2, 3, 4};
+  ASSERT_EQ(IntDeque_size(&deque), 9u);
+  for (int i = 0; i < 9; ++i) {
+    EXPECT_EQ(IntDeque_get_unchecked(&deque, i), expected[i]);
+  }
+  IntDeque_finalize(&other);
+}
+
+/* -------------------------------------------------------------
+ * Iteration
+ * ------------------------------------------------------------- */
+
+TEST_F(IntDequeTest, IteratorTraversesInLogicalOrder) {
+  FillWrapped(6);
+
+  IntDequeIterator iter{};
+  IntDeque_iterator(&iter, &deque);
+
+  int expected = 0;
+  while (IntDeque_has_next(&iter)) {
+    EXPECT_EQ(*IntDeque_value(&iter), expected++);
+    IntDeque_next(&iter);
+  }
+  EXPECT_EQ(expected, 6);
+}
+
+}  // namespace
@@ -0,0 +1,183 @@
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE /* mremap, fallocate */
+#endif
+
+#include "c-data-structures/file_store.h"
+
+#include <assert.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+static inline size_t round_to_pages(const FileStore *store, size_t size) {
+  if (size == 0) {
+    size = 1;
+  }
+  return (size + store->page_size - 1) & ~(store->page_size - 1);
+}
+
+/* Returns the index of the region mapped at `addr`. */
+static size_t region_index(const FileStore *store, const void *addr) {
+  for (size_t i = store->num_regions; i > 0; --i) {
+    if (store->regions[i - 1].addr == addr) {
+      return i - 1;
+    }
+  }
+  assert(false && "pointer was not allocated by this FileStore");
+  return SIZE_MAX;
+}
+
+static inline bool region_is_last(const FileStore *store,
+                                  const FileStoreRegion *region) {
+  return region->offset + region->length == store->file_size;
+}
+
+static void *file_store_allocate_fn(void *ctx, size_t size) {
+  FileStore *store = (FileStore *)ctx;
+  if (store->num_regions == store->regions_capacity) {
+    size_t capacity =
+        store->regions_capacity == 0 ? 8 : store->regions_capacity * 2;
+    FileStoreRegion *regions = (FileStoreRegion *)realloc(
+        store->regions, capacity * sizeof(FileStoreRegion));
+    if (regions == NULL) {
+      return NULL;
+    }
+    store->regions = regions;
+    store->regions_capacity = capacity;
+  }
+  size_t length = round_to_pages(store, size);
+  size_t offset = store->file_size;
+  if (ftruncate(store->fd, (off_t)(offset + length)) != 0) {
+    return NULL;
+  }
+  void *addr = mmap(NULL, length, PROT_READ | PROT_WRITE, MAP_SHARED,
+                    store->fd, (off_t)offset);
+  if (addr == MAP_FAILED) {
+    (void)ftruncate(store->fd, (off_t)offset);
+    return NULL;
+  }
+  store->file_size = offset + length;
+  FileStoreRegion *region = &store->regions[store->num_regions++];
+  region->addr = addr;
+  region->offset = offset;
+  region->length = length;
+  return addr;
+}
+
+static void file_store_deallocate_fn(void *ctx, void *ptr, size_t size) {
+  (void)size;
+  FileStore *store = (FileStore *)ctx;
+  if (ptr == NULL) {
+    return;
+  }
+  size_t index = region_index(store, ptr);
+  FileStoreRegion region = store->regions[index];
+  munmap(region.addr, region.length);
+  if (region_is_last(store, &region)) {
+    if (ftruncate(store->fd, (off_t)region.offset) == 0) {
+      store->file_size = region.offset;
+    }
+  } else {
+#if defined(__linux__)
+    /* Keep the file sparse; failure only costs disk space. */
+    (void)fallocate(store->fd, FALLOC_FL_PUNCH_HOLE | FALLOC_FL_KEEP_SIZE,
+                    (off_t)region.offset, (off_t)region.length);
+#endif
+  }
+  store->regions[index] = store->regions[--store->num_regions];
+}
+
+/* Grows the region at the end of the file to `length` bytes in place. */
+static void *grow_last_region(FileStore *store, FileStoreRegion *region,
+                              size_t length) {
+  if (ftruncate(store->fd, (off_t)(region->offset + length)) != 0) {
+    return NULL;
+  }
+#if defined(__linux__)
+  void *addr = mremap(region->addr, region->length, length, MREMAP_MAYMOVE);
+#else
+  /* The contents live in the file, so a fresh mapping preserves them. */
+  munmap(region->addr, region->length);
+  void *addr = mmap(NULL, length, PROT_READ | PROT_WRITE, MAP_SHARED,
+                    store->fd, (off_t)region->offset);
+#endif
+  if (addr == MAP_FAILED) {
+    (void)ftruncate(store->fd, (off_t)store->file_size);
+    return NULL;
+  }
+  region->addr = addr;
+  region->length = length;
+  store->file_size = region->offset + length;
+  return addr;
+}
+
+static void *file_store_reallocate_fn(void *ctx, void *ptr, size_t old_size,
+                                      size_t new_size) {
+  FileStore *store = (FileStore *)ctx;
+  if (ptr == NULL) {
+    return file_store_allocate_fn(store, new_size);
+  }
+  FileStoreRegion *region = &store->regions[region_index(store, ptr)];
+  size_t length = round_to_pages(store, new_size);
+  if (length <= region->length) {
+    return ptr;
+  }
+  if (region_is_last(store, region)) {
+    return grow_last_region(store, region, length);
+  }
+  void *moved = file_store_allocate_fn(store, new_size);
+  if (moved != NULL) {
+    memcpy(moved, ptr, old_size);
+    file_store_deallocate_fn(store, ptr, old_size);
+  }
+  return moved;
+}
+
+bool file_store_init(FileStore *store, const char *path) {
+  assert(store != NULL && path != NULL);
+  memset(store, 0x0, sizeof(FileStore));
+  store->fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+  store->page_size = (size_t)sysconf(_SC_PAGESIZE);
+  store->allocator.allocate = file_store_allocate_fn;
+  store->allocator.reallocate = file_store_reallocate_fn;
+  store->allocator.deallocate = file_store_deallocate_fn;
+  store->allocator.ctx = store;
+  return store->fd >= 0;
+}
+
+void file_store_finalize(FileStore *store) {
+  assert(store != NULL);
+  for (size_t i = 0; i < store->num_regions; ++i) {
+    munmap(store->regions[i].addr, store->regions[i].length);
+  }
+  free(store->regions);
+  if (store->fd >= 0) {
+    close(store->fd);
+  }
+  memset(store, 0x0, sizeof(FileStore));
+  store->fd = -1;
+}
+
+bool file_store_sync(FileStore *store) {
+  assert(store != NULL);
+  bool ok = true;
+  for (size_t i = 0; i < store->num_regions; ++i) {
+    if (msync(store->regions[i].addr, store->regions[i].length, MS_SYNC) !=
+        0) {
+      ok = false;
+    }
+  }
+  return ok;
+}
+
+size_t file_store_file_size(const FileStore *store) {
+  assert(store != NULL);
+  return store->file_size;
+}
+
+const Allocator *file_store_allocator(FileStore *store) {
+  assert(store != NULL);
+  return &store->allocator;
+}
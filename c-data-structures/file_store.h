@@ -0,0 +1,98 @@
+#ifndef C_DATA_STRUCTURES_FILE_STORE_H_
+#define C_DATA_STRUCTURES_FILE_STORE_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "c-data-structures/allocator.h"
+
+/**
+ * @file file_store.h
+ *
+ * @brief Allocator that places every allocation in a memory-mapped file.
+ *
+ * A FileStore backs allocations with pages of a sparse file mapped with
+ * MAP_SHARED, so containers can grow past physical memory: the kernel
+ * writes cold pages back to the file instead of to swap, and only the pages
+ * in use stay resident.
+ *
+ * Each allocation is its own page-aligned region of the file:
+ *  - `allocate` extends the file with ftruncate and maps the new range
+ *  - `reallocate` of the region at the end of the file extends the file
+ *    and remaps it in place (mremap on Linux), with no copy; any other
+ *    region is moved to the end of the file
+ *  - `deallocate` unmaps the region and returns its pages to the file
+ *    system, truncating the file or punching a hole in it
+ *
+ * `file_store_allocator` exposes the store through the Allocator interface,
+ * so it can back any container generated with a `_WITH_ALLOC` macro:
+ *  - an arraylike keeps its table as the last region, so it grows in place
+ *  - a stable_arraylike maps each block as a separate region, so element
+ *    addresses stay fixed as it grows
+ *
+ *   FileStore store;
+ *   file_store_init(&store, "/data/records.bin");
+ *   RecordArray records;
+ *   RecordArray_init_allocator(&records, file_store_allocator(&store), 1024);
+ *   ...
+ *   file_store_sync(&store);  // checkpoint dirty pages to the file
+ *
+ * The file is scratch storage for the store's lifetime: it is truncated by
+ * file_store_init and holds no metadata to reopen it with. Use
+ * arraylike_persist.h to save an array in a reloadable format.
+ *
+ * Every region occupies whole pages and costs a system call to map, so the
+ * store suits a few large tables rather than many small allocations. Give
+ * a file-backed stable_arraylike blocks of many pages with
+ * DEFINE_STABLE_ARRAYLIKE_N_WITH_ALLOC. A FileStore is not thread-safe and
+ * must not be moved (copied by value) after file_store_init, since its
+ * Allocator refers back to it.
+ */
+
+/**
+ * A mapped region of the file.
+ */
+typedef struct {
+  void *addr;
+  size_t offset;
+  size_t length;
+} FileStoreRegion;
+
+typedef struct {
+  int fd;
+  size_t file_size;
+  size_t page_size;
+  FileStoreRegion *regions;
+  size_t num_regions;
+  size_t regions_capacity;
+  Allocator allocator;
+} FileStore;
+
+/* Initialization and lifetime management */
+bool file_store_init(FileStore *store, const char *path);
+void file_store_finalize(FileStore *store);
+
+/**
+ * Writes every dirty page back to the file and waits for the writes to
+ * complete. Returns false if any region failed to sync.
+ */
+bool file_store_sync(FileStore *store);
+
+/* Introspection */
+size_t file_store_file_size(const FileStore *store);
+
+/**
+ * Returns an Allocator that allocates from `store`.
+ */
+const Allocator *file_store_allocator(FileStore *store);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* C_DATA_STRUCTURES_FILE_STORE_H_ */
@@ -0,0 +1,107 @@
+#include <benchmark/benchmark.h>
+#include <unistd.h>
+
+#include <cstdint>
+
+#include "c-data-structures/arraylike.h"
+#include "c-data-structures/file_store.h"
+#include "c-data-structures/stable_arraylike.h"
+
+namespace {
+
+DEFINE_ARRAYLIKE_WITH_ALLOC(Int64Array, int64_t);
+IMPL_ARRAYLIKE_WITH_ALLOC(Int64Array, int64_t, allocator_default());
+
+/* 512-KB blocks, so each mapping covers many pages. */
+DEFINE_STABLE_ARRAYLIKE_N_WITH_ALLOC(StableInt64Array, int64_t, 16);
+IMPL_STABLE_ARRAYLIKE_WITH_ALLOC(StableInt64Array, int64_t,
+                                 allocator_default());
+
+constexpr char kPath[] = "/tmp/file_store_benchmark";
+
+/* -------------------------------------------------------------
+ * Appending: anonymous memory vs. a file-backed table
+ * ------------------------------------------------------------- */
+
+void BM_ArrayLike_PushBack_Malloc(benchmark::State& state) {
+  const int64_t n = state.range(0);
+  for (auto _ : state) {
+    Int64Array array;
+    Int64Array_init(&array);
+    for (int64_t i = 0; i < n; ++i) {
+      Int64Array_push_back(&array, i);
+    }
+    benchmark::DoNotOptimize(array.table);
+    Int64Array_finalize(&array);
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+void BM_ArrayLike_PushBack_FileStore(benchmark::State& state) {
+  const int64_t n = state.range(0);
+  FileStore store;
+  file_store_init(&store, kPath);
+  for (auto _ : state) {
+    Int64Array array;
+    Int64Array_init_allocator(&array, file_store_allocator(&store), 16);
+    for (int64_t i = 0; i < n; ++i) {
+      Int64Array_push_back(&array, i);
+    }
+    benchmark::DoNotOptimize(array.table);
+    Int64Array_finalize(&array);
+  }
+  file_store_finalize(&store);
+  unlink(kPath);
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+void BM_StableArrayLike_PushBack_FileStore(benchmark::State& state) {
+  const int64_t n = state.range(0);
+  FileStore store;
+  file_store_init(&store, kPath);
+  for (auto _ : state) {
+    StableInt64Array array;
+    StableInt64Array_init_allocator(&array, file_store_allocator(&store));
+    for (int64_t i = 0; i < n; ++i) {
+      StableInt64Array_push_back(&array, i);
+    }
+    StableInt64Array_finalize(&array);
+  }
+  file_store_finalize(&store);
+  unlink(kPath);
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+/* -------------------------------------------------------------
+ * Checkpointing
+ * ------------------------------------------------------------- */
+
+/* Dirties every page of the table, then syncs it to the file. */
+void BM_FileStore_Sync(benchmark::State& state) {
+  const int64_t n = state.range(0);
+  FileStore store;
+  file_store_init(&store, kPath);
+  Int64Array array;
+  Int64Array_init_allocator(&array, file_store_allocator(&store), n);
+  for (auto _ : state) {
+    for (int64_t i = 0; i < n; ++i) {
+      Int64Array_push_back(&array, i);
+    }
+    file_store_sync(&store);
+    array.size = 0;
+  }
+  Int64Array_finalize(&array);
+  file_store_finalize(&store);
+  unlink(kPath);
+  state.SetBytesProcessed(state.iterations() * n * sizeof(int64_t));
+}
+
+#define RANGE RangeMultiplier(16)->Range(1 << 12, 1 << 22)
+
+BENCHMARK(BM_ArrayLike_PushBack_Malloc)->RANGE;
+BENCHMARK(BM_ArrayLike_PushBack_FileStore)->RANGE;
+BENCHMARK(BM_StableArrayLike_PushBack_FileStore)->RANGE;
+
+BENCHMARK(BM_FileStore_Sync)->RANGE;
+
+}  // namespace
@@ -0,0 +1,163 @@
+#include "c-data-structures/file_store.h"
+
+#include <gtest/gtest.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <string>
+#include <vector>
+
+#include "c-data-structures/arraylike.h"
+#include "c-data-structures/stable_arraylike.h"
+
+namespace {
+
+DEFINE_ARRAYLIKE_WITH_ALLOC(FileIntArray, int);
+IMPL_ARRAYLIKE_WITH_ALLOC(FileIntArray, int, allocator_default());
+
+DEFINE_STABLE_ARRAYLIKE_WITH_ALLOC(FileStableIntArray, int);
+IMPL_STABLE_ARRAYLIKE_WITH_ALLOC(FileStableIntArray, int,
+                                 allocator_default());
+
+/* Test fixture to ensure proper setup / teardown */
+class FileStoreTest : public ::testing::Test {
+ protected:
+  FileStore store{};
+  std::string path;
+
+  void SetUp() override {
+    path = ::testing::TempDir() + "file_store_test_" +
+           ::testing::UnitTest::GetInstance()->current_test_info()->name();
+    ASSERT_TRUE(file_store_init(&store, path.c_str()));
+  }
+
+  void TearDown() override {
+    file_store_finalize(&store);
+    unlink(path.c_str());
+  }
+
+  /* Size of the file as seen by the file system */
+  size_t FileSize() {
+    struct stat st;
+    EXPECT_EQ(stat(path.c_str(), &st), 0);
+    return (size_t)st.st_size;
+  }
+};
+
+/* -------------------------------------------------------------
+ * Allocation
+ * ------------------------------------------------------------- */
+
+TEST(FileStoreInitTest, FailsForUnwritablePath) {
+  FileStore store;
+  EXPECT_FALSE(file_store_init(&store, "/nonexistent-dir/file_store_test"));
+  file_store_finalize(&store);
+}
+
+TEST_F(FileStoreTest, AllocateExtendsFileByWholePages) {
+  const Allocator *allocator = file_store_allocator(&store);
+  EXPECT_EQ(file_store_file_size(&store), 0u);
+  void *a = allocator_allocate(allocator, 100);
+  ASSERT_NE(a, nullptr);
+  EXPECT_EQ(file_store_file_size(&store), store.page_size);
+  EXPECT_EQ((uintptr_t)a % store.page_size, 0u);
+  void *b = allocator_allocate(allocator, store.page_size + 1);
+  ASSERT_NE(b, nullptr);
+  EXPECT_EQ(file_store_file_size(&store), 3 * store.page_size);
+  EXPECT_EQ(FileSize(), 3 * store.page_size);
+  allocator_deallocate(allocator, a, 100);
+  allocator_deallocate(allocator, b, store.page_size + 1);
+}
+
+TEST_F(FileStoreTest, DeallocatingLastRegionTruncatesFile) {
+  const Allocator *allocator = file_store_allocator(&store);
+  void *a = allocator_allocate(allocator, 10);
+  void *b = allocator_allocate(allocator, 10);
+  allocator_deallocate(allocator, b, 10);
+  EXPECT_EQ(file_store_file_size(&store), store.page_size);
+  EXPECT_EQ(FileSize(), store.page_size);
+  allocator_deallocate(allocator, a, 10);
+  EXPECT_EQ(FileSize(), 0u);
+}
+
+TEST_F(FileStoreTest, ReallocateLastRegionGrowsInFile) {
+  const Allocator *allocator = file_store_allocator(&store);
+  int *values = (int *)allocator_allocate(allocator, 16 * sizeof(int));
+  for (int i = 0; i < 16; ++i) {
+    values[i] = i;
+  }
+  values = (int *)allocator_reallocate(allocator, values, 16 * sizeof(int),
+                                       100000 * sizeof(int));
+  ASSERT_NE(values, nullptr);
+  EXPECT_EQ(store.num_regions, 1u);
+  EXPECT_EQ(store.regions[0].offset, 0u);
+  for (int i = 0; i < 16; ++i) {
+    EXPECT_EQ(values[i], i);
+  }
+  values[99999] = 7;
+  allocator_deallocate(allocator, values, 100000 * sizeof(int));
+}
+
+TEST_F(FileStoreTest, ReallocateEarlierRegionMovesIt) {
+  const Allocator *allocator = file_store_allocator(&store);
+  char *a = (char *)allocator_allocate(allocator, 8);
+  void *b = allocator_allocate(allocator, 8);
+  memcpy(a, "payload", 8);
+  char *moved = (char *)allocator_reallocate(allocator, a, 8,
+                                             2 * store.page_size);
+  ASSERT_NE(moved, nullptr);
+  EXPECT_STREQ(moved, "payload");
+  EXPECT_EQ(store.num_regions, 2u);
+  allocator_deallocate(allocator, moved, 2 * store.page_size);
+  allocator_deallocate(allocator, b, 8);
+}
+
+/* -------------------------------------------------------------
+ * Containers
+ * ------------------------------------------------------------- */
+
+TEST_F(FileStoreTest, BacksArrayLike) {
+  FileIntArray array;
+  ASSERT_TRUE(
+      FileIntArray_init_allocator(&array, file_store_allocator(&store), 16));
+  for (int i = 0; i < 1000000; ++i) {
+    FileIntArray_push_back(&array, i);
+  }
+  EXPECT_GE(file_store_file_size(&store), 1000000 * sizeof(int));
+  ASSERT_TRUE(file_store_sync(&store));
+
+  /* The table is the only region, so the file holds the elements. */
+  FILE *file = fopen(path.c_str(), "rb");
+  ASSERT_NE(file, nullptr);
+  std::vector<int> contents(1000000);
+  ASSERT_EQ(fread(contents.data(), sizeof(int), contents.size(), file),
+            contents.size());
+  fclose(file);
+  for (int i = 0; i < 1000000; ++i) {
+    ASSERT_EQ(contents[i], i);
+  }
+  FileIntArray_finalize(&array);
+  EXPECT_EQ(FileSize(), 0u);
+}
+
+TEST_F(FileStoreTest, BacksStableArrayLikeWithFixedAddresses) {
+  FileStableIntArray array;
+  ASSERT_TRUE(
+      FileStableIntArray_init_allocator(&array, file_store_allocator(&store)));
+  std::vector<const int *> refs;
+  for (int i = 0; i < 100000; ++i) {
+    FileStableIntArray_push_back(&array, i);
+    refs.push_back(FileStableIntArray_get_ref_unchecked(&array, i));
+  }
+  for (int i = 0; i < 100000; ++i) {
+    ASSERT_EQ(FileStableIntArray_get_ref_unchecked(&array, i), refs[i]);
+    ASSERT_EQ(*refs[i], i);
+  }
+  EXPECT_TRUE(file_store_sync(&store));
+  FileStableIntArray_finalize(&array);
+  EXPECT_EQ(store.num_regions, 0u);
+}
+
+}  // namespace
\ No newline at end of file
@@ -0,0 +1,561 @@
+#ifndef C_DATA_STRUCTURES_FLAT_MAP_H_
+#define C_DATA_STRUCTURES_FLAT_MAP_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "c-data-structures/arraylike.h"
+#include "c-data-structures/arraylike_sort.h"
+#include "c-data-structures/container_stats.h"
+
+/**
+ * @file flat_map.h
+ *
+ * @brief Sorted-array maps and sets.
+ *
+ * DEFINE_FLAT_MAP / IMPL_FLAT_MAP generate a map from `key_type` to
+ * `value_type`, and DEFINE_FLAT_SET / IMPL_FLAT_SET a set of `type`, stored
+ * as an arraylike kept sorted by key. Compared with hashmap.h they use no
+ * memory beyond the elements themselves, iterate in key order over a
+ * contiguous table, and support ordered queries (`name##_lower_bound`), at
+ * the cost of O(log n) lookups and O(n) single insertions and removals.
+ * They suit small or read-mostly collections that are built or updated in
+ * batches.
+ *
+ * `name##_insert_batch` adds many elements at once: it sorts the batch in
+ * place, then merges it into the table from the back, so each existing
+ * element moves at most once. Inserting m elements into n costs
+ * O(m log m + m log(n / m)) comparisons and O(n + m) moves, instead of the
+ * O(m * n) moves of m single insertions. If the batch holds the same key
+ * more than once, only one of those elements (unspecified which) is kept.
+ *
+ * Keys are ordered by a three-way comparison supplied to IMPL_FLAT_MAP or
+ * IMPL_FLAT_SET as a function-like macro (or function), invoked as
+ * `cmp(a, b)` with two `key_type const *` and returning a negative, zero or
+ * positive int. FLAT_MAP_CMP compares with `<` and FLAT_MAP_CMP_STRING with
+ * strcmp; both work for sets too.
+ *
+ * The elements live in the arraylike `array` (of type `name##Entries` for a
+ * map and `name##Elements` for a set), which must not be modified directly.
+ * Pointers returned by lookups stay valid until the next insertion or
+ * removal. With CONTAINER_STATS defined, `name##_stats` reports that
+ * array's counters plus the number of lookups and of keys compared by their
+ * binary searches (as `lookups` and `probes`).
+ *
+ * Error handling follows arraylike.h: lookups report missing keys through
+ * their result and allocation failures are guarded with `assert`.
+ *
+ * Usage pattern:
+ *
+ *   // In a header or source file:
+ *   DEFINE_FLAT_MAP(RouteMap, uint32_t, int32_t);
+ *
+ *   // In exactly one source file:
+ *   IMPL_FLAT_MAP(RouteMap, uint32_t, int32_t, FLAT_MAP_CMP);
+ *
+ *   // Use as:
+ *   RouteMap routes;
+ *   RouteMap_init(&routes);
+ *   RouteMap_insert_batch(&routes, entries, count);
+ *   int32_t *hop = RouteMap_lookup(&routes, 0x0a000001);
+ */
+
+#define FLAT_MAP_CMP(a, b) ((*(a) > *(b)) - (*(a) < *(b)))
+#define FLAT_MAP_CMP_STRING(a, b) strcmp(*(a), *(b))
+
+/**
+ * @macro DEFINE_FLAT_MAP
+ *
+ * @brief Declares a sorted flat map type and its public API.
+ *
+ * This macro defines:
+ *  - The entry type, `name##Entry`, holding a key and its value
+ *  - The arraylike `name##Entries` of entries and its sort API
+ *  - The map structure and an iterator type
+ *  - Function prototypes for all supported operations
+ *
+ * @param name        Base name for the generated type and functions
+ * @param key_type    Key type
+ * @param value_type  Value type
+ */
+#define DEFINE_FLAT_MAP(name, key_type, value_type)                     \
+                                                                        \
+  typedef struct {                                                      \
+    key_type key;                                                       \
+    value_type value;                                                   \
+  } name##Entry;                                                        \
+                                                                        \
+  _FLAT_DECLARE(name, name##Entry, key_type, name##Entries);            \
+                                                                        \
+  /* Insertion; existing keys get the new value */                      \
+  bool name##_insert(name *const, key_type key, value_type value);      \
+  value_type *name##_upsert(name *const, key_type key, bool *inserted); \
+  size_t name##_insert_batch(name *const, name##Entry entries[],        \
+                             size_t count);                             \
+                                                                        \
+  /* Lookup */                                                          \
+  value_type *name##_lookup(const name *const, key_type key);           \
+  bool name##_get(const name *const, key_type key, value_type *ptr);    \
+                                                                        \
+  /* Removal */                                                         \
+  bool name##_remove(name *const, key_type key, value_type *ptr);       \
+                                                                        \
+  /* Iteration, in key order */                                         \
+  key_type const *name##_key(const name##Iterator *const);              \
+  value_type *name##_value(const name##Iterator *const)
+
+/**
+ * @macro DEFINE_FLAT_SET
+ *
+ * @brief Declares a sorted flat set type and its public API.
+ *
+ * @param name  Base name for the generated type and functions
+ * @param type  Element type
+ */
+#define DEFINE_FLAT_SET(name, type)                                   \
+                                                                      \
+  _FLAT_DECLARE(name, type, type, name##Elements);                    \
+                                                                      \
+  /* Insertion */                                                     \
+  bool name##_insert(name *const, type elt);                          \
+  size_t name##_insert_batch(name *const, type elts[], size_t count); \
+                                                                      \
+  /* Removal */                                                       \
+  bool name##_remove(name *const, type elt);                          \
+                                                                      \
+  /* Iteration, in order */                                           \
+  const type *name##_value(const name##Iterator *const)
+
+/* Declares the parts shared by maps and sets, which store `elt_type`
+ * elements keyed by `key_type` in the arraylike `elements`. */
+#define _FLAT_DECLARE(name, elt_type, key_type, elements)                \
+                                                                         \
+  DEFINE_ARRAYLIKE(elements, elt_type);                                  \
+  DEFINE_ARRAYLIKE_SORT(elements, elt_type);                             \
+                                                                         \
+  /**                                                                    \
+   * Flat map or set structure.                                          \
+   *                                                                     \
+   * - `array` holds the elements, sorted by key, with no duplicate keys \
+   */                                                                    \
+  typedef struct {                                                       \
+    elements array;                                                      \
+  } name;                                                                \
+                                                                         \
+  /**                                                                    \
+   * Iterator over the elements in key order.                            \
+   *                                                                     \
+   * The iterator remains valid as long as no elements are inserted or   \
+   * removed.                                                            \
+   */                                                                    \
+  typedef struct {                                                       \
+    int32_t index;                                                       \
+    const name *flat;                                                    \
+  } name##Iterator;                                                      \
+                                                                         \
+  /* Initialization and lifetime management */                           \
+  bool name##_init(name *);                                              \
+  bool name##_init_capacity(name *, size_t count);                       \
+                                                                         \
+  name *name##_create();                                                 \
+  name *name##_create_capacity(size_t count);                            \
+                                                                         \
+  void name##_finalize(name *);                                          \
+  void name##_delete(name *);                                            \
+  void name##_clear(name *const);                                        \
+                                                                         \
+  /* Capacity management */                                              \
+  void name##_reserve(name *const, size_t count);                        \
+  void name##_shrink_to_fit(name *const);                                \
+                                                                         \
+  /* Ordered lookup */                                                   \
+  bool name##_contains(const name *const, key_type key);                 \
+  int32_t name##_lower_bound(const name *const, key_type key);           \
+  const elt_type *name##_at(const name *const, int32_t index);           \
+                                                                         \
+  /* Size and state */                                                   \
+  size_t name##_size(const name *const);                                 \
+  bool name##_is_empty(const name *const);                               \
+  ContainerStats name##_stats(const name *const);                        \
+                                                                         \
+  /* Iteration */                                                        \
+  void name##_iterator(name##Iterator *, const name *const);             \
+  bool name##_has_next(const name##Iterator *const);                     \
+  void name##_next(name##Iterator *)
+
+/**
+ * @macro IMPL_FLAT_MAP
+ *
+ * @brief Generates the implementation for a previously declared flat map.
+ *
+ * `name##_insert` returns true if the key was new. `name##_upsert` returns
+ * the value for `key`, inserting it with a zeroed value if it is missing.
+ * `name##_insert_batch` sorts `entries` in place and returns the number of
+ * keys that were new.
+ *
+ * @param name        Base name used in DEFINE_FLAT_MAP
+ * @param key_type    Key type used in DEFINE_FLAT_MAP
+ * @param value_type  Value type used in DEFINE_FLAT_MAP
+ * @param cmp         Three-way comparison invoked as `cmp(a, b)` with two
+ *                    `key_type const *`
+ */
+#define IMPL_FLAT_MAP(name, key_type, value_type, cmp)                       \
+                                                                             \
+  _FLAT_IMPLEMENT(name, name##Entry, key_type, name##Entries, _FLAT_MAP_KEY, \
+                  cmp)                                                       \
+                                                                             \
+  value_type *name##_upsert(name *const map, key_type key, bool *inserted) { \
+    assert(map != NULL);                                                     \
+    size_t at = name##_search(map, 0, map->array.size, &key);                \
+    bool found = name##_found(map, at, &key);                                \
+    if (!found) {                                                            \
+      name##Entry entry;                                                     \
+      memset(&entry, 0x0, sizeof(entry));                                    \
+      entry.key = key;                                                       \
+      name##Entries_insert_range(&map->array, (int32_t)at, &entry, 1);       \
+    }                                                                        \
+    if (inserted != NULL) {                                                  \
+      *inserted = !found;                                                    \
+    }                                                                        \
+    return &map->array.table[at].value;                                      \
+  }                                                                          \
+                                                                             \
+  bool name##_insert(name *const map, key_type key, value_type value) {      \
+    bool inserted;                                                           \
+    *name##_upsert(map, key, &inserted) = value;                             \
+    return inserted;                                                         \
+  }                                                                          \
+                                                                             \
+  size_t name##_insert_batch(name *const map, name##Entry entries[],         \
+                             size_t count) {                                 \
+    return name##_merge(map, entries, count);                                \
+  }                                                                          \
+                                                                             \
+  value_type *name##_lookup(const name *const map, key_type key) {           \
+    assert(map != NULL);                                                     \
+    size_t at = name##_search(map, 0, map->array.size, &key);                \
+    return name##_found(map, at, &key) ? &map->array.table[at].value : NULL; \
+  }                                                                          \
+                                                                             \
+  bool name##_get(const name *const map, key_type key, value_type *ptr) {    \
+    value_type *value = name##_lookup(map, key);                             \
+    if (value == NULL) {                                                     \
+      return false;                                                          \
+    }                                                                        \
+    *ptr = *value;                                                           \
+    return true;                                                             \
+  }                                                                          \
+                                                                             \
+  bool name##_remove(name *const map, key_type key, value_type *ptr) {       \
+    assert(map != NULL);                                                     \
+    size_t at = name##_search(map, 0, map->array.size, &key);                \
+    if (!name##_found(map, at, &key)) {                                      \
+      return false;                                                          \
+    }                                                                        \
+    if (ptr != NULL) {                                                       \
+      *ptr = map->array.table[at].value;                                     \
+    }                                                                        \
+    name##Entries_erase_range(&map->array, (int32_t)at, (int32_t)at + 1);    \
+    return true;                                                             \
+  }                                                                          \
+                                                                             \
+  key_type const *name##_key(const name##Iterator *const iter) {             \
+    assert(iter != NULL);                                                    \
+    return &iter->flat->array.table[iter->index].key;                        \
+  }                                                                          \
+                                                                             \
+  value_type *name##_value(const name##Iterator *const iter) {               \
+    assert(iter != NULL);                                                    \
+    return &iter->flat->array.table[iter->index].value;                      \
+  }
+
+/**
+ * @macro IMPL_FLAT_SET
+ *
+ * @brief Generates the implementation for a previously declared flat set.
+ *
+ * `name##_insert` and `name##_remove` return true if the set changed;
+ * `name##_insert` leaves an element that compares equal in place.
+ * `name##_insert_batch` sorts `elts` in place, replaces elements that
+ * compare equal, and returns the number of elements that were new.
+ *
+ * @param name  Base name used in DEFINE_FLAT_SET
+ * @param type  Element type used in DEFINE_FLAT_SET
+ * @param cmp   Three-way comparison invoked as `cmp(a, b)` with two
+ *              `const type *`
+ */
+#define IMPL_FLAT_SET(name, type, cmp)                                     \
+                                                                           \
+  _FLAT_IMPLEMENT(name, type, type, name##Elements, _FLAT_SET_KEY, cmp)    \
+                                                                           \
+  bool name##_insert(name *const set, type elt) {                          \
+    assert(set != NULL);                                                   \
+    size_t at = name##_search(set, 0, set->array.size, &elt);              \
+    if (name##_found(set, at, &elt)) {                                     \
+      return false;                                                        \
+    }                                                                      \
+    name##Elements_insert_range(&set->array, (int32_t)at, &elt, 1);        \
+    return true;                                                           \
+  }                                                                        \
+                                                                           \
+  size_t name##_insert_batch(name *const set, type elts[], size_t count) { \
+    return name##_merge(set, elts, count);                                 \
+  }                                                                        \
+                                                                           \
+  bool name##_remove(name *const set, type elt) {                          \
+    assert(set != NULL);                                                   \
+    size_t at = name##_search(set, 0, set->array.size, &elt);              \
+    if (!name##_found(set, at, &elt)) {                                    \
+      return false;                                                        \
+    }                                                                      \
+    name##Elements_erase_range(&set->array, (int32_t)at, (int32_t)at + 1); \
+    return true;                                                           \
+  }                                                                        \
+                                                                           \
+  const type *name##_value(const name##Iterator *const iter) {             \
+    assert(iter != NULL);                                                  \
+    return &iter->flat->array.table[iter->index];                          \
+  }
+
+/* Key of an element, given a pointer to it. */
+#define _FLAT_MAP_KEY(elt) (&(elt)->key)
+#define _FLAT_SET_KEY(elt) (elt)
+
+/* Generates the parts shared by maps and sets. `key_of(elt)` returns the
+ * `key_type const *` key of a `const elt_type *` element. */
+#define _FLAT_IMPLEMENT(name, elt_type, key_type, elements, key_of, cmp)         \
+                                                                                 \
+  static inline int name##_cmp(key_type const *a, key_type const *b) {           \
+    return (cmp(a, b));                                                          \
+  }                                                                              \
+                                                                                 \
+  static inline bool name##_elt_less(const elt_type *a, const elt_type *b) {     \
+    return name##_cmp(key_of(a), key_of(b)) < 0;                                 \
+  }                                                                              \
+                                                                                 \
+  IMPL_ARRAYLIKE(elements, elt_type)                                             \
+  IMPL_ARRAYLIKE_SORT(elements, elt_type, name##_elt_less)                       \
+                                                                                 \
+  /* Returns the index of the first element in [lo, hi) whose key is not         \
+   * less than `key`, or `hi` if there is none. The answer is always in          \
+   * [base, base + n]; halving without a data-dependent branch lets the          \
+   * compiler use a conditional move instead of mispredicting half the           \
+   * steps. */                                                                   \
+  static inline size_t name##_search(const name *const flat, size_t lo,          \
+                                     size_t hi, key_type const *key) {           \
+    CONTAINER_STATS_ADD(&flat->array, lookups, 1);                               \
+    if (lo == hi) {                                                              \
+      return lo;                                                                 \
+    }                                                                            \
+    const elt_type *base = flat->array.table + lo;                               \
+    size_t n = hi - lo;                                                          \
+    while (n > 1) {                                                              \
+      size_t half = n / 2;                                                       \
+      CONTAINER_STATS_ADD(&flat->array, probes, 1);                              \
+      base = name##_cmp(key_of(&base[half]), key) < 0 ? base + half : base;      \
+      n -= half;                                                                 \
+    }                                                                            \
+    CONTAINER_STATS_ADD(&flat->array, probes, 1);                                \
+    base += name##_cmp(key_of(base), key) < 0;                                   \
+    return (size_t)(base - flat->array.table);                                   \
+  }                                                                              \
+                                                                                 \
+  static inline bool name##_found(const name *const flat, size_t at,             \
+                                  key_type const *key) {                         \
+    return at < flat->array.size &&                                              \
+           name##_cmp(key_of(&flat->array.table[at]), key) == 0;                 \
+  }                                                                              \
+                                                                                 \
+  /* Like name##_search, for an answer expected near `lo`: probes lo,            \
+   * lo + 1, lo + 3, lo + 7, ... before searching the last gap. */               \
+  static inline size_t name##_gallop_forward(const name *const flat,             \
+                                             size_t lo, size_t hi,               \
+                                             key_type const *key) {              \
+    const elt_type *table = flat->array.table;                                   \
+    size_t step = 1;                                                             \
+    while (step < hi - lo &&                                                     \
+           name##_cmp(key_of(&table[lo + step - 1]), key) < 0) {                 \
+      lo += step;                                                                \
+      step *= 2;                                                                 \
+    }                                                                            \
+    return name##_search(flat, lo, step < hi - lo ? lo + step : hi, key);        \
+  }                                                                              \
+                                                                                 \
+  /* Like name##_search, for an answer expected near `hi`. */                    \
+  static inline size_t name##_gallop_back(const name *const flat, size_t lo,     \
+                                          size_t hi, key_type const *key) {      \
+    const elt_type *table = flat->array.table;                                   \
+    size_t step = 1;                                                             \
+    while (step <= hi - lo && name##_cmp(key_of(&table[hi - step]), key) >= 0) { \
+      hi -= step;                                                                \
+      step *= 2;                                                                 \
+    }                                                                            \
+    return name##_search(flat, step <= hi - lo ? hi - step + 1 : lo, hi, key);   \
+  }                                                                              \
+                                                                                 \
+  /* Sorts `batch`, stores the elements whose keys are present and merges        \
+   * the rest in from the back. Returns the number of new keys. */               \
+  static size_t name##_merge(name *const flat, elt_type batch[],                 \
+                             size_t count) {                                     \
+    assert(flat != NULL && (batch != NULL || count == 0));                       \
+    if (count == 0) {                                                            \
+      return 0;                                                                  \
+    }                                                                            \
+    elements##_sort_table(batch, count);                                         \
+                                                                                 \
+    /* Drop duplicate keys, then replace the elements already present and        \
+     * compact the new ones to the front of `batch`, still sorted. */            \
+    size_t unique = 1;                                                           \
+    for (size_t i = 1; i < count; ++i) {                                         \
+      if (name##_cmp(key_of(&batch[unique - 1]), key_of(&batch[i])) != 0) {      \
+        unique++;                                                                \
+      }                                                                          \
+      batch[unique - 1] = batch[i];                                              \
+    }                                                                            \
+    const size_t size = flat->array.size;                                        \
+    size_t added = 0;                                                            \
+    for (size_t i = 0, lo = 0; i < unique; ++i) {                                \
+      lo = name##_gallop_forward(flat, lo, size, key_of(&batch[i]));             \
+      if (name##_found(flat, lo, key_of(&batch[i]))) {                           \
+        flat->array.table[lo] = batch[i];                                        \
+      } else {                                                                   \
+        batch[added++] = batch[i];                                               \
+      }                                                                          \
+    }                                                                            \
+    if (added == 0) {                                                            \
+      return 0;                                                                  \
+    }                                                                            \
+                                                                                 \
+    /* Working back from the largest new key, move each run of existing          \
+     * elements up to its final place in one memmove. */                         \
+    elements##_push_back_n(&flat->array, added);                                 \
+    elt_type *table = flat->array.table;                                         \
+    size_t end = size;                                                           \
+    for (size_t i = added; i > 0; --i) {                                         \
+      size_t at = name##_gallop_back(flat, 0, end, key_of(&batch[i - 1]));       \
+      memmove(table + at + i, table + at, (end - at) * sizeof(elt_type));        \
+      CONTAINER_STATS_ADD(&flat->array, bytes_moved,                             \
+                          (end - at) * sizeof(elt_type));                        \
+      table[at + i - 1] = batch[i - 1];                                          \
+      end = at;                                                                  \
+    }                                                                            \
+    return added;                                                                \
+  }                                                                              \
+                                                                                 \
+  bool name##_init(name *flat) {                                                 \
+    assert(flat != NULL);                                                        \
+    return elements##_init(&flat->array);                                        \
+  }                                                                              \
+                                                                                 \
+  bool name##_init_capacity(name *flat, size_t count) {                          \
+    assert(flat != NULL);                                                        \
+    return elements##_init_capacity(&flat->array,                                \
+                                    count > 0 ? count : DEFAULT_TABLE_SIZE);     \
+  }                                                                              \
+                                                                                 \
+  name *name##_create() {                                                        \
+    name *flat = (name *)malloc(sizeof(name));                                   \
+    assert(flat != NULL);                                                        \
+    name##_init(flat);                                                           \
+    return flat;                                                                 \
+  }                                                                              \
+                                                                                 \
+  name *name##_create_capacity(size_t count) {                                   \
+    name *flat = (name *)malloc(sizeof(name));                                   \
+    assert(flat != NULL);                                                        \
+    name##_init_capacity(flat, count);                                           \
+    return flat;                                                                 \
+  }                                                                              \
+                                                                                 \
+  void name##_finalize(name *flat) {                                             \
+    assert(flat != NULL);                                                        \
+    elements##_finalize(&flat->array);                                           \
+  }                                                                              \
+                                                                                 \
+  void name##_delete(name *flat) {                                               \
+    assert(flat != NULL);                                                        \
+    name##_finalize(flat);                                                       \
+    free(flat);                                                                  \
+  }                                                                              \
+                                                                                 \
+  void name##_clear(name *const flat) {                                          \
+    assert(flat != NULL);                                                        \
+    elements##_clear(&flat->array);                                              \
+  }                                                                              \
+                                                                                 \
+  void name##_reserve(name *const flat, size_t count) {                          \
+    assert(flat != NULL);                                                        \
+    elements##_reserve(&flat->array, count);                                     \
+  }                                                                              \
+                                                                                 \
+  void name##_shrink_to_fit(name *const flat) {                                  \
+    assert(flat != NULL);                                                        \
+    elements##_shrink_to_fit(&flat->array);                                      \
+  }                                                                              \
+                                                                                 \
+  bool name##_contains(const name *const flat, key_type key) {                   \
+    assert(flat != NULL);                                                        \
+    return name##_found(flat, name##_search(flat, 0, flat->array.size, &key),    \
+                        &key);                                                   \
+  }                                                                              \
+                                                                                 \
+  /* Returns the index of the first element whose key is not less than           \
+   * `key`, or the size if there is none. */                                     \
+  int32_t name##_lower_bound(const name *const flat, key_type key) {             \
+    assert(flat != NULL);                                                        \
+    return (int32_t)name##_search(flat, 0, flat->array.size, &key);              \
+  }                                                                              \
+                                                                                 \
+  /* Returns the element at `index` in key order, or NULL if out of range. */    \
+  const elt_type *name##_at(const name *const flat, int32_t index) {             \
+    assert(flat != NULL);                                                        \
+    if (index < 0 || (size_t)index >= flat->array.size) {                        \
+      return NULL;                                                               \
+    }                                                                            \
+    return &flat->array.table[index];                                            \
+  }                                                                              \
+                                                                                 \
+  size_t name##_size(const name *const flat) {                                   \
+    assert(flat != NULL);                                                        \
+    return flat->array.size;                                                     \
+  }                                                                              \
+                                                                                 \
+  bool name##_is_empty(const name *const flat) {                                 \
+    assert(flat != NULL);                                                        \
+    return flat->array.size == 0;                                                \
+  }                                                                              \
+                                                                                 \
+  ContainerStats name##_stats(const name *const flat) {                          \
+    assert(flat != NULL);                                                        \
+    return elements##_stats(&flat->array);                                       \
+  }                                                                              \
+                                                                                 \
+  void name##_iterator(name##Iterator *iter, const name *const flat) {           \
+    assert(iter != NULL && flat != NULL);                                        \
+    iter->index = 0;                                                             \
+    iter->flat = flat;                                                           \
+  }                                                                              \
+                                                                                 \
+  bool name##_has_next(const name##Iterator *const iter) {                       \
+    assert(iter != NULL);                                                        \
+    return (size_t)iter->index < iter->flat->array.size;                         \
+  }                                                                              \
+                                                                                 \
+  void name##_next(name##Iterator *iter) {                                       \
+    assert(iter != NULL && (size_t)iter->index < iter->flat->array.size);        \
+    iter->index++;                                                               \
+  }
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* C_DATA_STRUCTURES_FLAT_MAP_H_ */
@@ -0,0 +1,159 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "c-data-structures/flat_map.h"
+#include "c-data-structures/hashmap.h"
+
+namespace {
+
+DEFINE_FLAT_MAP(U64FlatMap, uint64_t, uint64_t);
+IMPL_FLAT_MAP(U64FlatMap, uint64_t, uint64_t, FLAT_MAP_CMP);
+
+DEFINE_HASHMAP(U64Map, uint64_t, uint64_t);
+IMPL_HASHMAP(U64Map, uint64_t, uint64_t, HASHMAP_HASH_INT, HASHMAP_EQ);
+
+/* Fixed-seed random keys so every run builds the same tables. */
+std::vector<U64FlatMapEntry> RandomEntries(int64_t n, uint64_t seed) {
+  std::mt19937_64 rng(seed);
+  std::vector<U64FlatMapEntry> entries;
+  entries.reserve(n);
+  for (int64_t i = 0; i < n; ++i) {
+    uint64_t key = rng();
+    entries.push_back({key, key});
+  }
+  return entries;
+}
+
+/* -------------------------------------------------------------
+ * Rebuilding in batches
+ * ------------------------------------------------------------- */
+
+/* Grows a map to n entries one insertion at a time. */
+void BM_FlatMap_InsertOneByOne(benchmark::State& state) {
+  const int64_t n = state.range(0);
+  const std::vector<U64FlatMapEntry> entries = RandomEntries(n, 42);
+  for (auto _ : state) {
+    U64FlatMap map;
+    U64FlatMap_init(&map);
+    for (const U64FlatMapEntry& entry : entries) {
+      U64FlatMap_insert(&map, entry.key, entry.value);
+    }
+    benchmark::DoNotOptimize(map.array.table);
+    U64FlatMap_finalize(&map);
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+/* Grows a map to n entries in 8 calls to insert_batch. */
+void BM_FlatMap_InsertBatch(benchmark::State& state) {
+  const int64_t n = state.range(0);
+  const std::vector<U64FlatMapEntry> entries = RandomEntries(n, 42);
+  std::vector<U64FlatMapEntry> batch;
+  for (auto _ : state) {
+    U64FlatMap map;
+    U64FlatMap_init(&map);
+    for (int64_t start = 0; start < n; start += n / 8) {
+      batch.assign(entries.begin() + start, entries.begin() + start + n / 8);
+      U64FlatMap_insert_batch(&map, batch.data(), batch.size());
+    }
+    benchmark::DoNotOptimize(map.array.table);
+    U64FlatMap_finalize(&map);
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+/* -------------------------------------------------------------
+ * Lookup
+ * ------------------------------------------------------------- */
+
+void BM_FlatMap_Lookup(benchmark::State& state) {
+  const int64_t n = state.range(0);
+  std::vector<U64FlatMapEntry> entries = RandomEntries(n, 42);
+  U64FlatMap map;
+  U64FlatMap_init(&map);
+  U64FlatMap_insert_batch(&map, entries.data(), entries.size());
+  /* insert_batch sorted `entries`; look the keys up in random order. */
+  const std::vector<U64FlatMapEntry> probes = RandomEntries(n, 42);
+  for (auto _ : state) {
+    for (const U64FlatMapEntry& probe : probes) {
+      benchmark::DoNotOptimize(U64FlatMap_lookup(&map, probe.key));
+    }
+  }
+  U64FlatMap_finalize(&map);
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+void BM_HashMap_Lookup(benchmark::State& state) {
+  const int64_t n = state.range(0);
+  const std::vector<U64FlatMapEntry> entries = RandomEntries(n, 42);
+  U64Map map;
+  U64Map_init(&map);
+  for (const U64FlatMapEntry& entry : entries) {
+    U64Map_insert(&map, entry.key, entry.value);
+  }
+  for (auto _ : state) {
+    for (const U64FlatMapEntry& entry : entries) {
+      benchmark::DoNotOptimize(U64Map_lookup(&map, entry.key));
+    }
+  }
+  U64Map_finalize(&map);
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+/* -------------------------------------------------------------
+ * Iteration
+ * ------------------------------------------------------------- */
+
+void BM_FlatMap_Iterate(benchmark::State& state) {
+  const int64_t n = state.range(0);
+  std::vector<U64FlatMapEntry> entries = RandomEntries(n, 42);
+  U64FlatMap map;
+  U64FlatMap_init(&map);
+  U64FlatMap_insert_batch(&map, entries.data(), entries.size());
+  for (auto _ : state) {
+    uint64_t sum = 0;
+    U64FlatMapIterator iter;
+    for (U64FlatMap_iterator(&iter, &map); U64FlatMap_has_next(&iter);
+         U64FlatMap_next(&iter)) {
+      sum += *U64FlatMap_value(&iter);
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  U64FlatMap_finalize(&map);
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+void BM_HashMap_Iterate(benchmark::State& state) {
+  const int64_t n = state.range(0);
+  const std::vector<U64FlatMapEntry> entries = RandomEntries(n, 42);
+  U64Map map;
+  U64Map_init(&map);
+  for (const U64FlatMapEntry& entry : entries) {
+    U64Map_insert(&map, entry.key, entry.value);
+  }
+  for (auto _ : state) {
+    uint64_t sum = 0;
+    U64MapIterator iter;
+    for (U64Map_iterator(&iter, &map); U64Map_has_next(&iter);
+         U64Map_next(&iter)) {
+      sum += *U64Map_value(&iter);
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  U64Map_finalize(&map);
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+#define SIZES RangeMultiplier(8)->Range(64, 1 << 15)
+
+BENCHMARK(BM_FlatMap_InsertOneByOne)->SIZES;
+BENCHMARK(BM_FlatMap_InsertBatch)->SIZES;
+BENCHMARK(BM_FlatMap_Lookup)->SIZES;
+BENCHMARK(BM_HashMap_Lookup)->SIZES;
+BENCHMARK(BM_FlatMap_Iterate)->SIZES;
+BENCHMARK(BM_HashMap_Iterate)->SIZES;
+
+}  // namespace
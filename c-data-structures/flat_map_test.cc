@@ -0,0 +1,248 @@
+#include "c-data-structures/flat_map.h"
+
+#include <gtest/gtest.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <map>
+#include <random>
+#include <set>
+#include <vector>
+
+namespace {
+
+DEFINE_FLAT_MAP(IntMap, int, int);
+IMPL_FLAT_MAP(IntMap, int, int, FLAT_MAP_CMP);
+
+DEFINE_FLAT_MAP(StringMap, const char *, int);
+IMPL_FLAT_MAP(StringMap, const char *, int, FLAT_MAP_CMP_STRING);
+
+DEFINE_FLAT_SET(IntSet, int);
+IMPL_FLAT_SET(IntSet, int, FLAT_MAP_CMP);
+
+/* Test fixture to ensure proper setup / teardown */
+class FlatMapTest : public ::testing::Test {
+ protected:
+  IntMap map{};
+
+  void SetUp() override { ASSERT_TRUE(IntMap_init(&map)); }
+
+  void TearDown() override { IntMap_finalize(&map); }
+
+  void ExpectSorted() {
+    for (size_t i = 1; i < IntMap_size(&map); ++i) {
+      ASSERT_LT(map.array.table[i - 1].key, map.array.table[i].key);
+    }
+  }
+};
+
+/* -------------------------------------------------------------
+ * Insertion and lookup
+ * ------------------------------------------------------------- */
+
+TEST_F(FlatMapTest, InitiallyEmpty) {
+  EXPECT_TRUE(IntMap_is_empty(&map));
+  EXPECT_EQ(IntMap_lookup(&map, 1), nullptr);
+  EXPECT_FALSE(IntMap_contains(&map, 1));
+  EXPECT_FALSE(IntMap_remove(&map, 1, nullptr));
+  EXPECT_EQ(IntMap_lower_bound(&map, 1), 0);
+}
+
+TEST_F(FlatMapTest, InsertKeepsKeysSorted) {
+  for (int key : {5, 1, 9, 3, 7}) {
+    EXPECT_TRUE(IntMap_insert(&map, key, key * 10));
+  }
+  EXPECT_EQ(IntMap_size(&map), 5u);
+  ExpectSorted();
+
+  int value;
+  EXPECT_TRUE(IntMap_get(&map, 7, &value));
+  EXPECT_EQ(value, 70);
+  EXPECT_FALSE(IntMap_get(&map, 4, &value));
+}
+
+TEST_F(FlatMapTest, InsertOverwritesExistingKey) {
+  EXPECT_TRUE(IntMap_insert(&map, 7, 1));
+  EXPECT_FALSE(IntMap_insert(&map, 7, 2));
+  EXPECT_EQ(IntMap_size(&map), 1u);
+  EXPECT_EQ(*IntMap_lookup(&map, 7), 2);
+}
+
+TEST_F(FlatMapTest, UpsertReturnsExistingOrZeroedValue) {
+  bool inserted;
+  int *value = IntMap_upsert(&map, 3, &inserted);
+  EXPECT_TRUE(inserted);
+  EXPECT_EQ(*value, 0);
+  *value = 30;
+  EXPECT_EQ(*IntMap_upsert(&map, 3, &inserted), 30);
+  EXPECT_FALSE(inserted);
+}
+
+TEST_F(FlatMapTest, RemoveReturnsValue) {
+  IntMap_insert(&map, 1, 10);
+  IntMap_insert(&map, 2, 20);
+  IntMap_insert(&map, 3, 30);
+  int value;
+  EXPECT_TRUE(IntMap_remove(&map, 2, &value));
+  EXPECT_EQ(value, 20);
+  EXPECT_FALSE(IntMap_contains(&map, 2));
+  EXPECT_EQ(IntMap_size(&map), 2u);
+  EXPECT_FALSE(IntMap_remove(&map, 2, &value));
+  ExpectSorted();
+}
+
+TEST_F(FlatMapTest, LowerBoundAndAt) {
+  for (int key = 0; key < 100; key += 10) {
+    IntMap_insert(&map, key, key);
+  }
+  EXPECT_EQ(IntMap_lower_bound(&map, 30), 3);
+  EXPECT_EQ(IntMap_lower_bound(&map, 31), 4);
+  EXPECT_EQ(IntMap_lower_bound(&map, 1000), 10);
+  ASSERT_NE(IntMap_at(&map, 4), nullptr);
+  EXPECT_EQ(IntMap_at(&map, 4)->key, 40);
+  EXPECT_EQ(IntMap_at(&map, 10), nullptr);
+  EXPECT_EQ(IntMap_at(&map, -1), nullptr);
+}
+
+TEST_F(FlatMapTest, IteratorVisitsKeysInOrder) {
+  for (int key : {4, 2, 8, 6}) {
+    IntMap_insert(&map, key, -key);
+  }
+  std::vector<int> keys;
+  IntMapIterator iter;
+  for (IntMap_iterator(&iter, &map); IntMap_has_next(&iter);
+       IntMap_next(&iter)) {
+    keys.push_back(*IntMap_key(&iter));
+    EXPECT_EQ(*IntMap_value(&iter), -*IntMap_key(&iter));
+  }
+  EXPECT_EQ(keys, (std::vector<int>{2, 4, 6, 8}));
+}
+
+TEST(FlatMapStringTest, StringKeysCompareByContents) {
+  StringMap map;
+  StringMap_init(&map);
+  char key[] = "beta";
+  StringMap_insert(&map, "gamma", 3);
+  StringMap_insert(&map, "alpha", 1);
+  StringMap_insert(&map, key, 2);
+  EXPECT_EQ(*StringMap_lookup(&map, "beta"), 2);
+  EXPECT_STREQ(StringMap_at(&map, 0)->key, "alpha");
+  EXPECT_STREQ(StringMap_at(&map, 2)->key, "gamma");
+  StringMap_finalize(&map);
+}
+
+/* -------------------------------------------------------------
+ * Batch insertion
+ * ------------------------------------------------------------- */
+
+TEST_F(FlatMapTest, InsertBatchIntoEmptyMap) {
+  IntMapEntry batch[] = {{5, 50}, {1, 10}, {3, 30}};
+  EXPECT_EQ(IntMap_insert_batch(&map, batch, 3), 3u);
+  EXPECT_EQ(IntMap_size(&map), 3u);
+  ExpectSorted();
+  EXPECT_EQ(*IntMap_lookup(&map, 3), 30);
+  EXPECT_EQ(IntMap_insert_batch(&map, batch, 0), 0u);
+}
+
+TEST_F(FlatMapTest, InsertBatchMergesAndOverwrites) {
+  for (int key = 0; key < 20; key += 2) {
+    IntMap_insert(&map, key, key);
+  }
+  /* New keys before, between and after the existing ones, plus updates */
+  IntMapEntry batch[] = {{25, 1}, {-1, 1}, {4, 1}, {7, 1}, {8, 1}, {19, 1}};
+  EXPECT_EQ(IntMap_insert_batch(&map, batch, 6), 4u);
+  EXPECT_EQ(IntMap_size(&map), 14u);
+  ExpectSorted();
+  EXPECT_EQ(*IntMap_lookup(&map, -1), 1);
+  EXPECT_EQ(*IntMap_lookup(&map, 4), 1);
+  EXPECT_EQ(*IntMap_lookup(&map, 6), 6);
+  EXPECT_EQ(*IntMap_lookup(&map, 7), 1);
+  EXPECT_EQ(*IntMap_lookup(&map, 25), 1);
+}
+
+TEST_F(FlatMapTest, InsertBatchKeepsOneOfRepeatedKeys) {
+  IntMapEntry batch[] = {{2, 1}, {1, 1}, {2, 2}, {2, 3}, {1, 4}};
+  EXPECT_EQ(IntMap_insert_batch(&map, batch, 5), 2u);
+  EXPECT_EQ(IntMap_size(&map), 2u);
+  ExpectSorted();
+}
+
+TEST_F(FlatMapTest, InsertBatchMatchesStdMap) {
+  std::mt19937 rng(7);
+  std::uniform_int_distribution<int> keys(0, 5000);
+  std::map<int, int> expected;
+  for (int round = 0; round < 20; ++round) {
+    std::vector<IntMapEntry> batch;
+    for (int i = 0; i < 200; ++i) {
+      int key = keys(rng);
+      if (expected.count(key) == 0 &&
+          std::none_of(batch.begin(), batch.end(),
+                       [&](const IntMapEntry &e) { return e.key == key; })) {
+        batch.push_back({key, round});
+      }
+    }
+    for (const IntMapEntry &entry : batch) {
+      expected[entry.key] = entry.value;
+    }
+    EXPECT_EQ(IntMap_insert_batch(&map, batch.data(), batch.size()),
+              batch.size());
+    /* Interleave single operations with batches */
+    int removed = keys(rng);
+    if (IntMap_remove(&map, removed, nullptr)) {
+      expected.erase(removed);
+    }
+  }
+  ASSERT_EQ(IntMap_size(&map), expected.size());
+  size_t i = 0;
+  for (const auto &[key, value] : expected) {
+    ASSERT_EQ(IntMap_at(&map, i)->key, key);
+    ASSERT_EQ(IntMap_at(&map, i)->value, value);
+    i++;
+  }
+}
+
+/* -------------------------------------------------------------
+ * Sets
+ * ------------------------------------------------------------- */
+
+TEST(FlatSetTest, InsertContainsRemove) {
+  IntSet set;
+  IntSet_init(&set);
+  EXPECT_TRUE(IntSet_insert(&set, 3));
+  EXPECT_TRUE(IntSet_insert(&set, 1));
+  EXPECT_FALSE(IntSet_insert(&set, 3));
+  EXPECT_TRUE(IntSet_contains(&set, 1));
+  EXPECT_FALSE(IntSet_contains(&set, 2));
+  EXPECT_TRUE(IntSet_remove(&set, 1));
+  EXPECT_FALSE(IntSet_remove(&set, 1));
+  EXPECT_EQ(IntSet_size(&set), 1u);
+  IntSet_finalize(&set);
+}
+
+TEST(FlatSetTest, InsertBatchMatchesStdSet) {
+  IntSet *set = IntSet_create_capacity(0);
+  std::set<int> expected;
+  std::mt19937 rng(11);
+  std::uniform_int_distribution<int> values(-1000, 1000);
+  for (int round = 0; round < 10; ++round) {
+    std::vector<int> batch;
+    size_t fresh = 0;
+    std::set<int> seen(expected);
+    for (int i = 0; i < 300; ++i) {
+      batch.push_back(values(rng));
+      fresh += seen.insert(batch.back()).second;
+    }
+    expected.insert(batch.begin(), batch.end());
+    EXPECT_EQ(IntSet_insert_batch(set, batch.data(), batch.size()), fresh);
+  }
+  std::vector<int> actual;
+  IntSetIterator iter;
+  for (IntSet_iterator(&iter, set); IntSet_has_next(&iter);
+       IntSet_next(&iter)) {
+    actual.push_back(*IntSet_value(&iter));
+  }
+  EXPECT_EQ(actual, std::vector<int>(expected.begin(), expected.end()));
+  IntSet_delete(set);
+}
+
+}  // namespace
@@ -0,0 +1,573 @@
+#ifndef C_DATA_STRUCTURES_HASHMAP_H_
+#define C_DATA_STRUCTURES_HASHMAP_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "c-data-structures/container_stats.h"
+
+/**
+ * @file hashmap.h
+ *
+ * @brief Macro-based, type-safe open-addressing hash map for C.
+ *
+ * DEFINE_HASHMAP and IMPL_HASHMAP generate a map from `key_type` to
+ * `value_type` that stores keys and values inline in a single table, with no
+ * per-entry allocation and no `void *`.
+ *
+ * The table uses Robin Hood linear probing: an entry being inserted takes
+ * the slot of any entry that sits closer to its home slot, which keeps probe
+ * sequences short and lets a lookup stop as soon as it reaches an entry
+ * closer to home than the key would be. Removal shifts the following
+ * entries of the cluster back by one slot (backward-shift deletion), so
+ * there are no tombstones and lookups never slow down after many removals.
+ *
+ * Each slot has a 32-bit metadata word, kept in its own array so probing
+ * touches one cache line per 16 slots:
+ *  - 0 for an empty slot
+ *  - otherwise `(fragment << 16) | (distance + 1)`, where `distance` is the
+ *    slot's offset from the entry's home slot and `fragment` is 16 bits of
+ *    the entry's hash
+ * A lookup at distance d only compares keys in slots whose metadata equals
+ * the key's own (fragment, d), so `eq` is rarely called on a mismatch.
+ *
+ * Hashing and equality are function-like macros (or functions) supplied to
+ * IMPL_HASHMAP, invoked as `hash(key)` and `eq(a, b)` with `key_type const
+ * *` arguments, and expanded inline. The hash is passed through a 64-bit
+ * finalizer before use, so simple hashes such as the identity are fine.
+ *
+ * Memory management:
+ *  - The capacity is 0 or a power of two, at least HASHMAP_MIN_CAPACITY
+ *  - The table doubles once it is more than 7/8 full, or if a probe
+ *    sequence would exceed 65535 slots
+ *  - `name##_reserve` presizes the table for a number of entries
+ *
+ * With CONTAINER_STATS defined, each map counts its lookups (including
+ * inserts and removals), the slots they probe, and its rehashes, readable
+ * through `name##_stats`.
+ *
+ * Error handling follows arraylike.h: lookups report missing keys through
+ * their result and allocation failures are guarded with `assert`.
+ *
+ * Usage pattern:
+ *
+ *   // In a header or source file:
+ *   DEFINE_HASHMAP(IntMap, int, double);
+ *
+ *   // In exactly one source file:
+ *   IMPL_HASHMAP(IntMap, int, double, HASHMAP_HASH_INT, HASHMAP_EQ);
+ *
+ *   // Use as:
+ *   IntMap map;
+ *   IntMap_init(&map);
+ *   IntMap_insert(&map, 42, 1.5);
+ *   double *value = IntMap_lookup(&map, 42);
+ */
+
+/** Smallest non-zero capacity. Must be a power of two. */
+#define HASHMAP_MIN_CAPACITY 8
+
+/** Longest probe sequence before the table is grown regardless of load. */
+#define HASHMAP_MAX_DISTANCE 65534
+
+/**
+ * 64-bit finalizer (from MurmurHash3) applied to every hash, so that every
+ * output bit depends on every input bit.
+ */
+static inline uint64_t hashmap_mix(uint64_t h) {
+  h ^= h >> 33;
+  h *= 0xff51afd7ed558ccdULL;
+  h ^= h >> 33;
+  h *= 0xc4ceb9fe1a85ec53ULL;
+  h ^= h >> 33;
+  return h;
+}
+
+/** FNV-1a over `size` bytes. */
+static inline uint64_t hashmap_hash_bytes(const void *data, size_t size) {
+  const unsigned char *bytes = (const unsigned char *)data;
+  uint64_t h = 0xcbf29ce484222325ULL;
+  for (size_t i = 0; i < size; ++i) {
+    h = (h ^ bytes[i]) * 0x100000001b3ULL;
+  }
+  return h;
+}
+
+/** FNV-1a over a NUL-terminated string. */
+static inline uint64_t hashmap_hash_string(const char *str) {
+  uint64_t h = 0xcbf29ce484222325ULL;
+  for (; *str != '\0'; ++str) {
+    h = (h ^ (unsigned char)*str) * 0x100000001b3ULL;
+  }
+  return h;
+}
+
+/**
+ * Hash and equality macros for common key types.
+ *
+ *  - HASHMAP_HASH_INT hashes any integer (or enum) key by value
+ *  - HASHMAP_HASH_PTR hashes a pointer key by address
+ *  - HASHMAP_HASH_STRING hashes a `char *` or `const char *` key by contents
+ *  - HASHMAP_HASH_BYTES hashes any key by its object representation; only
+ *    use it for types without padding
+ *  - HASHMAP_EQ compares keys with `==`
+ *  - HASHMAP_EQ_STRING compares string keys with strcmp
+ */
+#define HASHMAP_HASH_INT(key) ((uint64_t)*(key))
+#define HASHMAP_HASH_PTR(key) ((uint64_t)(uintptr_t)*(key))
+#define HASHMAP_HASH_STRING(key) hashmap_hash_string(*(key))
+#define HASHMAP_HASH_BYTES(key) hashmap_hash_bytes((key), sizeof(*(key)))
+#define HASHMAP_EQ(a, b) (*(a) == *(b))
+#define HASHMAP_EQ_STRING(a, b) (strcmp(*(a), *(b)) == 0)
+
+/**
+ * @macro DEFINE_HASHMAP
+ *
+ * @brief Declares a hash map type and its public API.
+ *
+ * This macro defines:
+ *  - The entry type, `name##Entry`, holding a key and its value
+ *  - The map structure
+ *  - An associated iterator type
+ *  - Function prototypes for all supported operations
+ *
+ * Pointers returned by lookups and by `name##_upsert` stay valid until the
+ * next insertion or removal.
+ *
+ * @param name        Base name for the generated type and functions
+ * @param key_type    Key type
+ * @param value_type  Value type
+ */
+#define DEFINE_HASHMAP(name, key_type, value_type)                      \
+                                                                        \
+  typedef struct {                                                      \
+    key_type key;                                                       \
+    value_type value;                                                   \
+  } name##Entry;                                                        \
+                                                                        \
+  /**                                                                   \
+   * Hash map structure.                                                \
+   *                                                                    \
+   * - `capacity` is the number of slots (0 or a power of two)          \
+   * - `size` is the number of entries                                  \
+   * - `meta[i]` describes slot i, as documented in hashmap.h           \
+   * - `entries[i]` holds the entry in slot i when `meta[i] != 0`       \
+   */                                                                   \
+  typedef struct {                                                      \
+    size_t capacity;                                                    \
+    size_t size;                                                        \
+    uint32_t *meta;                                                     \
+    name##Entry *entries;                                               \
+    CONTAINER_STATS_FIELD                                               \
+  } name;                                                               \
+                                                                        \
+  /**                                                                   \
+   * Iterator over the entries, in table order.                         \
+   *                                                                    \
+   * The iterator remains valid as long as no entries are inserted or   \
+   * removed.                                                           \
+   */                                                                   \
+  typedef struct {                                                      \
+    size_t index;                                                       \
+    const name *map;                                                    \
+  } name##Iterator;                                                     \
+                                                                        \
+  /* Initialization and lifetime management */                          \
+  bool name##_init(name *);                                             \
+  bool name##_init_capacity(name *, size_t count);                      \
+                                                                        \
+  name *name##_create();                                                \
+  name *name##_create_capacity(size_t count);                           \
+                                                                        \
+  void name##_finalize(name *);                                         \
+  void name##_delete(name *);                                           \
+  void name##_clear(name *const);                                       \
+                                                                        \
+  /* Capacity management */                                             \
+  void name##_reserve(name *const, size_t count);                       \
+                                                                        \
+  /* Insertion */                                                       \
+  bool name##_insert(name *const, key_type key, value_type value);      \
+  value_type *name##_upsert(name *const, key_type key, bool *inserted); \
+                                                                        \
+  /* Lookup */                                                          \
+  value_type *name##_lookup(const name *const, key_type key);           \
+  bool name##_get(const name *const, key_type key, value_type *ptr);    \
+  bool name##_contains(const name *const, key_type key);                \
+                                                                        \
+  /* Removal */                                                         \
+  bool name##_remove(name *const, key_type key, value_type *ptr);       \
+                                                                        \
+  /* Size and state */                                                  \
+  size_t name##_size(const name *const);                                \
+  bool name##_is_empty(const name *const);                              \
+  ContainerStats name##_stats(const name *const);                       \
+                                                                        \
+  /* Iteration */                                                       \
+  void name##_iterator(name##Iterator *, const name *const);            \
+  bool name##_has_next(const name##Iterator *const);                    \
+  void name##_next(name##Iterator *);                                   \
+  key_type const *name##_key(const name##Iterator *const);              \
+  value_type *name##_value(const name##Iterator *const)
+
+/**
+ * @macro IMPL_HASHMAP
+ *
+ * @brief Generates the implementation for a previously declared map type.
+ *
+ * @param name        Base name used in DEFINE_HASHMAP
+ * @param key_type    Key type used in DEFINE_HASHMAP
+ * @param value_type  Value type used in DEFINE_HASHMAP
+ * @param hash        Hash function invoked as `hash(key)` with a
+ *                    `key_type const *`, returning an integer
+ * @param eq          Equality invoked as `eq(a, b)` with two
+ *                    `key_type const *`
+ */
+#define IMPL_HASHMAP(name, key_type, value_type, hash, eq)                    \
+                                                                              \
+  /* --- Internal Helpers --- */                                              \
+  static inline uint64_t name##_hash(key_type const *key) {                   \
+    return hashmap_mix((uint64_t)(hash(key)));                                \
+  }                                                                           \
+                                                                              \
+  static inline bool name##_eq(key_type const *a, key_type const *b) {        \
+    return (eq(a, b));                                                        \
+  }                                                                           \
+                                                                              \
+  /* Metadata of an entry with hash `h` at distance `distance`. */            \
+  static inline uint32_t name##_meta(uint64_t h, size_t distance) {           \
+    return ((uint32_t)(h >> 48) << 16) | (uint32_t)(distance + 1);            \
+  }                                                                           \
+                                                                              \
+  static inline size_t name##_distance(uint32_t meta) {                       \
+    return (meta & 0xFFFF) - 1;                                               \
+  }                                                                           \
+                                                                              \
+  /* Slots needed to hold `count` entries at a load factor of at most 7/8. */ \
+  static inline size_t name##_capacity_for(size_t count) {                    \
+    size_t capacity = HASHMAP_MIN_CAPACITY;                                   \
+    while (capacity - capacity / 8 < count) {                                 \
+      capacity *= 2;                                                          \
+    }                                                                         \
+    return capacity;                                                          \
+  }                                                                           \
+                                                                              \
+  /* Returns the slot holding `key`, or -1. */                                \
+  static inline int64_t name##_find(const name *const map,                    \
+                                    key_type const *key) {                    \
+    CONTAINER_STATS_ADD(map, lookups, 1);                                     \
+    if (map->size == 0) {                                                     \
+      return -1;                                                              \
+    }                                                                         \
+    const size_t mask = map->capacity - 1;                                    \
+    const uint64_t h = name##_hash(key);                                      \
+    size_t slot = h & mask;                                                   \
+    for (size_t distance = 0;; ++distance, slot = (slot + 1) & mask) {        \
+      uint32_t meta = map->meta[slot];                                        \
+      uint32_t expected = name##_meta(h, distance);                           \
+      if (meta == expected && name##_eq(&map->entries[slot].key, key)) {      \
+        CONTAINER_STATS_ADD(map, probes, distance + 1);                       \
+        return (int64_t)slot;                                                 \
+      }                                                                       \
+      /* Empty, or an entry closer to home than the key would be. */          \
+      if ((meta & 0xFFFF) <= distance) {                                      \
+        CONTAINER_STATS_ADD(map, probes, distance + 1);                       \
+        return -1;                                                            \
+      }                                                                       \
+    }                                                                         \
+  }                                                                           \
+                                                                              \
+  /* Places `entry`, whose metadata at distance 0 would be `meta`, starting   \
+   * at `slot` and `distance`, displacing richer entries. Returns the slot    \
+   * the entry landed in, or -1 if some entry would exceed                    \
+   * HASHMAP_MAX_DISTANCE, in which case the table is unchanged. */           \
+  static int64_t name##_place(name *const map, size_t slot, size_t distance,  \
+                              uint32_t meta, const name##Entry *entry) {      \
+    const size_t mask = map->capacity - 1;                                    \
+    if (distance > HASHMAP_MAX_DISTANCE) {                                    \
+      return -1;                                                              \
+    }                                                                         \
+    /* Find the empty slot that ends the run first, so a failure leaves the   \
+     * table untouched. */                                                    \
+    size_t end = slot;                                                        \
+    for (; map->meta[end] != 0; end = (end + 1) & mask) {                     \
+      if (name##_distance(map->meta[end]) >= HASHMAP_MAX_DISTANCE) {          \
+        return -1;                                                            \
+      }                                                                       \
+    }                                                                         \
+    /* Shift the run [slot, end) right by one slot, then insert at `slot`.    \
+     * Robin Hood order is preserved because every shifted entry moves one    \
+     * step further from home. */                                             \
+    for (size_t at = end; at != slot; at = (at - 1) & mask) {                 \
+      size_t from = (at - 1) & mask;                                          \
+      map->meta[at] = map->meta[from] + 1;                                    \
+      map->entries[at] = map->entries[from];                                  \
+    }                                                                         \
+    map->meta[slot] = (meta & ~(uint32_t)0xFFFF) | (uint32_t)(distance + 1);  \
+    map->entries[slot] = *entry;                                              \
+    return (int64_t)slot;                                                     \
+  }                                                                           \
+                                                                              \
+  /* Inserts an entry whose key is known to be absent. */                     \
+  static int64_t name##_insert_new(name *const map, uint64_t h,               \
+                                   const name##Entry *entry) {                \
+    const size_t mask = map->capacity - 1;                                    \
+    size_t slot = h & mask;                                                   \
+    size_t distance = 0;                                                      \
+    while (map->meta[slot] != 0 &&                                            \
+           name##_distance(map->meta[slot]) >= distance) {                    \
+      slot = (slot + 1) & mask;                                               \
+      distance++;                                                             \
+    }                                                                         \
+    return name##_place(map, slot, distance, name##_meta(h, 0), entry);       \
+  }                                                                           \
+                                                                              \
+  static void name##_rehash(name *const map, size_t capacity) {               \
+    uint32_t *old_meta = map->meta;                                           \
+    name##Entry *old_entries = map->entries;                                  \
+    size_t old_capacity = map->capacity;                                      \
+    for (;; capacity *= 2) {                                                  \
+      map->meta = (uint32_t *)calloc(capacity, sizeof(uint32_t));             \
+      map->entries = (name##Entry *)malloc(capacity * sizeof(name##Entry));   \
+      assert(map->meta != NULL && map->entries != NULL);                      \
+      map->capacity = capacity;                                               \
+      bool placed_all = true;                                                 \
+      for (size_t i = 0; i < old_capacity && placed_all; ++i) {               \
+        if (old_meta[i] != 0) {                                               \
+          const name##Entry *entry = &old_entries[i];                         \
+          uint64_t h = name##_hash(&entry->key);                              \
+          placed_all = name##_insert_new(map, h, entry) >= 0;                 \
+        }                                                                     \
+      }                                                                       \
+      if (placed_all) {                                                       \
+        break;                                                                \
+      }                                                                       \
+      free(map->meta);                                                        \
+      free(map->entries);                                                     \
+    }                                                                         \
+    free(old_meta);                                                           \
+    free(old_entries);                                                        \
+    CONTAINER_STATS_ADD(map, reallocs, 1);                                    \
+    CONTAINER_STATS_MAX(map, peak_capacity, map->capacity);                   \
+  }                                                                           \
+                                                                              \
+  /* --- Initialization and lifetime management --- */                        \
+  bool name##_init(name *map) {                                               \
+    map->capacity = 0;                                                        \
+    map->size = 0;                                                            \
+    map->meta = NULL;                                                         \
+    map->entries = NULL;                                                      \
+    CONTAINER_STATS_REGISTER(map, #name);                                     \
+    return true;                                                              \
+  }                                                                           \
+                                                                              \
+  bool name##_init_capacity(name *map, size_t count) {                        \
+    name##_init(map);                                                         \
+    name##_reserve(map, count);                                               \
+    return true;                                                              \
+  }                                                                           \
+                                                                              \
+  name *name##_create() {                                                     \
+    name *map = (name *)malloc(sizeof(name));                                 \
+    assert(map != NULL);                                                      \
+    name##_init(map);                                                         \
+    return map;                                                               \
+  }                                                                           \
+                                                                              \
+  name *name##_create_capacity(size_t count) {                                \
+    name *map = (name *)malloc(sizeof(name));                                 \
+    assert(map != NULL);                                                      \
+    name##_init_capacity(map, count);                                         \
+    return map;                                                               \
+  }                                                                           \
+                                                                              \
+  void name##_finalize(name *map) {                                           \
+    assert(map != NULL);                                                      \
+    free(map->meta);                                                          \
+    free(map->entries);                                                       \
+    CONTAINER_STATS_UNREGISTER(map);                                          \
+    map->capacity = 0;                                                        \
+    map->size = 0;                                                            \
+    map->meta = NULL;                                                         \
+    map->entries = NULL;                                                      \
+  }                                                                           \
+                                                                              \
+  void name##_delete(name *map) {                                             \
+    assert(map != NULL);                                                      \
+    name##_finalize(map);                                                     \
+    free(map);                                                                \
+  }                                                                           \
+                                                                              \
+  void name##_clear(name *const map) {                                        \
+    assert(map != NULL);                                                      \
+    if (map->capacity > 0) {                                                  \
+      memset(map->meta, 0x0, map->capacity * sizeof(uint32_t));               \
+    }                                                                         \
+    map->size = 0;                                                            \
+  }                                                                           \
+                                                                              \
+  /* --- Capacity management --- */                                           \
+  void name##_reserve(name *const map, size_t count) {                        \
+    assert(map != NULL);                                                      \
+    size_t capacity = name##_capacity_for(count);                             \
+    if (capacity > map->capacity) {                                           \
+      name##_rehash(map, capacity);                                           \
+    }                                                                         \
+  }                                                                           \
+                                                                              \
+  /* --- Insertion --- */                                                     \
+  value_type *name##_upsert(name *const map, key_type key, bool *inserted) {  \
+    assert(map != NULL);                                                      \
+    if (map->capacity - map->capacity / 8 <= map->size) {                     \
+      name##_rehash(map, map->capacity == 0 ? HASHMAP_MIN_CAPACITY            \
+                                            : map->capacity * 2);             \
+    }                                                                         \
+    const uint64_t h = name##_hash(&key);                                     \
+    CONTAINER_STATS_ADD(map, lookups, 1);                                     \
+    for (;;) {                                                                \
+      const size_t mask = map->capacity - 1;                                  \
+      size_t slot = h & mask;                                                 \
+      size_t distance = 0;                                                    \
+      for (;; ++distance, slot = (slot + 1) & mask) {                         \
+        uint32_t meta = map->meta[slot];                                      \
+        uint32_t expected = name##_meta(h, distance);                         \
+        if (meta == expected && name##_eq(&map->entries[slot].key, &key)) {   \
+          CONTAINER_STATS_ADD(map, probes, distance + 1);                     \
+          if (inserted != NULL) *inserted = false;                            \
+          return &map->entries[slot].value;                                   \
+        }                                                                     \
+        if ((meta & 0xFFFF) <= distance) {                                    \
+          CONTAINER_STATS_ADD(map, probes, distance + 1);                     \
+          break;                                                              \
+        }                                                                     \
+      }                                                                       \
+      /* Not present: claim this slot, displacing the richer entries. */      \
+      name##Entry entry;                                                      \
+      memset(&entry, 0x0, sizeof(entry));                                     \
+      entry.key = key;                                                        \
+      int64_t placed = name##_place(map, slot, distance, name##_meta(h, 0),   \
+                                    &entry);                                  \
+      if (placed >= 0) {                                                      \
+        map->size++;                                                          \
+        CONTAINER_STATS_MAX(map, peak_size, map->size);                       \
+        if (inserted != NULL) *inserted = true;                               \
+        return &map->entries[placed].value;                                   \
+      }                                                                       \
+      name##_rehash(map, map->capacity * 2);                                  \
+    }                                                                         \
+  }                                                                           \
+                                                                              \
+  bool name##_insert(name *const map, key_type key, value_type value) {       \
+    bool inserted;                                                            \
+    *name##_upsert(map, key, &inserted) = value;                              \
+    return inserted;                                                          \
+  }                                                                           \
+                                                                              \
+  /* --- Lookup --- */                                                        \
+  value_type *name##_lookup(const name *const map, key_type key) {            \
+    assert(map != NULL);                                                      \
+    int64_t slot = name##_find(map, &key);                                    \
+    return slot < 0 ? NULL : &map->entries[slot].value;                       \
+  }                                                                           \
+                                                                              \
+  bool name##_get(const name *const map, key_type key, value_type *ptr) {     \
+    value_type *value = name##_lookup(map, key);                              \
+    if (value == NULL) {                                                      \
+      return false;                                                           \
+    }                                                                         \
+    if (ptr != NULL) {                                                        \
+      *ptr = *value;                                                          \
+    }                                                                         \
+    return true;                                                              \
+  }                                                                           \
+                                                                              \
+  bool name##_contains(const name *const map, key_type key) {                 \
+    assert(map != NULL);                                                      \
+    return name##_find(map, &key) >= 0;                                       \
+  }                                                                           \
+                                                                              \
+  /* --- Removal --- */                                                       \
+  bool name##_remove(name *const map, key_type key, value_type *ptr) {        \
+    assert(map != NULL);                                                      \
+    int64_t found = name##_find(map, &key);                                   \
+    if (found < 0) {                                                          \
+      return false;                                                           \
+    }                                                                         \
+    if (ptr != NULL) {                                                        \
+      *ptr = map->entries[found].value;                                       \
+    }                                                                         \
+    /* Backward-shift the rest of the cluster into the hole. */               \
+    const size_t mask = map->capacity - 1;                                    \
+    size_t hole = (size_t)found;                                              \
+    size_t next = (hole + 1) & mask;                                          \
+    while (map->meta[next] != 0 && name##_distance(map->meta[next]) > 0) {    \
+      map->meta[hole] = map->meta[next] - 1;                                  \
+      map->entries[hole] = map->entries[next];                                \
+      hole = next;                                                            \
+      next = (next + 1) & mask;                                               \
+    }                                                                         \
+    map->meta[hole] = 0;                                                      \
+    map->size--;                                                              \
+    return true;                                                              \
+  }                                                                           \
+                                                                              \
+  /* --- Size and state --- */                                                \
+  size_t name##_size(const name *const map) {                                 \
+    assert(map != NULL);                                                      \
+    return map->size;                                                         \
+  }                                                                           \
+                                                                              \
+  bool name##_is_empty(const name *const map) {                               \
+    assert(map != NULL);                                                      \
+    return map->size == 0;                                                    \
+  }                                                                           \
+                                                                              \
+  ContainerStats name##_stats(const name *const map) {                        \
+    assert(map != NULL);                                                      \
+    return CONTAINER_STATS_GET(map);                                          \
+  }                                                                           \
+                                                                              \
+  /* --- Iteration --- */                                                     \
+  static inline size_t name##_skip_empty(const name *const map,               \
+                                         size_t index) {                      \
+    while (index < map->capacity && map->meta[index] == 0) {                  \
+      index++;                                                                \
+    }                                                                         \
+    return index;                                                             \
+  }                                                                           \
+                                                                              \
+  void name##_iterator(name##Iterator *it, const name *const map) {           \
+    assert(it != NULL && map != NULL);                                        \
+    it->map = map;                                                            \
+    it->index = name##_skip_empty(map, 0);                                    \
+  }                                                                           \
+                                                                              \
+  bool name##_has_next(const name##Iterator *const it) {                      \
+    return it->index < it->map->capacity;                                     \
+  }                                                                           \
+                                                                              \
+  void name##_next(name##Iterator *it) {                                      \
+    it->index = name##_skip_empty(it->map, it->index + 1);                    \
+  }                                                                           \
+                                                                              \
+  key_type const *name##_key(const name##Iterator *const it) {                \
+    return &it->map->entries[it->index].key;                                  \
+  }                                                                           \
+                                                                              \
+  value_type *name##_value(const name##Iterator *const it) {                  \
+    return &it->map->entries[it->index].value;                                \
+  }
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* C_DATA_STRUCTURES_HASHMAP_H_ */
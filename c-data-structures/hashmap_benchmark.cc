@@ -0,0 +1,164 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+#include "c-data-structures/hashmap.h"
+
+namespace {
+
+DEFINE_HASHMAP(U64Map, uint64_t, uint64_t);
+IMPL_HASHMAP(U64Map, uint64_t, uint64_t, HASHMAP_HASH_INT, HASHMAP_EQ);
+
+/* Fixed-seed random keys so every run probes the same tables. */
+std::vector<uint64_t> RandomKeys(int64_t n, uint64_t seed) {
+  std::mt19937_64 rng(seed);
+  std::vector<uint64_t> keys;
+  keys.reserve(n);
+  for (int64_t i = 0; i < n; ++i) {
+    keys.push_back(rng());
+  }
+  return keys;
+}
+
+/* -------------------------------------------------------------
+ * Insertion
+ * ------------------------------------------------------------- */
+
+void BM_HashMap_Insert(benchmark::State& state) {
+  const int64_t n = state.range(0);
+  const std::vector<uint64_t> keys = RandomKeys(n, 42);
+  for (auto _ : state) {
+    U64Map map;
+    U64Map_init(&map);
+    for (uint64_t key : keys) {
+      U64Map_insert(&map, key, key);
+    }
+    benchmark::DoNotOptimize(map.entries);
+    U64Map_finalize(&map);
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+void BM_HashMap_InsertReserved(benchmark::State& state) {
+  const int64_t n = state.range(0);
+  const std::vector<uint64_t> keys = RandomKeys(n, 42);
+  for (auto _ : state) {
+    U64Map map;
+    U64Map_init_capacity(&map, n);
+    for (uint64_t key : keys) {
+      U64Map_insert(&map, key, key);
+    }
+    benchmark::DoNotOptimize(map.entries);
+    U64Map_finalize(&map);
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+void BM_UnorderedMap_Insert(benchmark::State& state) {
+  const int64_t n = state.range(0);
+  const std::vector<uint64_t> keys = RandomKeys(n, 42);
+  for (auto _ : state) {
+    std::unordered_map<uint64_t, uint64_t> map;
+    for (uint64_t key : keys) {
+      map[key] = key;
+    }
+    benchmark::DoNotOptimize(map.size());
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+/* -------------------------------------------------------------
+ * Lookup
+ * ------------------------------------------------------------- */
+
+/* range(1) selects hits (1) or misses (0). */
+void BM_HashMap_Lookup(benchmark::State& state) {
+  const int64_t n = state.range(0);
+  const std::vector<uint64_t> keys = RandomKeys(n, 42);
+  const std::vector<uint64_t> probes =
+      state.range(1) ? keys : RandomKeys(n, 7);
+  U64Map map;
+  U64Map_init(&map);
+  for (uint64_t key : keys) {
+    U64Map_insert(&map, key, key);
+  }
+  for (auto _ : state) {
+    for (uint64_t key : probes) {
+      benchmark::DoNotOptimize(U64Map_lookup(&map, key));
+    }
+  }
+  U64Map_finalize(&map);
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+void BM_UnorderedMap_Lookup(benchmark::State& state) {
+  const int64_t n = state.range(0);
+  const std::vector<uint64_t> keys = RandomKeys(n, 42);
+  const std::vector<uint64_t> probes =
+      state.range(1) ? keys : RandomKeys(n, 7);
+  std::unordered_map<uint64_t, uint64_t> map;
+  for (uint64_t key : keys) {
+    map[key] = key;
+  }
+  for (auto _ : state) {
+    for (uint64_t key : probes) {
+      benchmark::DoNotOptimize(map.find(key));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+/* -------------------------------------------------------------
+ * Removal
+ * ------------------------------------------------------------- */
+
+void BM_HashMap_InsertRemove(benchmark::State& state) {
+  const int64_t n = state.range(0);
+  const std::vector<uint64_t> keys = RandomKeys(n, 42);
+  U64Map map;
+  U64Map_init(&map);
+  for (auto _ : state) {
+    for (uint64_t key : keys) {
+      U64Map_insert(&map, key, key);
+    }
+    for (uint64_t key : keys) {
+      U64Map_remove(&map, key, nullptr);
+    }
+  }
+  U64Map_finalize(&map);
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+void BM_UnorderedMap_InsertRemove(benchmark::State& state) {
+  const int64_t n = state.range(0);
+  const std::vector<uint64_t> keys = RandomKeys(n, 42);
+  std::unordered_map<uint64_t, uint64_t> map;
+  for (auto _ : state) {
+    for (uint64_t key : keys) {
+      map[key] = key;
+    }
+    for (uint64_t key : keys) {
+      map.erase(key);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+#define RANGE RangeMultiplier(8)->Range(64, 1 << 20)
+#define LOOKUP_RANGE \
+  ArgsProduct({benchmark::CreateRange(64, 1 << 20, 8), {0, 1}})
+
+BENCHMARK(BM_HashMap_Insert)->RANGE;
+BENCHMARK(BM_HashMap_InsertReserved)->RANGE;
+BENCHMARK(BM_UnorderedMap_Insert)->RANGE;
+
+BENCHMARK(BM_HashMap_Lookup)->LOOKUP_RANGE;
+BENCHMARK(BM_UnorderedMap_Lookup)->LOOKUP_RANGE;
+
+BENCHMARK(BM_HashMap_InsertRemove)->RANGE;
+BENCHMARK(BM_UnorderedMap_InsertRemove)->RANGE;
+
+}  // namespace
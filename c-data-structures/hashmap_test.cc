@@ -0,0 +1,272 @@
+#include "c-data-structures/hashmap.h"
+
+#include <gtest/gtest.h>
+#include <stdint.h>
+
+#include <random>
+#include <string>
+#include <unordered_map>
+
+namespace {
+
+DEFINE_HASHMAP(IntMap, int, int);
+IMPL_HASHMAP(IntMap, int, int, HASHMAP_HASH_INT, HASHMAP_EQ);
+
+DEFINE_HASHMAP(StringMap, const char *, int);
+IMPL_HASHMAP(StringMap, const char *, int, HASHMAP_HASH_STRING,
+             HASHMAP_EQ_STRING);
+
+/* Every key lands in the same home slot, forcing long clusters */
+#define CONSTANT_HASH(key) ((void)(key), (uint64_t)0)
+DEFINE_HASHMAP(CollidingMap, int, int);
+IMPL_HASHMAP(CollidingMap, int, int, CONSTANT_HASH, HASHMAP_EQ);
+
+/* Test fixture to ensure proper setup / teardown */
+class IntMapTest : public ::testing::Test {
+ protected:
+  IntMap map{};
+
+  void SetUp() override { ASSERT_TRUE(IntMap_init(&map)); }
+
+  void TearDown() override { IntMap_finalize(&map); }
+};
+
+/* -------------------------------------------------------------
+ * Insertion and lookup
+ * ------------------------------------------------------------- */
+
+TEST_F(IntMapTest, InitiallyEmpty) {
+  EXPECT_TRUE(IntMap_is_empty(&map));
+  EXPECT_EQ(IntMap_size(&map), 0u);
+  EXPECT_EQ(IntMap_lookup(&map, 1), nullptr);
+  EXPECT_FALSE(IntMap_contains(&map, 1));
+  EXPECT_FALSE(IntMap_remove(&map, 1, nullptr));
+}
+
+TEST_F(IntMapTest, InsertAndLookup) {
+  EXPECT_TRUE(IntMap_insert(&map, 1, 10));
+  EXPECT_TRUE(IntMap_insert(&map, 2, 20));
+
+  ASSERT_NE(IntMap_lookup(&map, 1), nullptr);
+  EXPECT_EQ(*IntMap_lookup(&map, 1), 10);
+  int value;
+  EXPECT_TRUE(IntMap_get(&map, 2, &value));
+  EXPECT_EQ(value, 20);
+  EXPECT_FALSE(IntMap_get(&map, 3, &value));
+  EXPECT_EQ(IntMap_size(&map), 2u);
+}
+
+TEST_F(IntMapTest, InsertOverwritesExistingKey) {
+  EXPECT_TRUE(IntMap_insert(&map, 7, 1));
+  EXPECT_FALSE(IntMap_insert(&map, 7, 2));
+  EXPECT_EQ(*IntMap_lookup(&map, 7), 2);
+  EXPECT_EQ(IntMap_size(&map), 1u);
+}
+
+TEST_F(IntMapTest, UpsertReturnsExistingOrZeroedValue) {
+  bool inserted;
+  int *value = IntMap_upsert(&map, 5, &inserted);
+  EXPECT_TRUE(inserted);
+  EXPECT_EQ(*value, 0);
+  *value += 3;
+
+  value = IntMap_upsert(&map, 5, &inserted);
+  EXPECT_FALSE(inserted);
+  EXPECT_EQ(*value, 3);
+  EXPECT_EQ(IntMap_size(&map), 1u);
+}
+
+TEST_F(IntMapTest, GrowsPastInitialCapacity) {
+  for (int i = 0; i < 10000; ++i) {
+    IntMap_insert(&map, i, i * 2);
+  }
+  EXPECT_EQ(IntMap_size(&map), 10000u);
+  EXPECT_LE(IntMap_size(&map), map.capacity - map.capacity / 8);
+  for (int i = 0; i < 10000; ++i) {
+    ASSERT_NE(IntMap_lookup(&map, i), nullptr);
+    EXPECT_EQ(*IntMap_lookup(&map, i), i * 2);
+  }
+  EXPECT_EQ(IntMap_lookup(&map, 10000), nullptr);
+}
+
+/* -------------------------------------------------------------
+ * Capacity management
+ * ------------------------------------------------------------- */
+
+TEST_F(IntMapTest, ReserveAvoidsRehash) {
+  IntMap_reserve(&map, 1000);
+  size_t capacity = map.capacity;
+  EXPECT_GE(capacity - capacity / 8, 1000u);
+  for (int i = 0; i < 1000; ++i) {
+    IntMap_insert(&map, i, i);
+  }
+  EXPECT_EQ(map.capacity, capacity);
+}
+
+TEST_F(IntMapTest, ReserveKeepsEntries) {
+  for (int i = 0; i < 20; ++i) {
+    IntMap_insert(&map, i, -i);
+  }
+  IntMap_reserve(&map, 5000);
+  EXPECT_EQ(IntMap_size(&map), 20u);
+  for (int i = 0; i < 20; ++i) {
+    EXPECT_EQ(*IntMap_lookup(&map, i), -i);
+  }
+}
+
+TEST(HashMapTest, InitCapacity) {
+  IntMap map;
+  ASSERT_TRUE(IntMap_init_capacity(&map, 100));
+  EXPECT_GE(map.capacity - map.capacity / 8, 100u);
+  EXPECT_TRUE(IntMap_is_empty(&map));
+  IntMap_finalize(&map);
+}
+
+TEST_F(IntMapTest, ClearKeepsCapacity) {
+  for (int i = 0; i < 100; ++i) {
+    IntMap_insert(&map, i, i);
+  }
+  size_t capacity = map.capacity;
+  IntMap_clear(&map);
+  EXPECT_TRUE(IntMap_is_empty(&map));
+  EXPECT_EQ(map.capacity, capacity);
+  EXPECT_FALSE(IntMap_contains(&map, 50));
+  EXPECT_TRUE(IntMap_insert(&map, 50, 1));
+}
+
+/* -------------------------------------------------------------
+ * Removal
+ * ------------------------------------------------------------- */
+
+TEST_F(IntMapTest, RemoveReturnsValue) {
+  IntMap_insert(&map, 1, 100);
+  int value = 0;
+  EXPECT_TRUE(IntMap_remove(&map, 1, &value));
+  EXPECT_EQ(value, 100);
+  EXPECT_FALSE(IntMap_contains(&map, 1));
+  EXPECT_FALSE(IntMap_remove(&map, 1, &value));
+  EXPECT_TRUE(IntMap_is_empty(&map));
+}
+
+TEST_F(IntMapTest, RemoveLeavesNoTombstones) {
+  for (int i = 0; i < 1000; ++i) {
+    IntMap_insert(&map, i, i);
+  }
+  for (int i = 0; i < 1000; ++i) {
+    ASSERT_TRUE(IntMap_remove(&map, i, nullptr));
+  }
+  for (size_t i = 0; i < map.capacity; ++i) {
+    EXPECT_EQ(map.meta[i], 0u);
+  }
+}
+
+TEST(HashMapTest, RemoveWithinCollidingCluster) {
+  CollidingMap map;
+  CollidingMap_init(&map);
+  for (int i = 0; i < 50; ++i) {
+    CollidingMap_insert(&map, i, i);
+  }
+  for (int i = 0; i < 50; i += 2) {
+    ASSERT_TRUE(CollidingMap_remove(&map, i, nullptr));
+  }
+  for (int i = 0; i < 50; ++i) {
+    EXPECT_EQ(CollidingMap_contains(&map, i), i % 2 == 1) << i;
+  }
+  EXPECT_EQ(CollidingMap_size(&map), 25u);
+  CollidingMap_finalize(&map);
+}
+
+TEST(HashMapTest, ConstantHashKeepsEveryKey) {
+  CollidingMap map;
+  CollidingMap_init(&map);
+  for (int i = 0; i < 600; ++i) {
+    CollidingMap_insert(&map, i, i);
+  }
+  for (int i = 0; i < 600; ++i) {
+    ASSERT_TRUE(CollidingMap_contains(&map, i)) << i;
+  }
+  for (size_t i = 0; i < map.capacity; ++i) {
+    if (map.meta[i] != 0) {
+      EXPECT_LE((map.meta[i] & 0xFFFF) - 1u, (size_t)HASHMAP_MAX_DISTANCE);
+    }
+  }
+  CollidingMap_finalize(&map);
+}
+
+/* -------------------------------------------------------------
+ * Iteration
+ * ------------------------------------------------------------- */
+
+TEST_F(IntMapTest, IteratorVisitsEveryEntryOnce) {
+  for (int i = 0; i < 500; ++i) {
+    IntMap_insert(&map, i, i + 1);
+  }
+  std::unordered_map<int, int> seen;
+  IntMapIterator iter;
+  for (IntMap_iterator(&iter, &map); IntMap_has_next(&iter);
+       IntMap_next(&iter)) {
+    EXPECT_EQ(*IntMap_value(&iter), *IntMap_key(&iter) + 1);
+    seen[*IntMap_key(&iter)]++;
+  }
+  EXPECT_EQ(seen.size(), 500u);
+  for (const auto &[key, count] : seen) {
+    EXPECT_EQ(count, 1) << key;
+  }
+}
+
+TEST_F(IntMapTest, IteratorOnEmptyMap) {
+  IntMapIterator iter;
+  IntMap_iterator(&iter, &map);
+  EXPECT_FALSE(IntMap_has_next(&iter));
+}
+
+/* -------------------------------------------------------------
+ * Key types
+ * ------------------------------------------------------------- */
+
+TEST(HashMapTest, StringKeysCompareByContents) {
+  StringMap map;
+  StringMap_init(&map);
+  std::string key = "alpha";
+  StringMap_insert(&map, key.c_str(), 1);
+  StringMap_insert(&map, "beta", 2);
+
+  std::string same = "alpha";
+  ASSERT_NE(StringMap_lookup(&map, same.c_str()), nullptr);
+  EXPECT_EQ(*StringMap_lookup(&map, same.c_str()), 1);
+  EXPECT_FALSE(StringMap_contains(&map, "gamma"));
+  StringMap_finalize(&map);
+}
+
+/* -------------------------------------------------------------
+ * Randomized comparison against std::unordered_map
+ * ------------------------------------------------------------- */
+
+TEST_F(IntMapTest, MatchesUnorderedMap) {
+  std::mt19937 rng(42);
+  std::uniform_int_distribution<int> keys(0, 2000);
+  std::unordered_map<int, int> expected;
+  for (int i = 0; i < 50000; ++i) {
+    int key = keys(rng);
+    switch (rng() % 3) {
+      case 0:
+        EXPECT_EQ(IntMap_insert(&map, key, i), expected.count(key) == 0);
+        expected[key] = i;
+        break;
+      case 1:
+        EXPECT_EQ(IntMap_remove(&map, key, nullptr), expected.erase(key) == 1);
+        break;
+      default: {
+        int *value = IntMap_lookup(&map, key);
+        auto it = expected.find(key);
+        ASSERT_EQ(value != nullptr, it != expected.end());
+        if (value != nullptr) {
+          EXPECT_EQ(*value, it->second);
+        }
+      }
+    }
+    ASSERT_EQ(IntMap_size(&map), expected.size());
+  }
+}
+
+}  // namespace
\ No newline at end of file
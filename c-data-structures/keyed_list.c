@@ -3,52 +3,234 @@
 // Created on: Jun 03, 2020
 //     Author: Jeff Manzione
 
-#include "struct/keyed_list.h"
+#include "c-data-structures/keyed_list.h"
+
+#include <stdlib.h>
+#include <string.h>
 
-#include "alloc/alloc.h"
 #include "debug/debug.h"
-#include "struct/C_DATA_STRUCTURES_defaults.h"
+
+// The first value block holds 16 entries.
+#define DEFAULT_BLOCK_SHIFT 4
+
+IMPL_ARRAYLIKE_WITH_ALLOC(KeyedListKeys, KeyedListKey, allocator_default());
+IMPL_HASHMAP(KeyedListIndex, KeyedListKey, uint32_t, HASHMAP_HASH_PTR,
+             HASHMAP_EQ);
+
+// Block holding entry i, where block k holds entries
+// [((1 << k) - 1) << shift, ((1 << (k + 1)) - 1) << shift).
+static inline uint32_t _block_of(const KeyedList *klist, uint32_t i) {
+  uint64_t q = ((uint64_t)i >> klist->_block_shift) + 1;
+  return 63 - __builtin_clzll(q);
+}
+
+static inline size_t _block_start(const KeyedList *klist, uint32_t block) {
+  return (((size_t)1 << block) - 1) << klist->_block_shift;
+}
+
+static inline size_t _block_bytes(const KeyedList *klist, uint32_t block) {
+  return ((size_t)1 << (klist->_block_shift + block)) * klist->_type_sz;
+}
+
+static inline void *_value_at(const KeyedList *klist, uint32_t i) {
+  uint32_t block = _block_of(klist, i);
+  return klist->_blocks[block] +
+         (i - _block_start(klist, block)) * klist->_type_sz;
+}
+
+static void _ensure_block(KeyedList *klist, uint32_t block) {
+  ASSERT(block < KEYEDLIST_MAX_BLOCKS);
+  if (NULL == klist->_blocks[block]) {
+    size_t bytes = _block_bytes(klist, block);
+    klist->_blocks[block] =
+        (char *)allocator_allocate(klist->_allocator, bytes);
+    ASSERT(NOT_NULL(klist->_blocks[block]));
+    memset(klist->_blocks[block], 0x0, bytes);
+  }
+}
+
+static void _free_blocks(const KeyedList *klist) {
+  for (uint32_t i = 0; i < KEYEDLIST_MAX_BLOCKS; ++i) {
+    if (NULL != klist->_blocks[i]) {
+      allocator_deallocate(klist->_allocator, klist->_blocks[i],
+                           _block_bytes(klist, i));
+    }
+  }
+}
+
+// Appends a zeroed value for the next entry, allocating its block if needed.
+static void *_append_value(KeyedList *klist) {
+  uint32_t i = (uint32_t)klist->_keys.size;
+  _ensure_block(klist, _block_of(klist, i));
+  return _value_at(klist, i);
+}
+
+// Smallest block shift whose first block holds count entries.
+static uint32_t _block_shift_for(size_t count) {
+  uint32_t shift = DEFAULT_BLOCK_SHIFT;
+  while (((size_t)1 << shift) < count) {
+    shift++;
+  }
+  return shift;
+}
 
 void __keyedlist_init(KeyedList *klist, const char type_name[], size_t type_sz,
                       size_t table_sz) {
-  ASSERT(NOT_NULL(klist));
-  slist_init(&klist->_list, type_sz);
-  map_init_default(&klist->_map);
+  __keyedlist_init_allocator(klist, type_name, type_sz, table_sz,
+                             allocator_default());
+}
+
+void __keyedlist_init_allocator(KeyedList *klist, const char type_name[],
+                                size_t type_sz, size_t table_sz,
+                                const Allocator *allocator) {
+  ASSERT(NOT_NULL(klist), NOT_NULL(allocator));
+  KeyedListKeys_init_allocator(&klist->_keys, allocator, DEFAULT_TABLE_SIZE);
+  KeyedListIndex_init(&klist->_index);
+  memset(klist->_blocks, 0x0, sizeof(klist->_blocks));
+  klist->_allocator = allocator;
+  klist->_type_sz = type_sz;
+  klist->_removed = 0;
+  klist->_block_shift = DEFAULT_BLOCK_SHIFT;
+  keyedlist_reserve(klist, table_sz);
+}
+
+void __keyedlist_build_from(KeyedList *klist, const char type_name[],
+                            size_t type_sz, const void *const keys[],
+                            const void *values, size_t n) {
+  ASSERT(NOT_NULL(klist), 0 == n || NOT_NULL(keys));
+  __keyedlist_init(klist, type_name, type_sz, n);
+  for (size_t i = 0; i < n; ++i) {
+    void *entry;
+    keyedlist_insert(klist, keys[i], &entry);
+    if (NULL != values) {
+      memcpy(entry, (const char *)values + i * type_sz, type_sz);
+    }
+  }
 }
 
 void keyedlist_finalize(KeyedList *klist) {
   ASSERT(NOT_NULL(klist));
-  map_finalize(&klist->_map);
-  slist_finalize(&klist->_list);
+  _free_blocks(klist);
+  KeyedListIndex_finalize(&klist->_index);
+  KeyedListKeys_finalize(&klist->_keys);
 }
 
 void *keyedlist_insert(KeyedList *klist, const void *key, void **entry) {
   ASSERT(NOT_NULL(klist), NOT_NULL(key));
-  void *existing = map_lookup(&klist->_map, key);
-  if (NULL == existing) {
-    *entry = slist_add_last(&klist->_list);
-    map_insert(&klist->_map, key, *entry);
-    return NULL;
+  bool inserted;
+  uint32_t *index = KeyedListIndex_upsert(&klist->_index, key, &inserted);
+  if (!inserted) {
+    *entry = _value_at(klist, *index);
+    return *entry;
   }
-  *entry = existing;
-  return existing;
+  ASSERT(klist->_keys.size < UINT32_MAX);
+  *index = (uint32_t)klist->_keys.size;
+  *entry = _append_value(klist);
+  KeyedListKeys_push_back(&klist->_keys, key);
+  return NULL;
 }
 
 void *keyedlist_lookup(KeyedList *klist, const void *key) {
   ASSERT(NOT_NULL(klist), NOT_NULL(key));
-  return map_lookup(&klist->_map, key);
+  uint32_t *index = KeyedListIndex_lookup(&klist->_index, key);
+  return NULL == index ? NULL : _value_at(klist, *index);
 }
 
-KL_iter keyedlist_iter(KeyedList *klist) {
+bool keyedlist_remove(KeyedList *klist, const void *key) {
+  ASSERT(NOT_NULL(klist), NOT_NULL(key));
+  uint32_t index;
+  if (!KeyedListIndex_remove(&klist->_index, key, &index)) {
+    return false;
+  }
+  klist->_keys.table[index] = NULL;
+  klist->_removed++;
+  return true;
+}
+
+bool keyedlist_compact(KeyedList *klist) {
   ASSERT(NOT_NULL(klist));
-  KL_iter iter = {._iter = map_iter(&klist->_map)};
-  return iter;
+  size_t total = klist->_keys.size;
+  if (klist->_removed * 100 <= total * KEYEDLIST_COMPACT_PERCENT) {
+    return false;
+  }
+  // Keeps the old value blocks; the key array is shared.
+  KeyedList old = *klist;
+
+  // Rebuild into a single value block sized for the live entries.
+  size_t live = total - klist->_removed;
+  memset(klist->_blocks, 0x0, sizeof(klist->_blocks));
+  klist->_block_shift = DEFAULT_BLOCK_SHIFT;
+  klist->_keys.size = 0;
+  klist->_removed = 0;
+  KeyedListIndex_finalize(&klist->_index);
+  KeyedListIndex_init(&klist->_index);
+  keyedlist_reserve(klist, live);
+
+  for (uint32_t i = 0; i < total; ++i) {
+    const void *key = old._keys.table[i];
+    if (NULL == key) {
+      continue;
+    }
+    uint32_t index = (uint32_t)klist->_keys.size;
+    memcpy(_value_at(klist, index), _value_at(&old, i), klist->_type_sz);
+    // Keys only ever move down, so the key array is compacted in place.
+    klist->_keys.table[index] = key;
+    klist->_keys.size++;
+    KeyedListIndex_insert(&klist->_index, key, index);
+  }
+  KeyedListKeys_shrink_to_fit(&klist->_keys);
+  _free_blocks(&old);
+  return true;
+}
+
+size_t keyedlist_size(const KeyedList *klist) {
+  ASSERT(NOT_NULL(klist));
+  return klist->_keys.size - klist->_removed;
 }
 
-bool kl_has(KL_iter *iter) { return has(&iter->_iter); }
+void keyedlist_reserve(KeyedList *klist, size_t count) {
+  ASSERT(NOT_NULL(klist), count <= UINT32_MAX);
+  if (0 == count) {
+    return;
+  }
+  KeyedListKeys_reserve(&klist->_keys, count);
+  KeyedListIndex_reserve(&klist->_index, count);
+  // Blocks are allocated in order, so with no first block there are no
+  // values yet and the first block can be sized to hold everything.
+  if (NULL == klist->_blocks[0]) {
+    klist->_block_shift = _block_shift_for(count);
+  }
+  uint32_t last = _block_of(klist, (uint32_t)(count - 1));
+  for (uint32_t block = 0; block <= last; ++block) {
+    _ensure_block(klist, block);
+  }
+}
 
-void kl_inc(KL_iter *iter) { inc(&iter->_iter); }
+ContainerStats keyedlist_stats(const KeyedList *klist) {
+  ASSERT(NOT_NULL(klist));
+  ContainerStats stats = KeyedListKeys_stats(&klist->_keys);
+  ContainerStats index = KeyedListIndex_stats(&klist->_index);
+  stats.reallocs += index.reallocs;
+  stats.lookups = index.lookups;
+  stats.probes = index.probes;
+  return stats;
+}
 
-const void *kl_key(KL_iter *iter) { return key(&iter->_iter); }
+KL_iter keyedlist_iter(KeyedList *klist) {
+  ASSERT(NOT_NULL(klist));
+  KL_iter iter = {._klist = klist,
+                  ._index = 0,
+                  ._block_left = (size_t)1 << klist->_block_shift,
+                  ._value = klist->_blocks[0]};
+  if (kl_has(&iter) && NULL == kl_key(&iter)) {
+    kl_inc(&iter);
+  }
+  return iter;
+}
 
-const void *kl_value(KL_iter *iter) { return value(&iter->_iter); }
\ No newline at end of file
+void __kl_next_block(KL_iter *iter) {
+  const KeyedList *klist = iter->_klist;
+  uint32_t block = _block_of(klist, iter->_index);
+  iter->_block_left = (size_t)1 << (klist->_block_shift + block);
+  iter->_value = klist->_blocks[block];
+}
\ No newline at end of file
@@ -5,32 +5,119 @@
 // Created on: Jun 03, 2020
 //     Author: Jeff Manzione
 
-#include "struct/map.h"
-#include "struct/slist.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
 
+#include "c-data-structures/allocator.h"
+#include "c-data-structures/arraylike.h"
+#include "c-data-structures/container_stats.h"
+#include "c-data-structures/hashmap.h"
+
+// Initializes klist with room for table_sz entries before any rehashing or
+// further allocation.
 #define keyedlist_init(klist, type, table_sz) \
   __keyedlist_init((klist), #type, sizeof(type), (table_sz))
 
+// Same as keyedlist_init, but the value blocks and the key array are
+// allocated from allocator, which must outlive klist. The index is always
+// allocated with malloc.
+#define keyedlist_init_allocator(klist, type, table_sz, allocator)       \
+  __keyedlist_init_allocator((klist), #type, sizeof(type), (table_sz), \
+                             (allocator))
+
+// Initializes klist from n keys and, unless values is NULL, n contiguous
+// values of type. Storage is allocated once up front. If a key repeats, its
+// last value wins.
+#define keyedlist_build_from(klist, type, keys, values, n)                 \
+  __keyedlist_build_from((klist), #type, sizeof(type), (keys), (values), \
+                         (n))
+
+// Number of value blocks; block k holds (first block size << k) entries.
+#define KEYEDLIST_MAX_BLOCKS 32
+
+// keyedlist_compact only rebuilds once more than this percentage of the
+// entries are removed ones.
+#define KEYEDLIST_COMPACT_PERCENT 25
+
+// Keys are compared by address.
+typedef const void *KeyedListKey;
+
+DEFINE_ARRAYLIKE_WITH_ALLOC(KeyedListKeys, KeyedListKey);
+DEFINE_HASHMAP(KeyedListIndex, KeyedListKey, uint32_t);
+
+// Entries are numbered in insertion order. Entry i has its key at
+// _keys.table[i] and its value in the value blocks, which never move, so
+// pointers returned by insert and lookup stay valid until the next
+// keyedlist_compact. A removed entry keeps its slot with a NULL key.
 typedef struct {
-  SList _list;
-  Map _map;
+  KeyedListKeys _keys;
+  KeyedListIndex _index;  // key -> entry number
+  size_t _removed;        // NULL keys in _keys
+  char *_blocks[KEYEDLIST_MAX_BLOCKS];
+  const Allocator *_allocator;  // for the value blocks
+  size_t _type_sz;
+  uint32_t _block_shift;  // log2 of the first block's entry count
 } KeyedList;
 
 void __keyedlist_init(KeyedList *klist, const char type_name[], size_t type_sz,
                       size_t table_sz);
+void __keyedlist_init_allocator(KeyedList *klist, const char type_name[],
+                                size_t type_sz, size_t table_sz,
+                                const Allocator *allocator);
+void __keyedlist_build_from(KeyedList *klist, const char type_name[],
+                            size_t type_sz, const void *const keys[],
+                            const void *values, size_t n);
 void keyedlist_finalize(KeyedList *klist);
+// Finds or creates the entry for key in a single probe of the index. Sets
+// *entry to its value and returns it if it already existed, else NULL.
 void *keyedlist_insert(KeyedList *klist, const void *key, void **entry);
 void *keyedlist_lookup(KeyedList *klist, const void *key);
+// Removes the entry for key, leaving a tombstone in its slot. Returns
+// whether the key was present.
+bool keyedlist_remove(KeyedList *klist, const void *key);
+// Rebuilds the entries and index without tombstones once they make up more
+// than KEYEDLIST_COMPACT_PERCENT of the entries, and returns whether it did.
+// Compacting moves values, invalidating entry pointers and iterators.
+bool keyedlist_compact(KeyedList *klist);
+size_t keyedlist_size(const KeyedList *klist);
+// Makes room for count entries in total without further allocation.
+void keyedlist_reserve(KeyedList *klist, size_t count);
+// Counters of the key array and index combined; lookups and probes are those
+// of the index. All zero unless built with CONTAINER_STATS.
+ContainerStats keyedlist_stats(const KeyedList *klist);
 
+// Iterates entries in insertion order. The accessors are inline and walk the
+// value blocks with a cursor, so iteration is a linear scan.
 typedef struct {
-  M_iter _iter;
+  KeyedList *_klist;
+  uint32_t _index;
+  size_t _block_left;  // entries left in the current value block
+  char *_value;
 } KL_iter;
 
 KL_iter keyedlist_iter(KeyedList *klist);
-bool kl_has(KL_iter *iter);
-void kl_inc(KL_iter *iter);
+void __kl_next_block(KL_iter *iter);
+
+static inline bool kl_has(KL_iter *iter) {
+  return iter->_index < iter->_klist->_keys.size;
+}
+
+static inline const void *kl_key(KL_iter *iter) {
+  return iter->_klist->_keys.table[iter->_index];
+}
+
+// Advances to the next entry, skipping removed ones.
+static inline void kl_inc(KL_iter *iter) {
+  do {
+    iter->_index++;
+    iter->_value += iter->_klist->_type_sz;
+    if (0 == --iter->_block_left) {
+      __kl_next_block(iter);
+    }
+  } while (kl_has(iter) && NULL == kl_key(iter));
+}
 
-const void *kl_key(KL_iter *iter);
-const void *kl_value(KL_iter *iter);
+static inline const void *kl_value(KL_iter *iter) { return iter->_value; }
 
 #endif /* C_DATA_STRUCTURES_KEYED_LIST_H_ */
\ No newline at end of file
@@ -0,0 +1,210 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+extern "C" {
+#include "c-data-structures/keyed_list.h"
+}
+
+namespace {
+
+/* Distinct, stable keys. KeyedList compares keys with the map's default
+ * comparator, so each key is a unique, NUL-terminated string whose address
+ * is also unique. */
+std::vector<std::string> MakeKeys(int64_t n) {
+  std::vector<std::string> keys;
+  keys.reserve(n);
+  for (int64_t i = 0; i < n; ++i) {
+    keys.push_back("key_" + std::to_string(i));
+  }
+  return keys;
+}
+
+/* -------------------------------------------------------------
+ * keyed_list
+ * ------------------------------------------------------------- */
+
+void BM_KeyedList_Insert(benchmark::State& state) {
+  const int64_t n = state.range(0);
+  const std::vector<std::string> keys = MakeKeys(n);
+  for (auto _ : state) {
+    KeyedList klist;
+    keyedlist_init(&klist, int64_t, 0);
+    for (int64_t i = 0; i < n; ++i) {
+      void* entry = nullptr;
+      keyedlist_insert(&klist, keys[i].c_str(), &entry);
+      *(int64_t*)entry = i;
+    }
+    keyedlist_finalize(&klist);
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+void BM_KeyedList_InsertPresized(benchmark::State& state) {
+  const int64_t n = state.range(0);
+  const std::vector<std::string> keys = MakeKeys(n);
+  for (auto _ : state) {
+    KeyedList klist;
+    keyedlist_init(&klist, int64_t, n);
+    for (int64_t i = 0; i < n; ++i) {
+      void* entry = nullptr;
+      keyedlist_insert(&klist, keys[i].c_str(), &entry);
+      *(int64_t*)entry = i;
+    }
+    keyedlist_finalize(&klist);
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+void BM_KeyedList_BuildFrom(benchmark::State& state) {
+  const int64_t n = state.range(0);
+  const std::vector<std::string> names = MakeKeys(n);
+  std::vector<const void*> keys;
+  std::vector<int64_t> values;
+  for (int64_t i = 0; i < n; ++i) {
+    keys.push_back(names[i].c_str());
+    values.push_back(i);
+  }
+  for (auto _ : state) {
+    KeyedList klist;
+    keyedlist_build_from(&klist, int64_t, keys.data(), values.data(), n);
+    keyedlist_finalize(&klist);
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+void BM_KeyedList_Lookup(benchmark::State& state) {
+  const int64_t n = state.range(0);
+  const std::vector<std::string> keys = MakeKeys(n);
+  KeyedList klist;
+  keyedlist_init(&klist, int64_t, 0);
+  for (int64_t i = 0; i < n; ++i) {
+    void* entry = nullptr;
+    keyedlist_insert(&klist, keys[i].c_str(), &entry);
+    *(int64_t*)entry = i;
+  }
+  for (auto _ : state) {
+    for (int64_t i = 0; i < n; ++i) {
+      benchmark::DoNotOptimize(keyedlist_lookup(&klist, keys[i].c_str()));
+    }
+  }
+  keyedlist_finalize(&klist);
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+/* Removes every other entry, then compacts. */
+void BM_KeyedList_RemoveCompact(benchmark::State& state) {
+  const int64_t n = state.range(0);
+  const std::vector<std::string> keys = MakeKeys(n);
+  for (auto _ : state) {
+    state.PauseTiming();
+    KeyedList klist;
+    keyedlist_init(&klist, int64_t, n);
+    for (int64_t i = 0; i < n; ++i) {
+      void* entry = nullptr;
+      keyedlist_insert(&klist, keys[i].c_str(), &entry);
+      *(int64_t*)entry = i;
+    }
+    state.ResumeTiming();
+    for (int64_t i = 0; i < n; i += 2) {
+      keyedlist_remove(&klist, keys[i].c_str());
+    }
+    keyedlist_compact(&klist);
+    state.PauseTiming();
+    keyedlist_finalize(&klist);
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+void BM_KeyedList_Iterate(benchmark::State& state) {
+  const int64_t n = state.range(0);
+  const std::vector<std::string> keys = MakeKeys(n);
+  KeyedList klist;
+  keyedlist_init(&klist, int64_t, 0);
+  for (int64_t i = 0; i < n; ++i) {
+    void* entry = nullptr;
+    keyedlist_insert(&klist, keys[i].c_str(), &entry);
+    *(int64_t*)entry = i;
+  }
+  for (auto _ : state) {
+    int64_t sum = 0;
+    for (KL_iter iter = keyedlist_iter(&klist); kl_has(&iter); kl_inc(&iter)) {
+      benchmark::DoNotOptimize(kl_key(&iter));
+      sum += *(const int64_t*)kl_value(&iter);
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  keyedlist_finalize(&klist);
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+/* -------------------------------------------------------------
+ * std::unordered_map baseline, keyed by the same pointers
+ * ------------------------------------------------------------- */
+
+void BM_UnorderedMap_Insert(benchmark::State& state) {
+  const int64_t n = state.range(0);
+  const std::vector<std::string> keys = MakeKeys(n);
+  for (auto _ : state) {
+    std::unordered_map<const void*, int64_t> map;
+    for (int64_t i = 0; i < n; ++i) {
+      map.emplace(keys[i].c_str(), i);
+    }
+    benchmark::DoNotOptimize(map.size());
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+void BM_UnorderedMap_Lookup(benchmark::State& state) {
+  const int64_t n = state.range(0);
+  const std::vector<std::string> keys = MakeKeys(n);
+  std::unordered_map<const void*, int64_t> map;
+  for (int64_t i = 0; i < n; ++i) {
+    map.emplace(keys[i].c_str(), i);
+  }
+  for (auto _ : state) {
+    for (int64_t i = 0; i < n; ++i) {
+      benchmark::DoNotOptimize(map.find(keys[i].c_str()));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+void BM_UnorderedMap_Iterate(benchmark::State& state) {
+  const int64_t n = state.range(0);
+  const std::vector<std::string> keys = MakeKeys(n);
+  std::unordered_map<const void*, int64_t> map;
+  for (int64_t i = 0; i < n; ++i) {
+    map.emplace(keys[i].c_str(), i);
+  }
+  for (auto _ : state) {
+    int64_t sum = 0;
+    for (const auto& [key, value] : map) {
+      benchmark::DoNotOptimize(key);
+      sum += value;
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+#define RANGE RangeMultiplier(8)->Range(64, 1 << 18)
+
+BENCHMARK(BM_KeyedList_Insert)->RANGE;
+BENCHMARK(BM_KeyedList_InsertPresized)->RANGE;
+BENCHMARK(BM_KeyedList_BuildFrom)->RANGE;
+BENCHMARK(BM_UnorderedMap_Insert)->RANGE;
+
+BENCHMARK(BM_KeyedList_Lookup)->RANGE;
+BENCHMARK(BM_UnorderedMap_Lookup)->RANGE;
+
+BENCHMARK(BM_KeyedList_RemoveCompact)->RANGE;
+
+BENCHMARK(BM_KeyedList_Iterate)->RANGE;
+BENCHMARK(BM_UnorderedMap_Iterate)->RANGE;
+
+}  // namespace
@@ -0,0 +1,305 @@
+#include <gtest/gtest.h>
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+extern "C" {
+#include "c-data-structures/keyed_list.h"
+}
+
+namespace {
+
+/* Keys are compared by address, so each test keeps its keys alive */
+std::vector<std::string> MakeKeys(int n) {
+  std::vector<std::string> keys;
+  keys.reserve(n);
+  for (int i = 0; i < n; ++i) {
+    keys.push_back("key_" + std::to_string(i));
+  }
+  return keys;
+}
+
+/* Test fixture to ensure proper setup / teardown */
+class KeyedListTest : public ::testing::Test {
+ protected:
+  KeyedList klist;
+
+  void SetUp() override { keyedlist_init(&klist, int64_t, 0); }
+
+  void TearDown() override { keyedlist_finalize(&klist); }
+
+  int64_t *Insert(const std::string &key, int64_t value) {
+    void *entry = nullptr;
+    keyedlist_insert(&klist, key.c_str(), &entry);
+    *(int64_t *)entry = value;
+    return (int64_t *)entry;
+  }
+};
+
+/* -------------------------------------------------------------
+ * Insertion and lookup
+ * ------------------------------------------------------------- */
+
+TEST_F(KeyedListTest, InitiallyEmpty) {
+  std::string key = "missing";
+  EXPECT_EQ(keyedlist_size(&klist), 0u);
+  EXPECT_EQ(keyedlist_lookup(&klist, key.c_str()), nullptr);
+  KL_iter iter = keyedlist_iter(&klist);
+  EXPECT_FALSE(kl_has(&iter));
+}
+
+TEST_F(KeyedListTest, InsertNewKeyReturnsZeroedEntry) {
+  std::string key = "a";
+  void *entry = nullptr;
+  EXPECT_EQ(keyedlist_insert(&klist, key.c_str(), &entry), nullptr);
+  ASSERT_NE(entry, nullptr);
+  EXPECT_EQ(*(int64_t *)entry, 0);
+  EXPECT_EQ(keyedlist_size(&klist), 1u);
+}
+
+TEST_F(KeyedListTest, InsertExistingKeyReturnsExistingEntry) {
+  std::string key = "a";
+  int64_t *first = Insert(key, 7);
+  void *entry = nullptr;
+  EXPECT_EQ(keyedlist_insert(&klist, key.c_str(), &entry), first);
+  EXPECT_EQ(entry, first);
+  EXPECT_EQ(*(int64_t *)entry, 7);
+  EXPECT_EQ(keyedlist_size(&klist), 1u);
+}
+
+TEST_F(KeyedListTest, EntriesDoNotMoveAsListGrows) {
+  std::vector<std::string> keys = MakeKeys(5000);
+  std::vector<int64_t *> entries;
+  for (int i = 0; i < 5000; ++i) {
+    entries.push_back(Insert(keys[i], i));
+  }
+  for (int i = 0; i < 5000; ++i) {
+    EXPECT_EQ(keyedlist_lookup(&klist, keys[i].c_str()), entries[i]);
+    EXPECT_EQ(*entries[i], i);
+  }
+}
+
+/* -------------------------------------------------------------
+ * Iteration
+ * ------------------------------------------------------------- */
+
+TEST_F(KeyedListTest, IteratesInInsertionOrder) {
+  std::vector<std::string> keys = MakeKeys(1000);
+  for (int i = 999; i >= 0; --i) {
+    Insert(keys[i], i);
+  }
+  int expected = 999;
+  for (KL_iter iter = keyedlist_iter(&klist); kl_has(&iter); kl_inc(&iter)) {
+    EXPECT_EQ(kl_key(&iter), keys[expected].c_str());
+    EXPECT_EQ(*(const int64_t *)kl_value(&iter), expected);
+    expected--;
+  }
+  EXPECT_EQ(expected, -1);
+}
+
+/* -------------------------------------------------------------
+ * Presizing and bulk construction
+ * ------------------------------------------------------------- */
+
+TEST(KeyedListSizingTest, TableSzPresizesIndexAndValues) {
+  std::vector<std::string> keys = MakeKeys(100000);
+  KeyedList klist;
+  keyedlist_init(&klist, int64_t, 100000);
+  size_t index_capacity = klist._index.capacity;
+  const char *first_block = klist._blocks[0];
+  ASSERT_NE(first_block, nullptr);
+  for (int i = 0; i < 100000; ++i) {
+    void *entry;
+    keyedlist_insert(&klist, keys[i].c_str(), &entry);
+  }
+  EXPECT_EQ(klist._index.capacity, index_capacity);
+  EXPECT_EQ(klist._blocks[0], first_block);
+  EXPECT_EQ(klist._blocks[1], nullptr);
+  keyedlist_finalize(&klist);
+}
+
+TEST_F(KeyedListTest, ReserveKeepsExistingEntries) {
+  std::vector<std::string> keys = MakeKeys(1000);
+  int64_t *first = Insert(keys[0], 42);
+  keyedlist_reserve(&klist, 1000);
+  size_t index_capacity = klist._index.capacity;
+  for (int i = 1; i < 1000; ++i) {
+    Insert(keys[i], i);
+  }
+  EXPECT_EQ(klist._index.capacity, index_capacity);
+  EXPECT_EQ(keyedlist_lookup(&klist, keys[0].c_str()), first);
+  EXPECT_EQ(*first, 42);
+  EXPECT_EQ(keyedlist_size(&klist), 1000u);
+}
+
+TEST(KeyedListSizingTest, BuildFromKeysAndValues) {
+  std::vector<std::string> names = MakeKeys(500);
+  std::vector<const void *> keys;
+  std::vector<int64_t> values;
+  for (int i = 0; i < 500; ++i) {
+    keys.push_back(names[i].c_str());
+    values.push_back(i * 3);
+  }
+  KeyedList klist;
+  keyedlist_build_from(&klist, int64_t, keys.data(), values.data(), 500);
+  EXPECT_EQ(keyedlist_size(&klist), 500u);
+  int i = 0;
+  for (KL_iter iter = keyedlist_iter(&klist); kl_has(&iter); kl_inc(&iter)) {
+    EXPECT_EQ(kl_key(&iter), keys[i]);
+    EXPECT_EQ(*(const int64_t *)kl_value(&iter), i * 3);
+    i++;
+  }
+  EXPECT_EQ(i, 500);
+  keyedlist_finalize(&klist);
+}
+
+TEST(KeyedListSizingTest, BuildFromRepeatedKeyKeepsLastValue) {
+  std::string a = "a", b = "b";
+  const void *keys[] = {a.c_str(), b.c_str(), a.c_str()};
+  int64_t values[] = {1, 2, 3};
+  KeyedList klist;
+  keyedlist_build_from(&klist, int64_t, keys, values, 3);
+  EXPECT_EQ(keyedlist_size(&klist), 2u);
+  EXPECT_EQ(*(int64_t *)keyedlist_lookup(&klist, a.c_str()), 3);
+  EXPECT_EQ(*(int64_t *)keyedlist_lookup(&klist, b.c_str()), 2);
+  keyedlist_finalize(&klist);
+}
+
+TEST(KeyedListSizingTest, BuildFromWithoutValuesZeroesEntries) {
+  std::string a = "a";
+  const void *keys[] = {a.c_str()};
+  KeyedList klist;
+  keyedlist_build_from(&klist, int64_t, keys, nullptr, 1);
+  EXPECT_EQ(*(int64_t *)keyedlist_lookup(&klist, a.c_str()), 0);
+  keyedlist_finalize(&klist);
+}
+
+/* -------------------------------------------------------------
+ * Removal and compaction
+ * ------------------------------------------------------------- */
+
+TEST_F(KeyedListTest, RemoveDropsKey) {
+  std::vector<std::string> keys = MakeKeys(3);
+  for (int i = 0; i < 3; ++i) {
+    Insert(keys[i], i);
+  }
+  EXPECT_TRUE(keyedlist_remove(&klist, keys[1].c_str()));
+  EXPECT_FALSE(keyedlist_remove(&klist, keys[1].c_str()));
+  EXPECT_EQ(keyedlist_lookup(&klist, keys[1].c_str()), nullptr);
+  EXPECT_EQ(*(int64_t *)keyedlist_lookup(&klist, keys[2].c_str()), 2);
+  EXPECT_EQ(keyedlist_size(&klist), 2u);
+}
+
+TEST_F(KeyedListTest, RemoveKeepsOtherEntriesInPlace) {
+  std::vector<std::string> keys = MakeKeys(100);
+  std::vector<int64_t *> entries;
+  for (int i = 0; i < 100; ++i) {
+    entries.push_back(Insert(keys[i], i));
+  }
+  for (int i = 0; i < 100; i += 2) {
+    keyedlist_remove(&klist, keys[i].c_str());
+  }
+  for (int i = 1; i < 100; i += 2) {
+    EXPECT_EQ(keyedlist_lookup(&klist, keys[i].c_str()), entries[i]);
+  }
+}
+
+TEST_F(KeyedListTest, IterationSkipsRemovedEntries) {
+  std::vector<std::string> keys = MakeKeys(100);
+  for (int i = 0; i < 100; ++i) {
+    Insert(keys[i], i);
+  }
+  for (int i = 0; i < 100; ++i) {
+    if (i % 3 != 1) {
+      keyedlist_remove(&klist, keys[i].c_str());
+    }
+  }
+  int expected = 1;
+  for (KL_iter iter = keyedlist_iter(&klist); kl_has(&iter); kl_inc(&iter)) {
+    EXPECT_EQ(kl_key(&iter), keys[expected].c_str());
+    EXPECT_EQ(*(const int64_t *)kl_value(&iter), expected);
+    expected += 3;
+  }
+  EXPECT_EQ(expected, 100);
+}
+
+TEST_F(KeyedListTest, ReinsertAfterRemoveAppends) {
+  std::vector<std::string> keys = MakeKeys(2);
+  Insert(keys[0], 1);
+  Insert(keys[1], 2);
+  keyedlist_remove(&klist, keys[0].c_str());
+  void *entry;
+  EXPECT_EQ(keyedlist_insert(&klist, keys[0].c_str(), &entry), nullptr);
+  EXPECT_EQ(*(int64_t *)entry, 0);
+  KL_iter iter = keyedlist_iter(&klist);
+  EXPECT_EQ(kl_key(&iter), keys[1].c_str());
+  kl_inc(&iter);
+  EXPECT_EQ(kl_key(&iter), keys[0].c_str());
+}
+
+TEST_F(KeyedListTest, CompactBelowThresholdDoesNothing) {
+  std::vector<std::string> keys = MakeKeys(100);
+  for (int i = 0; i < 100; ++i) {
+    Insert(keys[i], i);
+  }
+  for (int i = 0; i < KEYEDLIST_COMPACT_PERCENT; ++i) {
+    keyedlist_remove(&klist, keys[i].c_str());
+  }
+  EXPECT_FALSE(keyedlist_compact(&klist));
+  EXPECT_EQ(klist._removed, (size_t)KEYEDLIST_COMPACT_PERCENT);
+}
+
+TEST_F(KeyedListTest, CompactRebuildsDenseEntries) {
+  std::vector<std::string> keys = MakeKeys(5000);
+  for (int i = 0; i < 5000; ++i) {
+    Insert(keys[i], i);
+  }
+  for (int i = 0; i < 5000; ++i) {
+    if (i % 4 != 0) {
+      keyedlist_remove(&klist, keys[i].c_str());
+    }
+  }
+  EXPECT_TRUE(keyedlist_compact(&klist));
+  EXPECT_EQ(klist._removed, 0u);
+  EXPECT_EQ(klist._keys.size, 1250u);
+  EXPECT_EQ(keyedlist_size(&klist), 1250u);
+  EXPECT_EQ(klist._blocks[1], nullptr);
+
+  int expected = 0;
+  for (KL_iter iter = keyedlist_iter(&klist); kl_has(&iter); kl_inc(&iter)) {
+    EXPECT_EQ(kl_key(&iter), keys[expected].c_str());
+    EXPECT_EQ(*(const int64_t *)kl_value(&iter), expected);
+    expected += 4;
+  }
+  EXPECT_EQ(expected, 5000);
+  for (int i = 0; i < 5000; ++i) {
+    void *value = keyedlist_lookup(&klist, keys[i].c_str());
+    if (i % 4 == 0) {
+      ASSERT_NE(value, nullptr);
+      EXPECT_EQ(*(int64_t *)value, i);
+    } else {
+      EXPECT_EQ(value, nullptr);
+    }
+  }
+  Insert(keys[1], -1);
+  EXPECT_EQ(*(int64_t *)keyedlist_lookup(&klist, keys[1].c_str()), -1);
+}
+
+TEST_F(KeyedListTest, CompactAfterRemovingEverything) {
+  std::vector<std::string> keys = MakeKeys(10);
+  for (int i = 0; i < 10; ++i) {
+    Insert(keys[i], i);
+  }
+  for (int i = 0; i < 10; ++i) {
+    keyedlist_remove(&klist, keys[i].c_str());
+  }
+  EXPECT_TRUE(keyedlist_compact(&klist));
+  EXPECT_EQ(keyedlist_size(&klist), 0u);
+  KL_iter iter = keyedlist_iter(&klist);
+  EXPECT_FALSE(kl_has(&iter));
+  Insert(keys[3], 3);
+  EXPECT_EQ(*(int64_t *)keyedlist_lookup(&klist, keys[3].c_str()), 3);
+}
+
+}  // namespace
\ No newline at end of file
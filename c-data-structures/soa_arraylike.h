@@ -0,0 +1,419 @@
+#ifndef C_DATA_STRUCTURES_SOA_ARRAYLIKE_H_
+#define C_DATA_STRUCTURES_SOA_ARRAYLIKE_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "c-data-structures/arraylike.h"
+#include "c-data-structures/container_stats.h"
+
+/**
+ * @file soa_arraylike.h
+ *
+ * @brief Struct-of-arrays variant of arraylike.h.
+ *
+ * DEFINE_ARRAYLIKE stores whole records next to each other, so a loop that
+ * reads one field of a wide record still pulls every other field through
+ * the cache. DEFINE_SOA_ARRAYLIKE and IMPL_SOA_ARRAYLIKE generate a
+ * container with the same push_back / get / set / remove / iterate API that
+ * keeps each field in its own contiguous column instead. A scan over one
+ * field then reads only that field's bytes, and the column can be handed to
+ * a loop the compiler vectorizes.
+ *
+ * Fields are given as an X-macro: a function-like macro taking a macro `X`
+ * and invoking `X(type, field)` once per field, in order:
+ *
+ *   #define POINT_FIELDS(X) \
+ *     X(double, x)          \
+ *     X(double, y)          \
+ *     X(int32_t, id)
+ *
+ *   // In a header or source file:
+ *   DEFINE_SOA_ARRAYLIKE(PointArray, POINT_FIELDS);
+ *
+ *   // In exactly one source file:
+ *   IMPL_SOA_ARRAYLIKE(PointArray, POINT_FIELDS);
+ *
+ *   // Use as:
+ *   PointArray points;
+ *   PointArray_init(&points);
+ *   PointArray_push_back(&points, (PointArrayRecord){1.0, 2.0, 7});
+ *
+ *   // Per-column access:
+ *   const double *xs = points.columns.x;
+ *   double sum = 0;
+ *   for (size_t i = 0; i < points.size; ++i) {
+ *     sum += xs[i];
+ *   }
+ *
+ * Records are passed and returned by value as `name##Record`, a struct with
+ * the same fields; it is assembled from the columns on every read, so code
+ * that touches a few fields should use the columns directly.
+ *
+ * Memory management and error handling follow arraylike.h: every column has
+ * `capacity` slots, all columns grow together according to the growth
+ * policy, new slots are zeroed, and allocation failures are guarded with
+ * `assert`. Column pointers are invalidated whenever the array grows.
+ *
+ * With CONTAINER_STATS defined, each array counts column resizes (once per
+ * resize of all columns), bytes memmoved across all columns by removal, and
+ * its peak size and capacity, readable through `name##_stats`.
+ */
+
+/* X-macro helpers. Those that touch the columns expect `array` in scope. */
+#define _SOA_RECORD_FIELD(type, field) type field;
+#define _SOA_COLUMN_FIELD(type, field) type *field;
+
+#define _SOA_CALLOC_COLUMN(type, field)                                 \
+  array->columns.field = (type *)calloc(array->capacity, sizeof(type)); \
+  assert(array->columns.field != NULL);
+
+/* Expects `new_capacity`. */
+#define _SOA_REALLOC_COLUMN(type, field)                                  \
+  array->columns.field =                                                  \
+      (type *)realloc(array->columns.field, new_capacity * sizeof(type)); \
+  assert(array->columns.field != NULL);                                   \
+  if (new_capacity > array->size) {                                       \
+    memset(array->columns.field + array->size, 0x0,                       \
+           (new_capacity - array->size) * sizeof(type));                  \
+  }
+
+#define _SOA_FREE_COLUMN(type, field) free(array->columns.field);
+
+/* Expect `index` and `record`. */
+#define _SOA_STORE_FIELD(type, field) \
+  array->columns.field[index] = record.field;
+#define _SOA_LOAD_FIELD(type, field) \
+  record.field = array->columns.field[index];
+
+/* Closes the gap left by removing the row at `index`. */
+#define _SOA_SHIFT_LEFT_COLUMN(type, field)          \
+  memmove(array->columns.field + index,              \
+          array->columns.field + index + 1,          \
+          (array->size - index - 1) * sizeof(type)); \
+  CONTAINER_STATS_ADD(array, bytes_moved,            \
+                      (array->size - index - 1) * sizeof(type));
+
+/* Expects `start` and `count`. */
+#define _SOA_ZERO_COLUMN(type, field) \
+  memset(array->columns.field + start, 0x0, count * sizeof(type));
+
+/**
+ * @macro DEFINE_SOA_ARRAYLIKE
+ *
+ * @brief Declares a struct-of-arrays type and its public API.
+ *
+ * This macro defines:
+ *  - `name##Record`, a struct holding one value of every field
+ *  - The array structure, with one column pointer per field in `columns`
+ *  - An associated iterator type
+ *  - Function prototypes for all supported operations
+ *
+ * @param name    Base name for the generated type and functions
+ * @param FIELDS  X-macro listing the fields as X(type, field)
+ */
+#define DEFINE_SOA_ARRAYLIKE(name, FIELDS)                                  \
+                                                                            \
+  typedef struct {                                                          \
+    FIELDS(_SOA_RECORD_FIELD)                                               \
+  } name##Record;                                                           \
+                                                                            \
+  /**                                                                       \
+   * Struct-of-arrays structure.                                            \
+   *                                                                        \
+   * - `capacity` is the allocated length of every column                   \
+   * - `size` is the number of logically present rows                       \
+   * - `columns.field` is a contiguous buffer of `capacity` values of field \
+   */                                                                       \
+  typedef struct name##_ name;                                              \
+  struct name##_ {                                                          \
+    size_t capacity;                                                        \
+    size_t size;                                                            \
+    struct {                                                                \
+      FIELDS(_SOA_COLUMN_FIELD)                                             \
+    } columns;                                                              \
+    CONTAINER_STATS_FIELD                                                   \
+  };                                                                        \
+                                                                            \
+  /**                                                                       \
+   * Forward iterator over the rows.                                        \
+   *                                                                        \
+   * The iterator remains valid as long as the underlying array is not      \
+   * structurally modified (push/pop/resize).                               \
+   */                                                                       \
+  typedef struct {                                                          \
+    int32_t index;                                                          \
+    name *array;                                                            \
+  } name##Iterator;                                                         \
+                                                                            \
+  /* Initialization and lifetime management */                              \
+  bool name##_init_capacity(name *, size_t capacity);                       \
+  bool name##_init(name *);                                                 \
+                                                                            \
+  name *name##_create();                                                    \
+  name *name##_create_capacity(size_t capacity);                            \
+                                                                            \
+  void name##_finalize(name *);                                             \
+  void name##_delete(name *);                                               \
+  void name##_clear(name *const);                                           \
+                                                                            \
+  /* Capacity management */                                                 \
+  void name##_reserve(name *const, size_t capacity);                        \
+  void name##_shrink_to_fit(name *const);                                   \
+                                                                            \
+  /* Back operations */                                                     \
+  void name##_push_back(name *const, name##Record);                         \
+  size_t name##_push_back_n(name *const, size_t count);                     \
+  bool name##_pop_back(name *const, name##Record *ptr);                     \
+                                                                            \
+  /* Random access */                                                       \
+  bool name##_set(name *const, int32_t index, name##Record);                \
+  bool name##_get(name *const, int32_t, name##Record *ptr);                 \
+  name##Record name##_get_unchecked(name *const, int32_t);                  \
+                                                                            \
+  /* Removal */                                                             \
+  bool name##_remove(name *const, int32_t, name##Record *ptr);              \
+  name##Record name##_remove_unchecked(name *const, int32_t);               \
+                                                                            \
+  /* Size and state */                                                      \
+  size_t name##_size(const name *const);                                    \
+  bool name##_is_empty(const name *const);                                  \
+  ContainerStats name##_stats(const name *const);                           \
+                                                                            \
+  /* Iteration */                                                           \
+  void name##_iterator(name##Iterator *, name *const);                      \
+  bool name##_has_next(const name##Iterator *const);                        \
+  void name##_next(name##Iterator *);                                       \
+  name##Record name##_value(const name##Iterator *const)
+
+/**
+ * @macro IMPL_SOA_ARRAYLIKE
+ *
+ * @brief Generates the implementation for a previously declared
+ * struct-of-arrays type.
+ *
+ * Capacity grows according to ARRAYLIKE_DEFAULT_GROWTH.
+ */
+#define IMPL_SOA_ARRAYLIKE(name, FIELDS) \
+  IMPL_SOA_ARRAYLIKE_WITH_GROWTH(name, FIELDS, ARRAYLIKE_DEFAULT_GROWTH)
+
+/**
+ * @macro IMPL_SOA_ARRAYLIKE_WITH_GROWTH
+ *
+ * @brief Same as IMPL_SOA_ARRAYLIKE, but with an explicit growth policy.
+ *
+ * @param name    Base name used in DEFINE_SOA_ARRAYLIKE
+ * @param FIELDS  Field X-macro used in DEFINE_SOA_ARRAYLIKE
+ * @param growth  Growth policy, e.g. ARRAYLIKE_GROWTH_LINEAR
+ */
+#define IMPL_SOA_ARRAYLIKE_WITH_GROWTH(name, FIELDS, growth)                \
+                                                                            \
+  bool name##_init_capacity(name *array, size_t capacity) {                 \
+    assert(array != NULL);                                                  \
+    if (capacity == 0) {                                                    \
+      return false;                                                         \
+    }                                                                       \
+    array->capacity = capacity;                                             \
+    array->size = 0;                                                        \
+    FIELDS(_SOA_CALLOC_COLUMN)                                              \
+    CONTAINER_STATS_REGISTER(array, #name);                                 \
+    CONTAINER_STATS_MAX(array, peak_capacity, capacity);                    \
+    return true;                                                            \
+  }                                                                         \
+                                                                            \
+  bool name##_init(name *array) {                                           \
+    return name##_init_capacity(array, DEFAULT_TABLE_SIZE);                 \
+  }                                                                         \
+                                                                            \
+  name *name##_create() {                                                   \
+    name *array = (name *)malloc(sizeof(name));                             \
+    assert(array != NULL);                                                  \
+    name##_init(array);                                                     \
+    return array;                                                           \
+  }                                                                         \
+                                                                            \
+  name *name##_create_capacity(size_t capacity) {                           \
+    name *array = (name *)malloc(sizeof(name));                             \
+    assert(array != NULL);                                                  \
+    name##_init_capacity(array, capacity);                                  \
+    return array;                                                           \
+  }                                                                         \
+                                                                            \
+  void name##_finalize(name *array) {                                       \
+    assert(array != NULL);                                                  \
+    FIELDS(_SOA_FREE_COLUMN)                                                \
+    CONTAINER_STATS_UNREGISTER(array);                                      \
+  }                                                                         \
+                                                                            \
+  void name##_delete(name *array) {                                         \
+    assert(array != NULL);                                                  \
+    name##_finalize(array);                                                 \
+    free(array);                                                            \
+  }                                                                         \
+                                                                            \
+  void name##_clear(name *const array) {                                    \
+    assert(array != NULL);                                                  \
+    array->size = 0;                                                        \
+  }                                                                         \
+                                                                            \
+  static inline void name##_resize_columns(name *const array,               \
+                                           size_t new_capacity) {           \
+    FIELDS(_SOA_REALLOC_COLUMN)                                             \
+    array->capacity = new_capacity;                                         \
+    CONTAINER_STATS_ADD(array, reallocs, 1);                                \
+    CONTAINER_STATS_MAX(array, peak_capacity, new_capacity);                \
+  }                                                                         \
+                                                                            \
+  static inline void name##_ensure_capacity(name *const array,              \
+                                            size_t need_to_accomodate) {    \
+    assert(array != NULL);                                                  \
+    CONTAINER_STATS_MAX(array, peak_size, need_to_accomodate);              \
+    if (need_to_accomodate <= array->capacity) {                            \
+      return;                                                               \
+    }                                                                       \
+    size_t new_capacity = growth(array->capacity, need_to_accomodate);      \
+    if (new_capacity < need_to_accomodate) {                                \
+      new_capacity = need_to_accomodate;                                    \
+    }                                                                       \
+    name##_resize_columns(array, new_capacity);                             \
+  }                                                                         \
+                                                                            \
+  void name##_reserve(name *const array, size_t capacity) {                 \
+    assert(array != NULL);                                                  \
+    if (capacity <= array->capacity) {                                      \
+      return;                                                               \
+    }                                                                       \
+    name##_resize_columns(array, capacity);                                 \
+  }                                                                         \
+                                                                            \
+  void name##_shrink_to_fit(name *const array) {                            \
+    assert(array != NULL);                                                  \
+    size_t new_capacity = array->size > 0 ? array->size : 1;                \
+    if (new_capacity >= array->capacity) {                                  \
+      return;                                                               \
+    }                                                                       \
+    name##_resize_columns(array, new_capacity);                             \
+  }                                                                         \
+                                                                            \
+  void name##_push_back(name *const array, name##Record record) {           \
+    assert(array != NULL);                                                  \
+    name##_ensure_capacity(array, array->size + 1);                         \
+    size_t index = array->size++;                                           \
+    FIELDS(_SOA_STORE_FIELD)                                                \
+  }                                                                         \
+                                                                            \
+  /* Appends `count` zeroed rows and returns the index of the first, so the \
+   * columns can be filled in bulk. */                                      \
+  size_t name##_push_back_n(name *const array, size_t count) {              \
+    assert(array != NULL);                                                  \
+    name##_ensure_capacity(array, array->size + count);                     \
+    size_t start = array->size;                                             \
+    FIELDS(_SOA_ZERO_COLUMN)                                                \
+    array->size += count;                                                   \
+    return start;                                                           \
+  }                                                                         \
+                                                                            \
+  bool name##_pop_back(name *const array, name##Record *ptr) {              \
+    assert(array != NULL);                                                  \
+    if (array->size == 0) {                                                 \
+      return false;                                                         \
+    }                                                                       \
+    *ptr = name##_get_unchecked(array, (int32_t)array->size - 1);           \
+    array->size--;                                                          \
+    return true;                                                            \
+  }                                                                         \
+                                                                            \
+  bool name##_set(name *const array, int32_t index, name##Record record) {  \
+    assert(array != NULL);                                                  \
+    if (index < 0) {                                                        \
+      return false;                                                         \
+    }                                                                       \
+    if ((size_t)index >= array->size) {                                     \
+      name##_ensure_capacity(array, index + 1);                             \
+      array->size = index + 1;                                              \
+    }                                                                       \
+    FIELDS(_SOA_STORE_FIELD)                                                \
+    return true;                                                            \
+  }                                                                         \
+                                                                            \
+  name##Record name##_get_unchecked(name *const array, int32_t index) {     \
+    assert(array != NULL);                                                  \
+    name##Record record;                                                    \
+    FIELDS(_SOA_LOAD_FIELD)                                                 \
+    return record;                                                          \
+  }                                                                         \
+                                                                            \
+  bool name##_get(name *const array, int32_t index, name##Record *ptr) {    \
+    assert(array != NULL);                                                  \
+    if (index < 0 || (size_t)index >= array->size) {                        \
+      return false;                                                         \
+    }                                                                       \
+    *ptr = name##_get_unchecked(array, index);                              \
+    return true;                                                            \
+  }                                                                         \
+                                                                            \
+  name##Record name##_remove_unchecked(name *const array, int32_t index) {  \
+    assert(array != NULL);                                                  \
+    name##Record to_return = name##_get_unchecked(array, index);            \
+    FIELDS(_SOA_SHIFT_LEFT_COLUMN)                                          \
+    array->size--;                                                          \
+    return to_return;                                                       \
+  }                                                                         \
+                                                                            \
+  bool name##_remove(name *const array, int32_t index, name##Record *ptr) { \
+    assert(array != NULL);                                                  \
+    if (index < 0 || (size_t)index >= array->size) {                        \
+      return false;                                                         \
+    }                                                                       \
+    *ptr = name##_remove_unchecked(array, index);                           \
+    return true;                                                            \
+  }                                                                         \
+                                                                            \
+  size_t name##_size(const name *const array) {                             \
+    assert(array != NULL);                                                  \
+    return array->size;                                                     \
+  }                                                                         \
+                                                                            \
+  bool name##_is_empty(const name *const array) {                           \
+    assert(array != NULL);                                                  \
+    return array->size == 0;                                                \
+  }                                                                         \
+                                                                            \
+  ContainerStats name##_stats(const name *const array) {                    \
+    assert(array != NULL);                                                  \
+    return CONTAINER_STATS_GET(array);                                      \
+  }                                                                         \
+                                                                            \
+  void name##_iterator(name##Iterator *iter, name *const array) {           \
+    assert(iter != NULL && array != NULL);                                  \
+    iter->index = 0;                                                        \
+    iter->array = array;                                                    \
+  }                                                                         \
+                                                                            \
+  bool name##_has_next(const name##Iterator *const iter) {                  \
+    assert(iter != NULL);                                                   \
+    return (size_t)iter->index < iter->array->size;                         \
+  }                                                                         \
+                                                                            \
+  void name##_next(name##Iterator *iter) {                                  \
+    assert(iter != NULL && (size_t)iter->index < iter->array->size);        \
+    iter->index++;                                                          \
+  }                                                                         \
+                                                                            \
+  name##Record name##_value(const name##Iterator *const iter) {             \
+    assert(iter != NULL);                                                   \
+    return name##_get_unchecked(iter->array, iter->index);                  \
+  }
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* C_DATA_STRUCTURES_SOA_ARRAYLIKE_H_ */
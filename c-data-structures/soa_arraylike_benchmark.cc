@@ -0,0 +1,164 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+
+#include "c-data-structures/arraylike.h"
+#include "c-data-structures/soa_arraylike.h"
+
+namespace {
+
+/* A 12-field record, of which the scans below read one or two fields. */
+#define TRADE_FIELDS(X) \
+  X(int64_t, id)        \
+  X(int64_t, timestamp) \
+  X(double, price)      \
+  X(double, quantity)   \
+  X(double, fee)        \
+  X(double, bid)        \
+  X(double, ask)        \
+  X(int32_t, venue)     \
+  X(int32_t, symbol)    \
+  X(int32_t, trader)    \
+  X(int32_t, flags)     \
+  X(int64_t, sequence)
+
+DEFINE_SOA_ARRAYLIKE(TradeColumns, TRADE_FIELDS);
+IMPL_SOA_ARRAYLIKE(TradeColumns, TRADE_FIELDS);
+
+typedef TradeColumnsRecord Trade;
+
+DEFINE_ARRAYLIKE(TradeArray, Trade);
+IMPL_ARRAYLIKE(TradeArray, Trade);
+
+Trade MakeTrade(int64_t i) {
+  Trade trade{};
+  trade.id = i;
+  trade.price = (double)(i % 1000);
+  trade.quantity = (double)(i % 7);
+  trade.venue = (int32_t)(i % 5);
+  return trade;
+}
+
+/* -------------------------------------------------------------
+ * Build
+ * ------------------------------------------------------------- */
+
+void BM_ArrayLike_PushBack(benchmark::State& state) {
+  const int64_t n = state.range(0);
+  for (auto _ : state) {
+    TradeArray array;
+    TradeArray_init(&array);
+    for (int64_t i = 0; i < n; ++i) {
+      TradeArray_push_back(&array, MakeTrade(i));
+    }
+    benchmark::DoNotOptimize(array.table);
+    TradeArray_finalize(&array);
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+void BM_SoaArrayLike_PushBack(benchmark::State& state) {
+  const int64_t n = state.range(0);
+  for (auto _ : state) {
+    TradeColumns array;
+    TradeColumns_init(&array);
+    for (int64_t i = 0; i < n; ++i) {
+      TradeColumns_push_back(&array, MakeTrade(i));
+    }
+    benchmark::DoNotOptimize(array.columns.price);
+    TradeColumns_finalize(&array);
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+/* -------------------------------------------------------------
+ * Scans touching one and two of the twelve fields
+ * ------------------------------------------------------------- */
+
+void BM_ArrayLike_SumOneField(benchmark::State& state) {
+  const int64_t n = state.range(0);
+  TradeArray array;
+  TradeArray_init(&array);
+  for (int64_t i = 0; i < n; ++i) {
+    TradeArray_push_back(&array, MakeTrade(i));
+  }
+  for (auto _ : state) {
+    double sum = 0;
+    for (size_t i = 0; i < array.size; ++i) {
+      sum += array.table[i].price;
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+  TradeArray_finalize(&array);
+}
+
+void BM_SoaArrayLike_SumOneField(benchmark::State& state) {
+  const int64_t n = state.range(0);
+  TradeColumns array;
+  TradeColumns_init(&array);
+  for (int64_t i = 0; i < n; ++i) {
+    TradeColumns_push_back(&array, MakeTrade(i));
+  }
+  for (auto _ : state) {
+    const double* price = array.columns.price;
+    double sum = 0;
+    for (size_t i = 0; i < array.size; ++i) {
+      sum += price[i];
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+  TradeColumns_finalize(&array);
+}
+
+void BM_ArrayLike_SumTwoFields(benchmark::State& state) {
+  const int64_t n = state.range(0);
+  TradeArray array;
+  TradeArray_init(&array);
+  for (int64_t i = 0; i < n; ++i) {
+    TradeArray_push_back(&array, MakeTrade(i));
+  }
+  for (auto _ : state) {
+    double notional = 0;
+    for (size_t i = 0; i < array.size; ++i) {
+      notional += array.table[i].price * array.table[i].quantity;
+    }
+    benchmark::DoNotOptimize(notional);
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+  TradeArray_finalize(&array);
+}
+
+void BM_SoaArrayLike_SumTwoFields(benchmark::State& state) {
+  const int64_t n = state.range(0);
+  TradeColumns array;
+  TradeColumns_init(&array);
+  for (int64_t i = 0; i < n; ++i) {
+    TradeColumns_push_back(&array, MakeTrade(i));
+  }
+  for (auto _ : state) {
+    const double* price = array.columns.price;
+    const double* quantity = array.columns.quantity;
+    double notional = 0;
+    for (size_t i = 0; i < array.size; ++i) {
+      notional += price[i] * quantity[i];
+    }
+    benchmark::DoNotOptimize(notional);
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+  TradeColumns_finalize(&array);
+}
+
+#define RANGE RangeMultiplier(16)->Range(1 << 10, 1 << 22)
+
+BENCHMARK(BM_ArrayLike_PushBack)->RANGE;
+BENCHMARK(BM_SoaArrayLike_PushBack)->RANGE;
+
+BENCHMARK(BM_ArrayLike_SumOneField)->RANGE;
+BENCHMARK(BM_SoaArrayLike_SumOneField)->RANGE;
+
+BENCHMARK(BM_ArrayLike_SumTwoFields)->RANGE;
+BENCHMARK(BM_SoaArrayLike_SumTwoFields)->RANGE;
+
+}  // namespace
@@ -0,0 +1,208 @@
+#include "c-data-structures/soa_arraylike.h"
+
+#include <gtest/gtest.h>
+#include <stdint.h>
+
+namespace {
+
+#define POINT_FIELDS(X) \
+  X(double, x)          \
+  X(double, y)          \
+  X(int32_t, id)
+
+DEFINE_SOA_ARRAYLIKE(PointArray, POINT_FIELDS);
+IMPL_SOA_ARRAYLIKE(PointArray, POINT_FIELDS);
+
+DEFINE_SOA_ARRAYLIKE(LinearPointArray, POINT_FIELDS);
+IMPL_SOA_ARRAYLIKE_WITH_GROWTH(LinearPointArray, POINT_FIELDS,
+                               ARRAYLIKE_GROWTH_LINEAR);
+
+PointArrayRecord Point(int32_t i) {
+  PointArrayRecord record;
+  record.x = i * 1.5;
+  record.y = -i;
+  record.id = i;
+  return record;
+}
+
+/* Test fixture to ensure proper setup / teardown */
+class SoaArrayLikeTest : public ::testing::Test {
+ protected:
+  PointArray array{};
+
+  void SetUp() override { ASSERT_TRUE(PointArray_init(&array)); }
+  void TearDown() override { PointArray_finalize(&array); }
+
+  void Fill(int32_t n) {
+    for (int32_t i = 0; i < n; ++i) {
+      PointArray_push_back(&array, Point(i));
+    }
+  }
+
+  void ExpectPoint(const PointArrayRecord &record, int32_t i) {
+    EXPECT_EQ(record.x, i * 1.5);
+    EXPECT_EQ(record.y, -i);
+    EXPECT_EQ(record.id, i);
+  }
+};
+
+/* ---- Initialization ---- */
+
+TEST_F(SoaArrayLikeTest, InitIsEmpty) {
+  EXPECT_TRUE(PointArray_is_empty(&array));
+  EXPECT_EQ(PointArray_size(&array), 0u);
+  EXPECT_EQ(array.capacity, (size_t)DEFAULT_TABLE_SIZE);
+}
+
+TEST_F(SoaArrayLikeTest, InitCapacityZeroFails) {
+  PointArray other;
+  EXPECT_FALSE(PointArray_init_capacity(&other, 0));
+}
+
+TEST_F(SoaArrayLikeTest, CreateAndDelete) {
+  PointArray *created = PointArray_create_capacity(100);
+  EXPECT_EQ(created->capacity, 100u);
+  PointArray_push_back(created, Point(3));
+  ExpectPoint(PointArray_get_unchecked(created, 0), 3);
+  PointArray_delete(created);
+}
+
+/* ---- Push / get / set ---- */
+
+TEST_F(SoaArrayLikeTest, PushBackStoresEachFieldInItsColumn) {
+  Fill(100);
+  ASSERT_EQ(PointArray_size(&array), 100u);
+  for (int32_t i = 0; i < 100; ++i) {
+    EXPECT_EQ(array.columns.x[i], i * 1.5);
+    EXPECT_EQ(array.columns.y[i], -i);
+    EXPECT_EQ(array.columns.id[i], i);
+  }
+}
+
+TEST_F(SoaArrayLikeTest, GetReturnsRecord) {
+  Fill(10);
+  PointArrayRecord record;
+  ASSERT_TRUE(PointArray_get(&array, 7, &record));
+  ExpectPoint(record, 7);
+  EXPECT_FALSE(PointArray_get(&array, 10, &record));
+  EXPECT_FALSE(PointArray_get(&array, -1, &record));
+}
+
+TEST_F(SoaArrayLikeTest, SetOverwritesAndExtends) {
+  Fill(3);
+  ASSERT_TRUE(PointArray_set(&array, 1, Point(42)));
+  ExpectPoint(PointArray_get_unchecked(&array, 1), 42);
+
+  ASSERT_TRUE(PointArray_set(&array, 20, Point(20)));
+  EXPECT_EQ(PointArray_size(&array), 21u);
+  ExpectPoint(PointArray_get_unchecked(&array, 20), 20);
+  /* Rows skipped over are zeroed. */
+  ExpectPoint(PointArray_get_unchecked(&array, 10), 0);
+
+  EXPECT_FALSE(PointArray_set(&array, -1, Point(0)));
+}
+
+TEST_F(SoaArrayLikeTest, PushBackNAppendsZeroedRows) {
+  Fill(2);
+  size_t start = PointArray_push_back_n(&array, 50);
+  EXPECT_EQ(start, 2u);
+  EXPECT_EQ(PointArray_size(&array), 52u);
+  for (size_t i = start; i < array.size; ++i) {
+    EXPECT_EQ(array.columns.x[i], 0.0);
+    EXPECT_EQ(array.columns.id[i], 0);
+    array.columns.id[i] = (int32_t)i;
+  }
+  EXPECT_EQ(PointArray_get_unchecked(&array, 51).id, 51);
+}
+
+TEST_F(SoaArrayLikeTest, PopBack) {
+  Fill(2);
+  PointArrayRecord record;
+  ASSERT_TRUE(PointArray_pop_back(&array, &record));
+  ExpectPoint(record, 1);
+  ASSERT_TRUE(PointArray_pop_back(&array, &record));
+  ExpectPoint(record, 0);
+  EXPECT_FALSE(PointArray_pop_back(&array, &record));
+}
+
+/* ---- Removal ---- */
+
+TEST_F(SoaArrayLikeTest, RemoveShiftsEveryColumn) {
+  Fill(10);
+  PointArrayRecord record;
+  ASSERT_TRUE(PointArray_remove(&array, 3, &record));
+  ExpectPoint(record, 3);
+  ASSERT_EQ(PointArray_size(&array), 9u);
+  for (int32_t i = 0; i < 9; ++i) {
+    ExpectPoint(PointArray_get_unchecked(&array, i), i < 3 ? i : i + 1);
+  }
+  EXPECT_FALSE(PointArray_remove(&array, 9, &record));
+}
+
+TEST_F(SoaArrayLikeTest, RemoveLast) {
+  Fill(1);
+  ExpectPoint(PointArray_remove_unchecked(&array, 0), 0);
+  EXPECT_TRUE(PointArray_is_empty(&array));
+}
+
+/* ---- Capacity ---- */
+
+TEST_F(SoaArrayLikeTest, GrowsGeometrically) {
+  Fill(DEFAULT_TABLE_SIZE + 1);
+  EXPECT_EQ(array.capacity, 2u * DEFAULT_TABLE_SIZE);
+}
+
+TEST(SoaArrayLikeGrowthTest, LinearGrowth) {
+  LinearPointArray array;
+  LinearPointArray_init(&array);
+  for (int32_t i = 0; i < DEFAULT_TABLE_SIZE * 3 + 1; ++i) {
+    LinearPointArray_push_back(&array, {0.0, 0.0, i});
+  }
+  EXPECT_EQ(array.capacity, 4u * DEFAULT_TABLE_SIZE);
+  EXPECT_EQ(array.columns.id[DEFAULT_TABLE_SIZE * 3], DEFAULT_TABLE_SIZE * 3);
+  LinearPointArray_finalize(&array);
+}
+
+TEST_F(SoaArrayLikeTest, ReserveAndShrinkToFit) {
+  PointArray_reserve(&array, 1000);
+  EXPECT_EQ(array.capacity, 1000u);
+  Fill(10);
+  PointArray_shrink_to_fit(&array);
+  EXPECT_EQ(array.capacity, 10u);
+  for (int32_t i = 0; i < 10; ++i) {
+    ExpectPoint(PointArray_get_unchecked(&array, i), i);
+  }
+}
+
+TEST_F(SoaArrayLikeTest, ClearKeepsCapacity) {
+  Fill(100);
+  size_t capacity = array.capacity;
+  PointArray_clear(&array);
+  EXPECT_TRUE(PointArray_is_empty(&array));
+  EXPECT_EQ(array.capacity, capacity);
+}
+
+/* ---- Iteration ---- */
+
+TEST_F(SoaArrayLikeTest, IteratesRowsInOrder) {
+  Fill(20);
+  PointArrayIterator iter;
+  int32_t i = 0;
+  for (PointArray_iterator(&iter, &array); PointArray_has_next(&iter);
+       PointArray_next(&iter)) {
+    ExpectPoint(PointArray_value(&iter), i++);
+  }
+  EXPECT_EQ(i, 20);
+}
+
+TEST_F(SoaArrayLikeTest, ColumnScan) {
+  Fill(1000);
+  double sum = 0;
+  const double *xs = array.columns.x;
+  for (size_t i = 0; i < array.size; ++i) {
+    sum += xs[i];
+  }
+  EXPECT_EQ(sum, 1.5 * 999 * 1000 / 2);
+}
+
+}  // namespace
\ No newline at end of file
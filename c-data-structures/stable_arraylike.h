@@ -11,17 +11,125 @@ extern "C" {
 #include <stdlib.h>
 #include <string.h>
 
+#include "c-data-structures/allocator.h"
+#include "c-data-structures/container_stats.h"
+
+/*
+ * Block size, in elements, of arrays declared with DEFINE_STABLE_ARRAYLIKE.
+ * Must be a power of two, at most 1 << 16; other values fail to compile.
+ * Use DEFINE_STABLE_ARRAYLIKE_N to pick a block size for a single
+ * instantiation instead.
+ */
 #ifndef STABLE_ARRAY_BLOCK_SIZE
 #define STABLE_ARRAY_BLOCK_SIZE 64
 #endif
 
-#define DEFINE_STABLE_ARRAYLIKE(name, type)                          \
+#define _STABLE_ARRAY_LOG2(n) \
+  ((n) >= (1 << 16)   ? 16    \
+   : (n) >= (1 << 15) ? 15    \
+   : (n) >= (1 << 14) ? 14    \
+   : (n) >= (1 << 13) ? 13    \
+   : (n) >= (1 << 12) ? 12    \
+   : (n) >= (1 << 11) ? 11    \
+   : (n) >= (1 << 10) ? 10    \
+   : (n) >= (1 << 9)  ? 9     \
+   : (n) >= (1 << 8)  ? 8     \
+   : (n) >= (1 << 7)  ? 7     \
+   : (n) >= (1 << 6)  ? 6     \
+   : (n) >= (1 << 5)  ? 5     \
+   : (n) >= (1 << 4)  ? 4     \
+   : (n) >= (1 << 3)  ? 3     \
+   : (n) >= (1 << 2)  ? 2     \
+   : (n) >= (1 << 1)  ? 1     \
+                      : 0)
+
+#ifdef __cplusplus
+#define _STABLE_ARRAY_STATIC_ASSERT static_assert
+#else
+#define _STABLE_ARRAY_STATIC_ASSERT _Static_assert
+#endif
+
+/* Rejects a STABLE_ARRAY_BLOCK_SIZE that _STABLE_ARRAY_LOG2 would round. */
+#define _STABLE_ARRAY_CHECK_BLOCK_SIZE()                    \
+  _STABLE_ARRAY_STATIC_ASSERT(                              \
+      (1 << _STABLE_ARRAY_LOG2(STABLE_ARRAY_BLOCK_SIZE)) == \
+          STABLE_ARRAY_BLOCK_SIZE,                          \
+      "STABLE_ARRAY_BLOCK_SIZE must be a power of two, at most 1 << 16")
+
+/*
+ * Number of emptied blocks an array keeps for reuse after pop_back, unless
+ * changed with name##_set_max_spare_blocks. Blocks beyond this are handed
+ * to the array's block cache (if any) or freed, so an array that spikes in
+ * size does not hold on to its peak memory.
+ */
+#ifndef STABLE_ARRAY_DEFAULT_SPARE_BLOCKS
+#define STABLE_ARRAY_DEFAULT_SPARE_BLOCKS 1
+#endif
+
+#define DEFINE_STABLE_ARRAYLIKE(name, type) \
+  _STABLE_ARRAY_CHECK_BLOCK_SIZE();         \
+  DEFINE_STABLE_ARRAYLIKE_N(name, type,     \
+                            _STABLE_ARRAY_LOG2(STABLE_ARRAY_BLOCK_SIZE))
+
+/*
+ * Same as DEFINE_STABLE_ARRAYLIKE, but blocks hold `1 << log2_block`
+ * elements. Element lookups split the index with a shift and a mask. The
+ * block size is exposed as the constant `name##_BLOCK_SIZE`.
+ *
+ * Sizing blocks to a page or two keeps the directory small without
+ * over-allocating the last block, e.g. 10 for a 4-byte type or 0 for a
+ * 4-KB type.
+ */
+#define DEFINE_STABLE_ARRAYLIKE_N(name, type, log2_block) \
+  _STABLE_ARRAYLIKE_DECLARE(name, type, log2_block, )
+
+/*
+ * Same as DEFINE_STABLE_ARRAYLIKE, but the block directory and every block
+ * are allocated through an Allocator stored in the array. Also declares
+ * `name##_init_allocator`; `name##_init` and `name##_create` use the default
+ * allocator passed to IMPL_STABLE_ARRAYLIKE_WITH_ALLOC.
+ */
+#define DEFINE_STABLE_ARRAYLIKE_WITH_ALLOC(name, type) \
+  _STABLE_ARRAY_CHECK_BLOCK_SIZE();                    \
+  DEFINE_STABLE_ARRAYLIKE_N_WITH_ALLOC(                \
+      name, type, _STABLE_ARRAY_LOG2(STABLE_ARRAY_BLOCK_SIZE))
+
+#define DEFINE_STABLE_ARRAYLIKE_N_WITH_ALLOC(name, type, log2_block) \
+  _STABLE_ARRAYLIKE_DECLARE(name, type, log2_block,                  \
+                            const Allocator *allocator;);            \
+  bool name##_init_allocator(name *, const Allocator *allocator)
+
+#define _STABLE_ARRAYLIKE_DECLARE(name, type, log2_block, fields)    \
+                                                                     \
+  enum {                                                             \
+    name##_BLOCK_SHIFT = (log2_block),                               \
+    name##_BLOCK_SIZE = 1 << (log2_block),                           \
+  };                                                                 \
+                                                                     \
+  /*                                                                 \
+   * Free-block cache that can be shared by several arrays of the    \
+   * same type. Surplus blocks released by one array are handed out  \
+   * to the next array that grows, instead of going back to the      \
+   * allocator. Holds at most `capacity` blocks. Not thread-safe.    \
+   * Finalizing an array hands its blocks to the cache, so the cache \
+   * must outlive every array attached to it.                        \
+   */                                                                \
+  typedef struct {                                                   \
+    type **blocks;                                                   \
+    size_t count;                                                    \
+    size_t capacity;                                                 \
+    const Allocator *allocator;                                      \
+  } name##BlockCache;                                                \
                                                                      \
   typedef struct {                                                   \
     type **blocks;                                                   \
     size_t size;                                                     \
     size_t num_blocks;                                               \
     size_t capacity_blocks;                                          \
+    size_t max_spare_blocks;                                         \
+    name##BlockCache *cache;                                         \
+    CONTAINER_STATS_FIELD                                            \
+    fields                                                           \
   } name;                                                            \
                                                                      \
   typedef struct {                                                   \
@@ -60,9 +168,18 @@ extern "C" {
   bool name##_last_ref(name *const, const type **ptr);               \
   const type *name##_last_ref_unchecked(name *const);                \
                                                                      \
+  /* Block retention */                                              \
+  void name##_set_max_spare_blocks(name *const, size_t max_blocks);  \
+  void name##_set_block_cache(name *const, name##BlockCache *cache); \
+  void name##_trim(name *const);                                     \
+                                                                     \
+  bool name##BlockCache_init(name##BlockCache *, size_t capacity);   \
+  void name##BlockCache_finalize(name##BlockCache *);                \
+                                                                     \
   /* Size and state */                                               \
   size_t name##_size(const name *const);                             \
   bool name##_is_empty(const name *const);                           \
+  ContainerStats name##_stats(const name *const);                    \
                                                                      \
   /* Iteration */                                                    \
   void name##_iterator(name##Iterator *, name *const);               \
@@ -71,186 +188,394 @@ extern "C" {
   const type *name##_value(const name##Iterator *const);             \
   type *name##_mutable_value(const name##Iterator *const)
 
-#define IMPL_STABLE_ARRAYLIKE(name, type)                                    \
-                                                                             \
-  /* --- Internal Helper: Accessor --- */                                    \
-  static inline type *name##_internal_get(const name *const array,           \
-                                          int32_t index) {                   \
-    if (index < 0 || (size_t)index >= array->size) return NULL;              \
-    size_t block_idx = index / STABLE_ARRAY_BLOCK_SIZE;                      \
-    size_t offset = index % STABLE_ARRAY_BLOCK_SIZE;                         \
-    return &array->blocks[block_idx][offset];                                \
-  }                                                                          \
-                                                                             \
-  /* --- Initialization and lifetime management --- */                       \
-  bool name##_init(name *array) {                                            \
-    array->size = 0;                                                         \
-    array->capacity_blocks = 4;                                              \
-    array->num_blocks = 0;                                                   \
-    array->blocks = (type **)calloc(array->capacity_blocks, sizeof(type *)); \
-    return array->blocks != NULL;                                            \
-  }                                                                          \
-                                                                             \
-  name *name##_create() {                                                    \
-    name *array = (name *)malloc(sizeof(name));                              \
-    if (array && !name##_init(array)) {                                      \
-      free(array);                                                           \
-      return NULL;                                                           \
-    }                                                                        \
-    return array;                                                            \
-  }                                                                          \
-                                                                             \
-  void name##_finalize(name *array) {                                        \
-    if (!array) return;                                                      \
-    for (size_t i = 0; i < array->num_blocks; ++i) {                         \
-      free(array->blocks[i]);                                                \
-    }                                                                        \
-    free(array->blocks);                                                     \
-    array->blocks = NULL;                                                    \
-    array->size = 0;                                                         \
-  }                                                                          \
-                                                                             \
-  void name##_delete(name *array) {                                          \
-    if (!array) return;                                                      \
-    name##_finalize(array);                                                  \
-    free(array);                                                             \
-  }                                                                          \
-                                                                             \
-  /* --- Back operations --- */                                              \
-  type *name##_push_back_ref(name *const array) {                            \
-    size_t block_idx = array->size / STABLE_ARRAY_BLOCK_SIZE;                \
-    if (block_idx >= array->num_blocks) {                                    \
-      /* Need new block */                                                   \
-      if (block_idx >= array->capacity_blocks) {                             \
-        size_t new_cap = array->capacity_blocks * 2;                         \
-        type **new_blocks =                                                  \
-            (type **)realloc(array->blocks, new_cap * sizeof(type *));       \
-        if (!new_blocks) return NULL;                                        \
-        array->blocks = new_blocks;                                          \
-        array->capacity_blocks = new_cap;                                    \
-      }                                                                      \
-      array->blocks[block_idx] =                                             \
-          (type *)malloc(STABLE_ARRAY_BLOCK_SIZE * sizeof(type));            \
-      if (!array->blocks[block_idx]) return NULL;                            \
-      array->num_blocks++;                                                   \
-    }                                                                        \
-    type *res =                                                              \
-        &array->blocks[block_idx][array->size % STABLE_ARRAY_BLOCK_SIZE];    \
-    array->size++;                                                           \
-    return res;                                                              \
-  }                                                                          \
-                                                                             \
-  void name##_push_back(name *const array, type value) {                     \
-    type *slot = name##_push_back_ref(array);                                \
-    if (slot) *slot = value;                                                 \
-  }                                                                          \
-                                                                             \
-  bool name##_pop_back(name *const array, type *ptr) {                       \
-    if (array->size == 0) return false;                                      \
-    if (ptr)                                                                 \
-      *ptr = name##_pop_back_unchecked(array);                               \
-    else                                                                     \
-      array->size--;                                                         \
-    return true;                                                             \
-  }                                                                          \
-                                                                             \
-  type name##_pop_back_unchecked(name *const array) {                        \
-    type val = *name##_internal_get(array, (int32_t)array->size - 1);        \
-    array->size--;                                                           \
-    return val;                                                              \
-  }                                                                          \
-                                                                             \
-  /* --- Random access mutation --- */                                       \
-  bool name##_set(name *const array, int32_t index, type value) {            \
-    type *slot = name##_internal_get(array, index);                          \
-    if (!slot) return false;                                                 \
-    *slot = value;                                                           \
-    return true;                                                             \
-  }                                                                          \
-                                                                             \
-  bool name##_set_ref(name *const array, int32_t index, type **ptr) {        \
-    type *slot = name##_internal_get(array, index);                          \
-    if (!slot) return false;                                                 \
-    if (ptr) *ptr = slot;                                                    \
-    return true;                                                             \
-  }                                                                          \
-                                                                             \
-  type *name##_set_ref_unchecked(name *const array, int32_t index) {         \
-    return name##_internal_get(array, index);                                \
-  }                                                                          \
-                                                                             \
-  /* --- Random access lookup --- */                                         \
-  bool name##_get(name *const array, int32_t index, type *ptr) {             \
-    type *slot = name##_internal_get(array, index);                          \
-    if (!slot) return false;                                                 \
-    if (ptr) *ptr = *slot;                                                   \
-    return true;                                                             \
-  }                                                                          \
-                                                                             \
-  type name##_get_unchecked(name *const array, int32_t index) {              \
-    return *name##_internal_get(array, index);                               \
-  }                                                                          \
-                                                                             \
-  bool name##_get_ref(name *const array, int32_t index, const type **ptr) {  \
-    type *slot = name##_internal_get(array, index);                          \
-    if (!slot) return false;                                                 \
-    if (ptr) *ptr = (const type *)slot;                                      \
-    return true;                                                             \
-  }                                                                          \
-                                                                             \
-  bool name##_mutable_ref(name *const array, int32_t index, type **ptr) {    \
-    type *slot = name##_internal_get(array, index);                          \
-    if (!slot) return false;                                                 \
-    if (ptr) *ptr = slot;                                                    \
-    return true;                                                             \
-  }                                                                          \
-                                                                             \
-  const type *name##_get_ref_unchecked(name *const array, int32_t index) {   \
-    return (const type *)name##_internal_get(array, index);                  \
-  }                                                                          \
-                                                                             \
-  type *name##_mutable_ref_unchecked(name *const array, int32_t index) {     \
-    return name##_internal_get(array, index);                                \
-  }                                                                          \
-                                                                             \
-  bool name##_last(name *const array, type *ptr) {                           \
-    return name##_get(array, (int32_t)array->size - 1, ptr);                 \
-  }                                                                          \
-                                                                             \
-  type name##_last_unchecked(name *const array) {                            \
-    return name##_get_unchecked(array, (int32_t)array->size - 1);            \
-  }                                                                          \
-                                                                             \
-  bool name##_last_ref(name *const array, const type **ptr) {                \
-    return name##_get_ref(array, (int32_t)array->size - 1, ptr);             \
-  }                                                                          \
-                                                                             \
-  const type *name##_last_ref_unchecked(name *const array) {                 \
-    return name##_get_ref_unchecked(array, (int32_t)array->size - 1);        \
-  }                                                                          \
-                                                                             \
-  /* --- Size and state --- */                                               \
-  size_t name##_size(const name *const array) { return array->size; }        \
-  bool name##_is_empty(const name *const array) { return array->size == 0; } \
-                                                                             \
-  /* --- Iteration --- */                                                    \
-  void name##_iterator(name##Iterator *it, name *const array) {              \
-    it->array = array;                                                       \
-    it->index = 0;                                                           \
-  }                                                                          \
-                                                                             \
-  bool name##_has_next(const name##Iterator *const it) {                     \
-    return it->index < it->array->size;                                      \
-  }                                                                          \
-                                                                             \
-  void name##_next(name##Iterator *it) { it->index++; }                      \
-                                                                             \
-  const type *name##_value(const name##Iterator *const it) {                 \
-    return name##_get_ref_unchecked(it->array, (int32_t)it->index);          \
-  }                                                                          \
-                                                                             \
-  type *name##_mutable_value(const name##Iterator *const it) {               \
-    return name##_mutable_ref_unchecked(it->array, (int32_t)it->index);      \
+#define IMPL_STABLE_ARRAYLIKE(name, type)      \
+  _STABLE_ARRAYLIKE_DEFAULT_MEMORY(name, type) \
+  _STABLE_ARRAYLIKE_IMPLEMENT(name, type)
+
+#define IMPL_STABLE_ARRAYLIKE_WITH_ALLOC(name, type, default_allocator) \
+  _STABLE_ARRAYLIKE_ALLOCATOR_MEMORY(name, type, default_allocator)     \
+  _STABLE_ARRAYLIKE_IMPLEMENT(name, type)                               \
+                                                                        \
+  bool name##_init_allocator(name *array, const Allocator *allocator) { \
+    array->allocator = allocator;                                       \
+    return name##_init_blocks(array);                                   \
+  }
+
+/*
+ * Memory hooks used by _STABLE_ARRAYLIKE_IMPLEMENT:
+ *  - name##_use_default_allocator(array) prepares a fresh array
+ *  - name##_directory_calloc/realloc/free manage the `blocks` directory,
+ *    sized in block pointers
+ *  - name##_block_alloc/free manage a single block of name##_BLOCK_SIZE
+ *    elements; blocks are freed through the
+ *    allocator returned by name##_allocator_of, so that a block cache can
+ *    release blocks after the array that allocated them is gone
+ */
+#define _STABLE_ARRAYLIKE_DEFAULT_MEMORY(name, type)                          \
+  static inline void name##_use_default_allocator(name *const array) {        \
+    (void)array;                                                              \
+  }                                                                           \
+                                                                              \
+  static inline type **name##_directory_calloc(name *const array, size_t n) { \
+    (void)array;                                                              \
+    return (type **)calloc(n, sizeof(type *));                                \
+  }                                                                           \
+                                                                              \
+  static inline type **name##_directory_realloc(                              \
+      name *const array, type **blocks, size_t old_n, size_t new_n) {         \
+    (void)array;                                                              \
+    (void)old_n;                                                              \
+    return (type **)realloc(blocks, new_n * sizeof(type *));                  \
+  }                                                                           \
+                                                                              \
+  static inline void name##_directory_free(name *const array, type **blocks,  \
+                                           size_t n) {                        \
+    (void)array;                                                              \
+    (void)n;                                                                  \
+    free(blocks);                                                             \
+  }                                                                           \
+                                                                              \
+  static inline type *name##_block_alloc(name *const array) {                 \
+    (void)array;                                                              \
+    return (type *)malloc(name##_BLOCK_SIZE * sizeof(type));                  \
+  }                                                                           \
+                                                                              \
+  static inline const Allocator *name##_allocator_of(                         \
+      const name *const array) {                                              \
+    (void)array;                                                              \
+    return NULL;                                                              \
+  }                                                                           \
+                                                                              \
+  static inline void name##_block_free(const Allocator *allocator,            \
+                                       type *block) {                         \
+    (void)allocator;                                                          \
+    free(block);                                                              \
+  }
+
+#define _STABLE_ARRAYLIKE_ALLOCATOR_MEMORY(name, type, default_allocator)     \
+  static inline void name##_use_default_allocator(name *const array) {        \
+    array->allocator = (default_allocator);                                   \
+  }                                                                           \
+                                                                              \
+  static inline type **name##_directory_calloc(name *const array, size_t n) { \
+    type **blocks = (type **)allocator_allocate(array->allocator,             \
+                                                n * sizeof(type *));          \
+    if (blocks != NULL) {                                                     \
+      memset(blocks, 0x0, n * sizeof(type *));                                \
+    }                                                                         \
+    return blocks;                                                            \
+  }                                                                           \
+                                                                              \
+  static inline type **name##_directory_realloc(                              \
+      name *const array, type **blocks, size_t old_n, size_t new_n) {         \
+    return (type **)allocator_reallocate(array->allocator, blocks,            \
+                                         old_n * sizeof(type *),              \
+                                         new_n * sizeof(type *));             \
+  }                                                                           \
+                                                                              \
+  static inline void name##_directory_free(name *const array, type **blocks,  \
+                                           size_t n) {                        \
+    allocator_deallocate(array->allocator, blocks, n * sizeof(type *));       \
+  }                                                                           \
+                                                                              \
+  static inline type *name##_block_alloc(name *const array) {                 \
+    return (type *)allocator_allocate(array->allocator,                       \
+                                      name##_BLOCK_SIZE * sizeof(type));      \
+  }                                                                           \
+                                                                              \
+  static inline const Allocator *name##_allocator_of(                         \
+      const name *const array) {                                              \
+    return array->allocator;                                                  \
+  }                                                                           \
+                                                                              \
+  static inline void name##_block_free(const Allocator *allocator,            \
+                                       type *block) {                         \
+    allocator_deallocate(allocator, block, name##_BLOCK_SIZE * sizeof(type)); \
+  }
+
+#define _STABLE_ARRAYLIKE_IMPLEMENT(name, type)                               \
+                                                                              \
+  /* --- Internal Helper: Accessor --- */                                     \
+  static inline type *name##_internal_get(const name *const array,            \
+                                          int32_t index) {                    \
+    if (index < 0 || (size_t)index >= array->size) return NULL;               \
+    size_t block_idx = (size_t)index >> name##_BLOCK_SHIFT;                   \
+    size_t offset = (size_t)index & (name##_BLOCK_SIZE - 1);                  \
+    return &array->blocks[block_idx][offset];                                 \
+  }                                                                           \
+                                                                              \
+  /* --- Internal Helpers: Block retention --- */                             \
+  static inline size_t name##_used_blocks(const name *const array) {          \
+    return (array->size + name##_BLOCK_SIZE - 1) >> name##_BLOCK_SHIFT;       \
+  }                                                                           \
+                                                                              \
+  static inline void name##_release_block(name *const array, type *block) {   \
+    name##BlockCache *cache = array->cache;                                   \
+    const Allocator *allocator = name##_allocator_of(array);                  \
+    if (cache != NULL && cache->count < cache->capacity &&                    \
+        (cache->count == 0 || cache->allocator == allocator)) {               \
+      cache->allocator = allocator;                                           \
+      cache->blocks[cache->count++] = block;                                  \
+      return;                                                                 \
+    }                                                                         \
+    name##_block_free(allocator, block);                                      \
+  }                                                                           \
+                                                                              \
+  static inline type *name##_acquire_block(name *const array) {               \
+    name##BlockCache *cache = array->cache;                                   \
+    if (cache != NULL && cache->count > 0 &&                                  \
+        cache->allocator == name##_allocator_of(array)) {                     \
+      return cache->blocks[--cache->count];                                   \
+    }                                                                         \
+    CONTAINER_STATS_ADD(array, block_allocs, 1);                              \
+    return name##_block_alloc(array);                                         \
+  }                                                                           \
+                                                                              \
+  /* Releases allocated-but-unused blocks beyond the first `keep`. */         \
+  static inline void name##_release_spare_blocks(name *const array,           \
+                                                 size_t keep) {               \
+    size_t used = name##_used_blocks(array);                                  \
+    while (array->num_blocks - used > keep) {                                 \
+      name##_release_block(array, array->blocks[--array->num_blocks]);        \
+    }                                                                         \
+  }                                                                           \
+                                                                              \
+  /* Frees every allocated-but-unused block, bypassing the cache. */          \
+  static inline void name##_free_spare_blocks(name *const array) {            \
+    size_t used = name##_used_blocks(array);                                  \
+    while (array->num_blocks > used) {                                        \
+      name##_block_free(name##_allocator_of(array),                           \
+                        array->blocks[--array->num_blocks]);                  \
+    }                                                                         \
+  }                                                                           \
+                                                                              \
+  /* --- Initialization and lifetime management --- */                        \
+  static inline bool name##_init_blocks(name *array) {                        \
+    array->size = 0;                                                          \
+    array->max_spare_blocks = STABLE_ARRAY_DEFAULT_SPARE_BLOCKS;              \
+    array->cache = NULL;                                                      \
+    array->capacity_blocks = 4;                                               \
+    array->num_blocks = 0;                                                    \
+    array->blocks = name##_directory_calloc(array, array->capacity_blocks);   \
+    if (array->blocks == NULL) return false;                                  \
+    CONTAINER_STATS_REGISTER(array, #name);                                   \
+    return true;                                                              \
+  }                                                                           \
+                                                                              \
+  bool name##_init(name *array) {                                             \
+    name##_use_default_allocator(array);                                      \
+    return name##_init_blocks(array);                                         \
+  }                                                                           \
+                                                                              \
+  name *name##_create() {                                                     \
+    name *array = (name *)malloc(sizeof(name));                               \
+    if (array && !name##_init(array)) {                                       \
+      free(array);                                                            \
+      return NULL;                                                            \
+    }                                                                         \
+    return array;                                                             \
+  }                                                                           \
+                                                                              \
+  void name##_finalize(name *array) {                                         \
+    if (!array) return;                                                       \
+    array->size = 0;                                                          \
+    name##_release_spare_blocks(array, 0);                                    \
+    name##_directory_free(array, array->blocks, array->capacity_blocks);      \
+    array->blocks = NULL;                                                     \
+    array->size = 0;                                                          \
+    CONTAINER_STATS_UNREGISTER(array);                                        \
+  }                                                                           \
+                                                                              \
+  void name##_delete(name *array) {                                           \
+    if (!array) return;                                                       \
+    name##_finalize(array);                                                   \
+    free(array);                                                              \
+  }                                                                           \
+                                                                              \
+  /* --- Back operations --- */                                               \
+  type *name##_push_back_ref(name *const array) {                             \
+    size_t block_idx = array->size >> name##_BLOCK_SHIFT;                     \
+    if (block_idx >= array->num_blocks) {                                     \
+      /* Need new block */                                                    \
+      if (block_idx >= array->capacity_blocks) {                              \
+        size_t new_cap = array->capacity_blocks * 2;                          \
+        type **new_blocks = name##_directory_realloc(                         \
+            array, array->blocks, array->capacity_blocks, new_cap);           \
+        if (!new_blocks) return NULL;                                         \
+        array->blocks = new_blocks;                                           \
+        array->capacity_blocks = new_cap;                                     \
+        CONTAINER_STATS_ADD(array, reallocs, 1);                              \
+      }                                                                       \
+      array->blocks[block_idx] = name##_acquire_block(array);                 \
+      if (!array->blocks[block_idx]) return NULL;                             \
+      array->num_blocks++;                                                    \
+      CONTAINER_STATS_MAX(array, peak_capacity,                               \
+                          array->num_blocks * name##_BLOCK_SIZE);             \
+    }                                                                         \
+    type *res =                                                               \
+        &array->blocks[block_idx][array->size & (name##_BLOCK_SIZE - 1)];     \
+    array->size++;                                                            \
+    CONTAINER_STATS_MAX(array, peak_size, array->size);                       \
+    return res;                                                               \
+  }                                                                           \
+                                                                              \
+  void name##_push_back(name *const array, type value) {                      \
+    type *slot = name##_push_back_ref(array);                                 \
+    if (slot) *slot = value;                                                  \
+  }                                                                           \
+                                                                              \
+  /* Shrinks by one element, releasing surplus blocks at block boundaries. */ \
+  static inline void name##_drop_back(name *const array) {                    \
+    array->size--;                                                            \
+    if ((array->size & (name##_BLOCK_SIZE - 1)) == 0) {                       \
+      name##_release_spare_blocks(array, array->max_spare_blocks);            \
+    }                                                                         \
+  }                                                                           \
+                                                                              \
+  bool name##_pop_back(name *const array, type *ptr) {                        \
+    if (array->size == 0) return false;                                       \
+    if (ptr)                                                                  \
+      *ptr = name##_pop_back_unchecked(array);                                \
+    else                                                                      \
+      name##_drop_back(array);                                                \
+    return true;                                                              \
+  }                                                                           \
+                                                                              \
+  type name##_pop_back_unchecked(name *const array) {                         \
+    type val = *name##_internal_get(array, (int32_t)array->size - 1);         \
+    name##_drop_back(array);                                                  \
+    return val;                                                               \
+  }                                                                           \
+                                                                              \
+  /* --- Block retention --- */                                               \
+  void name##_set_max_spare_blocks(name *const array, size_t max_blocks) {    \
+    array->max_spare_blocks = max_blocks;                                     \
+    name##_release_spare_blocks(array, max_blocks);                           \
+  }                                                                           \
+                                                                              \
+  /* `cache` must outlive the array: finalize releases blocks into it. */     \
+  void name##_set_block_cache(name *const array, name##BlockCache *cache) {   \
+    array->cache = cache;                                                     \
+  }                                                                           \
+                                                                              \
+  /* Returns every spare block to the allocator, even with a cache set. */    \
+  void name##_trim(name *const array) {                                       \
+    name##_free_spare_blocks(array);                                          \
+  }                                                                           \
+                                                                              \
+  bool name##BlockCache_init(name##BlockCache *cache, size_t capacity) {      \
+    cache->count = 0;                                                         \
+    cache->capacity = capacity;                                               \
+    cache->allocator = NULL;                                                  \
+    cache->blocks = (type **)calloc(capacity > 0 ? capacity : 1,              \
+                                    sizeof(type *));                          \
+    return cache->blocks != NULL;                                             \
+  }                                                                           \
+                                                                              \
+  void name##BlockCache_finalize(name##BlockCache *cache) {                   \
+    if (!cache) return;                                                       \
+    for (size_t i = 0; i < cache->count; ++i) {                               \
+      name##_block_free(cache->allocator, cache->blocks[i]);                  \
+    }                                                                         \
+    free(cache->blocks);                                                      \
+    cache->blocks = NULL;                                                     \
+    cache->count = 0;                                                         \
+  }                                                                           \
+                                                                              \
+  /* --- Random access mutation --- */                                        \
+  bool name##_set(name *const array, int32_t index, type value) {             \
+    type *slot = name##_internal_get(array, index);                           \
+    if (!slot) return false;                                                  \
+    *slot = value;                                                            \
+    return true;                                                              \
+  }                                                                           \
+                                                                              \
+  bool name##_set_ref(name *const array, int32_t index, type **ptr) {         \
+    type *slot = name##_internal_get(array, index);                           \
+    if (!slot) return false;                                                  \
+    if (ptr) *ptr = slot;                                                     \
+    return true;                                                              \
+  }                                                                           \
+                                                                              \
+  type *name##_set_ref_unchecked(name *const array, int32_t index) {          \
+    return name##_internal_get(array, index);                                 \
+  }                                                                           \
+                                                                              \
+  /* --- Random access lookup --- */                                          \
+  bool name##_get(name *const array, int32_t index, type *ptr) {              \
+    type *slot = name##_internal_get(array, index);                           \
+    if (!slot) return false;                                                  \
+    if (ptr) *ptr = *slot;                                                    \
+    return true;                                                              \
+  }                                                                           \
+                                                                              \
+  type name##_get_unchecked(name *const array, int32_t index) {               \
+    return *name##_internal_get(array, index);                                \
+  }                                                                           \
+                                                                              \
+  bool name##_get_ref(name *const array, int32_t index, const type **ptr) {   \
+    type *slot = name##_internal_get(array, index);                           \
+    if (!slot) return false;                                                  \
+    if (ptr) *ptr = (const type *)slot;                                       \
+    return true;                                                              \
+  }                                                                           \
+                                                                              \
+  bool name##_mutable_ref(name *const array, int32_t index, type **ptr) {     \
+    type *slot = name##_internal_get(array, index);                           \
+    if (!slot) return false;                                                  \
+    if (ptr) *ptr = slot;                                                     \
+    return true;                                                              \
+  }                                                                           \
+                                                                              \
+  const type *name##_get_ref_unchecked(name *const array, int32_t index) {    \
+    return (const type *)name##_internal_get(array, index);                   \
+  }                                                                           \
+                                                                              \
+  type *name##_mutable_ref_unchecked(name *const array, int32_t index) {      \
+    return name##_internal_get(array, index);                                 \
+  }                                                                           \
+                                                                              \
+  bool name##_last(name *const array, type *ptr) {                            \
+    return name##_get(array, (int32_t)array->size - 1, ptr);                  \
+  }                                                                           \
+                                                                              \
+  type name##_last_unchecked(name *const array) {                             \
+    return name##_get_unchecked(array, (int32_t)array->size - 1);             \
+  }                                                                           \
+                                                                              \
+  bool name##_last_ref(name *const array, const type **ptr) {                 \
+    return name##_get_ref(array, (int32_t)array->size - 1, ptr);              \
+  }                                                                           \
+                                                                              \
+  const type *name##_last_ref_unchecked(name *const array) {                  \
+    return name##_get_ref_unchecked(array, (int32_t)array->size - 1);         \
+  }                                                                           \
+                                                                              \
+  /* --- Size and state --- */                                                \
+  size_t name##_size(const name *const array) { return array->size; }         \
+  bool name##_is_empty(const name *const array) { return array->size == 0; }  \
+  ContainerStats name##_stats(const name *const array) {                      \
+    return CONTAINER_STATS_GET(array);                                        \
+  }                                                                           \
+                                                                              \
+  /* --- Iteration --- */                                                     \
+  void name##_iterator(name##Iterator *it, name *const array) {               \
+    it->array = array;                                                        \
+    it->index = 0;                                                            \
+  }                                                                           \
+                                                                              \
+  bool name##_has_next(const name##Iterator *const it) {                      \
+    return it->index < it->array->size;                                       \
+  }                                                                           \
+                                                                              \
+  void name##_next(name##Iterator *it) { it->index++; }                       \
+                                                                              \
+  const type *name##_value(const name##Iterator *const it) {                  \
+    return name##_get_ref_unchecked(it->array, (int32_t)it->index);           \
+  }                                                                           \
+                                                                              \
+  type *name##_mutable_value(const name##Iterator *const it) {                \
+    return name##_mutable_ref_unchecked(it->array, (int32_t)it->index);       \
   }
 
 #ifdef __cplusplus
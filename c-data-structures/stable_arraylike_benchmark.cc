@@ -0,0 +1,267 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <deque>
+#include <random>
+#include <vector>
+
+#include "c-data-structures/stable_arraylike.h"
+
+namespace {
+
+/* Element types used to sweep element size. */
+template <size_t N>
+struct Blob {
+  char bytes[N];
+};
+
+using Blob64 = Blob<64>;
+using Blob256 = Blob<256>;
+
+DEFINE_STABLE_ARRAYLIKE(StableInt32Array, int32_t);
+IMPL_STABLE_ARRAYLIKE(StableInt32Array, int32_t);
+DEFINE_STABLE_ARRAYLIKE(StableBlob64Array, Blob64);
+IMPL_STABLE_ARRAYLIKE(StableBlob64Array, Blob64);
+DEFINE_STABLE_ARRAYLIKE(StableBlob256Array, Blob256);
+IMPL_STABLE_ARRAYLIKE(StableBlob256Array, Blob256);
+
+/* Page-sized blocks (4 KB) for the block size comparison below. */
+DEFINE_STABLE_ARRAYLIKE_N(PageInt32Array, int32_t, 10);
+IMPL_STABLE_ARRAYLIKE(PageInt32Array, int32_t);
+DEFINE_STABLE_ARRAYLIKE_N(PageBlob256Array, Blob256, 4);
+IMPL_STABLE_ARRAYLIKE(PageBlob256Array, Blob256);
+
+/* Maps an element type to its generated stable_arraylike so the benchmarks
+ * below can be written once and instantiated per element size. */
+template <typename T>
+struct Ops;
+
+#define STABLE_ARRAYLIKE_OPS(Array, T)                                      \
+  template <>                                                               \
+  struct Ops<T> {                                                           \
+    using A = Array;                                                        \
+    using Iterator = Array##Iterator;                                       \
+    static void init(A* a) { Array##_init(a); }                             \
+    static void finalize(A* a) { Array##_finalize(a); }                     \
+    static void push_back(A* a, T v) { Array##_push_back(a, v); }           \
+    static const T* get_ref(A* a, int32_t i) {                              \
+      return Array##_get_ref_unchecked(a, i);                               \
+    }                                                                       \
+    static void iterator(Iterator* it, A* a) { Array##_iterator(it, a); }   \
+    static bool has_next(const Iterator* it) {                              \
+      return Array##_has_next(it);                                          \
+    }                                                                       \
+    static void next(Iterator* it) { Array##_next(it); }                    \
+    static const T* value(const Iterator* it) { return Array##_value(it); } \
+  }
+
+STABLE_ARRAYLIKE_OPS(StableInt32Array, int32_t);
+STABLE_ARRAYLIKE_OPS(StableBlob64Array, Blob64);
+STABLE_ARRAYLIKE_OPS(StableBlob256Array, Blob256);
+
+/* Fixed-seed random indices in [0, n) so every run probes the same slots. */
+std::vector<int32_t> RandomIndices(int64_t n) {
+  std::mt19937 rng(42);
+  std::uniform_int_distribution<int32_t> dist(0, (int32_t)n - 1);
+  std::vector<int32_t> indices(n);
+  for (auto& index : indices) {
+    index = dist(rng);
+  }
+  return indices;
+}
+
+/* -------------------------------------------------------------
+ * stable_arraylike
+ * ------------------------------------------------------------- */
+
+template <typename T>
+void BM_StableArrayLike_PushBack(benchmark::State& state) {
+  const int64_t n = state.range(0);
+  for (auto _ : state) {
+    typename Ops<T>::A array;
+    Ops<T>::init(&array);
+    for (int64_t i = 0; i < n; ++i) {
+      Ops<T>::push_back(&array, T{});
+    }
+    benchmark::DoNotOptimize(array.blocks);
+    Ops<T>::finalize(&array);
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+template <typename T>
+void BM_StableArrayLike_RandomGet(benchmark::State& state) {
+  const int64_t n = state.range(0);
+  typename Ops<T>::A array;
+  Ops<T>::init(&array);
+  for (int64_t i = 0; i < n; ++i) {
+    Ops<T>::push_back(&array, T{});
+  }
+  const std::vector<int32_t> indices = RandomIndices(n);
+  for (auto _ : state) {
+    for (int32_t index : indices) {
+      benchmark::DoNotOptimize(Ops<T>::get_ref(&array, index));
+    }
+  }
+  Ops<T>::finalize(&array);
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+template <typename T>
+void BM_StableArrayLike_Iterate(benchmark::State& state) {
+  const int64_t n = state.range(0);
+  typename Ops<T>::A array;
+  Ops<T>::init(&array);
+  for (int64_t i = 0; i < n; ++i) {
+    Ops<T>::push_back(&array, T{});
+  }
+  for (auto _ : state) {
+    typename Ops<T>::Iterator it;
+    for (Ops<T>::iterator(&it, &array); Ops<T>::has_next(&it);
+         Ops<T>::next(&it)) {
+      benchmark::DoNotOptimize(Ops<T>::value(&it));
+    }
+  }
+  Ops<T>::finalize(&array);
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+/* -------------------------------------------------------------
+ * Block size
+ *
+ * Compares the generated shift/mask lookup (name##_internal_get, which
+ * backs every accessor) against the signed divide/modulo lookup
+ * stable_arraylike used before block sizes became per-instantiation, for
+ * the default and page-sized blocks. Both are inlined so only the index
+ * arithmetic and the cache behaviour of the block size differ.
+ * ------------------------------------------------------------- */
+
+/* The lookup stable_arraylike used before DEFINE_STABLE_ARRAYLIKE_N. */
+template <int32_t kBlockSize, typename T, typename A>
+const T* DivModGet(const A* array, int32_t index) {
+  if (index < 0 || (size_t)index >= array->size) return nullptr;
+  size_t block_idx = index / kBlockSize;
+  size_t offset = index % kBlockSize;
+  return &array->blocks[block_idx][offset];
+}
+
+#define BLOCK_SIZE_BENCHMARKS(Array, T)                                \
+  void BM_##Array##_RandomGet(benchmark::State& state) {               \
+    const int64_t n = state.range(0);                                  \
+    Array array;                                                       \
+    Array##_init(&array);                                              \
+    for (int64_t i = 0; i < n; ++i) {                                  \
+      Array##_push_back(&array, T{});                                  \
+    }                                                                  \
+    const std::vector<int32_t> indices = RandomIndices(n);             \
+    for (auto _ : state) {                                             \
+      for (int32_t index : indices) {                                  \
+        benchmark::DoNotOptimize(Array##_internal_get(&array, index)); \
+      }                                                                \
+    }                                                                  \
+    Array##_finalize(&array);                                          \
+    state.SetItemsProcessed(state.iterations() * n);                   \
+  }                                                                    \
+                                                                       \
+  void BM_##Array##_RandomGetDivMod(benchmark::State& state) {         \
+    const int64_t n = state.range(0);                                  \
+    Array array;                                                       \
+    Array##_init(&array);                                              \
+    for (int64_t i = 0; i < n; ++i) {                                  \
+      Array##_push_back(&array, T{});                                  \
+    }                                                                  \
+    const std::vector<int32_t> indices = RandomIndices(n);             \
+    for (auto _ : state) {                                             \
+      for (int32_t index : indices) {                                  \
+        benchmark::DoNotOptimize(                                      \
+            DivModGet<Array##_BLOCK_SIZE, T>(&array, index));          \
+      }                                                                \
+    }                                                                  \
+    Array##_finalize(&array);                                          \
+    state.SetItemsProcessed(state.iterations() * n);                   \
+  }
+
+BLOCK_SIZE_BENCHMARKS(StableInt32Array, int32_t)
+BLOCK_SIZE_BENCHMARKS(PageInt32Array, int32_t)
+BLOCK_SIZE_BENCHMARKS(StableBlob256Array, Blob256)
+BLOCK_SIZE_BENCHMARKS(PageBlob256Array, Blob256)
+
+/* -------------------------------------------------------------
+ * std::vector / std::deque baselines
+ *
+ * std::deque is the closest standard analogue: it also stores elements in
+ * fixed-size blocks and never moves them on push_back.
+ * ------------------------------------------------------------- */
+
+template <typename Container>
+void BM_Std_PushBack(benchmark::State& state) {
+  const int64_t n = state.range(0);
+  for (auto _ : state) {
+    Container c;
+    for (int64_t i = 0; i < n; ++i) {
+      c.push_back(typename Container::value_type{});
+    }
+    benchmark::DoNotOptimize(&c.back());
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+template <typename Container>
+void BM_Std_RandomGet(benchmark::State& state) {
+  const int64_t n = state.range(0);
+  Container c(n);
+  const std::vector<int32_t> indices = RandomIndices(n);
+  for (auto _ : state) {
+    for (int32_t index : indices) {
+      benchmark::DoNotOptimize(&c[index]);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+template <typename Container>
+void BM_Std_Iterate(benchmark::State& state) {
+  const int64_t n = state.range(0);
+  Container c(n);
+  for (auto _ : state) {
+    for (const auto& value : c) {
+      benchmark::DoNotOptimize(&value);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+#define RANGE RangeMultiplier(8)->Range(64, 1 << 18)
+
+#define REGISTER_FOR_SIZES(bm)            \
+  BENCHMARK_TEMPLATE(bm, int32_t)->RANGE; \
+  BENCHMARK_TEMPLATE(bm, Blob64)->RANGE;  \
+  BENCHMARK_TEMPLATE(bm, Blob256)->RANGE
+
+#define REGISTER_STD_FOR_SIZES(bm, container)        \
+  BENCHMARK_TEMPLATE(bm, container<int32_t>)->RANGE; \
+  BENCHMARK_TEMPLATE(bm, container<Blob64>)->RANGE;  \
+  BENCHMARK_TEMPLATE(bm, container<Blob256>)->RANGE
+
+REGISTER_FOR_SIZES(BM_StableArrayLike_PushBack);
+REGISTER_STD_FOR_SIZES(BM_Std_PushBack, std::vector);
+REGISTER_STD_FOR_SIZES(BM_Std_PushBack, std::deque);
+
+REGISTER_FOR_SIZES(BM_StableArrayLike_RandomGet);
+REGISTER_STD_FOR_SIZES(BM_Std_RandomGet, std::vector);
+REGISTER_STD_FOR_SIZES(BM_Std_RandomGet, std::deque);
+
+BENCHMARK(BM_StableInt32Array_RandomGet)->RANGE;
+BENCHMARK(BM_StableInt32Array_RandomGetDivMod)->RANGE;
+BENCHMARK(BM_PageInt32Array_RandomGet)->RANGE;
+BENCHMARK(BM_PageInt32Array_RandomGetDivMod)->RANGE;
+BENCHMARK(BM_StableBlob256Array_RandomGet)->RANGE;
+BENCHMARK(BM_StableBlob256Array_RandomGetDivMod)->RANGE;
+BENCHMARK(BM_PageBlob256Array_RandomGet)->RANGE;
+BENCHMARK(BM_PageBlob256Array_RandomGetDivMod)->RANGE;
+
+REGISTER_FOR_SIZES(BM_StableArrayLike_Iterate);
+REGISTER_STD_FOR_SIZES(BM_Std_Iterate, std::vector);
+REGISTER_STD_FOR_SIZES(BM_Std_Iterate, std::deque);
+
+}  // namespace
@@ -9,6 +9,42 @@ namespace {
 DEFINE_STABLE_ARRAYLIKE(StableIntArray, int);
 IMPL_STABLE_ARRAYLIKE(StableIntArray, int);
 
+/* Per-instantiation block sizes */
+DEFINE_STABLE_ARRAYLIKE_N(PageIntArray, int, 10);
+IMPL_STABLE_ARRAYLIKE(PageIntArray, int);
+DEFINE_STABLE_ARRAYLIKE_N(SingleIntArray, int, 0);
+IMPL_STABLE_ARRAYLIKE(SingleIntArray, int);
+
+/* Allocator that forwards to malloc and tracks outstanding bytes */
+struct CountingAllocator {
+  size_t allocations = 0;
+  size_t live_bytes = 0;
+};
+
+void* CountingAllocate(void* ctx, size_t size) {
+  auto* counts = static_cast<CountingAllocator*>(ctx);
+  counts->allocations++;
+  counts->live_bytes += size;
+  return malloc(size);
+}
+
+void* CountingReallocate(void* ctx, void* ptr, size_t old_size,
+                         size_t new_size) {
+  auto* counts = static_cast<CountingAllocator*>(ctx);
+  counts->live_bytes += new_size - old_size;
+  return realloc(ptr, new_size);
+}
+
+void CountingDeallocate(void* ctx, void* ptr, size_t size) {
+  auto* counts = static_cast<CountingAllocator*>(ctx);
+  counts->live_bytes -= size;
+  free(ptr);
+}
+
+DEFINE_STABLE_ARRAYLIKE_WITH_ALLOC(AllocStableIntArray, int);
+IMPL_STABLE_ARRAYLIKE_WITH_ALLOC(AllocStableIntArray, int,
+                                 allocator_default());
+
 /* Test fixture to ensure proper setup / teardown */
 class StableIntArrayTest : public ::testing::Test {
  protected:
@@ -28,6 +64,29 @@ TEST_F(StableIntArrayTest, StartsEmpty) {
   EXPECT_EQ(StableIntArray_size(&array), 0u);
 }
 
+/* -------------------------------------------------------------
+ * Allocator hooks
+ * ------------------------------------------------------------- */
+
+TEST(AllocStableIntArrayTest, RoutesBlocksThroughAllocator) {
+  CountingAllocator counts;
+  const Allocator allocator = {CountingAllocate, CountingReallocate,
+                               CountingDeallocate, &counts};
+
+  AllocStableIntArray arr{};
+  ASSERT_TRUE(AllocStableIntArray_init_allocator(&arr, &allocator));
+  const int kCount = STABLE_ARRAY_BLOCK_SIZE * 10;
+  for (int i = 0; i < kCount; ++i) {
+    AllocStableIntArray_push_back(&arr, i);
+  }
+  /* One directory plus one allocation per block. */
+  EXPECT_EQ(counts.allocations, 11u);
+  EXPECT_EQ(AllocStableIntArray_get_unchecked(&arr, kCount - 1), kCount - 1);
+
+  AllocStableIntArray_finalize(&arr);
+  EXPECT_EQ(counts.live_bytes, 0u);
+}
+
 /* -------------------------------------------------------------
  * Push / Pop Back
  * ------------------------------------------------------------- */
@@ -125,4 +184,160 @@ TEST_F(StableIntArrayTest, LastElementAccess) {
   EXPECT_EQ(StableIntArray_last_unchecked(&array), 3);
 }
 
+/* -------------------------------------------------------------
+ * Block retention
+ * ------------------------------------------------------------- */
+
+TEST_F(StableIntArrayTest, PopBackReleasesSurplusBlocks) {
+  const int kCount = STABLE_ARRAY_BLOCK_SIZE * 10;
+  for (int i = 0; i < kCount; ++i) {
+    StableIntArray_push_back(&array, i);
+  }
+  EXPECT_EQ(array.num_blocks, 10u);
+
+  while (StableIntArray_pop_back(&array, nullptr)) {
+  }
+  EXPECT_EQ(array.num_blocks, (size_t)STABLE_ARRAY_DEFAULT_SPARE_BLOCKS);
+
+  /* The retained block is reused. */
+  StableIntArray_push_back(&array, 7);
+  EXPECT_EQ(array.num_blocks, (size_t)STABLE_ARRAY_DEFAULT_SPARE_BLOCKS);
+  EXPECT_EQ(StableIntArray_get_unchecked(&array, 0), 7);
+}
+
+TEST_F(StableIntArrayTest, SetMaxSpareBlocks) {
+  StableIntArray_set_max_spare_blocks(&array, 3);
+  const int kCount = STABLE_ARRAY_BLOCK_SIZE * 8;
+  for (int i = 0; i < kCount; ++i) {
+    StableIntArray_push_back(&array, i);
+  }
+  for (int i = 0; i < STABLE_ARRAY_BLOCK_SIZE * 6; ++i) {
+    StableIntArray_pop_back_unchecked(&array);
+  }
+  /* Two blocks in use plus three spares. */
+  EXPECT_EQ(array.num_blocks, 5u);
+
+  StableIntArray_set_max_spare_blocks(&array, 0);
+  EXPECT_EQ(array.num_blocks, 2u);
+}
+
+TEST_F(StableIntArrayTest, TrimReleasesAllSpareBlocks) {
+  StableIntArray_set_max_spare_blocks(&array, SIZE_MAX);
+  for (int i = 0; i < STABLE_ARRAY_BLOCK_SIZE * 4; ++i) {
+    StableIntArray_push_back(&array, i);
+  }
+  for (int i = 0; i < STABLE_ARRAY_BLOCK_SIZE * 3 + 1; ++i) {
+    StableIntArray_pop_back_unchecked(&array);
+  }
+  EXPECT_EQ(array.num_blocks, 4u);
+
+  StableIntArray_trim(&array);
+  EXPECT_EQ(array.num_blocks, 1u);
+  EXPECT_EQ(StableIntArray_size(&array), STABLE_ARRAY_BLOCK_SIZE - 1u);
+  EXPECT_EQ(StableIntArray_last_unchecked(&array), STABLE_ARRAY_BLOCK_SIZE - 2);
+}
+
+TEST(StableIntArrayBlockCacheTest, SharesBlocksBetweenArrays) {
+  StableIntArrayBlockCache cache;
+  ASSERT_TRUE(StableIntArrayBlockCache_init(&cache, 2));
+
+  StableIntArray a, b;
+  ASSERT_TRUE(StableIntArray_init(&a));
+  ASSERT_TRUE(StableIntArray_init(&b));
+  StableIntArray_set_block_cache(&a, &cache);
+  StableIntArray_set_block_cache(&b, &cache);
+
+  for (int i = 0; i < STABLE_ARRAY_BLOCK_SIZE * 4; ++i) {
+    StableIntArray_push_back(&a, i);
+  }
+  /* Blocks are released last-first, so block 2 is on top of the cache. */
+  int* reused_block = a.blocks[2];
+  StableIntArray_finalize(&a);
+  /* The cache is bounded; the remaining blocks were freed. */
+  EXPECT_EQ(cache.count, 2u);
+
+  StableIntArray_push_back(&b, 1);
+  EXPECT_EQ(cache.count, 1u);
+  EXPECT_EQ(b.blocks[0], reused_block);
+  StableIntArray_finalize(&b);
+  EXPECT_EQ(cache.count, 2u);
+
+  StableIntArrayBlockCache_finalize(&cache);
+}
+
+TEST(StableIntArrayBlockCacheTest, TrimBypassesTheCache) {
+  CountingAllocator counts;
+  const Allocator allocator = {CountingAllocate, CountingReallocate,
+                               CountingDeallocate, &counts};
+  AllocStableIntArrayBlockCache cache;
+  ASSERT_TRUE(AllocStableIntArrayBlockCache_init(&cache, 8));
+
+  AllocStableIntArray arr{};
+  ASSERT_TRUE(AllocStableIntArray_init_allocator(&arr, &allocator));
+  AllocStableIntArray_set_block_cache(&arr, &cache);
+  AllocStableIntArray_set_max_spare_blocks(&arr, SIZE_MAX);
+  for (int i = 0; i < STABLE_ARRAY_BLOCK_SIZE * 4; ++i) {
+    AllocStableIntArray_push_back(&arr, i);
+  }
+  for (int i = 0; i < STABLE_ARRAY_BLOCK_SIZE * 3; ++i) {
+    AllocStableIntArray_pop_back_unchecked(&arr);
+  }
+  size_t live = counts.live_bytes;
+
+  AllocStableIntArray_trim(&arr);
+  EXPECT_EQ(cache.count, 0u);
+  EXPECT_EQ(arr.num_blocks, 1u);
+  EXPECT_EQ(counts.live_bytes,
+            live - 3 * STABLE_ARRAY_BLOCK_SIZE * sizeof(int));
+
+  AllocStableIntArray_finalize(&arr);
+  AllocStableIntArrayBlockCache_finalize(&cache);
+  EXPECT_EQ(counts.live_bytes, 0u);
+}
+
+/* -------------------------------------------------------------
+ * Block size
+ * ------------------------------------------------------------- */
+
+TEST(StableArrayBlockSizeTest, DefaultMatchesGlobalBlockSize) {
+  EXPECT_EQ(StableIntArray_BLOCK_SIZE, STABLE_ARRAY_BLOCK_SIZE);
+  EXPECT_EQ(1 << StableIntArray_BLOCK_SHIFT, STABLE_ARRAY_BLOCK_SIZE);
+}
+
+TEST(StableArrayBlockSizeTest, PerInstantiationBlockSize) {
+  EXPECT_EQ(PageIntArray_BLOCK_SIZE, 1024);
+  PageIntArray arr;
+  ASSERT_TRUE(PageIntArray_init(&arr));
+  const int kCount = 1024 * 3 + 1;
+  for (int i = 0; i < kCount; ++i) {
+    PageIntArray_push_back(&arr, i);
+  }
+  EXPECT_EQ(arr.num_blocks, 4u);
+  for (int i = 0; i < kCount; ++i) {
+    ASSERT_EQ(PageIntArray_get_unchecked(&arr, i), i);
+  }
+  PageIntArray_finalize(&arr);
+}
+
+TEST(StableArrayBlockSizeTest, SingleElementBlocks) {
+  EXPECT_EQ(SingleIntArray_BLOCK_SIZE, 1);
+  SingleIntArray arr;
+  ASSERT_TRUE(SingleIntArray_init(&arr));
+  for (int i = 0; i < 100; ++i) {
+    SingleIntArray_push_back(&arr, i);
+  }
+  EXPECT_EQ(arr.num_blocks, 100u);
+  const int* first = nullptr;
+  ASSERT_TRUE(SingleIntArray_get_ref(&arr, 0, &first));
+  EXPECT_EQ(*first, 0);
+  EXPECT_EQ(SingleIntArray_last_unchecked(&arr), 99);
+
+  int value = 0;
+  while (SingleIntArray_pop_back(&arr, &value)) {
+  }
+  EXPECT_EQ(value, 0);
+  EXPECT_EQ(arr.num_blocks, (size_t)STABLE_ARRAY_DEFAULT_SPARE_BLOCKS);
+  SingleIntArray_finalize(&arr);
+}
+
 }  // namespace
\ No newline at end of file